@@ -0,0 +1,290 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <wpi/Logger.h>
+#include <wpi/RawFrame.h>
+#include <wpi/SmallString.h>
+#include <wpi/StringExtras.h>
+#include <wpinet/HttpUtil.h>
+#include <wpinet/TCPConnector.h>
+#include <wpinet/raw_socket_istream.h>
+
+#include "cscore.h"
+#include "cscore_cv.h"
+#include "cscore_raw.h"
+
+namespace {
+
+// Synthetic test pattern in a given pixel format, fed through a RawSource.
+class SyntheticSource {
+ public:
+  SyntheticSource(cs::VideoMode::PixelFormat pixelFormat, int width,
+                  int height)
+      : m_source{"synthetic", pixelFormat, width, height, 30} {
+    // Diagonal gradient (the content doesn't matter much, but compresses
+    // more like a real scene than a constant image)
+    cv::Mat bgr{height, width, CV_8UC3};
+    for (int y = 0; y < height; ++y) {
+      auto row = bgr.ptr<uint8_t>(y);
+      for (int x = 0; x < width; ++x) {
+        row[x * 3] = x + y;
+        row[x * 3 + 1] = x * 2;
+        row[x * 3 + 2] = y * 2;
+      }
+    }
+
+    std::vector<uint8_t> data;
+    int stride = 0;
+    switch (pixelFormat) {
+      case cs::VideoMode::kBGR:
+        data.assign(bgr.data, bgr.data + bgr.total() * bgr.elemSize());
+        stride = width * 3;
+        break;
+      case cs::VideoMode::kYUYV:
+        // OpenCV can't produce YUYV, so generate it directly
+        data.resize(width * height * 2);
+        for (int y = 0; y < height; ++y) {
+          for (int x = 0; x < width; ++x) {
+            uint8_t* p = &data[(y * width + x) * 2];
+            p[0] = x + y;                 // Y
+            p[1] = (x % 2 == 0) ? x : y;  // U or V
+          }
+        }
+        stride = width * 2;
+        break;
+      case cs::VideoMode::kMJPEG:
+        cv::imencode(".jpg", bgr, data);
+        break;
+      default:
+        break;
+    }
+
+    WPI_AllocateRawFrameData(&m_frame, data.size());
+    std::memcpy(m_frame.data, data.data(), data.size());
+    m_frame.size = data.size();
+    m_frame.pixelFormat = pixelFormat;
+    m_frame.width = width;
+    m_frame.height = height;
+    m_frame.stride = stride;
+  }
+
+  cs::RawSource& GetSource() { return m_source; }
+
+  void PutFrame() {
+    CS_Status status = 0;
+    cs::PutSourceFrame(m_source.GetHandle(), m_frame, &status);
+  }
+
+ private:
+  cs::RawSource m_source;
+  wpi::RawFrame m_frame;
+};
+
+void ResolutionArgs(benchmark::internal::Benchmark* b) {
+  b->Args({640, 480})
+      ->Args({1280, 720})
+      ->Args({1920, 1080})
+      ->ArgNames({"width", "height"})
+      ->MeasureProcessCPUTime()
+      ->UseRealTime()
+      ->Unit(benchmark::kMillisecond);
+}
+
+// Source -> CvSink, converting to sinkFormat at the source resolution
+void BM_CvSink(benchmark::State& state, cs::VideoMode::PixelFormat srcFormat,
+               cs::VideoMode::PixelFormat sinkFormat) {
+  int width = state.range(0);
+  int height = state.range(1);
+  SyntheticSource source{srcFormat, width, height};
+  cs::CvSink sink{"sink", sinkFormat};
+  sink.SetSource(source.GetSource());
+
+  cv::Mat image;
+  uint64_t lastTime = 0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    source.PutFrame();
+    lastTime = sink.GrabFrameDirectLastTime(image, lastTime);
+    if (lastTime == 0) {
+      state.SkipWithError("failed to grab frame");
+      break;
+    }
+  }
+  state.counters["fps"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_CvSink, BGR_to_BGR, cs::VideoMode::kBGR,
+                  cs::VideoMode::kBGR)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_CvSink, BGR_to_Gray, cs::VideoMode::kBGR,
+                  cs::VideoMode::kGray)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_CvSink, YUYV_to_BGR, cs::VideoMode::kYUYV,
+                  cs::VideoMode::kBGR)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_CvSink, YUYV_to_Gray, cs::VideoMode::kYUYV,
+                  cs::VideoMode::kGray)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_CvSink, MJPEG_to_BGR, cs::VideoMode::kMJPEG,
+                  cs::VideoMode::kBGR)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_CvSink, MJPEG_to_Gray, cs::VideoMode::kMJPEG,
+                  cs::VideoMode::kGray)
+    ->Apply(ResolutionArgs);
+
+// Loopback HTTP client for an MjpegServer stream
+class MjpegClient {
+ public:
+  explicit MjpegClient(int port) {
+    // The server may take a moment to start listening
+    for (int i = 0; i < 50 && !m_stream; ++i) {
+      m_stream = wpi::TCPConnector::connect("127.0.0.1", port, m_logger, 1);
+      if (!m_stream) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    if (!m_stream) {
+      return;
+    }
+    m_is = std::make_unique<wpi::raw_socket_istream>(*m_stream, 1);
+
+    std::string_view req = "GET /stream.mjpg HTTP/1.0\r\n\r\n";
+    wpi::NetworkStream::Error err;
+    m_stream->send(req.data(), req.size(), &err);
+
+    // Response line and headers
+    wpi::SmallString<64> line;
+    m_is->getline(line, 1024);
+    m_ok = !m_is->has_error() &&
+           wpi::ParseHttpHeaders(*m_is, nullptr, nullptr);
+  }
+
+  explicit operator bool() const { return m_ok; }
+
+  // Reads the next image from the stream; returns its size, or 0 on error.
+  size_t ReadFrame() {
+    if (!wpi::FindMultipartBoundary(*m_is, "boundarydonotcross", nullptr)) {
+      return 0;
+    }
+    wpi::SmallString<64> contentLength;
+    if (!wpi::ParseHttpHeaders(*m_is, nullptr, &contentLength)) {
+      return 0;
+    }
+    auto len = wpi::parse_integer<size_t>(wpi::trim(contentLength.str()), 10);
+    if (!len) {
+      return 0;
+    }
+    m_buf.resize(*len);
+    m_is->read(m_buf.data(), *len);
+    return m_is->has_error() ? 0 : *len;
+  }
+
+ private:
+  wpi::Logger m_logger;
+  std::unique_ptr<wpi::NetworkStream> m_stream;
+  std::unique_ptr<wpi::raw_socket_istream> m_is;
+  std::vector<char> m_buf;
+  bool m_ok = false;
+};
+
+// Source -> MjpegServer -> loopback HTTP client.  A producer thread puts a
+// new frame each time the client receives one (or after a short timeout, in
+// case the server missed a frame), so this measures the sustained rate of
+// the full server pipeline.
+void BM_MjpegServer(benchmark::State& state,
+                    cs::VideoMode::PixelFormat srcFormat, int scaleDivisor,
+                    int numClients) {
+  static int port = 18080;
+  ++port;
+
+  int width = state.range(0);
+  int height = state.range(1);
+  SyntheticSource source{srcFormat, width, height};
+  cs::MjpegServer server{"server", port};
+  server.SetSource(source.GetSource());
+  if (scaleDivisor != 1) {
+    server.SetResolution(width / scaleDivisor, height / scaleDivisor);
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool consumed = false;
+  std::atomic_bool active{true};
+  std::thread producer{[&] {
+    std::unique_lock lock{mutex};
+    while (active) {
+      lock.unlock();
+      source.PutFrame();
+      lock.lock();
+      cv.wait_for(lock, std::chrono::milliseconds(5),
+                  [&] { return consumed || !active; });
+      consumed = false;
+    }
+  }};
+
+  std::vector<std::unique_ptr<MjpegClient>> clients;
+  for (int i = 0; i < numClients; ++i) {
+    clients.emplace_back(std::make_unique<MjpegClient>(port));
+    if (!*clients.back()) {
+      state.SkipWithError("could not connect to server");
+    }
+  }
+
+  size_t bytes = 0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    if (clients.empty() || !*clients.front()) {
+      break;
+    }
+    for (auto&& client : clients) {
+      size_t size = client->ReadFrame();
+      if (size == 0) {
+        state.SkipWithError("failed to read frame");
+        break;
+      }
+      bytes += size;
+    }
+    {
+      std::scoped_lock lock{mutex};
+      consumed = true;
+    }
+    cv.notify_one();
+  }
+
+  active = false;
+  cv.notify_one();
+  producer.join();
+  clients.clear();
+
+  state.counters["fps"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK_CAPTURE(BM_MjpegServer, MJPEG_passthrough, cs::VideoMode::kMJPEG, 1,
+                  1)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_MjpegServer, MJPEG_half_size, cs::VideoMode::kMJPEG, 2, 1)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_MjpegServer, BGR, cs::VideoMode::kBGR, 1, 1)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_MjpegServer, BGR_4_clients, cs::VideoMode::kBGR, 1, 4)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_MjpegServer, YUYV, cs::VideoMode::kYUYV, 1, 1)
+    ->Apply(ResolutionArgs);
+BENCHMARK_CAPTURE(BM_MjpegServer, YUYV_half_size, cs::VideoMode::kYUYV, 2, 1)
+    ->Apply(ResolutionArgs);
+
+}  // namespace
@@ -0,0 +1,116 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include "frc/EigenCore.h"
+#include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/system/AutodiffJacobian.h"
+
+namespace {
+
+constexpr units::second_t kDt = 5_ms;
+
+// Differential drive with x = [x, y, heading, left velocity, right velocity]ᵀ
+// and u = [left voltage, right voltage]ᵀ
+template <typename Vector>
+Vector Drive(const Vector& x, const Vector& u) {
+  using std::cos;
+  using std::sin;
+  using slp::cos;
+  using slp::sin;
+
+  constexpr double kA = -4.0;  // Velocity decay (1/s)
+  constexpr double kB = 1.5;   // Acceleration per volt (m/s²/V)
+  constexpr double kC = 0.3;   // Coupling between sides
+  constexpr double kTrackwidth = 0.7;
+
+  Vector xdot{5};
+  xdot[0] = 0.5 * (x[3] + x[4]) * cos(x[2]);
+  xdot[1] = 0.5 * (x[3] + x[4]) * sin(x[2]);
+  xdot[2] = (x[4] - x[3]) / kTrackwidth;
+  xdot[3] = kA * x[3] + kB * u[0] + kC * (kA * x[4] + kB * u[1]);
+  xdot[4] = kA * x[4] + kB * u[1] + kC * (kA * x[3] + kB * u[0]);
+  return xdot;
+}
+
+frc::Vectord<5> Dynamics(const frc::Vectord<5>& x, const frc::Vectord<2>& u) {
+  Eigen::VectorXd xdot = Drive<Eigen::VectorXd>(x, u);
+  return frc::Vectord<5>{xdot};
+}
+
+frc::Vectord<3> Measurement(const frc::Vectord<5>& x, const frc::Vectord<2>&) {
+  return frc::Vectord<3>{x(2), x(3), x(4)};
+}
+
+frc::Matrixd<3, 5> MeasurementJacobian(const frc::Vectord<5>&,
+                                       const frc::Vectord<2>&) {
+  return frc::Matrixd<3, 5>{{0.0, 0.0, 1.0, 0.0, 0.0},
+                            {0.0, 0.0, 0.0, 1.0, 0.0},
+                            {0.0, 0.0, 0.0, 0.0, 1.0}};
+}
+
+frc::AutodiffJacobian<5, 5, 2> DriveJacobian() {
+  return frc::AutodiffJacobian<5, 5, 2>{
+      [](const slp::VariableMatrix& x, const slp::VariableMatrix& u) {
+        return Drive(x, u);
+      }};
+}
+
+template <typename Filter>
+void RunFilter(benchmark::State& state, Filter& filter) {
+  frc::Vectord<2> u{6.0, 8.0};
+  frc::Vectord<3> y{0.1, 1.0, 1.2};
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    filter.Predict(u, kDt);
+    filter.Correct(u, y);
+    frc::Vectord<5> xHat = filter.Xhat();
+    benchmark::DoNotOptimize(xHat);
+  }
+}
+
+void BM_EKFNumerical(benchmark::State& state) {
+  frc::ExtendedKalmanFilter<5, 2, 3> ekf{
+      Dynamics, Measurement, {0.5, 0.5, 10.0, 1.0, 1.0}, {0.01, 0.1, 0.1}, kDt};
+  RunFilter(state, ekf);
+}
+BENCHMARK(BM_EKFNumerical);
+
+void BM_EKFAnalytic(benchmark::State& state) {
+  frc::ExtendedKalmanFilter<5, 2, 3> ekf{
+      Dynamics, Measurement, {0.5, 0.5, 10.0, 1.0, 1.0}, {0.01, 0.1, 0.1}, kDt};
+  ekf.SetStateJacobian(DriveJacobian());
+  ekf.SetMeasurementJacobian(MeasurementJacobian);
+  RunFilter(state, ekf);
+}
+BENCHMARK(BM_EKFAnalytic);
+
+void BM_UKFNumerical(benchmark::State& state) {
+  frc::UnscentedKalmanFilter<5, 2, 3> ukf{
+      Dynamics, Measurement, {0.5, 0.5, 10.0, 1.0, 1.0}, {0.01, 0.1, 0.1}, kDt};
+  RunFilter(state, ukf);
+}
+BENCHMARK(BM_UKFNumerical);
+
+void BM_UKFAnalytic(benchmark::State& state) {
+  frc::UnscentedKalmanFilter<5, 2, 3> ukf{
+      Dynamics, Measurement, {0.5, 0.5, 10.0, 1.0, 1.0}, {0.01, 0.1, 0.1}, kDt};
+  ukf.SetStateJacobian(DriveJacobian());
+  RunFilter(state, ukf);
+}
+BENCHMARK(BM_UKFAnalytic);
+
+void BM_UKFUnlinearizedProcessNoise(benchmark::State& state) {
+  frc::UnscentedKalmanFilter<5, 2, 3> ukf{
+      Dynamics, Measurement, {0.5, 0.5, 10.0, 1.0, 1.0}, {0.01, 0.1, 0.1}, kDt};
+  ukf.SetLinearizedProcessNoise(false);
+  RunFilter(state, ukf);
+}
+BENCHMARK(BM_UKFUnlinearizedProcessNoise);
+
+}  // namespace
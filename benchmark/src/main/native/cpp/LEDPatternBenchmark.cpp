@@ -0,0 +1,53 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "frc/AddressableLED.h"
+#include "frc/LEDPattern.h"
+
+namespace {
+
+// A pattern with a few layers, like one showing a mechanism's progress over
+// an animated background
+frc::LEDPattern LayeredPattern() {
+  auto progress = frc::LEDPattern::ProgressMaskLayer([] { return 0.7; });
+  auto gradient = frc::LEDPattern::Gradient(
+      frc::LEDPattern::kContinuous, {frc::Color::kRed, frc::Color::kBlue});
+  return frc::LEDPattern::Rainbow(255, 128)
+      .ScrollAtRelativeSpeed(0.5_Hz)
+      .Mask(progress)
+      .Blend(gradient.Reversed())
+      .Breathe(2_s);
+}
+
+// Applies the pattern through its chain of per-LED functions. The argument is
+// the number of LEDs.
+void BM_LEDPattern_ApplyTo(benchmark::State& state) {
+  auto pattern = LayeredPattern();
+  std::vector<frc::AddressableLED::LEDData> buffer(state.range(0));
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    pattern.ApplyTo(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+BENCHMARK(BM_LEDPattern_ApplyTo)->Arg(60)->Arg(300);
+
+// Applies the compiled pattern a whole buffer at a time. The argument is the
+// number of LEDs.
+void BM_LEDPattern_ApplyToCompiled(benchmark::State& state) {
+  auto pattern = LayeredPattern().Compile();
+  std::vector<frc::AddressableLED::LEDData> buffer(state.range(0));
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    pattern.ApplyTo(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+BENCHMARK(BM_LEDPattern_ApplyToCompiled)->Arg(60)->Arg(300);
+
+}  // namespace
@@ -2,6 +2,12 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 #include <frc/geometry/Pose2d.h>
 #include <frc/path/TravelingSalesman.h>
@@ -41,4 +47,79 @@ void BM_Twist(benchmark::State& state) {
 }
 BENCHMARK(BM_Twist);
 
+// Returns the given number of waypoints scattered over the field
+static std::vector<frc::Pose2d> RandomWaypoints(int count) {
+  std::mt19937 gen{static_cast<unsigned int>(count)};
+  std::uniform_real_distribution<> x{0.0, 16.5};
+  std::uniform_real_distribution<> y{0.0, 8.0};
+  std::vector<frc::Pose2d> waypoints;
+  for (int i = 0; i < count; ++i) {
+    waypoints.emplace_back(units::meter_t{x(gen)}, units::meter_t{y(gen)},
+                           0_deg);
+  }
+  return waypoints;
+}
+
+static double PathLength(std::span<const frc::Pose2d> path) {
+  double sum = 0.0;
+  for (size_t i = 0; i < path.size(); ++i) {
+    sum += path[i]
+               .Translation()
+               .Distance(path[(i + 1) % path.size()].Translation())
+               .value();
+  }
+  return sum;
+}
+
+// The number of waypoints is the argument; each solve gets 100 iterations per
+// waypoint. The "length" counter is the resulting path length in meters.
+void BM_AnnealWaypoints(benchmark::State& state) {
+  auto waypoints = RandomWaypoints(state.range(0));
+  frc::TravelingSalesman traveler;
+  double length = 0.0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    auto path = traveler.Solve(std::span<const frc::Pose2d>{waypoints},
+                               100 * state.range(0));
+    length = PathLength(path);
+  }
+  state.counters["length"] = length;
+}
+BENCHMARK(BM_AnnealWaypoints)->Arg(20)->Arg(50)->Arg(100);
+
+void BM_CostMatrixWaypoints(benchmark::State& state) {
+  auto waypoints = RandomWaypoints(state.range(0));
+  frc::TravelingSalesman traveler;
+  double length = 0.0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    auto path = traveler.Solve(std::span<const frc::Pose2d>{waypoints},
+                               100 * state.range(0), 1);
+    length = PathLength(path);
+  }
+  state.counters["length"] = length;
+}
+BENCHMARK(BM_CostMatrixWaypoints)->Arg(20)->Arg(50)->Arg(100);
+
+// Eight restarts, split between all hardware threads
+void BM_CostMatrixWaypointsParallel(benchmark::State& state) {
+  auto waypoints = RandomWaypoints(state.range(0));
+  frc::TravelingSalesman traveler;
+  int numThreads =
+      (std::max)(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  double length = 0.0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    auto path = traveler.Solve(std::span<const frc::Pose2d>{waypoints},
+                               100 * state.range(0), 8, numThreads);
+    length = PathLength(path);
+  }
+  state.counters["length"] = length;
+}
+BENCHMARK(BM_CostMatrixWaypointsParallel)
+    ->Arg(20)
+    ->Arg(50)
+    ->Arg(100)
+    ->UseRealTime();
+
 BENCHMARK_MAIN();
@@ -0,0 +1,112 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "frc/simulation/DCMotorSim.h"
+#include "frc/simulation/ElevatorSim.h"
+#include "frc/simulation/FlywheelSim.h"
+#include "frc/simulation/SimBatch.h"
+#include "frc/simulation/SingleJointedArmSim.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+namespace {
+
+// The mechanisms of a robot with swerve modules, a shooter, an elevator and an
+// arm. The argument is the number of swerve modules, each with a drive and a
+// steering motor.
+struct Mechanisms {
+  explicit Mechanisms(int modules) {
+    for (int i = 0; i < modules * 2; ++i) {
+      motors.emplace_back(
+          frc::LinearSystemId::DCMotorSystem(frc::DCMotor::KrakenX60(1),
+                                             0.01_kg_sq_m, 6.75),
+          frc::DCMotor::KrakenX60(1));
+    }
+    for (int i = 0; i < 2; ++i) {
+      flywheels.emplace_back(
+          frc::LinearSystemId::FlywheelSystem(frc::DCMotor::NEO(1),
+                                              0.002_kg_sq_m, 1.5),
+          frc::DCMotor::NEO(1));
+    }
+    elevators.emplace_back(frc::DCMotor::Vex775Pro(4), 14.67, 8_kg, 0.75_in,
+                           0_m, 1.5_m, true, 0.5_m);
+    arms.emplace_back(frc::DCMotor::Vex775Pro(2), 300, 3_kg_sq_m, 30_in,
+                      -180_deg, 180_deg, true, 0_deg);
+  }
+
+  // Sets the inputs directly, since the voltage setters read the battery
+  // voltage from the HAL
+  void SetInputs() {
+    for (auto&& sim : motors) {
+      sim.SetInput(0, 6.0);
+    }
+    for (auto&& sim : flywheels) {
+      sim.SetInput(0, 6.0);
+    }
+    for (auto&& sim : elevators) {
+      sim.SetInput(0, 6.0);
+    }
+    for (auto&& sim : arms) {
+      sim.SetInput(0, 6.0);
+    }
+  }
+
+  std::vector<frc::sim::DCMotorSim> motors;
+  std::vector<frc::sim::FlywheelSim> flywheels;
+  std::vector<frc::sim::ElevatorSim> elevators;
+  std::vector<frc::sim::SingleJointedArmSim> arms;
+};
+
+// Updates each simulation separately
+void BM_SimBatch_Separate(benchmark::State& state) {
+  Mechanisms mechanisms{static_cast<int>(state.range(0))};
+  mechanisms.SetInputs();
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    for (auto&& sim : mechanisms.motors) {
+      sim.Update(20_ms);
+    }
+    for (auto&& sim : mechanisms.flywheels) {
+      sim.Update(20_ms);
+    }
+    for (auto&& sim : mechanisms.elevators) {
+      sim.Update(20_ms);
+    }
+    for (auto&& sim : mechanisms.arms) {
+      sim.Update(20_ms);
+    }
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_SimBatch_Separate)->Arg(4)->Arg(8)->Arg(64);
+
+// Updates the simulations as a batch
+void BM_SimBatch_Batched(benchmark::State& state) {
+  Mechanisms mechanisms{static_cast<int>(state.range(0))};
+  mechanisms.SetInputs();
+  frc::sim::SimBatch batch;
+  for (auto&& sim : mechanisms.motors) {
+    batch.Add(sim);
+  }
+  for (auto&& sim : mechanisms.flywheels) {
+    batch.Add(sim);
+  }
+  for (auto&& sim : mechanisms.elevators) {
+    batch.Add(sim);
+  }
+  for (auto&& sim : mechanisms.arms) {
+    batch.Add(sim);
+  }
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    batch.Update(20_ms);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_SimBatch_Batched)->Arg(4)->Arg(8)->Arg(64);
+
+}  // namespace
@@ -0,0 +1,69 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <benchmark/benchmark.h>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/interpolation/TimeInterpolatableBuffer.h"
+#include "units/time.h"
+
+namespace {
+
+// The pose estimators keep 1.5 s of odometry history
+constexpr units::second_t kHistory = 1.5_s;
+
+frc::Pose2d PoseAt(units::second_t time) {
+  return frc::Pose2d{units::meter_t{time.value()},
+                     units::meter_t{0.5 * time.value()},
+                     units::radian_t{0.1 * time.value()}};
+}
+
+// Fills a buffer with a full history of samples at the given rate
+void Fill(frc::TimeInterpolatableBuffer<frc::Pose2d>& buffer,
+          units::second_t period, units::second_t* time) {
+  for (; *time < 2 * kHistory; *time += period) {
+    buffer.AddSample(*time, PoseAt(*time));
+  }
+}
+
+// Steady-state odometry update: append a sample and prune the oldest one.
+// The argument is the update rate in Hz.
+void BM_TimeInterpolatableBuffer_AddSample(benchmark::State& state) {
+  units::second_t period{1.0 / state.range(0)};
+  frc::TimeInterpolatableBuffer<frc::Pose2d> buffer{kHistory};
+  units::second_t time = 0_s;
+  Fill(buffer, period, &time);
+
+  frc::Pose2d pose = PoseAt(time);
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    buffer.AddSample(time, pose);
+    time += period;
+  }
+  state.counters["samples"] = buffer.GetInternalBuffer().size();
+}
+BENCHMARK(BM_TimeInterpolatableBuffer_AddSample)->Arg(250)->Arg(1000);
+
+// Vision measurement latency compensation: sample a full buffer at a time
+// within its history. The argument is the update rate in Hz.
+void BM_TimeInterpolatableBuffer_Sample(benchmark::State& state) {
+  units::second_t period{1.0 / state.range(0)};
+  frc::TimeInterpolatableBuffer<frc::Pose2d> buffer{kHistory};
+  units::second_t time = 0_s;
+  Fill(buffer, period, &time);
+
+  units::second_t sampleTime = time - kHistory;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buffer.Sample(sampleTime));
+    sampleTime += 0.0123_s;
+    if (sampleTime > time) {
+      sampleTime = time - kHistory;
+    }
+  }
+  state.counters["samples"] = buffer.GetInternalBuffer().size();
+}
+BENCHMARK(BM_TimeInterpolatableBuffer_Sample)->Arg(250)->Arg(1000);
+
+}  // namespace
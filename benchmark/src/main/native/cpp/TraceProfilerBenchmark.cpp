@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <wpi/DataLogWriter.h>
+#include <wpi/raw_ostream.h>
+
+#include "frc/TraceProfiler.h"
+
+namespace {
+
+// A zone as it's used in robot code, while the profiler isn't running
+void BM_TraceProfiler_ZoneStopped(benchmark::State& state) {
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    FRC_TRACE_ZONE("Stopped");
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_TraceProfiler_ZoneStopped);
+
+// A zone while the profiler is running and flushing to a data log. The flush
+// period is short so the events are recorded rather than dropped.
+void BM_TraceProfiler_Zone(benchmark::State& state) {
+  wpi::log::DataLogWriter log{std::make_unique<wpi::raw_null_ostream>()};
+  frc::TraceProfiler::Start(log, 1_ms);
+  int64_t count = 0;
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    FRC_TRACE_ZONE("Running");
+    benchmark::ClobberMemory();
+
+    // The writer only writes out its buffers when asked to
+    if (++count % 4096 == 0) {
+      state.PauseTiming();
+      log.Flush();
+      state.ResumeTiming();
+    }
+  }
+  frc::TraceProfiler::Stop();
+}
+BENCHMARK(BM_TraceProfiler_Zone);
+
+}  // namespace
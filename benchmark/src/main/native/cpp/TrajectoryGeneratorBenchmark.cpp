@@ -0,0 +1,71 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+
+namespace {
+
+// Serpentine path with the given number of splines
+std::vector<frc::Pose2d> Waypoints(int numSplines) {
+  std::vector<frc::Pose2d> waypoints;
+  for (int i = 0; i <= numSplines; ++i) {
+    waypoints.emplace_back(units::meter_t{i * 1.5}, (i % 2 == 0) ? 0_m : 2_m,
+                           (i % 2 == 0) ? 30_deg : -30_deg);
+  }
+  return waypoints;
+}
+
+frc::TrajectoryConfig Config() {
+  frc::TrajectoryConfig config{3_mps, 3_mps_sq};
+  config.AddConstraint(frc::CentripetalAccelerationConstraint{2_mps_sq});
+  return config;
+}
+
+void BM_TrajectoryGenerator(benchmark::State& state) {
+  auto waypoints = Waypoints(state.range(0));
+  auto config = Config();
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        frc::TrajectoryGenerator::GenerateTrajectory(waypoints, config));
+  }
+}
+BENCHMARK(BM_TrajectoryGenerator)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_TrajectoryGeneratorWorkspace(benchmark::State& state, int numThreads) {
+  auto waypoints = Waypoints(state.range(0));
+  auto config = Config();
+  frc::TrajectoryGenerator::Workspace workspace{numThreads};
+  // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(frc::TrajectoryGenerator::GenerateTrajectory(
+        waypoints, config, workspace));
+  }
+}
+BENCHMARK_CAPTURE(BM_TrajectoryGeneratorWorkspace, SingleThread, 1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_TrajectoryGeneratorWorkspace, Parallel,
+                  static_cast<int>(std::thread::hardware_concurrency()))
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
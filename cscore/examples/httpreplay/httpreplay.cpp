@@ -0,0 +1,129 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Replays a recorded multipart MJPEG stream (e.g. one captured with
+// "curl -o recording.mjpg http://camera/stream") to an HttpCamera over a
+// local socket as fast as possible, and reports how quickly cscore parses it.
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <fmt/format.h>
+#include <wpi/Logger.h>
+#include <wpi/MemoryBuffer.h>
+#include <wpi/StringExtras.h>
+#include <wpi/print.h>
+#include <wpinet/TCPAcceptor.h>
+
+#include "cscore.h"
+
+static std::string_view FindBoundary(std::string_view data) {
+  // The recording must start at (or shortly before) the first boundary line
+  size_t pos = data.find("--");
+  if (pos == std::string_view::npos) {
+    return {};
+  }
+  auto line = wpi::substr(data, pos + 2);
+  return wpi::trim(line.substr(0, line.find('\n')));
+}
+
+static void ServeStream(wpi::NetworkStream& stream, std::string_view data,
+                        std::string_view boundary,
+                        const std::atomic_bool& active) {
+  wpi::NetworkStream::Error err;
+
+  // Discard the request; we only serve one thing
+  std::string request;
+  char buf[256];
+  while (request.find("\r\n\r\n") == std::string::npos) {
+    size_t count = stream.receive(buf, sizeof(buf), &err);
+    if (count == 0) {
+      return;
+    }
+    request.append(buf, count);
+  }
+
+  auto header = fmt::format(
+      "HTTP/1.0 200 OK\r\n"
+      "Content-Type: multipart/x-mixed-replace;boundary={}\r\n\r\n",
+      boundary);
+  if (stream.send(header.data(), header.size(), &err) != header.size()) {
+    return;
+  }
+
+  while (active) {
+    if (stream.send(data.data(), data.size(), &err) != data.size()) {
+      return;
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    wpi::print(stderr, "Usage: httpreplay <recording.mjpg> [port]\n");
+    return 1;
+  }
+  int port = 8090;
+  if (argc > 2) {
+    port = wpi::parse_integer<int>(argv[2], 10).value_or(port);
+  }
+
+  auto fileBuffer = wpi::MemoryBuffer::GetFile(argv[1]);
+  if (!fileBuffer) {
+    wpi::print(stderr, "could not open '{}'\n", argv[1]);
+    return 1;
+  }
+  std::string_view data{
+      reinterpret_cast<const char*>(fileBuffer.value()->begin()),
+      fileBuffer.value()->size()};
+  auto boundary = FindBoundary(data);
+  if (boundary.empty()) {
+    wpi::print(stderr, "no multipart boundary found in '{}'\n", argv[1]);
+    return 1;
+  }
+
+  wpi::Logger logger;
+  wpi::TCPAcceptor acceptor{port, "127.0.0.1", logger};
+  if (acceptor.start() != 0) {
+    wpi::print(stderr, "could not listen on port {}\n", port);
+    return 1;
+  }
+
+  std::atomic_bool active{true};
+  std::thread server{[&] {
+    while (active) {
+      auto stream = acceptor.accept();
+      if (!stream) {
+        break;
+      }
+      ServeStream(*stream, data, boundary, active);
+    }
+  }};
+
+  // Keep the camera streaming without any sinks so only the stream parsing
+  // is measured.
+  cs::HttpCamera camera{"replay", fmt::format("http://127.0.0.1:{}/", port)};
+  camera.SetConnectionStrategy(cs::VideoSource::kConnectionKeepOpen);
+
+  CS_Status status = 0;
+  cs::AddListener(
+      [&](const cs::RawEvent&) {
+        auto stats = camera.GetImagePoolStats();
+        wpi::print("FPS={:.1f} MBPS={:.1f} pool hits={} misses={}\n",
+                   camera.GetActualFPS(),
+                   camera.GetActualDataRate() / 1000000.0, stats.hits,
+                   stats.misses);
+      },
+      cs::RawEvent::kTelemetryUpdated, false, &status);
+  cs::SetTelemetryPeriod(1.0);
+
+  std::getchar();
+
+  active = false;
+  acceptor.shutdown();
+  server.join();
+}
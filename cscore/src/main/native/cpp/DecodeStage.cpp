@@ -0,0 +1,130 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "DecodeStage.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "WorkerPool.h"
+#include "cscore_cpp.h"
+
+using namespace cs;
+
+// A queued or running decode.  Releases its frame and notifies the stage on
+// destruction, even if the pool discards it without running it.
+struct DecodeStage::Job {
+  Job(DecodeStage& stage_, std::shared_ptr<Entry> entry_)
+      : stage{stage_}, entry{std::move(entry_)} {}
+  ~Job() {
+    entry.reset();
+    // Notify with the lock held, as Stop() may return (and the stage be
+    // destroyed) as soon as m_numPending reaches zero.
+    std::scoped_lock lock(stage.m_mutex);
+    --stage.m_numPending;
+    stage.m_cond.notify_all();
+  }
+
+  DecodeStage& stage;
+  std::shared_ptr<Entry> entry;
+};
+
+bool DecodeStage::FrameAvailable(const Frame& frame) {
+  bool decode = m_enabled && frame &&
+                frame.GetOriginalPixelFormat() == VideoMode::kMJPEG;
+
+  std::unique_lock lock(m_mutex);
+  if (!m_active) {
+    return false;
+  }
+  if (!decode) {
+    if (m_entries.empty()) {
+      return false;
+    }
+    // Queue behind the frames being decoded to keep them in order
+    m_entries.emplace_back(
+        std::make_shared<Entry>(Entry{frame, Entry::kDone}));
+    return true;
+  }
+
+  // Allow one frame per pool thread plus one waiting to start; beyond that,
+  // drop the oldest waiting frame (or this one if none are waiting).
+  size_t maxInFlight = (std::max<size_t>)(m_pool.GetNumThreads(), 1) + 1;
+  size_t inFlight = std::count_if(
+      m_entries.begin(), m_entries.end(), [](const auto& e) {
+        return e->state == Entry::kQueued || e->state == Entry::kRunning;
+      });
+  if (inFlight >= maxInFlight) {
+    ++m_numDropped;
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [](const auto& e) {
+                             return e->state == Entry::kQueued;
+                           });
+    if (it == m_entries.end()) {
+      return true;
+    }
+    (*it)->state = Entry::kDropped;
+  }
+
+  auto entry = std::make_shared<Entry>(Entry{frame, Entry::kQueued});
+  m_entries.emplace_back(entry);
+  ++m_numPending;
+  PublishReady();
+  lock.unlock();
+
+  // Post without holding the lock, as the pool destroys discarded jobs
+  // immediately
+  auto job = std::make_shared<Job>(*this, std::move(entry));
+  m_pool.Post([this, job] {
+    auto& entry = job->entry;
+    {
+      std::scoped_lock lock(m_mutex);
+      if (!m_active || entry->state != Entry::kQueued) {
+        return;
+      }
+      entry->state = Entry::kRunning;
+    }
+
+    // The frame isn't published yet, so nothing else is using it
+    entry->frame.GetImage(entry->frame.GetOriginalWidth(),
+                          entry->frame.GetOriginalHeight(), VideoMode::kBGR);
+
+    std::scoped_lock lock(m_mutex);
+    entry->state = Entry::kDone;
+    if (m_active) {
+      PublishReady();
+    }
+  });
+  return true;
+}
+
+uint64_t DecodeStage::GetNumDropped() const {
+  std::scoped_lock lock(m_mutex);
+  return m_numDropped;
+}
+
+void DecodeStage::Stop() {
+  std::deque<std::shared_ptr<Entry>> entries;
+  {
+    std::unique_lock lock(m_mutex);
+    m_active = false;
+    m_cond.wait(lock, [this] { return m_numPending == 0; });
+    entries.swap(m_entries);
+  }
+  // release frames outside the lock
+  entries.clear();
+}
+
+void DecodeStage::PublishReady() {
+  while (!m_entries.empty()) {
+    auto& front = m_entries.front();
+    if (front->state == Entry::kDone) {
+      m_publish(front->frame);
+    } else if (front->state != Entry::kDropped) {
+      break;
+    }
+    m_entries.pop_front();
+  }
+}
@@ -0,0 +1,89 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_DECODESTAGE_H_
+#define CSCORE_DECODESTAGE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "Frame.h"
+
+namespace cs {
+
+class WorkerPool;
+
+// Optional per-source stage that decodes MJPEG frames to BGR ahead of time.
+//
+// Without this stage, a frame is decoded by whichever sink first asks for an
+// uncompressed image, so a single sink can only consume frames as fast as
+// one core can decode them.  When enabled, each new MJPEG frame is instead
+// decoded on the shared worker pool, with several frames decoding in
+// parallel, and only published once decoded.  Frames are published in
+// capture order.  If decoding falls behind, the oldest frames that have not
+// started decoding are dropped.  As the decoded image is stored in the
+// frame, it is shared by all sinks of the source.
+class DecodeStage {
+ public:
+  using PublishFunc = std::function<void(const Frame& frame)>;
+
+  DecodeStage(WorkerPool& pool, PublishFunc publish)
+      : m_pool{pool}, m_publish{std::move(publish)} {}
+  ~DecodeStage() { Stop(); }
+
+  DecodeStage(const DecodeStage&) = delete;
+  DecodeStage& operator=(const DecodeStage&) = delete;
+
+  void SetEnabled(bool enabled) { m_enabled = enabled; }
+  bool IsEnabled() const { return m_enabled; }
+
+  // Called by the source for each new frame.  Returns false if the caller
+  // should publish the frame itself; otherwise the frame will be published
+  // by the stage (or dropped).
+  bool FrameAvailable(const Frame& frame);
+
+  // Number of frames dropped because decoding fell behind.
+  uint64_t GetNumDropped() const;
+
+  // Waits for decodes in progress to finish and discards frames not yet
+  // published.  Frames passed in after this are not handled by the stage.
+  void Stop();
+
+ private:
+  struct Entry {
+    enum State { kQueued, kRunning, kDone, kDropped };
+
+    Frame frame;
+    State state;
+  };
+
+  struct Job;
+
+  // Publishes finished frames from the front of the queue.
+  // Must be called with m_mutex held.
+  void PublishReady();
+
+  WorkerPool& m_pool;
+  PublishFunc m_publish;
+  std::atomic_bool m_enabled{false};
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::deque<std::shared_ptr<Entry>> m_entries;  // in capture order
+  int m_numPending = 0;                          // queued or running jobs
+  uint64_t m_numDropped = 0;
+  bool m_active = true;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_DECODESTAGE_H_
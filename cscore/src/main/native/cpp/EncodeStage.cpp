@@ -0,0 +1,147 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "EncodeStage.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <wpi/SmallVector.h>
+#include <wpi/timestamp.h>
+
+#include "Image.h"
+#include "WorkerPool.h"
+
+using namespace cs;
+
+// Variants that haven't been requested for this long are forgotten
+static constexpr uint64_t kVariantTimeout = 1000000;  // us
+
+namespace {
+// A queued or running encode.  Releases its frame and notifies the stage on
+// destruction, even if the pool discards it without running it.
+struct EncodeJob {
+  EncodeJob(std::function<void()> done_, Frame frame_)
+      : done{std::move(done_)}, frame{std::move(frame_)} {}
+  ~EncodeJob() {
+    frame = Frame{};
+    done();
+  }
+
+  std::function<void()> done;
+  Frame frame;
+};
+}  // namespace
+
+EncodeStage::~EncodeStage() {
+  std::unique_lock lock(m_mutex);
+  m_active = false;
+  m_cond.wait(lock, [this] { return m_numPending == 0; });
+}
+
+void EncodeStage::FrameAvailable(const Frame& frame) {
+  if (!frame) {
+    return;
+  }
+  Frame::Time time = frame.GetTime();
+
+  wpi::SmallVector<Key, 4> keys;
+  {
+    std::scoped_lock lock(m_mutex);
+    if (!m_active || m_variants.empty()) {
+      return;
+    }
+    uint64_t now = wpi::Now();
+    std::erase_if(m_variants, [&](const Variant& v) {
+      return v.lastUsed + kVariantTimeout < now;
+    });
+    for (auto&& v : m_variants) {
+      // Skip variants nobody consumed from the last frame we encoded for them
+      if (v.lastConsumed >= v.lastScheduled) {
+        v.lastScheduled = time;
+        keys.push_back(v.key);
+      }
+    }
+    m_numPending += keys.size();
+  }
+
+  for (auto&& key : keys) {
+    auto job = std::make_shared<EncodeJob>(
+        [this] {
+          // Notify with the lock held, as the destructor may return as soon
+          // as m_numPending reaches zero.
+          std::scoped_lock lock(m_mutex);
+          --m_numPending;
+          m_cond.notify_all();
+        },
+        frame);
+    m_pool.Post([this, job, key] {
+      {
+        std::scoped_lock lock(m_mutex);
+        if (!m_active) {
+          return;
+        }
+        // If we've fallen behind and a newer frame has been scheduled, don't
+        // bother encoding this one.
+        auto it = std::find_if(
+            m_variants.begin(), m_variants.end(),
+            [&](const Variant& v) { return v.key == key; });
+        if (it == m_variants.end() ||
+            it->lastScheduled != job->frame.GetTime()) {
+          return;
+        }
+      }
+      Encode(job->frame, key);
+    });
+  }
+}
+
+Image* EncodeStage::GetImageMJPEG(Frame& frame, int width, int height,
+                                  int requiredQuality, int defaultQuality) {
+  Key key{width, height, requiredQuality, defaultQuality};
+  {
+    std::scoped_lock lock(m_mutex);
+    auto it =
+        std::find_if(m_variants.begin(), m_variants.end(),
+                     [&](const Variant& v) { return v.key == key; });
+    if (it == m_variants.end()) {
+      m_variants.emplace_back(Variant{key});
+      it = std::prev(m_variants.end());
+    }
+    it->lastConsumed = (std::max)(it->lastConsumed, frame.GetTime());
+    it->lastUsed = wpi::Now();
+  }
+  return Encode(frame, key);
+}
+
+Image* EncodeStage::Encode(Frame& frame, const Key& key) {
+  Frame::Time time = frame.GetTime();
+  auto isInFlight = [&] {
+    return std::find_if(m_inFlight.begin(), m_inFlight.end(),
+                        [&](const InFlight& f) {
+                          return f.time == time && f.key == key;
+                        }) != m_inFlight.end();
+  };
+
+  // Wait for anyone else encoding this; once they're done the image will be
+  // found in the frame without encoding again.
+  {
+    std::unique_lock lock(m_mutex);
+    m_cond.wait(lock, [&] { return !isInFlight(); });
+    m_inFlight.emplace_back(InFlight{time, key});
+  }
+
+  Image* image = frame.GetImageMJPEGConcurrent(
+      key.width, key.height, key.requiredQuality, key.defaultQuality);
+
+  {
+    std::scoped_lock lock(m_mutex);
+    std::erase_if(m_inFlight, [&](const InFlight& f) {
+      return f.time == time && f.key == key;
+    });
+  }
+  m_cond.notify_all();
+  return image;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_ENCODESTAGE_H_
+#define CSCORE_ENCODESTAGE_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "Frame.h"
+
+namespace cs {
+
+class Image;
+class WorkerPool;
+
+// Per-source stage that produces the MJPEG variants (width, height, and
+// quality) of each frame requested by MJPEG server connections.
+//
+// Each variant is computed at most once per frame and is shared by all
+// connections asking for it.  When a new frame arrives, the variants that
+// were consumed from the previous frame are encoded ahead of time on the
+// shared worker pool, in parallel with each other; variants nobody consumed
+// last frame are skipped until they are requested again.
+class EncodeStage {
+ public:
+  explicit EncodeStage(WorkerPool& pool) : m_pool{pool} {}
+  ~EncodeStage();
+
+  EncodeStage(const EncodeStage&) = delete;
+  EncodeStage& operator=(const EncodeStage&) = delete;
+
+  // Called by the source each time a new frame is available.
+  void FrameAvailable(const Frame& frame);
+
+  // Gets the requested MJPEG variant of frame, encoding it on the calling
+  // thread if it's not already available or being encoded elsewhere.
+  // Semantics of the quality parameters are the same as
+  // Frame::GetImageMJPEG().
+  Image* GetImageMJPEG(Frame& frame, int width, int height,
+                       int requiredQuality, int defaultQuality);
+
+ private:
+  struct Key {
+    int width;
+    int height;
+    int requiredQuality;
+    int defaultQuality;
+
+    bool operator==(const Key&) const = default;
+  };
+
+  struct Variant {
+    Key key;
+    Frame::Time lastScheduled = 0;
+    Frame::Time lastConsumed = 0;
+    uint64_t lastUsed = 0;  // wpi::Now() of last request
+  };
+
+  struct InFlight {
+    Frame::Time time;
+    Key key;
+  };
+
+  // Encodes key for frame unless another thread is already doing so, in
+  // which case waits for that thread to finish.  Returns the image.
+  Image* Encode(Frame& frame, const Key& key);
+
+  WorkerPool& m_pool;
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::vector<Variant> m_variants;
+  std::vector<InFlight> m_inFlight;
+  int m_numPending = 0;  // queued or running pool jobs
+  bool m_active = true;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_ENCODESTAGE_H_
@@ -6,6 +6,7 @@
 
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
@@ -630,6 +631,7 @@ Image* Frame::ConvertBGRToMJPEG(Image* image, int quality) {
   }
   cv::imencode(".jpg", image->AsMat(), newImage->vec(),
                m_impl->compressionParams);
+  newImage->jpegQuality = quality;
 
   // Save the result
   Image* rv = newImage.release();
@@ -665,6 +667,7 @@ Image* Frame::ConvertGrayToMJPEG(Image* image, int quality) {
   }
   cv::imencode(".jpg", image->AsMat(), newImage->vec(),
                m_impl->compressionParams);
+  newImage->jpegQuality = quality;
 
   // Save the result
   Image* rv = newImage.release();
@@ -783,6 +786,49 @@ Image* Frame::GetImageImpl(int width, int height,
   return ConvertImpl(cur, pixelFormat, requiredJpegQuality, defaultJpegQuality);
 }
 
+Image* Frame::GetImageMJPEGConcurrent(int width, int height,
+                                      int requiredQuality, int defaultQuality) {
+  if (!m_impl) {
+    return nullptr;
+  }
+
+  Image* cur;
+  {
+    std::scoped_lock lock(m_impl->mutex);
+    cur = GetNearestImage(width, height, VideoMode::kMJPEG, requiredQuality);
+    if (!cur || cur->Is(width, height, VideoMode::kMJPEG, requiredQuality)) {
+      return cur;
+    }
+
+    // Get the uncompressed image to encode, at the requested size
+    bool gray = cur->pixelFormat == VideoMode::kGray ||
+                cur->pixelFormat == VideoMode::kY16;
+    cur = GetImageImpl(width, height,
+                       gray ? VideoMode::kGray : VideoMode::kBGR, -1,
+                       defaultQuality);
+    if (!cur) {
+      return nullptr;
+    }
+  }
+
+  // Compress without holding the lock; images are never modified or removed
+  // from the frame once added, so cur remains valid.
+  // See ConvertBGRToMJPEG() for the size estimates.
+  auto newImage = m_impl->source.AllocImage(
+      VideoMode::kMJPEG, cur->width, cur->height,
+      cur->width * cur->height *
+          (cur->pixelFormat == VideoMode::kGray ? 0.75 : 1.5));
+  std::vector<int> compressionParams{cv::IMWRITE_JPEG_QUALITY, defaultQuality};
+  cv::imencode(".jpg", cur->AsMat(), newImage->vec(), compressionParams);
+  newImage->jpegQuality = defaultQuality;
+
+  // Save the result
+  Image* rv = newImage.release();
+  std::scoped_lock lock(m_impl->mutex);
+  m_impl->images.push_back(rv);
+  return rv;
+}
+
 bool Frame::GetCv(cv::Mat& image, int width, int height,
                   VideoMode::PixelFormat pixelFormat) {
   Image* rawImage = GetImage(width, height, pixelFormat);
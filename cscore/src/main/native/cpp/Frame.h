@@ -230,6 +230,12 @@ class Frame {
                         defaultQuality);
   }
 
+  // Same as GetImageMJPEG(), but only holds the frame lock while finding or
+  // producing the uncompressed image, not while compressing it.  This allows
+  // different variants of the same frame to be encoded concurrently.
+  Image* GetImageMJPEGConcurrent(int width, int height, int requiredQuality,
+                                 int defaultQuality = 80);
+
   bool GetCv(cv::Mat& image, VideoMode::PixelFormat pixelFormat) {
     return GetCv(image, GetOriginalWidth(), GetOriginalHeight(), pixelFormat);
   }
@@ -139,7 +139,7 @@ void HttpCameraImpl::StreamThreadMain() {
     SetConnected(true);
 
     // stream
-    DeviceStream(conn->is, boundary.str());
+    DeviceStream(*conn, boundary.str());
     {
       std::unique_lock lock(m_mutex);
       m_streamConn = nullptr;
@@ -232,8 +232,12 @@ wpi::HttpConnection* HttpCameraImpl::DeviceStreamConnect(
   return conn;
 }
 
-void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
+void HttpCameraImpl::DeviceStream(wpi::HttpConnection& conn,
                                   std::string_view boundary) {
+  // The handshake is done through the unbuffered conn.is; from here on all
+  // reads go through a buffered reader, which must be the only reader.
+  MjpegStreamReader is{*conn.stream, 1};
+
   // Stored here so we reuse it from frame to frame
   std::string imageBuf;
 
@@ -244,7 +248,7 @@ void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
   // streaming loop
   while (m_active && !is.has_error() && IsEnabled() && numErrors < 3 &&
          !m_streamSettingsUpdated) {
-    if (!FindMultipartBoundary(is, boundary, nullptr)) {
+    if (!is.FindBoundary(boundary)) {
       break;
     }
 
@@ -274,7 +278,7 @@ void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
   }
 }
 
-bool HttpCameraImpl::DeviceStreamFrame(wpi::raw_istream& is,
+bool HttpCameraImpl::DeviceStreamFrame(MjpegStreamReader& is,
                                        std::string& imageBuf) {
   // Read the headers
   wpi::SmallString<64> contentTypeBuf;
@@ -298,7 +302,7 @@ bool HttpCameraImpl::DeviceStreamFrame(wpi::raw_istream& is,
   int width, height;
   if (auto v = wpi::parse_integer<unsigned int>(contentLengthBuf, 10)) {
     // We know how big it is!  Just get a frame of the right size and read
-    // the data directly into it.
+    // the data directly into it (large reads bypass the stream buffer).
     unsigned int contentLength = v.value();
     auto image =
         AllocImage(VideoMode::PixelFormat::kMJPEG, 0, 0, contentLength);
@@ -20,6 +20,7 @@
 #include <wpi/raw_istream.h>
 #include <wpinet/HttpUtil.h>
 
+#include "MjpegStreamReader.h"
 #include "SourceImpl.h"
 #include "cscore_cpp.h"
 
@@ -101,8 +102,8 @@ class HttpCameraImpl : public SourceImpl {
   // Functions used by StreamThreadMain()
   wpi::HttpConnection* DeviceStreamConnect(
       wpi::SmallVectorImpl<char>& boundary);
-  void DeviceStream(wpi::raw_istream& is, std::string_view boundary);
-  bool DeviceStreamFrame(wpi::raw_istream& is, std::string& imageBuf);
+  void DeviceStream(wpi::HttpConnection& conn, std::string_view boundary);
+  bool DeviceStreamFrame(MjpegStreamReader& is, std::string& imageBuf);
 
   // The camera settings thread
   void SettingsThreadMain();
@@ -0,0 +1,123 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ImagePool.h"
+
+#include <bit>
+#include <memory>
+#include <utility>
+
+using namespace cs;
+
+size_t ImagePool::ClassIndexCeil(size_t size) {
+  if (size <= (size_t{1} << kMinClassShift)) {
+    return 0;
+  }
+  // 2^(kMinClassShift + octave) < size <= 2^(kMinClassShift + octave + 1)
+  size_t octave = std::bit_width(size - 1) - kMinClassShift - 1;
+  size_t base = size_t{1} << (kMinClassShift + octave);
+  size_t step = base / kClassesPerOctave;
+  size_t sub = (size - base + step - 1) / step;  // 1..kClassesPerOctave
+  return octave * kClassesPerOctave + sub;
+}
+
+size_t ImagePool::ClassIndexFloor(size_t capacity) {
+  if (capacity < (size_t{1} << kMinClassShift)) {
+    return kNumClasses;
+  }
+  // 2^(kMinClassShift + octave) <= capacity < 2^(kMinClassShift + octave + 1)
+  size_t octave = std::bit_width(capacity) - kMinClassShift - 1;
+  size_t base = size_t{1} << (kMinClassShift + octave);
+  size_t sub = (capacity - base) / (base / kClassesPerOctave);
+  size_t index = octave * kClassesPerOctave + sub;
+  return index < kNumClasses ? index : kNumClasses;
+}
+
+std::unique_ptr<Image> ImagePool::Alloc(size_t size) {
+  size_t index = ClassIndexCeil(size);
+  if (index >= kNumClasses) {
+    // too large to pool
+    ++m_misses;
+    return std::make_unique<Image>(size);
+  }
+
+  // Try the exact class first, then one class larger; anything beyond that
+  // would waste too much memory for a single frame.
+  for (size_t i = index; i < index + 2 && i < kNumClasses; ++i) {
+    auto& bucket = m_buckets[i];
+    if (!bucket.empty()) {
+      auto image = std::move(bucket.back().image);
+      bucket.pop_back();
+      m_bytes -= image->capacity();
+      --m_images;
+      ++m_hits;
+      return image;
+    }
+  }
+
+  ++m_misses;
+  return std::make_unique<Image>(ClassSize(index));
+}
+
+void ImagePool::Release(std::unique_ptr<Image> image) {
+  size_t capacity = image->capacity();
+  size_t index = ClassIndexFloor(capacity);
+  if (index >= kNumClasses || capacity > m_maxBytes) {
+    ++m_evictions;
+    return;
+  }
+
+  m_buckets[index].emplace_back(Entry{std::move(image), m_seq++});
+  m_bytes += capacity;
+  ++m_images;
+
+  while (m_bytes > m_maxBytes) {
+    EvictOldest();
+  }
+}
+
+void ImagePool::Clear() {
+  for (auto&& bucket : m_buckets) {
+    bucket.clear();
+  }
+  m_bytes = 0;
+  m_images = 0;
+}
+
+void ImagePool::SetMaxBytes(size_t maxBytes) {
+  m_maxBytes = maxBytes;
+  while (m_bytes > m_maxBytes) {
+    EvictOldest();
+  }
+}
+
+ImagePoolStats ImagePool::GetStats() const {
+  ImagePoolStats stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.evictions = m_evictions;
+  stats.images = m_images;
+  stats.bytes = m_bytes;
+  stats.maxBytes = m_maxBytes;
+  return stats;
+}
+
+void ImagePool::EvictOldest() {
+  // The front of each bucket is its oldest entry
+  std::deque<Entry>* oldest = nullptr;
+  for (auto&& bucket : m_buckets) {
+    if (!bucket.empty() &&
+        (!oldest || bucket.front().seq < oldest->front().seq)) {
+      oldest = &bucket;
+    }
+  }
+  if (!oldest) {
+    m_bytes = 0;
+    return;
+  }
+  m_bytes -= oldest->front().image->capacity();
+  --m_images;
+  ++m_evictions;
+  oldest->pop_front();
+}
@@ -0,0 +1,93 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_IMAGEPOOL_H_
+#define CSCORE_IMAGEPOOL_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+#include "Image.h"
+#include "cscore_cpp.h"
+
+namespace cs {
+
+// Pool of idle Image buffers, bucketed by size class.
+//
+// Buffers are allocated with a capacity rounded up to the next size class
+// (four classes per power of two, so at most 25% slack), which lets a freed
+// buffer be found again in O(1) by any request for a similar size.  The total
+// capacity of idle buffers is bounded by a configurable byte limit; when a
+// release would exceed it, the least recently released buffers are freed.
+//
+// Not thread-safe; callers must provide their own locking.
+class ImagePool {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 32 * 1024 * 1024;
+
+  explicit ImagePool(size_t maxBytes = kDefaultMaxBytes)
+      : m_maxBytes{maxBytes} {}
+
+  ImagePool(const ImagePool&) = delete;
+  ImagePool& operator=(const ImagePool&) = delete;
+
+  // Get an image with at least size bytes of capacity.  The returned image
+  // has size 0 and unspecified format fields.
+  std::unique_ptr<Image> Alloc(size_t size);
+
+  // Return an image to the pool.  It may be freed immediately if it does not
+  // fit within the memory limit.
+  void Release(std::unique_ptr<Image> image);
+
+  // Free all idle images.
+  void Clear();
+
+  void SetMaxBytes(size_t maxBytes);
+  size_t GetMaxBytes() const { return m_maxBytes; }
+
+  ImagePoolStats GetStats() const;
+
+  // Size class helpers (exposed for testing)
+  static constexpr size_t kMinClassShift = 12;  // 4 KiB
+  static constexpr size_t kClassesPerOctave = 4;
+  static constexpr size_t kNumClasses = 20 * kClassesPerOctave;  // to 4 GiB
+
+  // Smallest class that can hold size bytes (may be >= kNumClasses).
+  static size_t ClassIndexCeil(size_t size);
+  // Largest class whose size is no greater than capacity bytes; returns
+  // kNumClasses if capacity is smaller than the smallest class.
+  static size_t ClassIndexFloor(size_t capacity);
+  static constexpr size_t ClassSize(size_t index) {
+    return (size_t{1} << (kMinClassShift + index / kClassesPerOctave)) *
+           (kClassesPerOctave + index % kClassesPerOctave) / kClassesPerOctave;
+  }
+
+ private:
+  struct Entry {
+    std::unique_ptr<Image> image;
+    uint64_t seq;
+  };
+
+  void EvictOldest();
+
+  // Each bucket is ordered oldest to newest release.
+  std::array<std::deque<Entry>, kNumClasses> m_buckets;
+  uint64_t m_seq = 0;
+
+  size_t m_maxBytes;
+  size_t m_bytes = 0;
+  size_t m_images = 0;
+
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  uint64_t m_evictions = 0;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_IMAGEPOOL_H_
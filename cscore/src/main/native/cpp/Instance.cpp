@@ -54,6 +54,7 @@ void Instance::Shutdown() {
   eventLoop.Stop();
   m_sinks.FreeAll();
   m_sources.FreeAll();
+  workerPool.Stop();
   networkListener.Stop();
   usbCameraListener.Stop();
   telemetry.Stop();
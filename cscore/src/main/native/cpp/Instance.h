@@ -19,6 +19,7 @@
 #include "Telemetry.h"
 #include "UnlimitedHandleResource.h"
 #include "UsbCameraListener.h"
+#include "WorkerPool.h"
 
 namespace cs {
 
@@ -56,6 +57,7 @@ class Instance {
   Telemetry telemetry;
   NetworkListener networkListener;
   UsbCameraListener usbCameraListener;
+  WorkerPool workerPool;
 
  private:
   UnlimitedHandleResource<Handle, SourceData, Handle::kSource> m_sources;
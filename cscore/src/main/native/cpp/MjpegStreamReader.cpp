@@ -0,0 +1,107 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "MjpegStreamReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <wpinet/NetworkStream.h>
+
+using namespace cs;
+
+MjpegStreamReader::MjpegStreamReader(wpi::NetworkStream& stream, int timeout,
+                                     size_t bufSize)
+    : m_stream{stream},
+      m_timeout{timeout},
+      m_bufSize{bufSize},
+      m_buf{new char[bufSize]} {
+  m_cur = m_end = m_buf.get();
+}
+
+bool MjpegStreamReader::FindBoundary(std::string_view boundary) {
+  size_t matchLen = boundary.size() + 2;
+  if (matchLen > m_bufSize) {
+    error_detected();
+    return false;
+  }
+
+  for (;;) {
+    // Fast-scan the buffer for '-' (memchr is vectorized by all supported
+    // C libraries), and only then match the entire --boundary.
+    char* p = m_cur;
+    while ((p = static_cast<char*>(std::memchr(p, '-', m_end - p)))) {
+      if (static_cast<size_t>(m_end - p) < matchLen) {
+        break;  // possible partial match; need more data
+      }
+      if (p[1] == '-' &&
+          std::memcmp(p + 2, boundary.data(), boundary.size()) == 0) {
+        m_cur = p + matchLen;
+        return true;
+      }
+      ++p;
+    }
+
+    // Discard everything that can't be the start of a match
+    m_cur = p ? p : m_end;
+    if (!Fill()) {
+      error_detected();
+      return false;
+    }
+  }
+}
+
+void MjpegStreamReader::close() {
+  m_stream.close();
+}
+
+void MjpegStreamReader::read_impl(void* data, size_t len) {
+  char* cdata = static_cast<char*>(data);
+
+  // Copy whatever is already buffered
+  size_t pos = (std::min)(len, in_avail());
+  std::memcpy(cdata, m_cur, pos);
+  m_cur += pos;
+
+  while (pos < len) {
+    size_t left = len - pos;
+    if (left >= m_bufSize / 2) {
+      // Large read: receive directly into the destination
+      wpi::NetworkStream::Error err;
+      size_t count = m_stream.receive(&cdata[pos], left, &err, m_timeout);
+      if (count == 0) {
+        error_detected();
+        break;
+      }
+      pos += count;
+    } else {
+      if (!Fill()) {
+        error_detected();
+        break;
+      }
+      size_t count = (std::min)(left, in_avail());
+      std::memcpy(&cdata[pos], m_cur, count);
+      m_cur += count;
+      pos += count;
+    }
+  }
+  set_read_count(pos);
+}
+
+bool MjpegStreamReader::Fill() {
+  size_t avail = in_avail();
+  if (m_cur != m_buf.get()) {
+    std::memmove(m_buf.get(), m_cur, avail);
+    m_cur = m_buf.get();
+    m_end = m_cur + avail;
+  }
+
+  wpi::NetworkStream::Error err;
+  size_t count = m_stream.receive(m_end, m_bufSize - avail, &err, m_timeout);
+  if (count == 0) {
+    return false;
+  }
+  m_end += count;
+  return true;
+}
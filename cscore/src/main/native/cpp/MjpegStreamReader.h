@@ -0,0 +1,61 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_MJPEGSTREAMREADER_H_
+#define CSCORE_MJPEGSTREAMREADER_H_
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+#include <wpi/raw_istream.h>
+
+namespace wpi {
+class NetworkStream;
+}  // namespace wpi
+
+namespace cs {
+
+// Buffered input stream for reading multipart MJPEG streams from a socket.
+//
+// wpi::raw_socket_istream issues one receive per read() call, which makes
+// header parsing and boundary searches (done in 1 to 2 byte reads) cost a
+// system call per byte.  This class instead receives into a large buffer,
+// searches for boundaries directly in that buffer, and bypasses the buffer
+// for large reads (such as Content-Length image bodies) so they land
+// directly in the caller's storage.
+//
+// This must be the only reader of the underlying stream once created.
+class MjpegStreamReader : public wpi::raw_istream {
+ public:
+  static constexpr size_t kDefaultBufSize = 64 * 1024;
+
+  explicit MjpegStreamReader(wpi::NetworkStream& stream, int timeout = 0,
+                             size_t bufSize = kDefaultBufSize);
+
+  // Skips data up to and including the next "--boundary".
+  // Returns false on stream error.
+  bool FindBoundary(std::string_view boundary);
+
+  void close() override;
+  size_t in_avail() const override { return m_end - m_cur; }
+
+ private:
+  void read_impl(void* data, size_t len) override;
+
+  // Moves unread data to the start of the buffer and receives more after it.
+  // Returns false on stream error.
+  bool Fill();
+
+  wpi::NetworkStream& m_stream;
+  int m_timeout;
+  size_t m_bufSize;
+  std::unique_ptr<char[]> m_buf;
+  char* m_cur;
+  char* m_end;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_MJPEGSTREAMREADER_H_
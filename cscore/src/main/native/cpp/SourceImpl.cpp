@@ -4,7 +4,6 @@
 
 #include "SourceImpl.h"
 
-#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -15,24 +14,29 @@
 #include <wpi/json.h>
 #include <wpi/timestamp.h>
 
+#include "Instance.h"
 #include "Log.h"
 #include "Notifier.h"
 #include "Telemetry.h"
 
 using namespace cs;
 
-static constexpr size_t kMaxImagesAvail = 32;
-
 SourceImpl::SourceImpl(std::string_view name, wpi::Logger& logger,
                        Notifier& notifier, Telemetry& telemetry)
     : m_logger(logger),
       m_notifier(notifier),
       m_telemetry(telemetry),
-      m_name{name} {
+      m_name{name},
+      m_encodeStage{Instance::GetInstance().workerPool},
+      m_decodeStage{Instance::GetInstance().workerPool,
+                    [this](const Frame& frame) { PublishFrame(frame); }} {
   m_frame = Frame{*this, std::string_view{}, 0, WPI_TIMESRC_UNKNOWN};
 }
 
 SourceImpl::~SourceImpl() {
+  // Stop publishing decoded frames; this must be done before clearing the
+  // current frame below.
+  m_decodeStage.Stop();
   // Wake up anyone who is waiting.  This also clears the current frame,
   // which is good because its destructor will call back into the class.
   Wakeup();
@@ -432,26 +436,7 @@ std::unique_ptr<Image> SourceImpl::AllocImage(
   std::unique_ptr<Image> image;
   {
     std::scoped_lock lock{m_poolMutex};
-    // find the smallest existing frame that is at least big enough.
-    int found = -1;
-    for (size_t i = 0; i < m_imagesAvail.size(); ++i) {
-      // is it big enough?
-      if (m_imagesAvail[i] && m_imagesAvail[i]->capacity() >= size) {
-        // is it smaller than the last found?
-        if (found < 0 ||
-            m_imagesAvail[i]->capacity() < m_imagesAvail[found]->capacity()) {
-          // yes, update
-          found = i;
-        }
-      }
-    }
-
-    // if nothing found, allocate a new buffer
-    if (found < 0) {
-      image = std::make_unique<Image>(size);
-    } else {
-      image = std::move(m_imagesAvail[found]);
-    }
+    image = m_imagePool.Alloc(size);
   }
 
   // Initialize image
@@ -459,6 +444,7 @@ std::unique_ptr<Image> SourceImpl::AllocImage(
   image->pixelFormat = pixelFormat;
   image->width = width;
   image->height = height;
+  image->jpegQuality = -1;
 
   return image;
 }
@@ -491,14 +477,26 @@ void SourceImpl::PutFrame(std::unique_ptr<Image> image, Frame::Time time,
   m_telemetry.RecordSourceFrames(*this, 1);
   m_telemetry.RecordSourceBytes(*this, static_cast<int>(image->size()));
 
+  Frame frame{*this, std::move(image), time, timeSrc};
+
+  // If decoding ahead, the decode stage publishes the frame once decoded
+  if (!m_decodeStage.FrameAvailable(frame)) {
+    PublishFrame(frame);
+  }
+}
+
+void SourceImpl::PublishFrame(const Frame& frame) {
   // Update frame
   {
     std::scoped_lock lock{m_frameMutex};
-    m_frame = Frame{*this, std::move(image), time, timeSrc};
+    m_frame = frame;
   }
 
   // Signal listeners
   m_frameCv.notify_all();
+
+  // Start encoding for MJPEG sinks
+  m_encodeStage.FrameAvailable(frame);
 }
 
 void SourceImpl::PutError(std::string_view msg, Frame::Time time) {
@@ -550,25 +548,17 @@ void SourceImpl::ReleaseImage(std::unique_ptr<Image> image) {
   if (m_destroyFrames) {
     return;
   }
-  // Return the frame to the pool.  First try to find an empty slot, otherwise
-  // add it to the end.
-  auto it = std::find(m_imagesAvail.begin(), m_imagesAvail.end(), nullptr);
-  if (it != m_imagesAvail.end()) {
-    *it = std::move(image);
-  } else if (m_imagesAvail.size() > kMaxImagesAvail) {
-    // Replace smallest buffer; don't need to check for null because the above
-    // find would have found it.
-    auto it2 = std::min_element(
-        m_imagesAvail.begin(), m_imagesAvail.end(),
-        [](const std::unique_ptr<Image>& a, const std::unique_ptr<Image>& b) {
-          return a->capacity() < b->capacity();
-        });
-    if ((*it2)->capacity() < image->capacity()) {
-      *it2 = std::move(image);
-    }
-  } else {
-    m_imagesAvail.emplace_back(std::move(image));
-  }
+  m_imagePool.Release(std::move(image));
+}
+
+void SourceImpl::SetImagePoolMaxBytes(size_t maxBytes) {
+  std::scoped_lock lock{m_poolMutex};
+  m_imagePool.SetMaxBytes(maxBytes);
+}
+
+ImagePoolStats SourceImpl::GetImagePoolStats() const {
+  std::scoped_lock lock{m_poolMutex};
+  return m_imagePool.GetStats();
 }
 
 std::unique_ptr<Frame::Impl> SourceImpl::AllocFrameImpl() {
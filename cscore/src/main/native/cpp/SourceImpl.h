@@ -18,9 +18,12 @@
 #include <wpi/json_fwd.h>
 #include <wpi/mutex.h>
 
+#include "DecodeStage.h"
+#include "EncodeStage.h"
 #include "Frame.h"
 #include "Handle.h"
 #include "Image.h"
+#include "ImagePool.h"
 #include "PropertyContainer.h"
 #include "cscore_cpp.h"
 
@@ -136,6 +139,17 @@ class SourceImpl : public PropertyContainer {
   std::unique_ptr<Image> AllocImage(VideoMode::PixelFormat pixelFormat,
                                     int width, int height, size_t size);
 
+  // Image pool configuration and statistics
+  void SetImagePoolMaxBytes(size_t maxBytes);
+  ImagePoolStats GetImagePoolStats() const;
+
+  // Shared MJPEG encoder for sinks that need compressed images
+  EncodeStage& GetEncodeStage() { return m_encodeStage; }
+
+  // MJPEG decode-ahead configuration
+  void SetDecodeAhead(bool enabled) { m_decodeStage.SetEnabled(enabled); }
+  bool GetDecodeAhead() const { return m_decodeStage.IsEnabled(); }
+
  protected:
   void NotifyPropertyCreated(int propIndex, PropertyImpl& prop) override;
   void UpdatePropertyValue(int property, bool setString, int value,
@@ -169,6 +183,9 @@ class SourceImpl : public PropertyContainer {
   std::unique_ptr<Frame::Impl> AllocFrameImpl();
   void ReleaseFrameImpl(std::unique_ptr<Frame::Impl> data);
 
+  // Makes frame the current frame and notifies sinks
+  void PublishFrame(const Frame& frame);
+
   std::string m_name;
   std::string m_description;
 
@@ -181,9 +198,9 @@ class SourceImpl : public PropertyContainer {
   bool m_destroyFrames{false};
 
   // Pool of frames/images to reduce malloc traffic.
-  wpi::mutex m_poolMutex;
+  mutable wpi::mutex m_poolMutex;
   std::vector<std::unique_ptr<Frame::Impl>> m_framesAvail;
-  std::vector<std::unique_ptr<Image>> m_imagesAvail;
+  ImagePool m_imagePool;
 
   std::atomic_bool m_connected{false};
 
@@ -192,6 +209,14 @@ class SourceImpl : public PropertyContainer {
   // MUST be located below m_poolMutex as the Frame destructor calls back
   // into SourceImpl::ReleaseImage, which locks m_poolMutex.
   Frame m_frame;
+
+  // MUST be located below m_poolMutex as it waits for outstanding encode
+  // jobs (which hold Frames) in its destructor.
+  EncodeStage m_encodeStage;
+
+  // MUST be located below m_frame and m_encodeStage as it publishes frames
+  // until stopped.
+  DecodeStage m_decodeStage;
 };
 
 }  // namespace cs
@@ -0,0 +1,77 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+using namespace cs;
+
+WorkerPool::~WorkerPool() {
+  Stop();
+}
+
+void WorkerPool::Post(std::function<void()> work) {
+  {
+    std::scoped_lock lock(m_mutex);
+    if (!m_active) {
+      return;
+    }
+    if (m_threads.empty()) {
+      // Leave at least half the cores for capture and user processing
+      size_t numThreads = std::clamp<size_t>(
+          std::thread::hardware_concurrency() / 2, 1, 4);
+      for (size_t i = 0; i < numThreads; ++i) {
+        m_threads.emplace_back(&WorkerPool::ThreadMain, this);
+      }
+    }
+    m_queue.emplace_back(std::move(work));
+  }
+  m_cond.notify_one();
+}
+
+size_t WorkerPool::GetNumThreads() const {
+  std::scoped_lock lock(m_mutex);
+  return m_threads.size();
+}
+
+void WorkerPool::Stop() {
+  std::vector<std::thread> threads;
+  std::deque<std::function<void()>> queue;
+  {
+    std::scoped_lock lock(m_mutex);
+    m_active = false;
+    queue.swap(m_queue);
+    threads.swap(m_threads);
+  }
+  // destroy discarded work outside the lock, as it may call back into us
+  queue.clear();
+  m_cond.notify_all();
+  for (auto&& thr : threads) {
+    if (thr.joinable()) {
+      thr.join();
+    }
+  }
+}
+
+void WorkerPool::ThreadMain() {
+  std::unique_lock lock(m_mutex);
+  for (;;) {
+    m_cond.wait(lock, [this] { return !m_active || !m_queue.empty(); });
+    if (!m_active) {
+      return;
+    }
+    {
+      auto work = std::move(m_queue.front());
+      m_queue.pop_front();
+      lock.unlock();
+      work();
+      // work is destroyed here, outside the lock
+    }
+    lock.lock();
+  }
+}
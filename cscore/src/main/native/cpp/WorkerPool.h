@@ -0,0 +1,50 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_WORKERPOOL_H_
+#define CSCORE_WORKERPOOL_H_
+
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+namespace cs {
+
+// Small pool of threads shared by all sources for image processing work
+// (e.g. JPEG encoding and decoding).  Threads are started on first use.
+class WorkerPool {
+ public:
+  WorkerPool() = default;
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Queue work to be run on a pool thread.  Work posted after Stop() is
+  // discarded.
+  void Post(std::function<void()> work);
+
+  // Number of pool threads (valid once started).
+  size_t GetNumThreads() const;
+
+  // Stops all threads; queued work that has not started is discarded.
+  void Stop();
+
+ private:
+  void ThreadMain();
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::deque<std::function<void()>> m_queue;
+  std::vector<std::thread> m_threads;
+  bool m_active = true;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_WORKERPOOL_H_
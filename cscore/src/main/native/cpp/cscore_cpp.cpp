@@ -413,6 +413,43 @@ std::span<CS_Sink> EnumerateSourceSinks(CS_Source source,
   return inst.EnumerateSourceSinks(source, vec);
 }
 
+void SetSourceImagePoolMaxBytes(CS_Source source, size_t maxBytes,
+                                CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  data->source->SetImagePoolMaxBytes(maxBytes);
+}
+
+ImagePoolStats GetSourceImagePoolStats(CS_Source source, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data) {
+    *status = CS_INVALID_HANDLE;
+    return {};
+  }
+  return data->source->GetImagePoolStats();
+}
+
+void SetSourceDecodeAhead(CS_Source source, bool enabled, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  data->source->SetDecodeAhead(enabled);
+}
+
+bool GetSourceDecodeAhead(CS_Source source, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data) {
+    *status = CS_INVALID_HANDLE;
+    return false;
+  }
+  return data->source->GetDecodeAhead();
+}
+
 CS_Source CopySource(CS_Source source, CS_Status* status) {
   if (source == 0) {
     return 0;
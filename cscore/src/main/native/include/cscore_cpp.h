@@ -56,6 +56,24 @@ struct UsbCameraInfo {
   int productId = -1;
 };
 
+/**
+ * Source image pool statistics
+ */
+struct ImagePoolStats {
+  /** Number of image allocations satisfied from the pool */
+  uint64_t hits = 0;
+  /** Number of image allocations that required a new buffer */
+  uint64_t misses = 0;
+  /** Number of idle buffers freed to stay within the memory limit */
+  uint64_t evictions = 0;
+  /** Number of idle buffers currently held by the pool */
+  size_t images = 0;
+  /** Total capacity in bytes of idle buffers currently held by the pool */
+  size_t bytes = 0;
+  /** Maximum total capacity in bytes of idle buffers */
+  size_t maxBytes = 0;
+};
+
 /**
  * Video mode
  */
@@ -256,6 +274,11 @@ std::vector<VideoMode> EnumerateSourceVideoModes(CS_Source source,
 std::span<CS_Sink> EnumerateSourceSinks(CS_Source source,
                                         wpi::SmallVectorImpl<CS_Sink>& vec,
                                         CS_Status* status);
+void SetSourceImagePoolMaxBytes(CS_Source source, size_t maxBytes,
+                                CS_Status* status);
+ImagePoolStats GetSourceImagePoolStats(CS_Source source, CS_Status* status);
+void SetSourceDecodeAhead(CS_Source source, bool enabled, CS_Status* status);
+bool GetSourceDecodeAhead(CS_Source source, CS_Status* status);
 CS_Source CopySource(CS_Source source, CS_Status* status);
 void ReleaseSource(CS_Source source, CS_Status* status);
 /** @} */
@@ -572,6 +572,53 @@ class VideoSource {
     return EnumerateSourceVideoModes(m_handle, &status);
   }
 
+  /**
+   * Sets the maximum total size of idle image buffers kept by this source
+   * for reuse.  Buffers beyond this limit are freed, least recently used
+   * first.
+   *
+   * @param maxBytes maximum pooled buffer capacity, in bytes
+   */
+  void SetImagePoolMaxBytes(size_t maxBytes) {
+    m_status = 0;
+    SetSourceImagePoolMaxBytes(m_handle, maxBytes, &m_status);
+  }
+
+  /**
+   * Get image buffer pool statistics (hits, misses, evictions, and current
+   * size).
+   */
+  ImagePoolStats GetImagePoolStats() const {
+    m_status = 0;
+    return GetSourceImagePoolStats(m_handle, &m_status);
+  }
+
+  /**
+   * Enables or disables decoding MJPEG frames ahead of time.
+   *
+   * When enabled, each MJPEG frame from this source is decoded on a shared
+   * pool of worker threads, with several frames decoded in parallel, before
+   * being made available to sinks.  This raises the frame rate sinks
+   * requiring uncompressed images can achieve beyond what a single core can
+   * decode, at the cost of some latency.  Frames stay in capture order; if
+   * decoding falls behind, frames are dropped.  Has no effect on other pixel
+   * formats.
+   *
+   * @param enabled true to enable decode-ahead
+   */
+  void SetDecodeAhead(bool enabled) {
+    m_status = 0;
+    SetSourceDecodeAhead(m_handle, enabled, &m_status);
+  }
+
+  /**
+   * Returns true if MJPEG decode-ahead is enabled.
+   */
+  bool GetDecodeAhead() const {
+    m_status = 0;
+    return GetSourceDecodeAhead(m_handle, &m_status);
+  }
+
   CS_Status GetLastStatus() const { return m_status; }
 
   /**
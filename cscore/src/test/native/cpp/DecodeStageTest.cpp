@@ -0,0 +1,145 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/mutex.h>
+
+#include "DecodeStage.h"
+#include "PipelineTestUtil.h"
+#include "WorkerPool.h"
+
+namespace cs {
+
+class DecodeStageTest : public ::testing::Test {
+ protected:
+  static constexpr int kWidth = TestSource::kWidth;
+  static constexpr int kHeight = TestSource::kHeight;
+
+  DecodeStageTest() { stage->SetEnabled(true); }
+
+  size_t GetNumPublished() {
+    std::scoped_lock lock{mutex};
+    return published.size();
+  }
+
+  std::vector<Frame::Time> GetPublishedTimes() {
+    std::scoped_lock lock{mutex};
+    std::vector<Frame::Time> times;
+    for (auto&& frame : published) {
+      times.push_back(frame.GetTime());
+    }
+    return times;
+  }
+
+  // Declared in destruction order: frames go back to the source
+  TestSource source;
+  WorkerPool pool;
+  wpi::mutex mutex;
+  std::vector<Frame> published;
+  std::unique_ptr<DecodeStage> stage =
+      std::make_unique<DecodeStage>(pool, [this](const Frame& frame) {
+        std::scoped_lock lock{mutex};
+        published.emplace_back(frame);
+      });
+};
+
+TEST_F(DecodeStageTest, Disabled) {
+  stage->SetEnabled(false);
+  EXPECT_FALSE(stage->FrameAvailable(source.MakeMJPEGFrame(1)));
+  EXPECT_EQ(GetNumPublished(), size_t{0});
+}
+
+TEST_F(DecodeStageTest, IgnoresUncompressedFrames) {
+  EXPECT_FALSE(stage->FrameAvailable(source.MakeBGRFrame(1)));
+  EXPECT_EQ(GetNumPublished(), size_t{0});
+}
+
+TEST_F(DecodeStageTest, PublishesDecodedFramesInOrder) {
+  for (Frame::Time time = 1; time <= 20; ++time) {
+    EXPECT_TRUE(stage->FrameAvailable(source.MakeMJPEGFrame(time)));
+  }
+  ASSERT_TRUE(WaitFor(
+      [&] { return GetNumPublished() + stage->GetNumDropped() == 20; }));
+
+  auto times = GetPublishedTimes();
+  ASSERT_FALSE(times.empty());
+  for (size_t i = 1; i < times.size(); ++i) {
+    EXPECT_LT(times[i - 1], times[i]);
+  }
+
+  std::scoped_lock lock{mutex};
+  for (auto&& frame : published) {
+    EXPECT_NE(frame.GetExistingImage(kWidth, kHeight, VideoMode::kBGR),
+              nullptr);
+  }
+}
+
+TEST_F(DecodeStageTest, UncompressedFramesWaitForDecodes) {
+  auto gate = std::make_unique<PoolGate>(pool);
+  EXPECT_TRUE(stage->FrameAvailable(source.MakeMJPEGFrame(1)));
+  // queued behind the MJPEG frame rather than published out of order
+  EXPECT_TRUE(stage->FrameAvailable(source.MakeBGRFrame(2)));
+  EXPECT_EQ(GetNumPublished(), size_t{0});
+
+  gate.reset();
+  ASSERT_TRUE(WaitFor([&] { return GetNumPublished() == 2; }));
+  EXPECT_EQ(GetPublishedTimes(), (std::vector<Frame::Time>{1, 2}));
+}
+
+TEST_F(DecodeStageTest, DropsOldestWhenBehind) {
+  auto gate = std::make_unique<PoolGate>(pool);
+  constexpr Frame::Time kNumFrames = 20;
+  for (Frame::Time time = 1; time <= kNumFrames; ++time) {
+    EXPECT_TRUE(stage->FrameAvailable(source.MakeMJPEGFrame(time)));
+  }
+  EXPECT_EQ(GetNumPublished(), size_t{0});
+  EXPECT_GT(stage->GetNumDropped(), uint64_t{0});
+
+  gate.reset();
+  ASSERT_TRUE(WaitFor([&] {
+    return GetNumPublished() + stage->GetNumDropped() == kNumFrames;
+  }));
+  // the newest frame is never the one dropped
+  EXPECT_EQ(GetPublishedTimes().back(), kNumFrames);
+}
+
+TEST_F(DecodeStageTest, DestroyWithDecodesInFlight) {
+  // Keep the decodes queued while the stage is destroyed; the destructor
+  // must wait for them to be released.
+  auto gate = std::make_unique<PoolGate>(pool);
+  for (Frame::Time time = 1; time <= 4; ++time) {
+    EXPECT_TRUE(stage->FrameAvailable(source.MakeMJPEGFrame(time)));
+  }
+  std::thread destroyer{[&] { stage.reset(); }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  gate.reset();
+  destroyer.join();
+
+  // Frames not yet decoded when stopped are never published
+  EXPECT_EQ(GetNumPublished(), size_t{0});
+}
+
+TEST_F(DecodeStageTest, DestroyWithDecodesRunning) {
+  for (Frame::Time time = 1; time <= 20; ++time) {
+    stage->FrameAvailable(source.MakeMJPEGFrame(time));
+  }
+  stage.reset();
+
+  // Nothing is published once the stage is destroyed
+  size_t numPublished = GetNumPublished();
+  pool.Stop();
+  EXPECT_EQ(GetNumPublished(), numPublished);
+}
+
+TEST_F(DecodeStageTest, FramesAfterStopAreNotHandled) {
+  stage->Stop();
+  EXPECT_FALSE(stage->FrameAvailable(source.MakeMJPEGFrame(1)));
+}
+
+}  // namespace cs
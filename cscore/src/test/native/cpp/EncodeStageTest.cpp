@@ -0,0 +1,127 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EncodeStage.h"
+#include "PipelineTestUtil.h"
+#include "WorkerPool.h"
+
+namespace cs {
+
+class EncodeStageTest : public ::testing::Test {
+ protected:
+  static constexpr int kWidth = TestSource::kWidth;
+  static constexpr int kHeight = TestSource::kHeight;
+
+  // Declared in destruction order: frames and jobs go back to the source
+  TestSource source;
+  WorkerPool pool;
+  std::unique_ptr<EncodeStage> stage = std::make_unique<EncodeStage>(pool);
+};
+
+TEST_F(EncodeStageTest, EncodesOnce) {
+  Frame frame = source.MakeBGRFrame(1);
+  Image* image = stage->GetImageMJPEG(frame, kWidth, kHeight, -1, 80);
+  ASSERT_NE(image, nullptr);
+  EXPECT_EQ(image->pixelFormat, VideoMode::kMJPEG);
+  EXPECT_EQ(image->width, kWidth);
+  EXPECT_EQ(image->height, kHeight);
+  EXPECT_EQ(stage->GetImageMJPEG(frame, kWidth, kHeight, -1, 80), image);
+}
+
+TEST_F(EncodeStageTest, SharesConcurrentEncodes) {
+  Frame frame = source.MakeBGRFrame(1);
+  Image* images[4];
+  std::vector<std::thread> threads;
+  for (auto&& image : images) {
+    threads.emplace_back([&] {
+      image = stage->GetImageMJPEG(frame, kWidth / 2, kHeight / 2, 50, 80);
+    });
+  }
+  for (auto&& thr : threads) {
+    thr.join();
+  }
+  ASSERT_NE(images[0], nullptr);
+  for (auto&& image : images) {
+    EXPECT_EQ(image, images[0]);
+  }
+  EXPECT_EQ(images[0]->jpegQuality, 50);
+}
+
+TEST_F(EncodeStageTest, EncodesConsumedVariantsAhead) {
+  Frame first = source.MakeBGRFrame(1);
+  stage->GetImageMJPEG(first, kWidth, kHeight, -1, 80);
+
+  Frame second = source.MakeBGRFrame(2);
+  stage->FrameAvailable(second);
+  EXPECT_TRUE(WaitFor([&] {
+    return second.GetExistingImage(kWidth, kHeight, VideoMode::kMJPEG) !=
+           nullptr;
+  }));
+}
+
+TEST_F(EncodeStageTest, SkipsUnconsumedVariants) {
+  Frame first = source.MakeBGRFrame(1);
+  stage->GetImageMJPEG(first, kWidth, kHeight, -1, 80);
+
+  // Scheduled for the second frame, but nobody consumes it...
+  Frame second = source.MakeBGRFrame(2);
+  stage->FrameAvailable(second);
+  EXPECT_TRUE(WaitFor([&] {
+    return second.GetExistingImage(kWidth, kHeight, VideoMode::kMJPEG) !=
+           nullptr;
+  }));
+
+  // ...so it isn't encoded ahead for the third
+  Frame third = source.MakeBGRFrame(3);
+  stage->FrameAvailable(third);
+  pool.Stop();
+  EXPECT_EQ(third.GetExistingImage(kWidth, kHeight, VideoMode::kMJPEG),
+            nullptr);
+}
+
+TEST_F(EncodeStageTest, DestroyWithEncodesInFlight) {
+  Frame first = source.MakeBGRFrame(1);
+  stage->GetImageMJPEG(first, kWidth, kHeight, -1, 80);
+  stage->GetImageMJPEG(first, kWidth / 2, kHeight / 2, -1, 80);
+
+  // Keep the encodes for the second frame queued while the stage is
+  // destroyed; the destructor must wait for them to be released.
+  auto gate = std::make_unique<PoolGate>(pool);
+  Frame second = source.MakeBGRFrame(2);
+  stage->FrameAvailable(second);
+  std::thread destroyer{[&] { stage.reset(); }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  gate.reset();
+  destroyer.join();
+
+  // The stage was gone before the jobs ran, so they did nothing
+  pool.Stop();
+  EXPECT_EQ(second.GetExistingImage(kWidth, kHeight, VideoMode::kMJPEG),
+            nullptr);
+}
+
+TEST_F(EncodeStageTest, DestroyWithEncodesRunning) {
+  Frame frame = source.MakeBGRFrame(1);
+  stage->GetImageMJPEG(frame, kWidth, kHeight, -1, 80);
+
+  // Consuming each frame makes the stage encode the next one ahead, racing
+  // with the consumer; the last one may still be encoding on destruction.
+  for (Frame::Time time = 2; time < 50; ++time) {
+    frame = source.MakeBGRFrame(time);
+    stage->FrameAvailable(frame);
+    if (time < 49) {
+      stage->GetImageMJPEG(frame, kWidth, kHeight, -1, 80);
+    }
+  }
+  stage.reset();
+}
+
+}  // namespace cs
@@ -0,0 +1,117 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "ImagePool.h"
+
+namespace cs {
+
+TEST(ImagePoolTest, ClassSizesIncrease) {
+  EXPECT_EQ(ImagePool::ClassSize(0), size_t{4096});
+  for (size_t i = 1; i < ImagePool::kNumClasses; ++i) {
+    EXPECT_GT(ImagePool::ClassSize(i), ImagePool::ClassSize(i - 1));
+  }
+}
+
+TEST(ImagePoolTest, ClassIndexCeil) {
+  EXPECT_EQ(ImagePool::ClassIndexCeil(0), size_t{0});
+  EXPECT_EQ(ImagePool::ClassIndexCeil(1), size_t{0});
+  EXPECT_EQ(ImagePool::ClassIndexCeil(4096), size_t{0});
+  EXPECT_EQ(ImagePool::ClassIndexCeil(4097), size_t{1});
+  for (size_t size : {5000u, 65536u, 65537u, 640u * 480u * 3u, 1000000u}) {
+    size_t index = ImagePool::ClassIndexCeil(size);
+    EXPECT_GE(ImagePool::ClassSize(index), size);
+    EXPECT_LT(ImagePool::ClassSize(index - 1), size);
+  }
+}
+
+TEST(ImagePoolTest, ClassIndexFloor) {
+  EXPECT_EQ(ImagePool::ClassIndexFloor(4095), ImagePool::kNumClasses);
+  for (size_t i = 0; i < 40; ++i) {
+    size_t size = ImagePool::ClassSize(i);
+    EXPECT_EQ(ImagePool::ClassIndexFloor(size), i);
+    EXPECT_EQ(ImagePool::ClassIndexFloor(size + 1), i);
+    if (i > 0) {
+      EXPECT_EQ(ImagePool::ClassIndexFloor(size - 1), i - 1);
+    }
+  }
+}
+
+TEST(ImagePoolTest, ReusesReleasedImage) {
+  ImagePool pool;
+  auto image = pool.Alloc(100000);
+  EXPECT_GE(image->capacity(), size_t{100000});
+  const Image* ptr = image.get();
+  pool.Release(std::move(image));
+
+  auto stats = pool.GetStats();
+  EXPECT_EQ(stats.images, size_t{1});
+  EXPECT_EQ(stats.misses, uint64_t{1});
+
+  // a slightly different size in the same class gets the same buffer back
+  image = pool.Alloc(99000);
+  EXPECT_EQ(image.get(), ptr);
+  stats = pool.GetStats();
+  EXPECT_EQ(stats.hits, uint64_t{1});
+  EXPECT_EQ(stats.images, size_t{0});
+  EXPECT_EQ(stats.bytes, size_t{0});
+}
+
+TEST(ImagePoolTest, DoesNotReuseMuchLargerImage) {
+  ImagePool pool;
+  pool.Release(pool.Alloc(1000000));
+  auto image = pool.Alloc(10000);
+  EXPECT_LT(image->capacity(), size_t{1000000});
+  EXPECT_EQ(pool.GetStats().hits, uint64_t{0});
+}
+
+TEST(ImagePoolTest, EvictsOldestOverLimit) {
+  size_t size = ImagePool::ClassSize(8);
+  ImagePool pool{size * 3};
+
+  auto first = pool.Alloc(size);
+  const Image* firstPtr = first.get();
+  std::unique_ptr<Image> images[3];
+  for (auto&& image : images) {
+    image = pool.Alloc(size);
+  }
+
+  pool.Release(std::move(first));
+  for (auto&& image : images) {
+    pool.Release(std::move(image));
+  }
+
+  auto stats = pool.GetStats();
+  EXPECT_EQ(stats.evictions, uint64_t{1});
+  EXPECT_EQ(stats.images, size_t{3});
+  EXPECT_LE(stats.bytes, stats.maxBytes);
+
+  // the first released image was the one evicted
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NE(pool.Alloc(size).get(), firstPtr);
+  }
+}
+
+TEST(ImagePoolTest, SetMaxBytesEvicts) {
+  ImagePool pool;
+  for (int i = 0; i < 4; ++i) {
+    pool.Release(std::make_unique<Image>(ImagePool::ClassSize(i * 4)));
+  }
+  EXPECT_EQ(pool.GetStats().images, size_t{4});
+
+  pool.SetMaxBytes(ImagePool::ClassSize(12));
+  auto stats = pool.GetStats();
+  EXPECT_LE(stats.bytes, ImagePool::ClassSize(12));
+  EXPECT_EQ(stats.evictions, uint64_t{3});
+
+  pool.Clear();
+  EXPECT_EQ(pool.GetStats().images, size_t{0});
+  EXPECT_EQ(pool.GetStats().bytes, size_t{0});
+}
+
+}  // namespace cs
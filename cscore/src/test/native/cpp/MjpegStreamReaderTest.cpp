@@ -0,0 +1,156 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <wpi/SmallString.h>
+#include <wpi/StringExtras.h>
+#include <wpinet/HttpUtil.h>
+#include <wpinet/NetworkStream.h>
+
+#include "MjpegStreamReader.h"
+
+namespace cs {
+
+namespace {
+
+// Stream that returns at most chunkSize bytes per receive
+class FakeStream : public wpi::NetworkStream {
+ public:
+  FakeStream(std::string_view data, size_t chunkSize)
+      : m_data{data}, m_chunkSize{chunkSize} {}
+
+  size_t send(const char* buffer, size_t len, Error* err) override {
+    return 0;
+  }
+  size_t receive(char* buffer, size_t len, Error* err,
+                 int timeout = 0) override {
+    ++receives;
+    size_t count = (std::min)({len, m_chunkSize, m_data.size() - m_pos});
+    if (count == 0) {
+      *err = kConnectionClosed;
+      return 0;
+    }
+    std::memcpy(buffer, m_data.data() + m_pos, count);
+    m_pos += count;
+    return count;
+  }
+  void close() override { closed = true; }
+
+  std::string_view getPeerIP() const override { return ""; }
+  int getPeerPort() const override { return 0; }
+  void setNoDelay() override {}
+  bool setBlocking(bool enabled) override { return true; }
+  int getNativeHandle() const override { return -1; }
+
+  int receives = 0;
+  bool closed = false;
+
+ private:
+  std::string m_data;
+  size_t m_chunkSize;
+  size_t m_pos = 0;
+};
+
+std::string MakePart(std::string_view body) {
+  return fmt::format(
+      "--myboundary\r\nContent-Type: image/jpeg\r\n"
+      "Content-Length: {}\r\n\r\n{}\r\n",
+      body.size(), body);
+}
+
+}  // namespace
+
+TEST(MjpegStreamReaderTest, FindBoundary) {
+  FakeStream stream{"-x--my-boundary--myboundaryrest", 100};
+  MjpegStreamReader is{stream};
+  ASSERT_TRUE(is.FindBoundary("myboundary"));
+  char buf[4];
+  is.read(buf, 4);
+  EXPECT_EQ(std::string_view(buf, 4), "rest");
+  EXPECT_FALSE(is.has_error());
+}
+
+TEST(MjpegStreamReaderTest, FindBoundarySplitAcrossReceives) {
+  // one byte per receive forces every partial match to wait for more data
+  FakeStream stream{"junk-----myboundaryrest", 1};
+  MjpegStreamReader is{stream, 0, 16};
+  ASSERT_TRUE(is.FindBoundary("myboundary"));
+  char buf[4];
+  is.read(buf, 4);
+  EXPECT_EQ(std::string_view(buf, 4), "rest");
+}
+
+TEST(MjpegStreamReaderTest, FindBoundaryEndOfStream) {
+  FakeStream stream{"--myboundar", 100};
+  MjpegStreamReader is{stream};
+  EXPECT_FALSE(is.FindBoundary("myboundary"));
+  EXPECT_TRUE(is.has_error());
+}
+
+TEST(MjpegStreamReaderTest, FindBoundaryTooLong) {
+  FakeStream stream{"--myboundary", 100};
+  MjpegStreamReader is{stream, 0, 8};
+  EXPECT_FALSE(is.FindBoundary("myboundary"));
+  EXPECT_TRUE(is.has_error());
+}
+
+TEST(MjpegStreamReaderTest, MultipartStream) {
+  std::string small(100, 'a');
+  std::string large(5000, 'b');
+  std::string data = MakePart(small) + MakePart(large) + MakePart(small);
+
+  for (size_t chunkSize : {1u, 7u, 100u, 100000u}) {
+    SCOPED_TRACE(chunkSize);
+    FakeStream stream{data, chunkSize};
+    MjpegStreamReader is{stream, 0, 256};
+
+    for (auto&& body : {small, large, small}) {
+      ASSERT_TRUE(is.FindBoundary("myboundary"));
+      char eol[2];
+      is.read(eol, 2);
+      EXPECT_EQ(std::string_view(eol, 2), "\r\n");
+      wpi::SmallString<64> contentType;
+      wpi::SmallString<64> contentLength;
+      ASSERT_TRUE(wpi::ParseHttpHeaders(is, &contentType, &contentLength));
+      EXPECT_EQ(contentType.str(), "image/jpeg");
+      auto length = wpi::parse_integer<size_t>(contentLength, 10);
+      ASSERT_TRUE(length);
+      ASSERT_EQ(length.value(), body.size());
+
+      std::string image(body.size(), '\0');
+      is.read(image.data(), image.size());
+      ASSERT_FALSE(is.has_error());
+      EXPECT_EQ(image, body);
+    }
+
+    EXPECT_FALSE(is.FindBoundary("myboundary"));
+  }
+}
+
+TEST(MjpegStreamReaderTest, LargeReadBypassesBuffer) {
+  std::string large(10000, 'c');
+  FakeStream stream{large, 100000};
+  MjpegStreamReader is{stream, 0, 256};
+  std::string image(large.size(), '\0');
+  is.read(image.data(), image.size());
+  EXPECT_FALSE(is.has_error());
+  EXPECT_EQ(image, large);
+  // the whole image is received at once instead of a buffer at a time
+  EXPECT_EQ(stream.receives, 1);
+}
+
+TEST(MjpegStreamReaderTest, Close) {
+  FakeStream stream{"", 1};
+  MjpegStreamReader is{stream};
+  is.close();
+  EXPECT_TRUE(stream.closed);
+}
+
+}  // namespace cs
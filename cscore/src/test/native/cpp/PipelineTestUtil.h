@@ -0,0 +1,116 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "ConfigurableSourceImpl.h"
+#include "Frame.h"
+#include "Instance.h"
+#include "WorkerPool.h"
+
+namespace cs {
+
+// Source used only to own the frames and images passed through the stages
+class TestSource : public ConfigurableSourceImpl {
+ public:
+  static constexpr int kWidth = 64;
+  static constexpr int kHeight = 48;
+
+  TestSource()
+      : ConfigurableSourceImpl{
+            "test", Instance::GetInstance().logger,
+            Instance::GetInstance().notifier, Instance::GetInstance().telemetry,
+            VideoMode{VideoMode::kBGR, kWidth, kHeight, 30}} {}
+
+  Frame MakeBGRFrame(Frame::Time time) {
+    auto image =
+        AllocImage(VideoMode::kBGR, kWidth, kHeight, kWidth * kHeight * 3);
+    std::memset(image->data(), static_cast<int>(time & 0xff), image->size());
+    return Frame{*this, std::move(image), time, WPI_TIMESRC_FRAME_DEQUEUE};
+  }
+
+  Frame MakeMJPEGFrame(Frame::Time time) {
+    Frame bgr = MakeBGRFrame(time);
+    Image* jpeg = bgr.GetImageMJPEG(kWidth, kHeight, -1);
+    auto image = AllocImage(VideoMode::kMJPEG, kWidth, kHeight, jpeg->size());
+    std::memcpy(image->data(), jpeg->data(), jpeg->size());
+    return Frame{*this, std::move(image), time, WPI_TIMESRC_FRAME_DEQUEUE};
+  }
+};
+
+// Blocks every thread of a WorkerPool until opened, so that work posted
+// afterwards stays queued.
+class PoolGate {
+ public:
+  explicit PoolGate(WorkerPool& pool) {
+    Post(pool);  // starts the pool threads
+    for (size_t i = 1; i < pool.GetNumThreads(); ++i) {
+      Post(pool);
+    }
+    std::unique_lock lock{m_mutex};
+    m_cond.wait(lock, [&] { return m_entered == pool.GetNumThreads(); });
+  }
+
+  // Waits for the blocked threads to leave, as they reference the gate
+  ~PoolGate() {
+    Open();
+    std::unique_lock lock{m_mutex};
+    m_cond.wait(lock, [&] { return m_left == m_entered; });
+  }
+
+  PoolGate(const PoolGate&) = delete;
+  PoolGate& operator=(const PoolGate&) = delete;
+
+  void Open() {
+    {
+      std::scoped_lock lock{m_mutex};
+      m_open = true;
+    }
+    m_cond.notify_all();
+  }
+
+ private:
+  void Post(WorkerPool& pool) {
+    pool.Post([this] {
+      std::unique_lock lock{m_mutex};
+      ++m_entered;
+      m_cond.notify_all();
+      m_cond.wait(lock, [&] { return m_open; });
+      ++m_left;
+      m_cond.notify_all();
+    });
+  }
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  size_t m_entered = 0;
+  size_t m_left = 0;
+  bool m_open = false;
+};
+
+// Waits up to a few seconds for pred to become true
+inline bool WaitFor(std::function<bool()> pred) {
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() > end) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  return true;
+}
+
+}  // namespace cs
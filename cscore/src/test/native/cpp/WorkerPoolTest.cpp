@@ -0,0 +1,100 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/mutex.h>
+
+#include "PipelineTestUtil.h"
+#include "WorkerPool.h"
+
+namespace cs {
+
+namespace {
+// Counts how many times work was run and destroyed
+struct Counter {
+  std::atomic_int ran{0};
+  std::atomic_int destroyed{0};
+};
+
+struct Token {
+  explicit Token(Counter& counter_) : counter{counter_} {}
+  ~Token() { ++counter.destroyed; }
+  Counter& counter;
+};
+}  // namespace
+
+TEST(WorkerPoolTest, RunsPostedWork) {
+  WorkerPool pool;
+  Counter counter;
+  for (int i = 0; i < 100; ++i) {
+    auto token = std::make_shared<Token>(counter);
+    pool.Post([token] { ++token->counter.ran; });
+  }
+  EXPECT_TRUE(WaitFor([&] { return counter.destroyed == 100; }));
+  EXPECT_EQ(counter.ran, 100);
+  EXPECT_GE(pool.GetNumThreads(), size_t{1});
+}
+
+TEST(WorkerPoolTest, RunsWorkInOrder) {
+  WorkerPool pool;
+  std::vector<int> order;
+  wpi::mutex mutex;
+  {
+    // queue everything before any of it can run
+    PoolGate gate{pool};
+    for (int i = 0; i < 10; ++i) {
+      pool.Post([&, i] {
+        std::scoped_lock lock{mutex};
+        order.push_back(i);
+      });
+    }
+  }
+  EXPECT_TRUE(WaitFor([&] {
+    std::scoped_lock lock{mutex};
+    return order.size() == 10;
+  }));
+  // with several threads, work starts in order but may finish out of order
+  if (pool.GetNumThreads() == 1) {
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_EQ(order[i], i);
+    }
+  }
+}
+
+TEST(WorkerPoolTest, StopDiscardsQueuedWork) {
+  WorkerPool pool;
+  Counter counter;
+  auto gate = std::make_unique<PoolGate>(pool);
+  for (int i = 0; i < 10; ++i) {
+    auto token = std::make_shared<Token>(counter);
+    pool.Post([token] { ++token->counter.ran; });
+  }
+
+  // Stop() joins the threads, which are blocked until the gate opens
+  std::thread stopper{[&] { pool.Stop(); }};
+  EXPECT_TRUE(WaitFor([&] { return counter.destroyed == 10; }));
+  gate.reset();
+  stopper.join();
+
+  EXPECT_EQ(counter.ran, 0);
+  EXPECT_EQ(pool.GetNumThreads(), size_t{0});
+}
+
+TEST(WorkerPoolTest, PostAfterStop) {
+  WorkerPool pool;
+  pool.Stop();
+  Counter counter;
+  auto token = std::make_shared<Token>(counter);
+  pool.Post([token] { ++token->counter.ran; });
+  token.reset();
+  EXPECT_EQ(counter.destroyed, 1);
+  EXPECT_EQ(counter.ran, 0);
+}
+
+}  // namespace cs
@@ -26,6 +26,7 @@
 #include <imgui_stdlib.h>
 #include <portable-file-dialogs.h>
 #include <wpi/DenseMap.h>
+#include <wpi/Endian.h>
 #include <wpi/MemoryBuffer.h>
 #include <wpi/SmallVector.h>
 #include <wpi/SpanExtras.h>
@@ -617,6 +618,163 @@ static void ExportCsv(std::string_view outputFolder, int style) {
   }
 }
 
+static constexpr std::string_view kTraceZonesEntry = "TraceProfiler/Zones";
+static constexpr std::string_view kTraceThreadsPrefix =
+    "TraceProfiler/Threads/";
+static constexpr std::string_view kTraceEventType = "struct:TraceEvent[]";
+static constexpr size_t kTraceEventSize = 11;
+
+static void PrintEscapedJsonString(wpi::raw_ostream& os, std::string_view str) {
+  for (char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      os << '\\' << ch;
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      wpi::print(os, "\\u{:04x}", static_cast<int>(ch));
+    } else {
+      os << ch;
+    }
+  }
+}
+
+static void PrintTraceThreadName(wpi::raw_ostream& os, bool* first, int tid,
+                                 std::string_view name) {
+  if (name.empty()) {
+    return;
+  }
+  if (!*first) {
+    os << ",\n";
+  }
+  *first = false;
+  wpi::print(os,
+             "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+             "\"args\":{{\"name\":\"",
+             tid);
+  PrintEscapedJsonString(os, name);
+  os << "\"}}";
+}
+
+// Converts the events recorded by frc::TraceProfiler to the Chrome trace event
+// format, with one thread per TraceProfiler thread.
+static void ExportTraceFile(InputFile& f, wpi::raw_ostream& os) {
+  os << "{\"traceEvents\":[\n";
+  bool first = true;
+
+  int zonesEntry = -1;
+  std::vector<std::string> zones;
+  wpi::DenseMap<int, int> threadMap;
+  for (auto&& record : f.datalog->GetReader()) {
+    if (record.IsStart()) {
+      wpi::log::StartRecordData data;
+      if (!record.GetStartData(&data)) {
+        continue;
+      }
+      if (data.name == kTraceZonesEntry && data.type == "string[]") {
+        zonesEntry = data.entry;
+      } else if (data.name.starts_with(kTraceThreadsPrefix) &&
+                 data.type == kTraceEventType) {
+        auto it = gEntries.find(data.name);
+        auto tid = wpi::parse_integer<int>(
+            data.name.substr(kTraceThreadsPrefix.size()), 10);
+        if (it != gEntries.end() && it->second->selected && tid) {
+          threadMap[data.entry] = *tid;
+          PrintTraceThreadName(os, &first, *tid, data.metadata);
+        }
+      }
+    } else if (record.IsSetMetadata()) {
+      wpi::log::MetadataRecordData data;
+      if (record.GetSetMetadataData(&data)) {
+        auto it = threadMap.find(data.entry);
+        if (it != threadMap.end()) {
+          PrintTraceThreadName(os, &first, it->second, data.metadata);
+        }
+      }
+    } else if (record.IsFinish()) {
+      int entry;
+      if (record.GetFinishEntry(&entry)) {
+        threadMap.erase(entry);
+        if (entry == zonesEntry) {
+          zonesEntry = -1;
+        }
+      }
+    } else if (!record.IsControl()) {
+      if (record.GetEntry() == zonesEntry) {
+        std::vector<std::string_view> names;
+        if (record.GetStringArray(&names)) {
+          zones.assign(names.begin(), names.end());
+        }
+        continue;
+      }
+
+      auto threadIt = threadMap.find(record.GetEntry());
+      if (threadIt == threadMap.end()) {
+        continue;
+      }
+      auto data = record.GetRaw();
+      for (; data.size() >= kTraceEventSize;
+           data = data.subspan(kTraceEventSize)) {
+        int64_t time = wpi::support::endian::read64le(data.data());
+        uint16_t zone = wpi::support::endian::read16le(data.data() + 8);
+        uint8_t type = data[10];
+
+        if (!first) {
+          os << ",\n";
+        }
+        first = false;
+        os << "{\"name\":\"";
+        if (zone < zones.size()) {
+          PrintEscapedJsonString(os, zones[zone]);
+        } else {
+          wpi::print(os, "zone {}", zone);
+        }
+        wpi::print(os, "\",\"ph\":\"{}\",\"ts\":{},\"pid\":1,\"tid\":{}}}",
+                   type == 0 ? 'B' : 'E', time / 1000.0, threadIt->second);
+      }
+    }
+  }
+
+  os << "\n]}\n";
+}
+
+static void ExportTrace(std::string_view outputFolder) {
+  fs::path outPath{outputFolder};
+  for (auto&& f : gInputFiles) {
+    if (f.second->datalog) {
+      // only export files with TraceProfiler events
+      bool hasTrace = false;
+      for (auto it = gEntries.lower_bound(kTraceThreadsPrefix);
+           it != gEntries.end() && it->first.starts_with(kTraceThreadsPrefix);
+           ++it) {
+        if (it->second->inputFiles.contains(f.second.get())) {
+          hasTrace = true;
+          break;
+        }
+      }
+      if (!hasTrace) {
+        std::scoped_lock lock{gExportMutex};
+        gExportErrors.emplace_back(
+            fmt::format("{}: no TraceProfiler entries", f.first));
+        ++gExportCount;
+        continue;
+      }
+
+      std::error_code ec;
+      auto of = fs::OpenFileForWrite(
+          outPath / fs::path{f.first}.replace_extension("json"), ec,
+          fs::CD_CreateNew, fs::OF_Text);
+      if (ec) {
+        std::scoped_lock lock{gExportMutex};
+        gExportErrors.emplace_back(
+            fmt::format("{}: {}", f.first, ec.message()));
+        ++gExportCount;
+        continue;
+      }
+      wpi::raw_fd_ostream os{fs::FileToFd(of, ec, fs::OF_Text), true};
+      ExportTraceFile(*f.second, os);
+    }
+    ++gExportCount;
+  }
+}
+
 void DisplayOutput(glass::Storage& storage) {
   static std::string& outputFolder = storage.GetString("outputFolder");
   static std::unique_ptr<pfd::select_folder> outputFolderSelector;
@@ -645,6 +803,21 @@ void DisplayOutput(glass::Storage& storage) {
       gExportErrors.clear();
       exporter = std::async(std::launch::async, ExportCsv, outputFolder, style);
     }
+    if (!gInputFiles.empty() && !outputFolder.empty()) {
+      ImGui::SameLine();
+      if (ImGui::Button("Export Trace") &&
+          (gExportCount == 0 ||
+           gExportCount == static_cast<int>(gInputFiles.size()))) {
+        gExportCount = 0;
+        gExportErrors.clear();
+        exporter = std::async(std::launch::async, ExportTrace, outputFolder);
+      }
+      if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Exports TraceProfiler events as a Chrome trace (JSON), which can "
+            "be opened with Perfetto or chrome://tracing");
+      }
+    }
     if (exporter.valid()) {
       ImGui::SameLine();
       ImGui::Text("Exported %d/%d", gExportCount.load(),
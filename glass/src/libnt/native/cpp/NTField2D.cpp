@@ -13,23 +13,29 @@
 #include <fmt/format.h>
 #include <networktables/DoubleArrayTopic.h>
 #include <networktables/MultiSubscriber.h>
+#include <networktables/StructArrayTopic.h>
 #include <ntcore_cpp.h>
 #include <wpi/Endian.h>
 #include <wpi/MathExtras.h>
 #include <wpi/SmallVector.h>
 #include <wpi/StringExtras.h>
+#include <wpi/struct/Struct.h>
 
 using namespace glass;
 
 class NTField2DModel::ObjectModel : public FieldObjectModel {
  public:
-  ObjectModel(std::string_view name, nt::DoubleArrayTopic topic)
-      : m_name{name}, m_topic{topic} {}
+  ObjectModel(std::string_view name, nt::Topic topic)
+      : m_name{name}, m_topic{topic} {
+    m_chunks.emplace_back().topic = topic;
+  }
 
   const char* GetName() const override { return m_name.c_str(); }
-  nt::DoubleArrayTopic GetTopic() const { return m_topic; }
+  nt::Topic GetTopic() const { return m_topic; }
 
-  void NTUpdate(const nt::Value& value);
+  // Returns false if the topic isn't the object's topic or one of its chunks
+  bool NTUpdate(NT_Topic topic, const nt::Value& value);
+  void AddChunk(size_t index, nt::Topic topic);
 
   void Update() override {}
   bool Exists() override { return m_topic.Exists(); }
@@ -43,20 +49,40 @@ class NTField2DModel::ObjectModel : public FieldObjectModel {
 
  private:
   void UpdateNT();
+  void UpdateFromChunks();
 
   std::string m_name;
-  nt::DoubleArrayTopic m_topic;
+  nt::Topic m_topic;
   nt::DoubleArrayPublisher m_pub;
 
+  // Pose2d struct array chunks, when the object is published as struct
+  // arrays. The first chunk is the object's topic, and the rest are
+  // ".name/1", ".name/2", etc. The poses are the chunks up to the first empty
+  // one.
+  struct Chunk {
+    nt::Topic topic;
+    std::vector<frc::Pose2d> poses;
+    nt::StructArrayPublisher<frc::Pose2d> pub;
+  };
+  std::vector<Chunk> m_chunks;
+  bool m_struct = false;
+
   std::vector<frc::Pose2d> m_poses;
 };
 
-void NTField2DModel::ObjectModel::NTUpdate(const nt::Value& value) {
-  if (value.IsDoubleArray()) {
+bool NTField2DModel::ObjectModel::NTUpdate(NT_Topic topic,
+                                           const nt::Value& value) {
+  auto chunk = std::find_if(m_chunks.begin(), m_chunks.end(),
+                            [&](auto& c) { return c.topic.GetHandle() == topic; });
+  if (chunk == m_chunks.end()) {
+    return false;
+  }
+  if (value.IsDoubleArray() && chunk == m_chunks.begin()) {
+    m_struct = false;
     auto arr = value.GetDoubleArray();
     auto size = arr.size();
     if ((size % 3) != 0) {
-      return;
+      return true;
     }
     m_poses.resize(size / 3);
     for (size_t i = 0; i < size / 3; ++i) {
@@ -64,10 +90,69 @@ void NTField2DModel::ObjectModel::NTUpdate(const nt::Value& value) {
           units::meter_t{arr[i * 3 + 0]}, units::meter_t{arr[i * 3 + 1]},
           frc::Rotation2d{units::degree_t{arr[i * 3 + 2]}}};
     }
+  } else if (value.IsRaw()) {
+    constexpr size_t kSize = wpi::GetStructSize<frc::Pose2d>();
+    auto raw = value.GetRaw();
+    if ((raw.size() % kSize) != 0) {
+      return true;
+    }
+    m_struct = true;
+    chunk->poses.clear();
+    for (size_t i = 0; i < raw.size(); i += kSize) {
+      chunk->poses.emplace_back(
+          wpi::UnpackStruct<frc::Pose2d>(raw.subspan(i, kSize)));
+    }
+    UpdateFromChunks();
+  }
+  return true;
+}
+
+void NTField2DModel::ObjectModel::AddChunk(size_t index, nt::Topic topic) {
+  if (index >= m_chunks.size()) {
+    m_chunks.resize(index + 1);
+  }
+  m_chunks[index].topic = topic;
+}
+
+void NTField2DModel::ObjectModel::UpdateFromChunks() {
+  m_poses.clear();
+  for (auto&& chunk : m_chunks) {
+    if (chunk.poses.empty()) {
+      break;
+    }
+    m_poses.insert(m_poses.end(), chunk.poses.begin(), chunk.poses.end());
   }
 }
 
 void NTField2DModel::ObjectModel::UpdateNT() {
+  if (m_struct) {
+    // Keep the robot's chunks if the number of poses didn't change, so only
+    // the changed chunk is sent; otherwise send all of them in the first
+    size_t total = 0;
+    for (auto&& chunk : m_chunks) {
+      if (chunk.poses.empty()) {
+        break;
+      }
+      total += chunk.poses.size();
+    }
+    std::span<const frc::Pose2d> poses{m_poses};
+    for (auto&& chunk : m_chunks) {
+      if (!chunk.topic) {
+        continue;
+      }
+      size_t size = total == m_poses.size() ? chunk.poses.size() : poses.size();
+      size = (std::min)(size, poses.size());
+      chunk.poses.assign(poses.begin(), poses.begin() + size);
+      poses = poses.subspan(size);
+      if (!chunk.pub) {
+        chunk.pub =
+            nt::StructArrayTopic<frc::Pose2d>{chunk.topic.GetHandle()}.Publish();
+      }
+      chunk.pub.Set(chunk.poses);
+    }
+    return;
+  }
+
   wpi::SmallVector<double, 9> arr;
   for (auto&& pose : m_poses) {
     auto& translation = pose.Translation();
@@ -76,7 +161,7 @@ void NTField2DModel::ObjectModel::UpdateNT() {
     arr.push_back(pose.Rotation().Degrees().value());
   }
   if (!m_pub) {
-    m_pub = m_topic.Publish();
+    m_pub = nt::DoubleArrayTopic{m_topic.GetHandle()}.Publish();
   }
   m_pub.Set(arr);
 }
@@ -130,7 +215,25 @@ void NTField2DModel::Update() {
     if (auto info = event.GetTopicInfo()) {
       // handle publish/unpublish
       auto name = wpi::remove_prefix(info->name, m_path).value_or("");
-      if (name.empty() || name[0] == '.') {
+      if (name.empty()) {
+        continue;
+      }
+      if (name[0] == '.') {
+        // struct array chunks of objects are published as ".name/index"
+        auto [objName, indexStr] = wpi::rsplit(name.substr(1), '/');
+        auto index = wpi::parse_integer<size_t>(indexStr, 10);
+        if (objName.empty() || !index || *index == 0 ||
+            !(event.flags & nt::EventFlags::kPublish)) {
+          continue;
+        }
+        auto fullName = fmt::format("{}{}", m_path, objName);
+        auto [it, match] = Find(fullName);
+        if (!match) {
+          it = m_objects.emplace(it,
+                                 std::make_unique<ObjectModel>(
+                                     fullName, m_inst.GetTopic(fullName)));
+        }
+        (*it)->AddChunk(*index, nt::Topic{info->topic});
         continue;
       }
       auto [it, match] = Find(info->name);
@@ -142,8 +245,8 @@ void NTField2DModel::Update() {
       } else if (event.flags & nt::EventFlags::kPublish) {
         if (!match) {
           it = m_objects.emplace(
-              it, std::make_unique<ObjectModel>(
-                      info->name, nt::DoubleArrayTopic{info->topic}));
+              it, std::make_unique<ObjectModel>(info->name,
+                                                nt::Topic{info->topic}));
         }
       } else if (!match) {
         continue;
@@ -158,13 +261,10 @@ void NTField2DModel::Update() {
         continue;
       }
 
-      auto it =
-          std::find_if(m_objects.begin(), m_objects.end(), [&](const auto& e) {
-            return e->GetTopic().GetHandle() == valueData->topic;
-          });
-      if (it != m_objects.end()) {
-        (*it)->NTUpdate(valueData->value);
-        continue;
+      for (auto&& obj : m_objects) {
+        if (obj->NTUpdate(valueData->topic, valueData->value)) {
+          break;
+        }
       }
     }
   }
@@ -182,9 +282,8 @@ FieldObjectModel* NTField2DModel::AddFieldObject(std::string_view name) {
   auto fullName = fmt::format("{}{}", m_path, name);
   auto [it, match] = Find(fullName);
   if (!match) {
-    it = m_objects.emplace(it,
-                           std::make_unique<ObjectModel>(
-                               fullName, m_inst.GetDoubleArrayTopic(fullName)));
+    it = m_objects.emplace(
+        it, std::make_unique<ObjectModel>(fullName, m_inst.GetTopic(fullName)));
   }
   return it->get();
 }
@@ -28,6 +28,8 @@ HAL_Bool HALSIM_IsTimingPaused(void) {
 
 void HALSIM_StepTiming(uint64_t delta) {}
 
+void HALSIM_StepTimingLockstep(uint64_t delta) {}
+
 void HALSIM_StepTimingAsync(uint64_t delta) {}
 
 void HALSIM_SetSendError(HALSIM_SendErrorHandler handler) {}
@@ -0,0 +1,23 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "hal/simulation/SimContext.h"
+
+extern "C" {
+
+int32_t HALSIM_CreateSimContext(void) {
+  return 0;
+}
+
+HAL_Bool HALSIM_DestroySimContext(int32_t context) {
+  return false;
+}
+
+void HALSIM_SetThreadSimContext(int32_t context) {}
+
+int32_t HALSIM_GetThreadSimContext(void) {
+  return 0;
+}
+
+}  // extern "C"
@@ -9,10 +9,16 @@
 #include <wpi/SmallVector.h>
 #include <wpi/mutex.h>
 
+#include "hal/simulation/SimContext.h"
+
 namespace hal {
 static wpi::SmallVector<HandleBase*, 32>* globalHandles = nullptr;
 static wpi::mutex globalHandleMutex;
-HandleBase::HandleBase() {
+HandleBase::HandleBase() : m_simContext{HALSIM_GetThreadSimContext()} {
+  // Handles don't encode their context, so start each context's versions at a
+  // different value. Most handles used in the wrong context then fail the
+  // version check instead of finding another context's resource.
+  m_version = m_simContext & 0xff;
   static wpi::SmallVector<HandleBase*, 32> gH;
   std::scoped_lock lock(globalHandleMutex);
   if (!globalHandles) {
@@ -20,6 +26,11 @@ HandleBase::HandleBase() {
   }
 
   auto index = std::find(globalHandles->begin(), globalHandles->end(), this);
+  if (index == globalHandles->end()) {
+    // Reuse the entries of destroyed resources, as simulation contexts may
+    // create and destroy many of them
+    index = std::find(globalHandles->begin(), globalHandles->end(), nullptr);
+  }
   if (index == globalHandles->end()) {
     globalHandles->push_back(this);
   } else {
@@ -40,9 +51,13 @@ void HandleBase::ResetHandles() {
   }
 }
 void HandleBase::ResetGlobalHandles() {
+  // Resources are created in the context of the thread that first uses them
+  int32_t simContext = HALSIM_GetThreadSimContext();
   std::unique_lock lock(globalHandleMutex);
-  for (auto&& i : *globalHandles) {
-    if (i != nullptr) {
+  // Indexed, as other contexts may add resources while the lock is released
+  for (size_t index = 0; index < globalHandles->size(); ++index) {
+    HandleBase* i = (*globalHandles)[index];
+    if (i != nullptr && i->m_simContext == simContext) {
       lock.unlock();
       i->ResetHandles();
       lock.lock();
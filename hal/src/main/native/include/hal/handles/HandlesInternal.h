@@ -32,10 +32,18 @@ class HandleBase {
   HandleBase(const HandleBase&) = delete;
   HandleBase& operator=(const HandleBase&) = delete;
   virtual void ResetHandles();
+  /**
+   * Resets the handles of all resources in the calling thread's simulation
+   * context.
+   */
   static void ResetGlobalHandles();
 
  protected:
-  int16_t m_version;
+  int16_t m_version = 0;
+
+ private:
+  // The simulation context the resource was created in
+  int32_t m_simContext;
 };
 
 constexpr int16_t InvalidHandleIndex = -1;
@@ -117,7 +125,7 @@ static inline bool isHandleType(HAL_Handle handle, HAL_HandleEnum handleType) {
  * @return true if the handle is the right version, otherwise false
  */
 static inline bool isHandleCorrectVersion(HAL_Handle handle, int16_t version) {
-  return (((handle & 0xFF0000) >> 16) & version) == version;
+  return ((handle & 0xFF0000) >> 16) == version;
 }
 
 /**
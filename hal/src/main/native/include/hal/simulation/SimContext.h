@@ -0,0 +1,74 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hal/Types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates a new simulation context. Simulation contexts hold the simulated
+ * hardware state (device data and handles, SimDevices, Notifiers and the
+ * simulation time), so several robots can be simulated in one process, each
+ * on its own threads. Each thread uses the default context (0) until it's set
+ * to another one. Driver station data and callbacks that aren't tied to a
+ * device (such as the periodic simulation callbacks) are shared by all
+ * contexts.
+ *
+ * Timing starts paused at 0 in the new context.
+ *
+ * @return the context
+ */
+int32_t HALSIM_CreateSimContext(void);
+
+/**
+ * Destroys a simulation context, and all of its simulated hardware, including
+ * any handles still open in it. If the calling thread uses the context, the
+ * thread is set to the default context.
+ *
+ * The context isn't destroyed while any other thread is set to it, such as the
+ * thread of a frc::Notifier created in the context. Stop and join those threads
+ * first; a thread is unset from its context when it exits or sets another one.
+ *
+ * @param context the context; the default context can't be destroyed
+ * @return true if the context was destroyed, false if other threads still use
+ *         it or it doesn't exist
+ */
+HAL_Bool HALSIM_DestroySimContext(int32_t context);
+
+/**
+ * Sets the simulation context used by the calling thread. Threads started by
+ * the thread (including Notifier threads) need to set the context too. A
+ * context can't be destroyed while other threads are set to it.
+ *
+ * HAL handles belong to the context they were created in, and so do the
+ * wpilibc objects that hold them (e.g., frc::Notifier, frc::PWM). Only use and
+ * destroy them from threads set to that context. Handles don't record their
+ * context, so the HAL can't always tell when one is used from another
+ * context. Each context starts its handle versions at a different value, so
+ * such a handle usually fails with HAL_HANDLE_ERROR. However, it may instead
+ * refer to the resource at the same index in the other context. For example,
+ * a frc::Notifier destroyed in the wrong context could stop another context's
+ * Notifier.
+ *
+ * @param context the context, or 0 for the default context; invalid contexts
+ *                are ignored
+ */
+void HALSIM_SetThreadSimContext(int32_t context);
+
+/**
+ * Gets the simulation context used by the calling thread.
+ *
+ * @return the context, or 0 for the default context
+ */
+int32_t HALSIM_GetThreadSimContext(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -9,6 +9,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/AnalogAccumulator.h"
 #include "hal/Errors.h"
 #include "hal/handles/IndexedHandleResource.h"
@@ -24,16 +25,12 @@ struct AnalogGyro {
 
 using namespace hal;
 
-static IndexedHandleResource<HAL_GyroHandle, AnalogGyro, kNumAccumulators,
-                             HAL_HandleEnum::AnalogGyro>* analogGyroHandles;
+static SimContextSlot<
+    IndexedHandleResource<HAL_GyroHandle, AnalogGyro, kNumAccumulators,
+                          HAL_HandleEnum::AnalogGyro>> analogGyroHandles;
 
 namespace hal::init {
-void InitializeAnalogGyro() {
-  static IndexedHandleResource<HAL_GyroHandle, AnalogGyro, kNumAccumulators,
-                               HAL_HandleEnum::AnalogGyro>
-      agH;
-  analogGyroHandles = &agH;
-}
+void InitializeAnalogGyro() {}
 }  // namespace hal::init
 
 extern "C" {
@@ -5,18 +5,16 @@
 #include "AnalogInternal.h"
 
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/handles/IndexedHandleResource.h"
 
 namespace hal {
-IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort, kNumAnalogInputs,
-                      HAL_HandleEnum::AnalogInput>* analogInputHandles;
+SimContextSlot<
+    IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
+                          kNumAnalogInputs, HAL_HandleEnum::AnalogInput>>
+    analogInputHandles;
 }  // namespace hal
 
 namespace hal::init {
-void InitializeAnalogInternal() {
-  static IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
-                               kNumAnalogInputs, HAL_HandleEnum::AnalogInput>
-      aiH;
-  analogInputHandles = &aiH;
-}
+void InitializeAnalogInternal() {}
 }  // namespace hal::init
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/IndexedHandleResource.h"
 
@@ -25,8 +26,9 @@ struct AnalogPort {
   std::string previousAllocation;
 };
 
-extern IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
-                             kNumAnalogInputs, HAL_HandleEnum::AnalogInput>*
+extern SimContextSlot<
+    IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
+                          kNumAnalogInputs, HAL_HandleEnum::AnalogInput>>
     analogInputHandles;
 
 int32_t GetAnalogTriggerInputIndex(HAL_AnalogTriggerHandle handle,
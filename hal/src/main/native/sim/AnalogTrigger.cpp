@@ -7,6 +7,7 @@
 #include "AnalogInternal.h"
 #include "HALInitializer.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/AnalogInput.h"
 #include "hal/Errors.h"
 #include "hal/handles/HandlesInternal.h"
@@ -24,18 +25,13 @@ struct AnalogTrigger {
 
 using namespace hal;
 
-static LimitedHandleResource<HAL_AnalogTriggerHandle, AnalogTrigger,
-                             kNumAnalogTriggers, HAL_HandleEnum::AnalogTrigger>*
+static SimContextSlot<
+    LimitedHandleResource<HAL_AnalogTriggerHandle, AnalogTrigger,
+                          kNumAnalogTriggers, HAL_HandleEnum::AnalogTrigger>>
     analogTriggerHandles;
 
 namespace hal::init {
-void InitializeAnalogTrigger() {
-  static LimitedHandleResource<HAL_AnalogTriggerHandle, AnalogTrigger,
-                               kNumAnalogTriggers,
-                               HAL_HandleEnum::AnalogTrigger>
-      atH;
-  analogTriggerHandles = &atH;
-}
+void InitializeAnalogTrigger() {}
 }  // namespace hal::init
 
 int32_t hal::GetAnalogTriggerInputIndex(HAL_AnalogTriggerHandle handle,
@@ -10,6 +10,7 @@
 
 #include "CANAPIInternal.h"
 #include "HALInitializer.h"
+#include "SimContextInternal.h"
 #include "hal/CAN.h"
 #include "hal/Errors.h"
 #include "hal/HALBase.h"
@@ -35,16 +36,13 @@ struct CANStorage {
 };
 }  // namespace
 
-static UnlimitedHandleResource<HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>*
+static SimContextSlot<
+    UnlimitedHandleResource<HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>>
     canHandles;
 
 namespace hal {
 namespace init {
-void InitializeCANAPI() {
-  static UnlimitedHandleResource<HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>
-      cH;
-  canHandles = &cH;
-}
+void InitializeCANAPI() {}
 }  // namespace init
 namespace can {
 int32_t GetCANModuleFromHandle(HAL_CANHandle handle, int32_t* status) {
@@ -7,22 +7,19 @@
 #include "CounterInternal.h"
 #include "HALInitializer.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
 
 namespace hal {
 
-LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                      HAL_HandleEnum::Counter>* counterHandles;
+SimContextSlot<
+    LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
+                          HAL_HandleEnum::Counter>> counterHandles;
 }  // namespace hal
 
 namespace hal::init {
-void InitializeCounter() {
-  static LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                               HAL_HandleEnum::Counter>
-      cH;
-  counterHandles = &cH;
-}
+void InitializeCounter() {}
 }  // namespace hal::init
 
 extern "C" {
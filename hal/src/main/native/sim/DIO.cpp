@@ -8,6 +8,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
 #include "mockdata/DIODataInternal.h"
@@ -15,18 +16,12 @@
 
 using namespace hal;
 
-static LimitedHandleResource<HAL_DigitalPWMHandle, uint8_t,
-                             kNumDigitalPWMOutputs, HAL_HandleEnum::DigitalPWM>*
-    digitalPWMHandles;
+static SimContextSlot<
+    LimitedHandleResource<HAL_DigitalPWMHandle, uint8_t, kNumDigitalPWMOutputs,
+                          HAL_HandleEnum::DigitalPWM>> digitalPWMHandles;
 
 namespace hal::init {
-void InitializeDIO() {
-  static LimitedHandleResource<HAL_DigitalPWMHandle, uint8_t,
-                               kNumDigitalPWMOutputs,
-                               HAL_HandleEnum::DigitalPWM>
-      dpH;
-  digitalPWMHandles = &dpH;
-}
+void InitializeDIO() {}
 }  // namespace hal::init
 
 extern "C" {
@@ -5,6 +5,7 @@
 #include "DigitalInternal.h"
 
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/AnalogTrigger.h"
 #include "hal/Errors.h"
 #include "hal/handles/DigitalHandleResource.h"
@@ -12,17 +13,13 @@
 
 namespace hal {
 
-DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                      kNumDigitalChannels + kNumPWMHeaders>*
+SimContextSlot<
+    DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
+                          kNumDigitalChannels + kNumPWMHeaders>>
     digitalChannelHandles;
 
 namespace init {
-void InitializeDigitalInternal() {
-  static DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                               kNumDigitalChannels + kNumPWMHeaders>
-      dcH;
-  digitalChannelHandles = &dcH;
-}
+void InitializeDigitalInternal() {}
 }  // namespace init
 
 bool remapDigitalSource(HAL_Handle digitalSourceHandle,
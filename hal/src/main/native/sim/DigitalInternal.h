@@ -9,6 +9,7 @@
 #include <string>
 
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/AnalogTrigger.h"
 #include "hal/handles/DigitalHandleResource.h"
 
@@ -54,8 +55,9 @@ struct DigitalPort {
   std::string previousAllocation;
 };
 
-extern DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                             kNumDigitalChannels + kNumPWMHeaders>*
+extern SimContextSlot<
+    DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
+                          kNumDigitalChannels + kNumPWMHeaders>>
     digitalChannelHandles;
 
 /**
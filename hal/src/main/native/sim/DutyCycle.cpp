@@ -6,6 +6,7 @@
 
 #include "HALInitializer.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/Errors.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
@@ -20,16 +21,12 @@ struct DutyCycle {
 struct Empty {};
 }  // namespace
 
-static LimitedHandleResource<HAL_DutyCycleHandle, DutyCycle, kNumDutyCycles,
-                             HAL_HandleEnum::DutyCycle>* dutyCycleHandles;
+static SimContextSlot<
+    LimitedHandleResource<HAL_DutyCycleHandle, DutyCycle, kNumDutyCycles,
+                          HAL_HandleEnum::DutyCycle>> dutyCycleHandles;
 
 namespace hal::init {
-void InitializeDutyCycle() {
-  static LimitedHandleResource<HAL_DutyCycleHandle, DutyCycle, kNumDutyCycles,
-                               HAL_HandleEnum::DutyCycle>
-      dcH;
-  dutyCycleHandles = &dcH;
-}
+void InitializeDutyCycle() {}
 }  // namespace hal::init
 
 extern "C" {
@@ -10,6 +10,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/Errors.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
@@ -29,25 +30,17 @@ struct Encoder {
 struct Empty {};
 }  // namespace
 
-static LimitedHandleResource<HAL_EncoderHandle, Encoder,
-                             kNumEncoders + kNumCounters,
-                             HAL_HandleEnum::Encoder>* encoderHandles;
+static SimContextSlot<
+    LimitedHandleResource<HAL_EncoderHandle, Encoder,
+                          kNumEncoders + kNumCounters, HAL_HandleEnum::Encoder>>
+    encoderHandles;
 
-static LimitedHandleResource<HAL_FPGAEncoderHandle, Empty, kNumEncoders,
-                             HAL_HandleEnum::FPGAEncoder>* fpgaEncoderHandles;
+static SimContextSlot<
+    LimitedHandleResource<HAL_FPGAEncoderHandle, Empty, kNumEncoders,
+                          HAL_HandleEnum::FPGAEncoder>> fpgaEncoderHandles;
 
 namespace hal::init {
-void InitializeEncoder() {
-  static LimitedHandleResource<HAL_FPGAEncoderHandle, Empty, kNumEncoders,
-                               HAL_HandleEnum::FPGAEncoder>
-      feH;
-  fpgaEncoderHandles = &feH;
-  static LimitedHandleResource<HAL_EncoderHandle, Encoder,
-                               kNumEncoders + kNumCounters,
-                               HAL_HandleEnum::Encoder>
-      eH;
-  encoderHandles = &eH;
-}
+void InitializeEncoder() {}
 }  // namespace hal::init
 
 namespace hal {
@@ -14,6 +14,7 @@
 #include "HALInitializer.h"
 #include "MockHooksInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/AnalogTrigger.h"
 #include "hal/Errors.h"
 #include "hal/Value.h"
@@ -57,25 +58,18 @@ struct SynchronousWaitData {
 };
 }  // namespace
 
-static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
-                             HAL_HandleEnum::Interrupt>* interruptHandles;
+static SimContextSlot<
+    LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
+                          HAL_HandleEnum::Interrupt>> interruptHandles;
 
 using SynchronousWaitDataHandle = HAL_Handle;
-static UnlimitedHandleResource<SynchronousWaitDataHandle, SynchronousWaitData,
-                               HAL_HandleEnum::Vendor>*
+static SimContextSlot<
+    UnlimitedHandleResource<SynchronousWaitDataHandle, SynchronousWaitData,
+                            HAL_HandleEnum::Vendor>>
     synchronousInterruptHandles;
 
 namespace hal::init {
-void InitializeInterrupts() {
-  static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
-                               HAL_HandleEnum::Interrupt>
-      iH;
-  interruptHandles = &iH;
-  static UnlimitedHandleResource<SynchronousWaitDataHandle, SynchronousWaitData,
-                                 HAL_HandleEnum::Vendor>
-      siH;
-  synchronousInterruptHandles = &siH;
-}
+void InitializeInterrupts() {}
 }  // namespace hal::init
 
 extern "C" {
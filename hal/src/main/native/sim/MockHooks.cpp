@@ -13,13 +13,21 @@
 
 #include "MockHooksInternal.h"
 #include "NotifierInternal.h"
+#include "SimContextInternal.h"
 #include "hal/simulation/NotifierData.h"
 
+namespace {
+struct Timing {
+  std::atomic<uint64_t> programStartTime{0};
+  std::atomic<uint64_t> programPauseTime{0};
+  std::atomic<uint64_t> programStepTime{0};
+};
+}  // namespace
+
 static std::atomic<bool> programStarted{false};
 
-static std::atomic<uint64_t> programStartTime{0};
-static std::atomic<uint64_t> programPauseTime{0};
-static std::atomic<uint64_t> programStepTime{0};
+// Each simulation context has its own time
+static hal::SimContextSlot<Timing> timing;
 
 namespace hal::init {
 void InitializeMockHooks() {
@@ -29,40 +37,44 @@ void InitializeMockHooks() {
 
 namespace hal {
 void RestartTiming() {
-  programStartTime = wpi::NowDefault();
-  programStepTime = 0;
-  if (programPauseTime != 0) {
-    programPauseTime = programStartTime.load();
+  Timing& t = *timing;
+  t.programStartTime = wpi::NowDefault();
+  t.programStepTime = 0;
+  if (t.programPauseTime != 0) {
+    t.programPauseTime = t.programStartTime.load();
   }
 }
 
 void PauseTiming() {
-  if (programPauseTime == 0) {
-    programPauseTime = wpi::NowDefault();
+  Timing& t = *timing;
+  if (t.programPauseTime == 0) {
+    t.programPauseTime = wpi::NowDefault();
   }
 }
 
 void ResumeTiming() {
-  if (programPauseTime != 0) {
-    programStartTime += wpi::NowDefault() - programPauseTime;
-    programPauseTime = 0;
+  Timing& t = *timing;
+  if (t.programPauseTime != 0) {
+    t.programStartTime += wpi::NowDefault() - t.programPauseTime;
+    t.programPauseTime = 0;
   }
 }
 
 bool IsTimingPaused() {
-  return programPauseTime != 0;
+  return timing->programPauseTime != 0;
 }
 
 void StepTiming(uint64_t delta) {
-  programStepTime += delta;
+  timing->programStepTime += delta;
 }
 
 uint64_t GetFPGATime() {
-  uint64_t curTime = programPauseTime;
+  Timing& t = *timing;
+  uint64_t curTime = t.programPauseTime;
   if (curTime == 0) {
     curTime = wpi::NowDefault();
   }
-  return curTime + programStepTime - programStartTime;
+  return curTime + t.programStepTime - t.programStartTime;
 }
 
 double GetFPGATimestamp() {
@@ -131,6 +143,29 @@ void HALSIM_StepTiming(uint64_t delta) {
   }
 }
 
+void HALSIM_StepTimingLockstep(uint64_t delta) {
+  for (;;) {
+    // Run the expired Notifiers one at a time, waiting for all Notifiers
+    // (including any new ones) to be waiting before running the next
+    do {
+      WaitNotifiers();
+    } while (WakeupWaitNextNotifier());
+
+    if (delta == 0) {
+      break;
+    }
+
+    // No timeouts are expired, so the next one is in the future
+    int32_t status = 0;
+    uint64_t curTime = HAL_GetFPGATime(&status);
+    uint64_t nextTimeout = HALSIM_GetNextNotifierTimeout();
+    uint64_t step = (std::min)(delta, nextTimeout - curTime);
+
+    StepTiming(step);
+    delta -= step;
+  }
+}
+
 void HALSIM_StepTimingAsync(uint64_t delta) {
   StepTiming(delta);
   WakeupNotifiers();
@@ -19,6 +19,7 @@
 
 #include "HALInitializer.h"
 #include "NotifierInternal.h"
+#include "SimContextInternal.h"
 #include "hal/Errors.h"
 #include "hal/HALBase.h"
 #include "hal/cpp/fpga_clock.h"
@@ -40,9 +41,6 @@ struct Notifier {
 
 using namespace hal;
 
-static wpi::mutex notifiersWaiterMutex;
-static wpi::condition_variable notifiersWaiterCond;
-
 class NotifierHandleContainer
     : public UnlimitedHandleResource<HAL_NotifierHandle, Notifier,
                                      HAL_HandleEnum::Notifier> {
@@ -56,27 +54,28 @@ class NotifierHandleContainer
       }
       notifier->cond.notify_all();  // wake up any waiting threads
     });
-    notifiersWaiterCond.notify_all();
+    waiterCond.notify_all();
   }
+
+  wpi::mutex waiterMutex;
+  wpi::condition_variable waiterCond;
+  std::atomic<bool> paused{false};
 };
 
-static NotifierHandleContainer* notifierHandles;
-static std::atomic<bool> notifiersPaused{false};
+// The Notifiers of each simulation context are stepped separately
+static SimContextSlot<NotifierHandleContainer> notifierHandles;
 
 namespace hal {
 namespace init {
-void InitializeNotifier() {
-  static NotifierHandleContainer nH;
-  notifierHandles = &nH;
-}
+void InitializeNotifier() {}
 }  // namespace init
 
 void PauseNotifiers() {
-  notifiersPaused = true;
+  notifierHandles->paused = true;
 }
 
 void ResumeNotifiers() {
-  notifiersPaused = false;
+  notifierHandles->paused = false;
   WakeupNotifiers();
 }
 
@@ -87,7 +86,7 @@ void WakeupNotifiers() {
 }
 
 void WaitNotifiers() {
-  std::unique_lock ulock(notifiersWaiterMutex);
+  std::unique_lock ulock(notifierHandles->waiterMutex);
   wpi::SmallVector<HAL_NotifierHandle, 8> waiters;
 
   // Wait for all Notifiers to hit HAL_WaitForNotifierAlarm()
@@ -116,12 +115,13 @@ void WaitNotifiers() {
       break;
     }
     waiters.resize(count);
-    notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
+    notifierHandles->waiterCond.wait_for(ulock,
+                                         std::chrono::duration<double>(1));
   }
 }
 
 void WakeupWaitNotifiers() {
-  std::unique_lock ulock(notifiersWaiterMutex);
+  std::unique_lock ulock(notifierHandles->waiterMutex);
   int32_t status = 0;
   uint64_t curTime = HAL_GetFPGATime(&status);
   wpi::SmallVector<std::pair<HAL_NotifierHandle, uint64_t>, 8> waiters;
@@ -159,9 +159,53 @@ void WakeupWaitNotifiers() {
       break;
     }
     waiters.resize(count);
-    notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
+    notifierHandles->waiterCond.wait_for(ulock,
+                                         std::chrono::duration<double>(1));
   }
 }
+
+bool WakeupWaitNextNotifier() {
+  std::unique_lock ulock(notifierHandles->waiterMutex);
+  int32_t status = 0;
+  uint64_t curTime = HAL_GetFPGATime(&status);
+  HAL_NotifierHandle next = HAL_kInvalidHandle;
+  uint64_t nextTime = UINT64_MAX;
+  uint64_t nextWaitCount = 0;
+
+  // Find the Notifier with the earliest expired timeout. Notifiers are visited
+  // in handle order, so ties go to the lowest handle.
+  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
+    std::scoped_lock lock(notifier->mutex);
+    if (notifier->active && notifier->waitTimeValid &&
+        curTime >= notifier->waitTime && notifier->waitTime < nextTime) {
+      next = handle;
+      nextTime = notifier->waitTime;
+      nextWaitCount = notifier->waitCount;
+    }
+  });
+  if (next == HAL_kInvalidHandle) {
+    return false;
+  }
+
+  // Wake up only that Notifier, and wait until HAL_WaitForNotifierAlarm() is
+  // exited, then reentered
+  for (;;) {
+    auto notifier = notifierHandles->Get(next);
+    if (!notifier) {
+      break;
+    }
+    {
+      std::scoped_lock lock(notifier->mutex);
+      if (!notifier->active || notifier->waitCount != nextWaitCount) {
+        break;
+      }
+      notifier->cond.notify_all();
+    }
+    notifierHandles->waiterCond.wait_for(ulock,
+                                         std::chrono::duration<double>(1));
+  }
+  return true;
+}
 }  // namespace hal
 
 extern "C" {
@@ -258,12 +302,12 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
     return 0;
   }
 
-  std::unique_lock ulock(notifiersWaiterMutex);
+  std::unique_lock ulock(notifierHandles->waiterMutex);
   std::unique_lock lock(notifier->mutex);
   notifier->waitingForAlarm = true;
   ++notifier->waitCount;
   ulock.unlock();
-  notifiersWaiterCond.notify_all();
+  notifierHandles->waiterCond.notify_all();
   while (notifier->active) {
     uint64_t curTime = HAL_GetFPGATime(status);
     if (notifier->waitTimeValid && curTime >= notifier->waitTime) {
@@ -273,7 +317,7 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
     }
 
     double waitDuration;
-    if (!notifier->waitTimeValid || notifiersPaused) {
+    if (!notifier->waitTimeValid || notifierHandles->paused) {
       // If not running, wait 1000 seconds
       waitDuration = 1000.0;
     } else {
@@ -10,4 +10,5 @@ void ResumeNotifiers();
 void WakeupNotifiers();
 void WaitNotifiers();
 void WakeupWaitNotifiers();
+bool WakeupWaitNextNotifier();
 }  // namespace hal
@@ -9,6 +9,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/Errors.h"
 #include "hal/handles/IndexedHandleResource.h"
 #include "mockdata/REVPHDataInternal.h"
@@ -23,16 +24,12 @@ struct PCM {
 };
 }  // namespace
 
-static IndexedHandleResource<HAL_REVPHHandle, PCM, kNumREVPHModules,
-                             HAL_HandleEnum::REVPH>* pcmHandles;
+static SimContextSlot<
+    IndexedHandleResource<HAL_REVPHHandle, PCM, kNumREVPHModules,
+                          HAL_HandleEnum::REVPH>> pcmHandles;
 
 namespace hal::init {
-void InitializeREVPH() {
-  static IndexedHandleResource<HAL_REVPHHandle, PCM, kNumREVPHModules,
-                               HAL_HandleEnum::REVPH>
-      pH;
-  pcmHandles = &pH;
-}
+void InitializeREVPH() {}
 }  // namespace hal::init
 
 HAL_REVPHHandle HAL_InitializeREVPH(int32_t module,
@@ -9,6 +9,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/handles/IndexedHandleResource.h"
 #include "mockdata/RelayDataInternal.h"
 
@@ -22,16 +23,12 @@ struct Relay {
 };
 }  // namespace
 
-static IndexedHandleResource<HAL_RelayHandle, Relay, kNumRelayChannels,
-                             HAL_HandleEnum::Relay>* relayHandles;
+static SimContextSlot<
+    IndexedHandleResource<HAL_RelayHandle, Relay, kNumRelayChannels,
+                          HAL_HandleEnum::Relay>> relayHandles;
 
 namespace hal::init {
-void InitializeRelay() {
-  static IndexedHandleResource<HAL_RelayHandle, Relay, kNumRelayChannels,
-                               HAL_HandleEnum::Relay>
-      rH;
-  relayHandles = &rH;
-}
+void InitializeRelay() {}
 }  // namespace hal::init
 
 extern "C" {
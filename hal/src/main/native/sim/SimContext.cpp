@@ -0,0 +1,199 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "hal/simulation/SimContext.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <wpi/DenseMap.h>
+#include <wpi/mutex.h>
+#include <wpi/print.h>
+
+#include "SimContextInternal.h"
+#include "hal/simulation/MockHooks.h"
+
+namespace {
+// The maximum number of SimContextSlots; each context has an entry for each
+constexpr int kMaxSlots = 128;
+
+struct SlotEntry {
+  std::atomic<void*> data{nullptr};
+  void (*destroy)(void*) = nullptr;
+};
+
+struct SimContext {
+  explicit SimContext(int32_t id) : id{id} {}
+  ~SimContext() {
+    // Destroy in reverse order of creation, like statics would be
+    for (auto it = created.rbegin(); it != created.rend(); ++it) {
+      auto& slot = slots[*it];
+      slot.destroy(slot.data.load(std::memory_order_relaxed));
+    }
+  }
+
+  int32_t id;
+  // The number of threads set to this context, guarded by SimContexts::mutex
+  int boundThreads = 0;
+  // Recursive, as creating the data for one slot may access another
+  wpi::recursive_mutex mutex;
+  std::array<SlotEntry, kMaxSlots> slots;
+  std::vector<int> created;
+};
+
+struct SimContexts {
+  wpi::mutex mutex;
+  int32_t nextId = 1;
+  wpi::DenseMap<int32_t, std::unique_ptr<SimContext>> contexts;
+};
+}  // namespace
+
+static std::atomic<int> nextSlotIndex{0};
+static thread_local SimContext* threadContext = nullptr;
+
+static SimContexts& GetContexts();
+
+// Unsets the thread from its context when the thread exits. Kept separate from
+// threadContext so reading the context doesn't need a thread_local guard.
+namespace {
+struct ThreadBinding {
+  bool used = false;
+
+  ~ThreadBinding() {
+    if (threadContext) {
+      std::scoped_lock lock{GetContexts().mutex};
+      --threadContext->boundThreads;
+      threadContext = nullptr;
+    }
+  }
+};
+}  // namespace
+
+static thread_local ThreadBinding threadBinding;
+
+// The default context and the registry are never destroyed, as the time may
+// be read (through wpi::Now()) during static destruction
+static SimContext& GetDefaultContext() {
+  static SimContext* context = new SimContext{0};
+  return *context;
+}
+
+static SimContext& GetThreadContext() {
+  if (threadContext) {
+    return *threadContext;
+  }
+  return GetDefaultContext();
+}
+
+static SimContexts& GetContexts() {
+  static SimContexts* contexts = new SimContexts;
+  return *contexts;
+}
+
+void* hal::impl::GetSimContextSlot(std::atomic<int>& index,
+                                   void* (*create)(size_t),
+                                   void (*destroy)(void*), size_t count) {
+  int i = index.load(std::memory_order_acquire);
+  if (i < 0) {
+    int newIndex = nextSlotIndex++;
+    if (newIndex >= kMaxSlots) {
+      wpi::print(stderr, "HAL: too many simulation context slots (max {})\n",
+                 kMaxSlots);
+      std::abort();
+    }
+    // Another thread may have assigned the index first
+    if (index.compare_exchange_strong(i, newIndex)) {
+      i = newIndex;
+    }
+  }
+
+  SimContext& context = GetThreadContext();
+  SlotEntry& slot = context.slots[i];
+  void* data = slot.data.load(std::memory_order_acquire);
+  if (!data) {
+    std::scoped_lock lock{context.mutex};
+    data = slot.data.load(std::memory_order_relaxed);
+    if (!data) {
+      data = create(count);
+      slot.destroy = destroy;
+      context.created.emplace_back(i);
+      slot.data.store(data, std::memory_order_release);
+    }
+  }
+  return data;
+}
+
+extern "C" {
+
+int32_t HALSIM_CreateSimContext(void) {
+  auto& contexts = GetContexts();
+  std::unique_lock lock{contexts.mutex};
+  int32_t id = contexts.nextId++;
+  auto context = std::make_unique<SimContext>(id);
+  SimContext* prevContext = std::exchange(threadContext, context.get());
+  contexts.contexts[id] = std::move(context);
+  lock.unlock();
+
+  // Start at 0, paused
+  HALSIM_PauseTiming();
+  HALSIM_RestartTiming();
+
+  threadContext = prevContext;
+  return id;
+}
+
+HAL_Bool HALSIM_DestroySimContext(int32_t context) {
+  std::unique_ptr<SimContext> destroyed;
+  {
+    auto& contexts = GetContexts();
+    std::scoped_lock lock{contexts.mutex};
+    auto it = contexts.contexts.find(context);
+    if (it == contexts.contexts.end()) {
+      return false;
+    }
+    bool callerBound = threadContext == it->second.get();
+    if (it->second->boundThreads > (callerBound ? 1 : 0)) {
+      return false;
+    }
+    if (callerBound) {
+      threadContext = nullptr;
+    }
+    destroyed = std::move(it->second);
+    contexts.contexts.erase(it);
+  }
+  return true;
+}
+
+void HALSIM_SetThreadSimContext(int32_t context) {
+  auto& contexts = GetContexts();
+  std::scoped_lock lock{contexts.mutex};
+  SimContext* newContext = nullptr;
+  if (context != 0) {
+    auto it = contexts.contexts.find(context);
+    if (it == contexts.contexts.end()) {
+      return;
+    }
+    newContext = it->second.get();
+  }
+  if (threadContext) {
+    --threadContext->boundThreads;
+  }
+  if (newContext) {
+    ++newContext->boundThreads;
+    // Constructs the binding, so the thread is unset when it exits
+    threadBinding.used = true;
+  }
+  threadContext = newContext;
+}
+
+int32_t HALSIM_GetThreadSimContext(void) {
+  return GetThreadContext().id;
+}
+
+}  // extern "C"
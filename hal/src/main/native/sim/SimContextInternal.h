@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <atomic>
+
+namespace hal {
+namespace impl {
+void* GetSimContextSlot(std::atomic<int>& index, void* (*create)(size_t),
+                        void (*destroy)(void*), size_t count);
+}  // namespace impl
+
+/**
+ * Simulation state that's kept separately for each simulation context (see
+ * hal/simulation/SimContext.h). Each context lazily creates its own array of
+ * count default constructed T the first time it's accessed, and destroys it
+ * when the context is destroyed. Accesses use the calling thread's context.
+ */
+template <typename T>
+class SimContextSlot {
+ public:
+  constexpr explicit SimContextSlot(size_t count = 1) : m_count{count} {}
+
+  SimContextSlot(const SimContextSlot&) = delete;
+  SimContextSlot& operator=(const SimContextSlot&) = delete;
+
+  T* Get() const {
+    return static_cast<T*>(
+        impl::GetSimContextSlot(m_index, &Create, &Destroy, m_count));
+  }
+
+  T* operator->() const { return Get(); }
+  T& operator*() const { return *Get(); }
+  T& operator[](size_t index) const { return Get()[index]; }
+
+ private:
+  // Value initialized, so members without initializers are zeroed like they
+  // would be in static storage
+  static void* Create(size_t count) { return new T[count](); }
+  static void Destroy(void* data) { delete[] static_cast<T*>(data); }
+
+  size_t m_count;
+  mutable std::atomic<int> m_index{-1};
+};
+}  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeAccelerometerData() {
-  static AccelerometerData sad[kAccelerometers];
-  ::hal::SimAccelerometerData = sad;
-}
+void InitializeAccelerometerData() {}
 }  // namespace hal::init
 
-AccelerometerData* hal::SimAccelerometerData;
+SimContextSlot<AccelerometerData> hal::SimAccelerometerData{kAccelerometers};
 void AccelerometerData::ResetData() {
   active.Reset(false);
   range.Reset(static_cast<HAL_AccelerometerRange>(0));
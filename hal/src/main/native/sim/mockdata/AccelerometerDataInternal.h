@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/AccelerometerData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -29,5 +30,5 @@ class AccelerometerData {
 
   virtual void ResetData();
 };
-extern AccelerometerData* SimAccelerometerData;
+extern SimContextSlot<AccelerometerData> SimAccelerometerData;
 }  // namespace hal
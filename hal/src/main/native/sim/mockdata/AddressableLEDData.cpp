@@ -11,13 +11,11 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeAddressableLEDData() {
-  static AddressableLEDData sad[kNumAddressableLEDs];
-  ::hal::SimAddressableLEDData = sad;
-}
+void InitializeAddressableLEDData() {}
 }  // namespace hal::init
 
-AddressableLEDData* hal::SimAddressableLEDData;
+SimContextSlot<AddressableLEDData> hal::SimAddressableLEDData{
+    kNumAddressableLEDs};
 
 void AddressableLEDData::ResetData() {
   initialized.Reset(false);
@@ -8,6 +8,7 @@
 
 #include <wpi/spinlock.h>
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/AddressableLEDData.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 #include "hal/simulation/SimDataValue.h"
@@ -36,5 +37,5 @@ class AddressableLEDData {
 
   void ResetData();
 };
-extern AddressableLEDData* SimAddressableLEDData;
+extern SimContextSlot<AddressableLEDData> SimAddressableLEDData;
 }  // namespace hal
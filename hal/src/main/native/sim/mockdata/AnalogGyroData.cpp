@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeAnalogGyroData() {
-  static AnalogGyroData agd[kNumAccumulators];
-  ::hal::SimAnalogGyroData = agd;
-}
+void InitializeAnalogGyroData() {}
 }  // namespace hal::init
 
-AnalogGyroData* hal::SimAnalogGyroData;
+SimContextSlot<AnalogGyroData> hal::SimAnalogGyroData{kNumAccumulators};
 void AnalogGyroData::ResetData() {
   angle.Reset(0.0);
   rate.Reset(0.0);
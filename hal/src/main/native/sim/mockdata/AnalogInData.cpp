@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeAnalogInData() {
-  static AnalogInData sind[kNumAnalogInputs];
-  ::hal::SimAnalogInData = sind;
-}
+void InitializeAnalogInData() {}
 }  // namespace hal::init
 
-AnalogInData* hal::SimAnalogInData;
+SimContextSlot<AnalogInData> hal::SimAnalogInData{kNumAnalogInputs};
 void AnalogInData::ResetData() {
   initialized.Reset(false);
   simDevice = 0;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/AnalogInData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -39,5 +40,5 @@ class AnalogInData {
 
   virtual void ResetData();
 };
-extern AnalogInData* SimAnalogInData;
+extern SimContextSlot<AnalogInData> SimAnalogInData;
 }  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeAnalogOutData() {
-  static AnalogOutData siod[kNumAnalogOutputs];
-  ::hal::SimAnalogOutData = siod;
-}
+void InitializeAnalogOutData() {}
 }  // namespace hal::init
 
-AnalogOutData* hal::SimAnalogOutData;
+SimContextSlot<AnalogOutData> hal::SimAnalogOutData{kNumAnalogOutputs};
 void AnalogOutData::ResetData() {
   voltage.Reset(0.0);
   initialized.Reset(0);
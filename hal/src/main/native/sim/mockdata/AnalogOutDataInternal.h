@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/AnalogOutData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -18,5 +19,5 @@ class AnalogOutData {
 
   virtual void ResetData();
 };
-extern AnalogOutData* SimAnalogOutData;
+extern SimContextSlot<AnalogOutData> SimAnalogOutData;
 }  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeAnalogTriggerData() {
-  static AnalogTriggerData satd[kNumAnalogTriggers];
-  ::hal::SimAnalogTriggerData = satd;
-}
+void InitializeAnalogTriggerData() {}
 }  // namespace hal::init
 
-AnalogTriggerData* hal::SimAnalogTriggerData;
+SimContextSlot<AnalogTriggerData> hal::SimAnalogTriggerData{kNumAnalogTriggers};
 void AnalogTriggerData::ResetData() {
   initialized.Reset(0);
   triggerLowerBound.Reset(0);
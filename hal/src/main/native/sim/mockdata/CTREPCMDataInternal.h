@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "../PortsInternal.h"
 #include "hal/simulation/CTREPCMData.h"
 #include "hal/simulation/SimDataValue.h"
@@ -39,5 +40,5 @@ class CTREPCMData {
 
   virtual void ResetData();
 };
-extern CTREPCMData* SimCTREPCMData;
+extern SimContextSlot<CTREPCMData> SimCTREPCMData;
 }  // namespace hal
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/CanData.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 
@@ -34,6 +35,6 @@ class CanData {
   void ResetData();
 };
 
-extern CanData* SimCanData;
+extern SimContextSlot<CanData> SimCanData;
 
 }  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeDigitalPWMData() {
-  static DigitalPWMData sdpd[kNumDigitalPWMOutputs];
-  ::hal::SimDigitalPWMData = sdpd;
-}
+void InitializeDigitalPWMData() {}
 }  // namespace hal::init
 
-DigitalPWMData* hal::SimDigitalPWMData;
+SimContextSlot<DigitalPWMData> hal::SimDigitalPWMData{kNumDigitalPWMOutputs};
 void DigitalPWMData::ResetData() {
   initialized.Reset(false);
   dutyCycle.Reset(0.0);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/DigitalPWMData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -21,5 +22,5 @@ class DigitalPWMData {
 
   virtual void ResetData();
 };
-extern DigitalPWMData* SimDigitalPWMData;
+extern SimContextSlot<DigitalPWMData> SimDigitalPWMData;
 }  // namespace hal
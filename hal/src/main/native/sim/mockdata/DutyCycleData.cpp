@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeDutyCycleData() {
-  static DutyCycleData sed[kNumDutyCycles];
-  ::hal::SimDutyCycleData = sed;
-}
+void InitializeDutyCycleData() {}
 }  // namespace hal::init
 
-DutyCycleData* hal::SimDutyCycleData;
+SimContextSlot<DutyCycleData> hal::SimDutyCycleData{kNumDutyCycles};
 
 void DutyCycleData::ResetData() {
   digitalChannel = 0;
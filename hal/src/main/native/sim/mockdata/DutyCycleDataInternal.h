@@ -7,6 +7,7 @@
 #include <atomic>
 #include <limits>
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/DutyCycleData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -26,5 +27,5 @@ class DutyCycleData {
 
   virtual void ResetData();
 };
-extern DutyCycleData* SimDutyCycleData;
+extern SimContextSlot<DutyCycleData> SimDutyCycleData;
 }  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeI2CData() {
-  static I2CData sid[kI2CPorts];
-  ::hal::SimI2CData = sid;
-}
+void InitializeI2CData() {}
 }  // namespace hal::init
 
-I2CData* hal::SimI2CData;
+SimContextSlot<I2CData> hal::SimI2CData{kI2CPorts};
 
 void I2CData::ResetData() {
   initialized.Reset(false);
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializePWMData() {
-  static PWMData spd[kNumPWMChannels];
-  ::hal::SimPWMData = spd;
-}
+void InitializePWMData() {}
 }  // namespace hal::init
 
-PWMData* hal::SimPWMData;
+SimContextSlot<PWMData> hal::SimPWMData{kNumPWMChannels};
 void PWMData::ResetData() {
   initialized.Reset(false);
   pulseMicrosecond.Reset(0);
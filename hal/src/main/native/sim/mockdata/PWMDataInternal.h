@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/PWMData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -28,5 +29,5 @@ class PWMData {
 
   virtual void ResetData();
 };
-extern PWMData* SimPWMData;
+extern SimContextSlot<PWMData> SimPWMData;
 }  // namespace hal
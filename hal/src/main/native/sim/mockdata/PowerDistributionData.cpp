@@ -8,13 +8,11 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializePowerDistributionData() {
-  static PowerDistributionData spd[kNumPDSimModules];
-  ::hal::SimPowerDistributionData = spd;
-}
+void InitializePowerDistributionData() {}
 }  // namespace hal::init
 
-PowerDistributionData* hal::SimPowerDistributionData;
+SimContextSlot<PowerDistributionData> hal::SimPowerDistributionData{
+    kNumPDSimModules};
 void PowerDistributionData::ResetData() {
   initialized.Reset(false);
   temperature.Reset(0.0);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "../PortsInternal.h"
 #include "hal/simulation/PowerDistributionData.h"
 #include "hal/simulation/SimDataValue.h"
@@ -30,5 +31,5 @@ class PowerDistributionData {
 
   virtual void ResetData();
 };
-extern PowerDistributionData* SimPowerDistributionData;
+extern SimContextSlot<PowerDistributionData> SimPowerDistributionData;
 }  // namespace hal
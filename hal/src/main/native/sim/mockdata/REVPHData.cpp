@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeREVPHData() {
-  static REVPHData spd[kNumREVPHModules];
-  ::hal::SimREVPHData = spd;
-}
+void InitializeREVPHData() {}
 }  // namespace hal::init
 
-REVPHData* hal::SimREVPHData;
+SimContextSlot<REVPHData> hal::SimREVPHData{kNumREVPHModules};
 void REVPHData::ResetData() {
   for (int i = 0; i < kNumREVPHChannels; i++) {
     solenoidOutput[i].Reset(false);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "../PortsInternal.h"
 #include "hal/simulation/REVPHData.h"
 #include "hal/simulation/SimDataValue.h"
@@ -46,5 +47,5 @@ class REVPHData {
 
   virtual void ResetData();
 };
-extern REVPHData* SimREVPHData;
+extern SimContextSlot<REVPHData> SimREVPHData;
 }  // namespace hal
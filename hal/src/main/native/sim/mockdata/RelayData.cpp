@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeRelayData() {
-  static RelayData srd[kNumRelayHeaders];
-  ::hal::SimRelayData = srd;
-}
+void InitializeRelayData() {}
 }  // namespace hal::init
 
-RelayData* hal::SimRelayData;
+SimContextSlot<RelayData> hal::SimRelayData{kNumRelayHeaders};
 void RelayData::ResetData() {
   initializedForward.Reset(false);
   initializedReverse.Reset(false);
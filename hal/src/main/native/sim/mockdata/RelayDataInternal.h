@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/RelayData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -24,5 +25,5 @@ class RelayData {
 
   virtual void ResetData();
 };
-extern RelayData* SimRelayData;
+extern SimContextSlot<RelayData> SimRelayData;
 }  // namespace hal
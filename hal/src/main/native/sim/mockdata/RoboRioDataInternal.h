@@ -9,6 +9,7 @@
 
 #include <wpi/spinlock.h>
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/RoboRioData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -96,5 +97,5 @@ class RoboRioData {
   SimCallbackRegistry<HAL_RoboRioStringCallback, GetCommentsName>
       m_commentsCallbacks;
 };
-extern RoboRioData* SimRoboRioData;
+extern SimContextSlot<RoboRioData> SimRoboRioData;
 }  // namespace hal
@@ -8,13 +8,11 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeSPIAccelerometerData() {
-  static SPIAccelerometerData ssad[kSPIAccelerometers];
-  ::hal::SimSPIAccelerometerData = ssad;
-}
+void InitializeSPIAccelerometerData() {}
 }  // namespace hal::init
 
-SPIAccelerometerData* hal::SimSPIAccelerometerData;
+SimContextSlot<SPIAccelerometerData> hal::SimSPIAccelerometerData{
+    kSPIAccelerometers};
 void SPIAccelerometerData::ResetData() {
   active.Reset(false);
   range.Reset(0);
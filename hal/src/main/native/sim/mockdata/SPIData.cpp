@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeSPIData() {
-  static SPIData ssd[kSPIPorts];
-  ::hal::SimSPIData = ssd;
-}
+void InitializeSPIData() {}
 }  // namespace hal::init
 
-SPIData* hal::SimSPIData;
+SimContextSlot<SPIData> hal::SimSPIData{kSPIPorts};
 void SPIData::ResetData() {
   initialized.Reset(false);
   read.Reset();
@@ -15,13 +15,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeSimDeviceData() {
-  static SimDeviceData sdd;
-  ::hal::SimSimDeviceData = &sdd;
-}
+void InitializeSimDeviceData() {}
 }  // namespace hal::init
 
-SimDeviceData* hal::SimSimDeviceData;
+SimContextSlot<SimDeviceData> hal::SimSimDeviceData;
 
 SimDeviceData::Device* SimDeviceData::LookupDevice(HAL_SimDeviceHandle handle) {
   if (handle <= 0) {
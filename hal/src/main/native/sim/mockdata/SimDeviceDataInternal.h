@@ -16,6 +16,7 @@
 #include <wpi/UidVector.h>
 #include <wpi/spinlock.h>
 
+#include "../SimContextInternal.h"
 #include "hal/Value.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 #include "hal/simulation/SimDeviceData.h"
@@ -253,5 +254,5 @@ class SimDeviceData {
 
   void ResetData();
 };
-extern SimDeviceData* SimSimDeviceData;
+extern SimContextSlot<SimDeviceData> SimSimDeviceData;
 }  // namespace hal
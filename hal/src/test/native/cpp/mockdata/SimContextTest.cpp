@@ -0,0 +1,175 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "hal/HAL.h"
+#include "hal/PWM.h"
+#include "hal/handles/HandlesInternal.h"
+#include "hal/simulation/MockHooks.h"
+#include "hal/simulation/PWMData.h"
+#include "hal/simulation/SimContext.h"
+
+namespace hal {
+
+TEST(SimContextTest, Default) {
+  EXPECT_EQ(0, HALSIM_GetThreadSimContext());
+  std::thread{[] { EXPECT_EQ(0, HALSIM_GetThreadSimContext()); }}.join();
+
+  // Invalid contexts are ignored
+  HALSIM_SetThreadSimContext(12345);
+  EXPECT_EQ(0, HALSIM_GetThreadSimContext());
+}
+
+TEST(SimContextTest, Isolated) {
+  const int kChannel = 13;
+  int32_t context = HALSIM_CreateSimContext();
+  ASSERT_NE(0, context);
+
+  int32_t status = 0;
+  HAL_DigitalHandle handle =
+      HAL_InitializePWMPort(HAL_GetPort(kChannel), nullptr, &status);
+  ASSERT_EQ(0, status);
+  HAL_SetPWMPulseTimeMicroseconds(handle, 1500, &status);
+
+  // The channel is free in the new context, and the time starts paused at 0
+  std::thread{[&] {
+    HALSIM_SetThreadSimContext(context);
+    EXPECT_EQ(context, HALSIM_GetThreadSimContext());
+    EXPECT_FALSE(HALSIM_GetPWMInitialized(kChannel));
+    int32_t otherStatus = 0;
+    EXPECT_TRUE(HALSIM_IsTimingPaused());
+    EXPECT_EQ(0u, HAL_GetFPGATime(&otherStatus));
+
+    HAL_DigitalHandle otherHandle =
+        HAL_InitializePWMPort(HAL_GetPort(kChannel), nullptr, &otherStatus);
+    EXPECT_EQ(0, otherStatus);
+    HAL_SetPWMPulseTimeMicroseconds(otherHandle, 1000, &otherStatus);
+    EXPECT_EQ(1000, HALSIM_GetPWMPulseMicrosecond(kChannel));
+
+    HALSIM_StepTiming(1000);
+    EXPECT_EQ(1000u, HAL_GetFPGATime(&otherStatus));
+    HAL_FreePWMPort(otherHandle);
+  }}.join();
+
+  EXPECT_EQ(1500, HALSIM_GetPWMPulseMicrosecond(kChannel));
+
+  // The calling thread can use the context too
+  HALSIM_SetThreadSimContext(context);
+  EXPECT_EQ(1000u, HAL_GetFPGATime(&status));
+  HALSIM_SetThreadSimContext(0);
+  EXPECT_EQ(1500, HALSIM_GetPWMPulseMicrosecond(kChannel));
+
+  EXPECT_TRUE(HALSIM_DestroySimContext(context));
+  HAL_FreePWMPort(handle);
+}
+
+TEST(SimContextTest, Destroy) {
+  int32_t context = HALSIM_CreateSimContext();
+  HALSIM_SetThreadSimContext(context);
+  int32_t status = 0;
+  HAL_InitializePWMPort(HAL_GetPort(2), nullptr, &status);
+  EXPECT_EQ(0, status);
+
+  // Destroying the calling thread's context sets it back to the default
+  EXPECT_TRUE(HALSIM_DestroySimContext(context));
+  EXPECT_EQ(0, HALSIM_GetThreadSimContext());
+  HALSIM_SetThreadSimContext(context);
+  EXPECT_EQ(0, HALSIM_GetThreadSimContext());
+  EXPECT_FALSE(HALSIM_GetPWMInitialized(2));
+  EXPECT_FALSE(HALSIM_DestroySimContext(context));
+}
+
+TEST(SimContextTest, ResetHandles) {
+  int32_t status = 0;
+  HAL_DigitalHandle handle =
+      HAL_InitializePWMPort(HAL_GetPort(14), nullptr, &status);
+  ASSERT_EQ(0, status);
+
+  int32_t context = HALSIM_CreateSimContext();
+  std::thread{[&] {
+    HALSIM_SetThreadSimContext(context);
+    int32_t otherStatus = 0;
+    HAL_DigitalHandle otherHandle =
+        HAL_InitializePWMPort(HAL_GetPort(14), nullptr, &otherStatus);
+    ASSERT_EQ(0, otherStatus);
+
+    // Only the handles of the thread's context are reset
+    HandleBase::ResetGlobalHandles();
+    HAL_SetPWMPulseTimeMicroseconds(otherHandle, 1000, &otherStatus);
+    EXPECT_EQ(HAL_HANDLE_ERROR, otherStatus);
+  }}.join();
+
+  HAL_SetPWMPulseTimeMicroseconds(handle, 1500, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_TRUE(HALSIM_DestroySimContext(context));
+  HAL_FreePWMPort(handle);
+}
+
+TEST(SimContextTest, HandleFromOtherContext) {
+  int32_t status = 0;
+  HAL_DigitalHandle handle =
+      HAL_InitializePWMPort(HAL_GetPort(15), nullptr, &status);
+  ASSERT_EQ(0, status);
+
+  int32_t context = HALSIM_CreateSimContext();
+  HAL_DigitalHandle otherHandle = HAL_kInvalidHandle;
+  std::thread{[&] {
+    HALSIM_SetThreadSimContext(context);
+    int32_t otherStatus = 0;
+    otherHandle =
+        HAL_InitializePWMPort(HAL_GetPort(15), nullptr, &otherStatus);
+    EXPECT_EQ(0, otherStatus);
+  }}.join();
+
+  // The same channel in another context gets a different handle, which this
+  // context rejects
+  EXPECT_NE(handle, otherHandle);
+  HAL_SetPWMPulseTimeMicroseconds(otherHandle, 1000, &status);
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+
+  EXPECT_TRUE(HALSIM_DestroySimContext(context));
+  HAL_FreePWMPort(handle);
+}
+
+TEST(SimContextTest, DestroyWithBoundThread) {
+  int32_t context = HALSIM_CreateSimContext();
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool bound = false;
+  bool done = false;
+  std::thread thread{[&] {
+    HALSIM_SetThreadSimContext(context);
+    std::unique_lock lock{mutex};
+    bound = true;
+    cond.notify_all();
+    cond.wait(lock, [&] { return done; });
+  }};
+  {
+    std::unique_lock lock{mutex};
+    cond.wait(lock, [&] { return bound; });
+  }
+
+  // Refused while the other thread uses the context
+  EXPECT_FALSE(HALSIM_DestroySimContext(context));
+  HALSIM_SetThreadSimContext(context);
+  EXPECT_FALSE(HALSIM_DestroySimContext(context));
+  EXPECT_EQ(context, HALSIM_GetThreadSimContext());
+
+  // The thread is unset from the context when it exits
+  {
+    std::scoped_lock lock{mutex};
+    done = true;
+  }
+  cond.notify_all();
+  thread.join();
+  EXPECT_TRUE(HALSIM_DestroySimContext(context));
+  EXPECT_EQ(0, HALSIM_GetThreadSimContext());
+}
+
+}  // namespace hal
@@ -315,6 +315,14 @@ class LocalStorage final : public net::ILocalStorage {
     return m_impl.SetEntryValue(pubentryHandle, value);
   }
 
+  void SetEntryValues(std::span<const NT_Handle> pubentryHandles,
+                      std::span<const Value> values) {
+    std::scoped_lock lock{m_mutex};
+    for (size_t i = 0; i < pubentryHandles.size(); ++i) {
+      m_impl.SetEntryValue(pubentryHandles[i], values[i]);
+    }
+  }
+
   bool SetDefaultEntryValue(NT_Handle pubsubentryHandle, const Value& value) {
     std::scoped_lock lock{m_mutex};
     return m_impl.SetDefaultEntryValue(pubsubentryHandle, value);
@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstdio>
@@ -132,6 +133,29 @@ bool SetEntryValue(NT_Entry entry, const Value& value) {
   }
 }
 
+void SetEntryValues(std::span<const NT_Handle> entries,
+                    std::span<const Value> values) {
+  size_t count = (std::min)(entries.size(), values.size());
+  entries = entries.first(count);
+  values = values.first(count);
+
+  // Set each run of handles from the same instance together
+  while (!entries.empty()) {
+    int inst = Handle{entries.front()}.GetInst();
+    size_t runLength = 1;
+    while (runLength < entries.size() &&
+           Handle{entries[runLength]}.GetInst() == inst) {
+      ++runLength;
+    }
+    if (auto ii = InstanceImpl::GetHandle(entries.front())) {
+      ii->localStorage.SetEntryValues(entries.first(runLength),
+                                      values.first(runLength));
+    }
+    entries = entries.subspan(runLength);
+    values = values.subspan(runLength);
+  }
+}
+
 void SetEntryFlags(NT_Entry entry, unsigned int flags) {
   if (auto ii = InstanceImpl::GetHandle(entry)) {
     ii->localStorage.SetEntryFlags(entry, flags);
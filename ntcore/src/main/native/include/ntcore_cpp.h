@@ -510,6 +510,20 @@ bool SetDefaultEntryValue(NT_Entry entry, const Value& value);
  */
 bool SetEntryValue(NT_Entry entry, const Value& value);
 
+/**
+ * Set Entry Values.
+ *
+ * Sets the values of multiple entries or publishers at once. This is
+ * equivalent to calling SetEntryValue() for each of them, but only takes the
+ * instance's lock once for all of the handles from the same instance, so it's
+ * much cheaper when setting many values every loop.
+ *
+ * @param entries   entry or publisher handles
+ * @param values    new values, one for each handle
+ */
+void SetEntryValues(std::span<const NT_Handle> entries,
+                    std::span<const Value> values);
+
 /**
  * Set Entry Flags.
  *
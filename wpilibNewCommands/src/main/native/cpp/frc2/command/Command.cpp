@@ -22,6 +22,7 @@ Command::Command() {
 
 Command::~Command() {
   CommandScheduler::GetInstance().Cancel(this);
+  CommandScheduler::GetInstance().RemoveCommandState(this);
 }
 
 Command& Command::operator=(const Command& rhs) {
@@ -51,6 +52,7 @@ void Command::AddRequirements(Subsystem* requirement) {
 
 void Command::SetName(std::string_view name) {
   wpi::SendableRegistry::SetName(this, name);
+  ++m_nameVersion;
 }
 
 std::string Command::GetName() const {
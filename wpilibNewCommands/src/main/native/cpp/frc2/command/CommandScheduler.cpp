@@ -4,22 +4,30 @@
 
 #include "frc2/command/CommandScheduler.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
 #include <frc/RobotBase.h>
 #include <frc/RobotState.h>
 #include <frc/TimedRobot.h>
+#include <frc/TimingHistogram.h>
 #include <frc/livewindow/LiveWindow.h>
 #include <hal/FRCUsageReporting.h>
 #include <hal/HALBase.h>
+#include <hal/cpp/fpga_clock.h>
 #include <networktables/IntegerArrayTopic.h>
+#include <networktables/NetworkTableInstance.h>
 #include <networktables/StringArrayTopic.h>
+#include <wpi/DataLog.h>
 #include <wpi/DenseMap.h>
 #include <wpi/SmallVector.h>
+#include <wpi/StringMap.h>
 #include <wpi/sendable/SendableBuilder.h>
 #include <wpi/sendable/SendableRegistry.h>
 
@@ -28,10 +36,98 @@
 
 using namespace frc2;
 
+namespace {
+
+// Names and timing of a command, so scheduling and running it doesn't need to
+// look up or concatenate any strings. Kept until the command is destroyed.
+struct CommandState {
+  // The command's name version the names were made from
+  uint32_t nameVersion = 0;
+  std::string name;
+  std::string initializeEpoch;
+  std::string executeEpoch;
+  std::string endEpoch;
+  std::string interruptEpoch;
+  frc::TimingHistogram* timing = nullptr;
+  bool scheduled = false;
+};
+
+// Names and timing of a registered subsystem
+struct SubsystemState {
+  std::string name;
+  std::string periodicEpoch;
+  frc::TimingHistogram* timing = nullptr;
+};
+
+}  // namespace
+
 class CommandScheduler::Impl {
  public:
-  // A set of the currently-running commands.
-  wpi::SmallSet<Command*, 12> scheduledCommands;
+  bool IsScheduled(const Command* command) const {
+    auto state = commandStates.find(const_cast<Command*>(command));
+    return state != commandStates.end() && state->second.scheduled;
+  }
+
+  // Gets the state of a command, making its names the first time it's seen
+  // and after it's renamed
+  CommandState& GetCommandState(Command* command) {
+    auto [it, inserted] = commandStates.try_emplace(command);
+    auto& state = it->second;
+    if (inserted || state.nameVersion != command->m_nameVersion) {
+      state.nameVersion = command->m_nameVersion;
+      state.name = command->GetName();
+      state.initializeEpoch = state.name + ".Initialize()";
+      state.executeEpoch = state.name + ".Execute()";
+      state.endEpoch = state.name + ".End(false)";
+      state.interruptEpoch = state.name + ".End(true)";
+      state.timing = GetTiming("Commands", state.name);
+    }
+    return state;
+  }
+
+  void AddScheduled(Command* command) {
+    scheduledCommands.emplace_back(command);
+    GetCommandState(command).scheduled = true;
+  }
+
+  void RemoveScheduled(Command* command) {
+    auto state = commandStates.find(command);
+    if (state != commandStates.end() && state->second.scheduled) {
+      state->second.scheduled = false;
+      scheduledCommands.erase(std::find(scheduledCommands.begin(),
+                                        scheduledCommands.end(), command));
+    }
+  }
+
+  SubsystemState& GetSubsystemState(Subsystem* subsystem) {
+    auto [it, inserted] = subsystemStates.try_emplace(subsystem);
+    if (inserted) {
+      it->second.name = subsystem->GetName();
+      it->second.periodicEpoch = it->second.name + ".Periodic()";
+      it->second.timing = GetTiming("Subsystems", it->second.name);
+    }
+    return it->second;
+  }
+
+  frc::TimingHistogram* GetTiming(std::string_view table,
+                                  std::string_view name) {
+    if (!timingEnabled) {
+      return nullptr;
+    }
+    auto topic = fmt::format("/CommandScheduler/Timing/{}/{}", table, name);
+    return &timings.try_emplace(topic, topic).first->second;
+  }
+
+  // The currently-running commands, in the order they were scheduled.
+  wpi::SmallVector<Command*, 12> scheduledCommands;
+
+  // A map from commands that have been scheduled to their names, timing, and
+  // whether they're currently running.
+  wpi::DenseMap<Command*, CommandState> commandStates;
+
+  // Copy of scheduledCommands iterated by Run() to avoid iterator
+  // invalidation. Kept between runs to reuse its storage.
+  wpi::SmallVector<Command*, 12> runCommands;
 
   // A map from required subsystems to their requiring commands.  Also used as a
   // set of the currently-required subsystems.
@@ -41,6 +137,10 @@ class CommandScheduler::Impl {
   // commands.  Also used as a list of currently-registered subsystems.
   wpi::DenseMap<Subsystem*, std::unique_ptr<Command>> subsystems;
 
+  // A map from registered subsystems to their names and timing, filled in when
+  // they first run.
+  wpi::DenseMap<Subsystem*, SubsystemState> subsystemStates;
+
   frc::EventLoop defaultButtonLoop;
   // The set of currently-registered buttons that will be polled every
   // iteration.
@@ -59,6 +159,15 @@ class CommandScheduler::Impl {
   // via Schedule(CommandPtr&&). These are erased (destroyed) at the very end of
   // the loop cycle when the command lifecycle is complete.
   wpi::DenseMap<Command*, CommandPtr> ownedCommands;
+
+  // Execution time histograms, keyed by topic name.
+  bool timingEnabled{false};
+  std::chrono::duration<double> timingPublishPeriod{0};
+  wpi::log::DataLog* timingLog{nullptr};
+  nt::NetworkTableInstance timingInst;
+  hal::fpga_clock::time_point lastTimingPublish{hal::fpga_clock::epoch()};
+  wpi::StringMap<frc::TimingHistogram> timings;
+  nt::IntegerArrayPublisher timingBoundsPublisher;
 };
 
 template <typename TMap, typename TKey>
@@ -112,7 +221,7 @@ frc::EventLoop* CommandScheduler::GetDefaultButtonLoop() const {
 void CommandScheduler::Schedule(Command* command) {
   RequireUngrouped(command);
 
-  if (m_impl->disabled || m_impl->scheduledCommands.contains(command) ||
+  if (m_impl->disabled || m_impl->IsScheduled(command) ||
       (frc::RobotState::IsDisabled() && !command->RunsWhenDisabled())) {
     return;
   }
@@ -138,7 +247,7 @@ void CommandScheduler::Schedule(Command* command) {
         Cancel(cmdToCancel, std::make_optional(command));
       }
     }
-    m_impl->scheduledCommands.insert(command);
+    m_impl->AddScheduled(command);
     for (auto&& requirement : requirements) {
       m_impl->requirements[requirement] = command;
     }
@@ -146,7 +255,7 @@ void CommandScheduler::Schedule(Command* command) {
     for (auto&& action : m_impl->initActions) {
       action(*command);
     }
-    m_watchdog.AddEpoch(command->GetName() + ".Initialize()");
+    m_watchdog.AddEpoch(m_impl->GetCommandState(command).initializeEpoch);
   }
 }
 
@@ -181,11 +290,16 @@ void CommandScheduler::Run() {
 
   // Run the periodic method of all registered subsystems.
   for (auto&& subsystem : m_impl->subsystems) {
+    auto& state = m_impl->GetSubsystemState(subsystem.getFirst());
+    auto start = hal::fpga_clock::now();
     subsystem.getFirst()->Periodic();
     if constexpr (frc::RobotBase::IsSimulation()) {
       subsystem.getFirst()->SimulationPeriodic();
     }
-    m_watchdog.AddEpoch(subsystem.getFirst()->GetName() + ".Periodic()");
+    if (state.timing) {
+      state.timing->Record(hal::fpga_clock::now() - start);
+    }
+    m_watchdog.AddEpoch(state.periodicEpoch);
   }
 
   // Cache the active instance to avoid concurrency problems if SetActiveLoop()
@@ -196,8 +310,11 @@ void CommandScheduler::Run() {
   m_watchdog.AddEpoch("buttons.Run()");
 
   bool isDisabled = frc::RobotState::IsDisabled();
-  // create a new set to avoid iterator invalidation.
-  for (Command* command : wpi::SmallSet(m_impl->scheduledCommands)) {
+  // copy the commands to avoid iterator invalidation.
+  auto& runCommands = m_impl->runCommands;
+  runCommands.assign(m_impl->scheduledCommands.begin(),
+                     m_impl->scheduledCommands.end());
+  for (Command* command : runCommands) {
     if (!IsScheduled(command)) {
       continue;  // skip as the normal scheduledCommands was modified
     }
@@ -207,14 +324,22 @@ void CommandScheduler::Run() {
       continue;
     }
 
+    auto start = hal::fpga_clock::now();
     command->Execute();
     for (auto&& action : m_impl->executeActions) {
       action(*command);
     }
-    m_watchdog.AddEpoch(command->GetName() + ".Execute()");
+
+    // Execute() may have scheduled other commands, so the state is looked up
+    // afterwards
+    auto& state = m_impl->GetCommandState(command);
+    if (state.timing) {
+      state.timing->Record(hal::fpga_clock::now() - start);
+    }
+    m_watchdog.AddEpoch(state.executeEpoch);
 
     if (command->IsFinished()) {
-      m_impl->scheduledCommands.erase(command);
+      m_impl->RemoveScheduled(command);
       command->End(false);
       for (auto&& action : m_impl->finishActions) {
         action(*command);
@@ -224,7 +349,7 @@ void CommandScheduler::Run() {
         m_impl->requirements.erase(requirement);
       }
 
-      m_watchdog.AddEpoch(command->GetName() + ".End(false)");
+      m_watchdog.AddEpoch(m_impl->GetCommandState(command).endEpoch);
       // remove owned commands after everything else is done
       m_impl->ownedCommands.erase(command);
     }
@@ -238,6 +363,10 @@ void CommandScheduler::Run() {
     }
   }
 
+  if (m_impl->timingEnabled) {
+    PublishTimingHistograms();
+  }
+
   m_watchdog.Disable();
   if (m_watchdog.IsExpired()) {
     m_watchdog.PrintEpochs();
@@ -258,6 +387,7 @@ void CommandScheduler::UnregisterSubsystem(Subsystem* subsystem) {
   if (s != m_impl->subsystems.end()) {
     m_impl->subsystems.erase(s);
   }
+  m_impl->subsystemStates.erase(subsystem);
 }
 
 void CommandScheduler::RegisterSubsystem(
@@ -290,6 +420,7 @@ void CommandScheduler::UnregisterSubsystem(
 
 void CommandScheduler::UnregisterAllSubsystems() {
   m_impl->subsystems.clear();
+  m_impl->subsystemStates.clear();
 }
 
 void CommandScheduler::SetDefaultCommand(Subsystem* subsystem,
@@ -324,7 +455,7 @@ void CommandScheduler::Cancel(Command* command,
   if (!IsScheduled(command)) {
     return;
   }
-  m_impl->scheduledCommands.erase(command);
+  m_impl->RemoveScheduled(command);
   command->End(true);
   for (auto&& action : m_impl->interruptActions) {
     action(*command, interruptor);
@@ -334,7 +465,13 @@ void CommandScheduler::Cancel(Command* command,
       m_impl->requirements.erase(requirement.first);
     }
   }
-  m_watchdog.AddEpoch(command->GetName() + ".End(true)");
+  m_watchdog.AddEpoch(m_impl->GetCommandState(command).interruptEpoch);
+}
+
+void CommandScheduler::RemoveCommandState(Command* command) {
+  if (m_impl) {
+    m_impl->commandStates.erase(command);
+  }
 }
 
 void CommandScheduler::Cancel(Command* command) {
@@ -386,11 +523,11 @@ bool CommandScheduler::IsScheduled(
 }
 
 bool CommandScheduler::IsScheduled(const Command* command) const {
-  return m_impl->scheduledCommands.contains(command);
+  return m_impl->IsScheduled(command);
 }
 
 bool CommandScheduler::IsScheduled(const CommandPtr& command) const {
-  return m_impl->scheduledCommands.contains(command.get());
+  return m_impl->IsScheduled(command.get());
 }
 
 Command* CommandScheduler::Requiring(const Subsystem* subsystem) const {
@@ -414,6 +551,76 @@ void CommandScheduler::PrintWatchdogEpochs() {
   m_watchdog.PrintEpochs();
 }
 
+void CommandScheduler::EnableTimingHistograms(units::second_t publishPeriod,
+                                              wpi::log::DataLog* log) {
+  if (!log) {
+    EnableTimingHistograms(publishPeriod,
+                           nt::NetworkTableInstance::GetDefault());
+    return;
+  }
+
+  DisableTimingHistograms();
+  m_impl->timingLog = log;
+  wpi::log::IntegerArrayLogEntry{*log, "CommandScheduler/Timing/BucketBounds"}
+      .Append(frc::TimingHistogram::kBucketBounds);
+  StartTimingHistograms(publishPeriod);
+}
+
+void CommandScheduler::EnableTimingHistograms(units::second_t publishPeriod,
+                                              nt::NetworkTableInstance inst) {
+  DisableTimingHistograms();
+  m_impl->timingInst = inst;
+  m_impl->timingBoundsPublisher =
+      inst.GetIntegerArrayTopic("/CommandScheduler/Timing/BucketBounds")
+          .Publish();
+  m_impl->timingBoundsPublisher.Set(frc::TimingHistogram::kBucketBounds);
+  StartTimingHistograms(publishPeriod);
+}
+
+void CommandScheduler::StartTimingHistograms(units::second_t publishPeriod) {
+  m_impl->timingEnabled = true;
+  m_impl->timingPublishPeriod =
+      std::chrono::duration<double>{publishPeriod.value()};
+  m_impl->lastTimingPublish = hal::fpga_clock::epoch();
+
+  for (auto&& state : m_impl->commandStates) {
+    state.second.timing = m_impl->GetTiming("Commands", state.second.name);
+  }
+  for (auto&& state : m_impl->subsystemStates) {
+    state.second.timing = m_impl->GetTiming("Subsystems", state.second.name);
+  }
+}
+
+void CommandScheduler::DisableTimingHistograms() {
+  m_impl->timingEnabled = false;
+  for (auto&& state : m_impl->commandStates) {
+    state.second.timing = nullptr;
+  }
+  for (auto&& state : m_impl->subsystemStates) {
+    state.second.timing = nullptr;
+  }
+  m_impl->timings.clear();
+  m_impl->timingLog = nullptr;
+  m_impl->timingInst = {};
+  m_impl->timingBoundsPublisher = {};
+}
+
+void CommandScheduler::PublishTimingHistograms() {
+  auto now = hal::fpga_clock::now();
+  if (now - m_impl->lastTimingPublish < m_impl->timingPublishPeriod) {
+    return;
+  }
+  m_impl->lastTimingPublish = now;
+
+  for (auto&& entry : m_impl->timings) {
+    if (m_impl->timingLog) {
+      entry.second.Publish(*m_impl->timingLog);
+    } else {
+      entry.second.Publish(m_impl->timingInst);
+    }
+  }
+}
+
 void CommandScheduler::OnCommandInitialize(Action action) {
   m_impl->initActions.emplace_back(std::move(action));
 }
@@ -515,8 +722,7 @@ void CommandScheduler::InitSendable(wpi::SendableBuilder& builder) {
         for (auto cancel : toCancel) {
           uintptr_t ptrTmp = static_cast<uintptr_t>(cancel);
           Command* command = reinterpret_cast<Command*>(ptrTmp);
-          if (m_impl->scheduledCommands.find(command) !=
-              m_impl->scheduledCommands.end()) {
+          if (m_impl->IsScheduled(command)) {
             Cancel(command);
           }
         }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -484,6 +485,12 @@ class Command : public wpi::Sendable, public wpi::SendableHelper<Command> {
   wpi::SmallSet<Subsystem*, 4> m_requirements;
 
   std::optional<std::string> m_previousComposition;
+
+  /// Incremented by SetName(), so the scheduler knows to update the names it
+  /// cached for this command.
+  uint32_t m_nameVersion = 0;
+
+  friend class CommandScheduler;
 };
 
 /**
@@ -20,6 +20,14 @@
 #include <wpi/sendable/Sendable.h>
 #include <wpi/sendable/SendableHelper.h>
 
+namespace nt {
+class NetworkTableInstance;
+}  // namespace nt
+
+namespace wpi::log {
+class DataLog;
+}  // namespace wpi::log
+
 namespace frc2 {
 class Command;
 class CommandPtr;
@@ -367,6 +375,46 @@ class CommandScheduler final : public wpi::Sendable,
    */
   void PrintWatchdogEpochs();
 
+  /**
+   * Enables histograms of the execution time of each command's Execute() and
+   * each subsystem's Periodic(), keyed by name.
+   *
+   * Each histogram is an integer array of counts, one per bucket of
+   * frc::TimingHistogram. The histograms are published to the
+   * "/CommandScheduler/Timing/Commands" and
+   * "/CommandScheduler/Timing/Subsystems" NetworkTables tables, or recorded to
+   * a data log under the same names, and the bucket bounds are published as
+   * "/CommandScheduler/Timing/BucketBounds". Only histograms that changed are
+   * published.
+   *
+   * Recording a timing doesn't allocate memory. A command's name is read the
+   * first time it's scheduled and again after it's renamed, and a subsystem's
+   * name when it first runs.
+   *
+   * @param publishPeriod How often to publish the histograms. If zero, they're
+   *                      published every time Run() is called.
+   * @param log The data log to record the histograms to, or nullptr to publish
+   *            them to NetworkTables.
+   */
+  void EnableTimingHistograms(units::second_t publishPeriod = 1_s,
+                              wpi::log::DataLog* log = nullptr);
+
+  /**
+   * Enables the execution time histograms, publishing them to the given
+   * NetworkTables instance instead of the default one.
+   *
+   * @param publishPeriod How often to publish the histograms. If zero, they're
+   *                      published every time Run() is called.
+   * @param inst The NetworkTables instance to publish the histograms to.
+   */
+  void EnableTimingHistograms(units::second_t publishPeriod,
+                              nt::NetworkTableInstance inst);
+
+  /**
+   * Disables and clears the execution time histograms.
+   */
+  void DisableTimingHistograms();
+
   /**
    * Adds an action to perform on the initialization of any command by the
    * scheduler.
@@ -478,11 +526,19 @@ class CommandScheduler final : public wpi::Sendable,
 
   void Cancel(Command* command, std::optional<Command*> interruptor);
 
+  // Forgets the cached names of a command that is being destroyed
+  void RemoveCommandState(Command* command);
+
+  void StartTimingHistograms(units::second_t publishPeriod);
+
+  void PublishTimingHistograms();
+
   class Impl;
   std::unique_ptr<Impl> m_impl;
 
   frc::Watchdog m_watchdog;
 
+  friend class Command;
   friend class CommandTestBase;
 
   template <typename T>
@@ -4,8 +4,12 @@
 
 #include <frc2/command/Commands.h>
 
+#include <numeric>
 #include <utility>
 
+#include <networktables/IntegerArrayTopic.h>
+#include <networktables/NetworkTableInstance.h>
+
 #include "CommandTestBase.h"
 #include "frc2/command/InstantCommand.h"
 #include "frc2/command/RunCommand.h"
@@ -224,3 +228,68 @@ TEST_F(SchedulerTest, ScheduleCommandPtr) {
   EXPECT_EQ(destructionCounter, 1)
       << "Scheduler should delete command after command completes";
 }
+
+TEST_F(SchedulerTest, TimingHistograms) {
+  CommandScheduler scheduler = GetScheduler();
+
+  TestSubsystem subsystem;
+  subsystem.SetName("TimedSubsystem");
+  scheduler.RegisterSubsystem(&subsystem);
+
+  auto inst = nt::NetworkTableInstance::Create();
+  inst.StartLocal();
+
+  auto command = cmd::Idle().WithName("TimedCommand");
+  scheduler.EnableTimingHistograms(0_s, inst);
+  scheduler.Schedule(command);
+  for (int i = 0; i < 3; ++i) {
+    scheduler.Run();
+  }
+
+  auto sum = [&](std::string_view name) {
+    auto counts = inst.GetIntegerArrayTopic(name).Subscribe({}).Get();
+    return std::accumulate(counts.begin(), counts.end(), int64_t{0});
+  };
+  EXPECT_EQ(12u,
+            inst.GetIntegerArrayTopic("/CommandScheduler/Timing/BucketBounds")
+                .Subscribe({})
+                .Get()
+                .size());
+  EXPECT_EQ(3, sum("/CommandScheduler/Timing/Commands/TimedCommand"));
+  EXPECT_EQ(3, sum("/CommandScheduler/Timing/Subsystems/TimedSubsystem"));
+
+  scheduler.DisableTimingHistograms();
+  nt::NetworkTableInstance::Destroy(inst);
+}
+
+TEST_F(SchedulerTest, TimingHistogramsRescheduleAndRename) {
+  CommandScheduler scheduler = GetScheduler();
+
+  auto inst = nt::NetworkTableInstance::Create();
+  inst.StartLocal();
+
+  auto command = cmd::Idle().WithName("RescheduledCommand");
+  scheduler.EnableTimingHistograms(0_s, inst);
+  auto sum = [&](std::string_view name) {
+    auto counts = inst.GetIntegerArrayTopic(name).Subscribe({}).Get();
+    return std::accumulate(counts.begin(), counts.end(), int64_t{0});
+  };
+
+  // Rescheduling records into the same histogram
+  for (int i = 0; i < 2; ++i) {
+    scheduler.Schedule(command);
+    scheduler.Run();
+    scheduler.Cancel(command);
+  }
+  EXPECT_EQ(2, sum("/CommandScheduler/Timing/Commands/RescheduledCommand"));
+
+  // Renaming the command moves it to a new histogram
+  command.get()->SetName("RenamedCommand");
+  scheduler.Schedule(command);
+  scheduler.Run();
+  EXPECT_EQ(2, sum("/CommandScheduler/Timing/Commands/RescheduledCommand"));
+  EXPECT_EQ(1, sum("/CommandScheduler/Timing/Commands/RenamedCommand"));
+
+  scheduler.DisableTimingHistograms();
+  nt::NetworkTableInstance::Destroy(inst);
+}
@@ -13,6 +13,8 @@
 
 #include "frc/DSControlWord.h"
 #include "frc/Errors.h"
+#include "frc/RobotController.h"
+#include "frc/TimingHistogram.h"
 #include "frc/livewindow/LiveWindow.h"
 #include "frc/shuffleboard/Shuffleboard.h"
 #include "frc/smartdashboard/SmartDashboard.h"
@@ -180,7 +182,11 @@ void IterativeRobotBase::LoopFunc() {
     m_lastMode = mode;
   }
 
-  // Call the appropriate function depending upon the current robot mode
+  // Call the appropriate function depending upon the current robot mode. If
+  // the histograms are enabled partway through the loop, periodicStart is 0
+  // and the samples up to that point are skipped.
+  uint64_t periodicStart =
+      m_periodicHistograms ? RobotController::GetFPGATime() : 0;
   if (mode == Mode::kDisabled) {
     HAL_ObserveUserProgramDisabled();
     DisabledPeriodic();
@@ -199,8 +205,23 @@ void IterativeRobotBase::LoopFunc() {
     m_watchdog.AddEpoch("TestPeriodic()");
   }
 
+  // The histograms are indexed the same way as the modes, with RobotPeriodic()
+  // in place of kNone
+  if (m_periodicHistograms) {
+    uint64_t now = RobotController::GetFPGATime();
+    if (mode != Mode::kNone && periodicStart != 0) {
+      m_periodicHistograms[static_cast<int>(mode)].Record(
+          std::chrono::microseconds{now - periodicStart});
+    }
+    periodicStart = now;
+  }
+
   RobotPeriodic();
   m_watchdog.AddEpoch("RobotPeriodic()");
+  if (m_periodicHistograms && periodicStart != 0) {
+    m_periodicHistograms[0].Record(std::chrono::microseconds{
+        RobotController::GetFPGATime() - periodicStart});
+  }
 
   SmartDashboard::UpdateValues();
   m_watchdog.AddEpoch("SmartDashboard::UpdateValues()");
@@ -229,6 +250,10 @@ void IterativeRobotBase::LoopFunc() {
   }
 }
 
+void IterativeRobotBase::SetPeriodicHistograms(TimingHistogram* histograms) {
+  m_periodicHistograms = histograms;
+}
+
 void IterativeRobotBase::PrintLoopOverrunMessage() {
   FRC_ReportError(err::Error, "Loop time of {:.6f}s overrun", m_period.value());
 }
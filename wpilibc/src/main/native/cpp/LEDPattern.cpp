@@ -6,8 +6,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <numbers>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -18,10 +18,67 @@
 
 using namespace frc;
 
+struct LEDPattern::Node {
+  enum Kind {
+    // A pattern created from an arbitrary function, which is called with the
+    // LED buffer
+    kOpaque,
+    // Computes the color of every LED at once
+    kKernel,
+    // Remaps the indices of the child pattern
+    kMap,
+    // Modifies the colors written by the child pattern
+    kTransform,
+    // Writes the second pattern's lit LEDs over the first pattern
+    kOverlay,
+    // Averages the second pattern's colors with the first pattern's
+    kBlend,
+    // Masks the first pattern's colors with the second pattern's
+    kMask,
+    // Plays the child pattern while the condition is true, and turns the LEDs
+    // off otherwise
+    kBlink
+  };
+
+  explicit Node(Kind kind) : kind{kind} {}
+
+  Kind kind;
+  std::function<void(LEDPattern::LEDReader, std::function<void(int, Color)>)>
+      impl;
+  std::function<void(std::span<Color>)> kernel;
+  std::function<size_t(size_t, size_t)> mapper;
+  // If set, the mapper offsets every index by this amount (wrapping around),
+  // so the compiled pattern only needs to compute it once per buffer
+  std::function<int64_t(size_t)> offset;
+  std::function<bool()> condition;
+  std::shared_ptr<const Node> first;
+  std::shared_ptr<const Node> second;
+};
+
 LEDPattern::LEDPattern(std::function<void(frc::LEDPattern::LEDReader,
                                           std::function<void(int, frc::Color)>)>
                            impl)
-    : m_impl(std::move(impl)) {}
+    : m_impl(std::move(impl)) {
+  auto node = std::make_shared<Node>(Node::kOpaque);
+  node->impl = m_impl;
+  m_node = std::move(node);
+}
+
+LEDPattern::LEDPattern(std::function<void(frc::LEDPattern::LEDReader,
+                                          std::function<void(int, frc::Color)>)>
+                           impl,
+                       std::shared_ptr<const Node> node)
+    : m_impl(std::move(impl)), m_node(std::move(node)) {}
+
+LEDPattern LEDPattern::FromKernel(
+    std::function<void(frc::LEDPattern::LEDReader,
+                       std::function<void(int, frc::Color)>)>
+        impl,
+    std::function<void(std::span<Color>)> kernel) {
+  auto node = std::make_shared<Node>(Node::kKernel);
+  node->kernel = std::move(kernel);
+  return LEDPattern{std::move(impl), std::move(node)};
+}
 
 void LEDPattern::ApplyTo(LEDPattern::LEDReader reader,
                          std::function<void(int, frc::Color)> writer) const {
@@ -38,15 +95,31 @@ void LEDPattern::ApplyTo(std::span<AddressableLED::LEDData> data) const {
   ApplyTo(data, [&](int index, Color color) { data[index].SetLED(color); });
 }
 
+CompiledLEDPattern LEDPattern::Compile() const {
+  return CompiledLEDPattern{*this};
+}
+
 LEDPattern LEDPattern::MapIndex(
     std::function<size_t(size_t, size_t)> indexMapper) {
-  return LEDPattern{[self = *this, indexMapper](auto data, auto writer) {
-    size_t bufLen = data.size();
-    self.ApplyTo(
-        LEDPattern::LEDReader{
-            [=](auto i) { return data[indexMapper(bufLen, i)]; }, bufLen},
-        [&](int i, Color color) { writer(indexMapper(bufLen, i), color); });
-  }};
+  return MapIndex(std::move(indexMapper), nullptr);
+}
+
+LEDPattern LEDPattern::MapIndex(
+    std::function<size_t(size_t, size_t)> indexMapper,
+    std::function<int64_t(size_t)> offset) {
+  auto node = std::make_shared<Node>(Node::kMap);
+  node->mapper = indexMapper;
+  node->offset = std::move(offset);
+  node->first = m_node;
+  return LEDPattern{
+      [self = *this, indexMapper](auto data, auto writer) {
+        size_t bufLen = data.size();
+        self.ApplyTo(
+            LEDPattern::LEDReader{
+                [=](auto i) { return data[indexMapper(bufLen, i)]; }, bufLen},
+            [&](int i, Color color) { writer(indexMapper(bufLen, i), color); });
+      },
+      std::move(node)};
 }
 
 LEDPattern LEDPattern::Reversed() {
@@ -54,10 +127,12 @@ LEDPattern LEDPattern::Reversed() {
 }
 
 LEDPattern LEDPattern::OffsetBy(int offset) {
-  return MapIndex([offset](size_t bufLen, size_t i) {
-    return frc::FloorMod(static_cast<int>(i) + offset,
-                         static_cast<int>(bufLen));
-  });
+  return MapIndex(
+      [offset](size_t bufLen, size_t i) {
+        return frc::FloorMod(static_cast<int>(i) + offset,
+                             static_cast<int>(bufLen));
+      },
+      [offset](size_t) { return offset; });
 }
 
 LEDPattern LEDPattern::ScrollAtRelativeSpeed(units::hertz_t velocity) {
@@ -65,18 +140,21 @@ LEDPattern LEDPattern::ScrollAtRelativeSpeed(units::hertz_t velocity) {
   // second, 0.5_hz = half cycle per second, 2_hz = two cycles per second)
   // Invert and multiply by 1,000,000 to get microseconds
   double periodMicros = 1e6 / velocity.value();
-
-  return MapIndex([=](size_t bufLen, size_t i) {
+  auto getOffset = [=](size_t bufLen) {
     auto now = wpi::Now();
 
     // index should move by (bufLen) / (period)
     double t =
         (now % static_cast<int64_t>(std::floor(periodMicros))) / periodMicros;
-    int offset = static_cast<int>(std::floor(t * bufLen));
-
-    return frc::FloorMod(static_cast<int>(i) + offset,
-                         static_cast<int>(bufLen));
-  });
+    return static_cast<int>(std::floor(t * bufLen));
+  };
+
+  return MapIndex(
+      [=](size_t bufLen, size_t i) {
+        return frc::FloorMod(static_cast<int>(i) + getOffset(bufLen),
+                             static_cast<int>(bufLen));
+      },
+      getOffset);
 }
 
 LEDPattern LEDPattern::ScrollAtAbsoluteSpeed(
@@ -86,31 +164,39 @@ LEDPattern LEDPattern::ScrollAtAbsoluteSpeed(
   auto microsPerLed =
       static_cast<int64_t>(std::floor((ledSpacing / velocity).value() * 1e6));
 
-  return MapIndex([=](size_t bufLen, size_t i) {
+  auto getOffset = [=](size_t) {
     auto now = wpi::Now();
 
     // every step in time that's a multiple of microsPerLED will increment
     // the offset by 1
     // cast unsigned int64 `now` to a signed int64 so we can get negative
     // offset values for negative velocities
-    auto offset = static_cast<int64_t>(now) / microsPerLed;
-
-    return frc::FloorMod(static_cast<int>(i) + offset,
-                         static_cast<int>(bufLen));
-  });
+    return static_cast<int64_t>(now) / microsPerLed;
+  };
+
+  return MapIndex(
+      [=](size_t bufLen, size_t i) {
+        return frc::FloorMod(static_cast<int>(i) + getOffset(bufLen),
+                             static_cast<int>(bufLen));
+      },
+      getOffset);
 }
 
 LEDPattern LEDPattern::Blink(units::second_t onTime, units::second_t offTime) {
   auto totalMicros = units::microsecond_t{onTime + offTime}.to<uint64_t>();
   auto onMicros = units::microsecond_t{onTime}.to<uint64_t>();
 
+  auto node = std::make_shared<Node>(Node::kBlink);
+  node->condition = [=] { return wpi::Now() % totalMicros < onMicros; };
+  node->first = m_node;
   return LEDPattern{[=, self = *this](auto data, auto writer) {
-    if (wpi::Now() % totalMicros < onMicros) {
-      self.ApplyTo(data, writer);
-    } else {
-      LEDPattern::Off().ApplyTo(data, writer);
-    }
-  }};
+                      if (wpi::Now() % totalMicros < onMicros) {
+                        self.ApplyTo(data, writer);
+                      } else {
+                        LEDPattern::Off().ApplyTo(data, writer);
+                      }
+                    },
+                    std::move(node)};
 }
 
 LEDPattern LEDPattern::Blink(units::second_t onTime) {
@@ -118,86 +204,130 @@ LEDPattern LEDPattern::Blink(units::second_t onTime) {
 }
 
 LEDPattern LEDPattern::SynchronizedBlink(std::function<bool()> signal) {
+  auto node = std::make_shared<Node>(Node::kBlink);
+  node->condition = signal;
+  node->first = m_node;
   return LEDPattern{[=, self = *this](auto data, auto writer) {
-    if (signal()) {
-      self.ApplyTo(data, writer);
-    } else {
-      LEDPattern::Off().ApplyTo(data, writer);
-    }
-  }};
+                      if (signal()) {
+                        self.ApplyTo(data, writer);
+                      } else {
+                        LEDPattern::Off().ApplyTo(data, writer);
+                      }
+                    },
+                    std::move(node)};
 }
 
 LEDPattern LEDPattern::Breathe(units::second_t period) {
   auto periodMicros = units::microsecond_t{period};
 
-  return LEDPattern{[periodMicros, self = *this](auto data, auto writer) {
-    self.ApplyTo(data, [&writer, periodMicros](int i, Color color) {
-      double t = (wpi::Now() % periodMicros.to<uint64_t>()) /
-                 periodMicros.to<double>();
-      double phase = t * 2 * std::numbers::pi;
-
-      // Apply the cosine function and shift its output from [-1, 1] to [0, 1]
-      // Use cosine so the period starts at 100% brightness
-      double dim = (std::cos(phase) + 1) / 2.0;
-
-      writer(i, Color{color.red * dim, color.green * dim, color.blue * dim});
-    });
-  }};
+  auto node = std::make_shared<Node>(Node::kTransform);
+  node->kernel = [periodMicros](std::span<Color> colors) {
+    double t = (wpi::Now() % periodMicros.to<uint64_t>()) /
+               periodMicros.to<double>();
+    double dim = (std::cos(t * 2 * std::numbers::pi) + 1) / 2.0;
+    for (auto& color : colors) {
+      color = Color{color.red * dim, color.green * dim, color.blue * dim};
+    }
+  };
+  node->first = m_node;
+  return LEDPattern{
+      [periodMicros, self = *this](auto data, auto writer) {
+        self.ApplyTo(data, [&writer, periodMicros](int i, Color color) {
+          double t = (wpi::Now() % periodMicros.to<uint64_t>()) /
+                     periodMicros.to<double>();
+          double phase = t * 2 * std::numbers::pi;
+
+          // Apply the cosine function and shift its output from [-1, 1] to
+          // [0, 1]. Use cosine so the period starts at 100% brightness
+          double dim = (std::cos(phase) + 1) / 2.0;
+
+          writer(i,
+                 Color{color.red * dim, color.green * dim, color.blue * dim});
+        });
+      },
+      std::move(node)};
 }
 
 LEDPattern LEDPattern::OverlayOn(const LEDPattern& base) {
+  auto node = std::make_shared<Node>(Node::kOverlay);
+  node->first = base.m_node;
+  node->second = m_node;
   return LEDPattern{[self = *this, base](auto data, auto writer) {
-    // write the base pattern down first...
-    base.ApplyTo(data, writer);
-
-    // ... then, overwrite with illuminated LEDs from the overlay
-    self.ApplyTo(data, [&](int i, Color color) {
-      if (color.red > 0 || color.green > 0 || color.blue > 0) {
-        writer(i, color);
-      }
-    });
-  }};
+                      // write the base pattern down first...
+                      base.ApplyTo(data, writer);
+
+                      // ... then, overwrite with illuminated LEDs from the
+                      // overlay
+                      self.ApplyTo(data, [&](int i, Color color) {
+                        if (color.red > 0 || color.green > 0 ||
+                            color.blue > 0) {
+                          writer(i, color);
+                        }
+                      });
+                    },
+                    std::move(node)};
 }
 
 LEDPattern LEDPattern::Blend(const LEDPattern& other) {
+  auto node = std::make_shared<Node>(Node::kBlend);
+  node->first = m_node;
+  node->second = other.m_node;
   return LEDPattern{[self = *this, other](auto data, auto writer) {
-    // Apply the current pattern down as normal...
-    self.ApplyTo(data, writer);
-
-    other.ApplyTo(data, [&](int i, Color color) {
-      // ... then read the result and average it with the output from the other
-      // pattern
-      writer(i, Color{(data[i].r / 255.0 + color.red) / 2,
-                      (data[i].g / 255.0 + color.green) / 2,
-                      (data[i].b / 255.0 + color.blue) / 2});
-    });
-  }};
+                      // Apply the current pattern down as normal...
+                      self.ApplyTo(data, writer);
+
+                      other.ApplyTo(data, [&](int i, Color color) {
+                        // ... then read the result and average it with the
+                        // output from the other pattern
+                        writer(i, Color{(data[i].r / 255.0 + color.red) / 2,
+                                        (data[i].g / 255.0 + color.green) / 2,
+                                        (data[i].b / 255.0 + color.blue) / 2});
+                      });
+                    },
+                    std::move(node)};
 }
 
 LEDPattern LEDPattern::Mask(const LEDPattern& mask) {
-  return LEDPattern{[self = *this, mask](auto data, auto writer) {
-    // Apply the current pattern down as normal...
-    self.ApplyTo(data, writer);
-
-    mask.ApplyTo(data, [&](int i, Color color) {
-      auto currentColor = data[i];
-      // ... then perform a bitwise AND operation on each channel to apply the
-      // mask
-      writer(i, Color{currentColor.r & static_cast<uint8_t>(255 * color.red),
-                      currentColor.g & static_cast<uint8_t>(255 * color.green),
-                      currentColor.b & static_cast<uint8_t>(255 * color.blue)});
-    });
-  }};
+  auto node = std::make_shared<Node>(Node::kMask);
+  node->first = m_node;
+  node->second = mask.m_node;
+  return LEDPattern{
+      [self = *this, mask](auto data, auto writer) {
+        // Apply the current pattern down as normal...
+        self.ApplyTo(data, writer);
+
+        mask.ApplyTo(data, [&](int i, Color color) {
+          auto currentColor = data[i];
+          // ... then perform a bitwise AND operation on each channel to apply
+          // the mask
+          writer(i,
+                 Color{currentColor.r & static_cast<uint8_t>(255 * color.red),
+                       currentColor.g & static_cast<uint8_t>(255 * color.green),
+                       currentColor.b & static_cast<uint8_t>(255 * color.blue)});
+        });
+      },
+      std::move(node)};
 }
 
 LEDPattern LEDPattern::AtBrightness(double relativeBrightness) {
-  return LEDPattern{[relativeBrightness, self = *this](auto data, auto writer) {
-    self.ApplyTo(data, [&](int i, Color color) {
-      writer(i, Color{color.red * relativeBrightness,
-                      color.green * relativeBrightness,
-                      color.blue * relativeBrightness});
-    });
-  }};
+  auto node = std::make_shared<Node>(Node::kTransform);
+  node->kernel = [relativeBrightness](std::span<Color> colors) {
+    for (auto& color : colors) {
+      color = Color{color.red * relativeBrightness,
+                    color.green * relativeBrightness,
+                    color.blue * relativeBrightness};
+    }
+  };
+  node->first = m_node;
+  return LEDPattern{
+      [relativeBrightness, self = *this](auto data, auto writer) {
+        self.ApplyTo(data, [&](int i, Color color) {
+          writer(i, Color{color.red * relativeBrightness,
+                          color.green * relativeBrightness,
+                          color.blue * relativeBrightness});
+        });
+      },
+      std::move(node)};
 }
 
 // Static constants and functions
@@ -207,28 +337,42 @@ LEDPattern LEDPattern::Off() {
 }
 
 LEDPattern LEDPattern::Solid(const Color color) {
+  auto node = std::make_shared<Node>(Node::kKernel);
+  node->kernel = [=](std::span<Color> colors) {
+    std::fill(colors.begin(), colors.end(), color);
+  };
   return LEDPattern{[=](auto data, auto writer) {
-    auto bufLen = data.size();
-    for (size_t i = 0; i < bufLen; i++) {
-      writer(i, color);
-    }
-  }};
+                      auto bufLen = data.size();
+                      for (size_t i = 0; i < bufLen; i++) {
+                        writer(i, color);
+                      }
+                    },
+                    std::move(node)};
 }
 
 LEDPattern LEDPattern::ProgressMaskLayer(
     std::function<double()> progressFunction) {
-  return LEDPattern{[=](auto data, auto writer) {
-    double progress = std::clamp(progressFunction(), 0.0, 1.0);
-    auto bufLen = data.size();
-    size_t max = bufLen * progress;
-
-    for (size_t led = 0; led < max; led++) {
-      writer(led, Color::kWhite);
-    }
-    for (size_t led = max; led < bufLen; led++) {
-      writer(led, Color::kBlack);
-    }
-  }};
+  return FromKernel(
+      [=](auto data, auto writer) {
+        double progress = std::clamp(progressFunction(), 0.0, 1.0);
+        auto bufLen = data.size();
+        size_t max = bufLen * progress;
+
+        for (size_t led = 0; led < max; led++) {
+          writer(led, Color::kWhite);
+        }
+        for (size_t led = max; led < bufLen; led++) {
+          writer(led, Color::kBlack);
+        }
+      },
+      [=](std::span<Color> colors) {
+        double progress = std::clamp(progressFunction(), 0.0, 1.0);
+        auto bufLen = colors.size();
+        size_t max = bufLen * progress;
+
+        std::fill(colors.begin(), colors.begin() + max, Color::kWhite);
+        std::fill(colors.begin() + max, colors.end(), Color::kBlack);
+      });
 }
 
 LEDPattern LEDPattern::Steps(std::span<const std::pair<double, Color>> steps) {
@@ -241,25 +385,49 @@ LEDPattern LEDPattern::Steps(std::span<const std::pair<double, Color>> steps) {
     return LEDPattern::Solid(steps[0].second);
   }
 
-  return LEDPattern{[steps = std::vector(steps.begin(), steps.end())](
-                        auto data, auto writer) {
-    auto bufLen = data.size();
-
-    // precompute relevant positions for this buffer so we don't need to do a
-    // check on every single LED index
-    std::unordered_map<int, Color> stopPositions;
-
-    for (auto step : steps) {
-      stopPositions[std::floor(step.first * bufLen)] = step.second;
-    }
-    auto currentColor = Color::kBlack;
-    for (size_t led = 0; led < bufLen; led++) {
-      if (stopPositions.contains(led)) {
-        currentColor = stopPositions[led];
+  // Calls fill(start, end, color) for each step's range, from the step's
+  // position up to the next step's position. When steps start at the same
+  // position, only the last one is filled. LEDs before the first step are
+  // filled with black.
+  auto forEachRange = [steps = std::vector(steps.begin(), steps.end())](
+                          int bufLen, auto&& fill) {
+    int firstStart = bufLen;
+    for (size_t i = 0; i < steps.size(); ++i) {
+      int start = std::floor(steps[i].first * bufLen);
+      if (start < 0 || start >= bufLen) {
+        continue;
+      }
+      int end = bufLen;
+      bool overridden = false;
+      for (size_t j = 0; j < steps.size(); ++j) {
+        int otherStart = std::floor(steps[j].first * bufLen);
+        if (otherStart > start && otherStart < end) {
+          end = otherStart;
+        } else if (otherStart == start && j > i) {
+          overridden = true;
+        }
+      }
+      firstStart = (std::min)(firstStart, start);
+      if (!overridden) {
+        fill(start, end, steps[i].second);
       }
-      writer(led, currentColor);
     }
-  }};
+    fill(0, firstStart, Color::kBlack);
+  };
+
+  return FromKernel(
+      [=](auto data, auto writer) {
+        forEachRange(data.size(), [&](int start, int end, Color color) {
+          for (int led = start; led < end; led++) {
+            writer(led, color);
+          }
+        });
+      },
+      [=](std::span<Color> colors) {
+        forEachRange(colors.size(), [&](int start, int end, Color color) {
+          std::fill(colors.begin() + start, colors.begin() + end, color);
+        });
+      });
 }
 
 LEDPattern LEDPattern::Steps(
@@ -278,10 +446,10 @@ LEDPattern LEDPattern::Gradient(GradientType type,
     return LEDPattern::Solid(colors[0]);
   }
 
-  return LEDPattern{[type, colors = std::vector(colors.begin(), colors.end())](
-                        auto data, auto writer) {
+  // Calls set(led, color) for every LED
+  auto forEachLED = [type, colors = std::vector(colors.begin(), colors.end())](
+                        size_t bufLen, auto&& set) {
     size_t numSegments = colors.size();
-    auto bufLen = data.size();
     int ledsPerSegment = 0;
     switch (type) {
       case kContinuous:
@@ -303,9 +471,17 @@ LEDPattern LEDPattern::Gradient(GradientType type,
       Color gradientColor{wpi::Lerp(color.red, nextColor.red, t),
                           wpi::Lerp(color.green, nextColor.green, t),
                           wpi::Lerp(color.blue, nextColor.blue, t)};
-      writer(led, gradientColor);
+      set(led, gradientColor);
     }
-  }};
+  };
+
+  return FromKernel(
+      [=](auto data, auto writer) { forEachLED(data.size(), writer); },
+      [=](std::span<Color> out) {
+        forEachLED(out.size(), [&](size_t led, Color color) {
+          out[led] = color;
+        });
+      });
 }
 
 LEDPattern LEDPattern::Gradient(GradientType type,
@@ -314,11 +490,209 @@ LEDPattern LEDPattern::Gradient(GradientType type,
 }
 
 LEDPattern LEDPattern::Rainbow(int saturation, int value) {
-  return LEDPattern{[=](auto data, auto writer) {
-    auto bufLen = data.size();
-    for (size_t led = 0; led < bufLen; led++) {
-      int hue = ((led * 180) / bufLen) % 180;
-      writer(led, Color::FromHSV(hue, saturation, value));
+  return FromKernel(
+      [=](auto data, auto writer) {
+        auto bufLen = data.size();
+        for (size_t led = 0; led < bufLen; led++) {
+          int hue = ((led * 180) / bufLen) % 180;
+          writer(led, Color::FromHSV(hue, saturation, value));
+        }
+      },
+      [=](std::span<Color> colors) {
+        auto bufLen = colors.size();
+        for (size_t led = 0; led < bufLen; led++) {
+          int hue = ((led * 180) / bufLen) % 180;
+          colors[led] = Color::FromHSV(hue, saturation, value);
+        }
+      });
+}
+
+// Compiled patterns
+
+CompiledLEDPattern::CompiledLEDPattern(const LEDPattern& pattern)
+    : m_root{pattern.m_node}, m_maps(1) {
+  Emit(*m_root, 0, 0);
+}
+
+void CompiledLEDPattern::Emit(const LEDPattern::Node& node, size_t mapDepth,
+                              size_t stageDepth) {
+  using Node = LEDPattern::Node;
+
+  if (m_stages.capacity() < stageDepth) {
+    m_stages.reserve(stageDepth);
+  }
+
+  switch (node.kind) {
+    case Node::kOpaque:
+      m_program.push_back({Instruction::kOpaque, &node});
+      break;
+    case Node::kKernel:
+      m_program.push_back({Instruction::kKernel, &node});
+      break;
+    case Node::kMap:
+      if (m_maps.size() < mapDepth + 2) {
+        m_maps.resize(mapDepth + 2);
+      }
+      m_program.push_back({Instruction::kPushMap, &node});
+      Emit(*node.first, mapDepth + 1, stageDepth);
+      m_program.push_back({Instruction::kPopMap});
+      break;
+    case Node::kTransform:
+      m_program.push_back({Instruction::kPushStage, &node});
+      Emit(*node.first, mapDepth, stageDepth + 1);
+      m_program.push_back({Instruction::kPopStage});
+      break;
+    case Node::kOverlay:
+    case Node::kBlend:
+    case Node::kMask:
+      // The first pattern is written directly, and the second pattern's
+      // writes are combined with it
+      Emit(*node.first, mapDepth, stageDepth);
+      m_program.push_back({Instruction::kPushStage, &node});
+      Emit(*node.second, mapDepth, stageDepth + 1);
+      m_program.push_back({Instruction::kPopStage});
+      break;
+    case Node::kBlink: {
+      size_t jumpUnless = m_program.size();
+      m_program.push_back({Instruction::kJumpUnless, &node});
+      Emit(*node.first, mapDepth, stageDepth);
+      size_t jump = m_program.size();
+      m_program.push_back({Instruction::kJump});
+      m_program[jumpUnless].target = m_program.size();
+      m_program.push_back({Instruction::kOff});
+      m_program[jump].target = m_program.size();
+      break;
+    }
+  }
+}
+
+void CompiledLEDPattern::ApplyTo(std::span<AddressableLED::LEDData> data) {
+  size_t bufLen = data.size();
+  if (bufLen != m_length) {
+    m_length = bufLen;
+    for (auto& map : m_maps) {
+      map.resize(bufLen);
+    }
+    for (size_t i = 0; i < bufLen; i++) {
+      m_maps[0][i] = i;
+    }
+    m_colors.resize(bufLen);
+    m_valid.resize(bufLen);
+  }
+
+  size_t mapDepth = 0;
+  m_stages.clear();
+  size_t pc = 0;
+  while (pc < m_program.size()) {
+    auto& instruction = m_program[pc++];
+    switch (instruction.op) {
+      case Instruction::kKernel:
+        instruction.node->kernel(m_colors);
+        Write(data, m_colors, m_maps[mapDepth], m_valid);
+        break;
+      case Instruction::kOff:
+        std::fill(m_colors.begin(), m_colors.end(), Color::kBlack);
+        Write(data, m_colors, m_maps[mapDepth], m_valid);
+        break;
+      case Instruction::kOpaque: {
+        // Opaque patterns may read and write LEDs in any order, so each write
+        // is applied immediately
+        std::span<const size_t> map = m_maps[mapDepth];
+        instruction.node->impl(
+            LEDPattern::LEDReader{[&](int i) { return data[map[i]]; }, bufLen},
+            [&](int i, Color color) {
+              size_t index = map[i];
+              uint8_t valid;
+              Write(data, {&color, 1}, {&index, 1}, {&valid, 1});
+            });
+        break;
+      }
+      case Instruction::kPushMap: {
+        auto& node = *instruction.node;
+        auto& from = m_maps[mapDepth];
+        auto& to = m_maps[++mapDepth];
+        if (node.offset && bufLen > 0) {
+          size_t offset = frc::FloorMod(node.offset(bufLen),
+                                        static_cast<int64_t>(bufLen));
+          std::copy(from.begin() + offset, from.end(), to.begin());
+          std::copy(from.begin(), from.begin() + offset,
+                    to.end() - offset);
+        } else {
+          for (size_t i = 0; i < bufLen; i++) {
+            to[i] = from[node.mapper(bufLen, i)];
+          }
+        }
+        break;
+      }
+      case Instruction::kPopMap:
+        --mapDepth;
+        break;
+      case Instruction::kPushStage:
+        m_stages.push_back(instruction.node);
+        break;
+      case Instruction::kPopStage:
+        m_stages.pop_back();
+        break;
+      case Instruction::kJumpUnless:
+        if (!instruction.node->condition()) {
+          pc = instruction.target;
+        }
+        break;
+      case Instruction::kJump:
+        pc = instruction.target;
+        break;
+    }
+  }
+}
+
+void CompiledLEDPattern::Write(std::span<AddressableLED::LEDData> data,
+                               std::span<Color> colors,
+                               std::span<const size_t> indices,
+                               std::span<uint8_t> valid) {
+  using Node = LEDPattern::Node;
+
+  // Each LED is written at most once per call, so applying each stage to the
+  // whole buffer before the next one gives the same result as passing each LED
+  // through all of the stages in turn. The innermost stage applies first.
+  std::fill(valid.begin(), valid.end(), 1);
+  for (auto it = m_stages.rbegin(); it != m_stages.rend(); ++it) {
+    const Node& stage = **it;
+    switch (stage.kind) {
+      case Node::kTransform:
+        stage.kernel(colors);
+        break;
+      case Node::kOverlay:
+        for (size_t i = 0; i < colors.size(); i++) {
+          auto& color = colors[i];
+          valid[i] &= color.red > 0 || color.green > 0 || color.blue > 0;
+        }
+        break;
+      case Node::kBlend:
+        for (size_t i = 0; i < colors.size(); i++) {
+          auto& led = data[indices[i]];
+          auto& color = colors[i];
+          color = Color{(led.r / 255.0 + color.red) / 2,
+                        (led.g / 255.0 + color.green) / 2,
+                        (led.b / 255.0 + color.blue) / 2};
+        }
+        break;
+      case Node::kMask:
+        for (size_t i = 0; i < colors.size(); i++) {
+          auto& led = data[indices[i]];
+          auto& color = colors[i];
+          color = Color{led.r & static_cast<uint8_t>(255 * color.red),
+                        led.g & static_cast<uint8_t>(255 * color.green),
+                        led.b & static_cast<uint8_t>(255 * color.blue)};
+        }
+        break;
+      default:
+        break;
     }
-  }};
+  }
+
+  for (size_t i = 0; i < colors.size(); i++) {
+    if (valid[i]) {
+      data[indices[i]].SetLED(colors[i]);
+    }
+  }
 }
@@ -11,6 +11,7 @@
 #include <hal/FRCUsageReporting.h>
 #include <hal/Notifier.h>
 #include <hal/Threads.h>
+#include <hal/simulation/SimContext.h>
 
 #include "frc/Errors.h"
 #include "frc/Timer.h"
@@ -26,7 +27,10 @@ Notifier::Notifier(std::function<void()> callback) {
   m_notifier = HAL_InitializeNotifier(&status);
   FRC_CheckErrorStatus(status, "InitializeNotifier");
 
+  // The HAL Notifier belongs to this thread's simulation context
+  int32_t simContext = HALSIM_GetThreadSimContext();
   m_thread = std::thread([=, this] {
+    HALSIM_SetThreadSimContext(simContext);
     for (;;) {
       int32_t status = 0;
       HAL_NotifierHandle notifier = m_notifier.load();
@@ -68,7 +72,10 @@ Notifier::Notifier(int priority, std::function<void()> callback) {
   m_notifier = HAL_InitializeNotifier(&status);
   FRC_CheckErrorStatus(status, "InitializeNotifier");
 
+  // The HAL Notifier belongs to this thread's simulation context
+  int32_t simContext = HALSIM_GetThreadSimContext();
   m_thread = std::thread([=, this] {
+    HALSIM_SetThreadSimContext(simContext);
     int32_t status = 0;
     HAL_SetCurrentThreadPriority(true, priority, &status);
     for (;;) {
@@ -116,7 +123,22 @@ Notifier::Notifier(int priority, std::function<void()> callback) {
   });
 }
 
+Notifier::Notifier(NotifierExecutor& executor, std::function<void()> callback)
+    : Notifier(executor, 0, std::move(callback)) {}
+
+Notifier::Notifier(NotifierExecutor& executor, int priority,
+                   std::function<void()> callback)
+    : m_executor{&executor},
+      m_handle{executor.Add(std::move(callback), priority)} {}
+
 Notifier::~Notifier() {
+  if (m_executor) {
+    if (m_handle) {
+      m_executor->Remove(m_handle);
+    }
+    return;
+  }
+
   int32_t status = 0;
   // atomically set handle to 0, then clean
   HAL_NotifierHandle handle = m_notifier.exchange(0);
@@ -137,11 +159,19 @@ Notifier::Notifier(Notifier&& rhs)
       m_callback(std::move(rhs.m_callback)),
       m_expirationTime(std::move(rhs.m_expirationTime)),
       m_period(std::move(rhs.m_period)),
-      m_periodic(std::move(rhs.m_periodic)) {
+      m_periodic(std::move(rhs.m_periodic)),
+      m_executor(rhs.m_executor),
+      m_handle(rhs.m_handle) {
   rhs.m_notifier = HAL_kInvalidHandle;
+  rhs.m_handle = {};
 }
 
 Notifier& Notifier::operator=(Notifier&& rhs) {
+  // Stop our own callback before taking over rhs's registration
+  if (m_executor && m_handle && this != &rhs) {
+    m_executor->Remove(m_handle);
+  }
+
   m_thread = std::move(rhs.m_thread);
   m_notifier = rhs.m_notifier.load();
   rhs.m_notifier = HAL_kInvalidHandle;
@@ -149,11 +179,18 @@ Notifier& Notifier::operator=(Notifier&& rhs) {
   m_expirationTime = std::move(rhs.m_expirationTime);
   m_period = std::move(rhs.m_period);
   m_periodic = std::move(rhs.m_periodic);
+  m_executor = rhs.m_executor;
+  m_handle = rhs.m_handle;
+  rhs.m_handle = {};
 
   return *this;
 }
 
 void Notifier::SetName(std::string_view name) {
+  if (m_executor) {
+    m_executor->SetName(m_handle, name);
+    return;
+  }
   fmt::memory_buffer buf;
   fmt::format_to(fmt::appender{buf}, "{}", name);
   buf.push_back('\0');  // null terminate
@@ -162,11 +199,19 @@ void Notifier::SetName(std::string_view name) {
 }
 
 void Notifier::SetCallback(std::function<void()> callback) {
+  if (m_executor) {
+    m_executor->SetCallback(m_handle, std::move(callback));
+    return;
+  }
   std::scoped_lock lock(m_processMutex);
   m_callback = callback;
 }
 
 void Notifier::StartSingle(units::second_t delay) {
+  if (m_executor) {
+    m_executor->StartSingle(m_handle, delay);
+    return;
+  }
   std::scoped_lock lock(m_processMutex);
   m_periodic = false;
   m_period = delay;
@@ -175,6 +220,10 @@ void Notifier::StartSingle(units::second_t delay) {
 }
 
 void Notifier::StartPeriodic(units::second_t period) {
+  if (m_executor) {
+    m_executor->StartPeriodic(m_handle, period);
+    return;
+  }
   std::scoped_lock lock(m_processMutex);
   m_periodic = true;
   m_period = period;
@@ -187,6 +236,10 @@ void Notifier::StartPeriodic(units::hertz_t frequency) {
 }
 
 void Notifier::Stop() {
+  if (m_executor) {
+    m_executor->Stop(m_handle);
+    return;
+  }
   std::scoped_lock lock(m_processMutex);
   m_periodic = false;
   int32_t status = 0;
@@ -209,6 +262,13 @@ void Notifier::UpdateAlarm() {
   UpdateAlarm(static_cast<uint64_t>(m_expirationTime * 1e6));
 }
 
+NotifierExecutor::Stats Notifier::GetStats() const {
+  if (m_executor) {
+    return m_executor->GetStats(m_handle);
+  }
+  return {};
+}
+
 bool Notifier::SetHALThreadPriority(bool realTime, int32_t priority) {
   int32_t status = 0;
   return HAL_SetNotifierThreadPriority(realTime, priority, &status);
@@ -0,0 +1,359 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/NotifierExecutor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+#include <hal/DriverStation.h>
+#include <hal/HALBase.h>
+#include <hal/Notifier.h>
+#include <hal/Threads.h>
+#include <hal/simulation/SimContext.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "frc/Errors.h"
+#include "frc/internal/TimerWheel.h"
+#include "units/math.h"
+
+using namespace frc;
+
+namespace {
+
+uint64_t GetTime() {
+  int32_t status = 0;
+  uint64_t time = HAL_GetFPGATime(&status);
+  FRC_CheckErrorStatus(status, "GetFPGATime");
+  return time;
+}
+
+units::second_t ToSeconds(uint64_t microseconds) {
+  return units::second_t{microseconds * 1e-6};
+}
+
+}  // namespace
+
+struct NotifierExecutor::Thread {
+  struct Entry {
+    std::function<void()> callback;
+    std::string name;
+    int priority = 0;
+
+    // Period in microseconds, or 0 if the callback runs once
+    uint64_t period = 0;
+
+    // Incremented whenever the callback is started or stopped, which cancels
+    // its timer in the wheel
+    uint32_t generation = 0;
+
+    bool used = false;
+    bool running = false;
+    Stats stats;
+  };
+
+  explicit Thread(uint64_t now) : wheel{now} {}
+
+  // Waits on the HAL alarm and runs the due callbacks
+  void Run();
+
+  // Sets the HAL alarm to the earliest deadline. Must be called with the mutex
+  // held.
+  void UpdateAlarm();
+
+  // Blocks until the entry isn't running, unless it's running on this thread
+  void WaitUntilIdle(std::unique_lock<wpi::mutex>& lock, uint32_t index);
+
+  Entry& Get(uint32_t index);
+
+  std::thread thread;
+  std::atomic<HAL_NotifierHandle> notifier{0};
+
+  mutable wpi::mutex mutex;
+  wpi::condition_variable idleCond;
+  std::vector<Entry> entries;
+  std::vector<uint32_t> freeIndices;
+  size_t size = 0;
+  internal::TimerWheel wheel;
+};
+
+void NotifierExecutor::Thread::Run() {
+  std::vector<internal::TimerWheel::Timer> expired;
+  for (;;) {
+    int32_t status = 0;
+    HAL_NotifierHandle handle = notifier.load();
+    if (handle == 0) {
+      break;
+    }
+    uint64_t curTime = HAL_WaitForNotifierAlarm(handle, &status);
+    if (curTime == 0 || status != 0) {
+      break;
+    }
+
+    std::unique_lock lock(mutex);
+    expired.clear();
+    wheel.Advance(curTime, &expired);
+
+    // Run the highest priority callbacks first, then the earliest
+    std::stable_sort(expired.begin(), expired.end(),
+                     [&](const auto& a, const auto& b) {
+                       if (entries[a.index].priority !=
+                           entries[b.index].priority) {
+                         return entries[a.index].priority >
+                                entries[b.index].priority;
+                       }
+                       return a.deadline < b.deadline;
+                     });
+
+    for (auto&& timer : expired) {
+      // An earlier callback may have stopped or restarted this one
+      if (!entries[timer.index].used ||
+          entries[timer.index].generation != timer.generation) {
+        continue;
+      }
+
+      entries[timer.index].running = true;
+      auto callback = entries[timer.index].callback;
+      lock.unlock();
+
+      uint64_t start = GetTime();
+      if (callback) {
+        try {
+          callback();
+        } catch (const frc::RuntimeError& e) {
+          e.Report();
+          FRC_ReportError(
+              err::Error,
+              "Error in NotifierExecutor thread."
+              "  The above stacktrace can help determine where the error "
+              "occurred.\n"
+              "  See https://wpilib.org/stacktrace for more information.\n");
+          throw;
+        } catch (const std::exception& e) {
+          HAL_SendError(1, err::Error, 0, e.what(), "", "", 1);
+          throw;
+        }
+      }
+      uint64_t end = GetTime();
+
+      lock.lock();
+      auto& entry = entries[timer.index];
+      entry.running = false;
+      ++entry.stats.runs;
+      entry.stats.lastRunTime = ToSeconds(end - start);
+      entry.stats.maxRunTime =
+          units::math::max(entry.stats.maxRunTime, entry.stats.lastRunTime);
+      if (start > timer.deadline) {
+        entry.stats.maxLatency = units::math::max(
+            entry.stats.maxLatency, ToSeconds(start - timer.deadline));
+      }
+
+      if (entry.generation == timer.generation && entry.period > 0) {
+        // Skip the periods that have already passed instead of running them
+        // back-to-back
+        uint64_t periods = 1;
+        if (timer.deadline + entry.period <= end) {
+          uint64_t missed = (end - timer.deadline) / entry.period;
+          entry.stats.overruns += missed;
+          periods += missed;
+        }
+        wheel.Add({timer.deadline + periods * entry.period, timer.index,
+                   timer.generation});
+      }
+      idleCond.notify_all();
+    }
+
+    UpdateAlarm();
+  }
+}
+
+void NotifierExecutor::Thread::UpdateAlarm() {
+  int32_t status = 0;
+  // Return if we are being destructed
+  auto handle = notifier.load();
+  if (handle == 0) {
+    return;
+  }
+  if (auto deadline = wheel.NextDeadline()) {
+    HAL_UpdateNotifierAlarm(handle, *deadline, &status);
+    FRC_CheckErrorStatus(status, "UpdateNotifierAlarm");
+  } else {
+    HAL_CancelNotifierAlarm(handle, &status);
+    FRC_CheckErrorStatus(status, "CancelNotifierAlarm");
+  }
+}
+
+void NotifierExecutor::Thread::WaitUntilIdle(
+    std::unique_lock<wpi::mutex>& lock, uint32_t index) {
+  if (std::this_thread::get_id() == thread.get_id()) {
+    return;
+  }
+  idleCond.wait(lock, [&] { return !entries[index].running; });
+}
+
+NotifierExecutor::Thread::Entry& NotifierExecutor::Thread::Get(
+    uint32_t index) {
+  if (index >= entries.size() || !entries[index].used) {
+    throw FRC_MakeError(err::InvalidParameter, "handle");
+  }
+  return entries[index];
+}
+
+NotifierExecutor::NotifierExecutor(int numThreads)
+    : NotifierExecutor(numThreads, 0) {}
+
+NotifierExecutor::NotifierExecutor(int numThreads, int priority) {
+  uint64_t now = GetTime();
+  // The HAL Notifiers belong to this thread's simulation context
+  int32_t simContext = HALSIM_GetThreadSimContext();
+  for (int i = 0; i < (std::max)(numThreads, 1); ++i) {
+    auto thread = std::make_unique<Thread>(now);
+
+    int32_t status = 0;
+    thread->notifier = HAL_InitializeNotifier(&status);
+    FRC_CheckErrorStatus(status, "InitializeNotifier");
+    HAL_SetNotifierName(thread->notifier,
+                        fmt::format("NotifierExecutor {}", i).c_str(), &status);
+
+    thread->thread = std::thread([t = thread.get(), priority, simContext] {
+      HALSIM_SetThreadSimContext(simContext);
+      if (priority > 0) {
+        int32_t status = 0;
+        HAL_SetCurrentThreadPriority(true, priority, &status);
+      }
+      t->Run();
+    });
+    m_threads.emplace_back(std::move(thread));
+  }
+}
+
+NotifierExecutor::~NotifierExecutor() {
+  for (auto&& thread : m_threads) {
+    int32_t status = 0;
+    // atomically set handle to 0, then clean
+    HAL_NotifierHandle handle = thread->notifier.exchange(0);
+    HAL_StopNotifier(handle, &status);
+    FRC_ReportError(status, "StopNotifier");
+
+    // Join the thread to ensure the callbacks have exited.
+    if (thread->thread.joinable()) {
+      thread->thread.join();
+    }
+
+    HAL_CleanNotifier(handle);
+  }
+}
+
+NotifierExecutor::Handle NotifierExecutor::Add(std::function<void()> callback,
+                                               int priority) {
+  if (!callback) {
+    throw FRC_MakeError(err::NullParameter, "callback");
+  }
+
+  // Balance the callbacks between the threads
+  int threadIndex = 0;
+  size_t fewest = SIZE_MAX;
+  for (size_t i = 0; i < m_threads.size(); ++i) {
+    std::scoped_lock lock(m_threads[i]->mutex);
+    if (m_threads[i]->size < fewest) {
+      fewest = m_threads[i]->size;
+      threadIndex = i;
+    }
+  }
+
+  auto& thread = *m_threads[threadIndex];
+  std::scoped_lock lock(thread.mutex);
+  uint32_t index;
+  if (thread.freeIndices.empty()) {
+    index = thread.entries.size();
+    thread.entries.emplace_back();
+  } else {
+    index = thread.freeIndices.back();
+    thread.freeIndices.pop_back();
+  }
+  ++thread.size;
+
+  auto& entry = thread.entries[index];
+  entry.callback = std::move(callback);
+  entry.name.clear();
+  entry.priority = priority;
+  entry.period = 0;
+  ++entry.generation;
+  entry.used = true;
+  entry.stats = Stats{};
+  return {threadIndex, index};
+}
+
+void NotifierExecutor::Remove(Handle handle) {
+  auto& thread = *m_threads.at(handle.thread);
+  std::unique_lock lock(thread.mutex);
+  auto& entry = thread.Get(handle.index);
+  ++entry.generation;
+  thread.WaitUntilIdle(lock, handle.index);
+
+  // The entry may have moved while waiting
+  auto& idleEntry = thread.entries[handle.index];
+  idleEntry.used = false;
+  idleEntry.callback = nullptr;
+  thread.freeIndices.emplace_back(handle.index);
+  --thread.size;
+}
+
+void NotifierExecutor::SetName(Handle handle, std::string_view name) {
+  auto& thread = *m_threads.at(handle.thread);
+  std::scoped_lock lock(thread.mutex);
+  thread.Get(handle.index).name = name;
+}
+
+void NotifierExecutor::SetCallback(Handle handle,
+                                   std::function<void()> callback) {
+  auto& thread = *m_threads.at(handle.thread);
+  std::scoped_lock lock(thread.mutex);
+  thread.Get(handle.index).callback = std::move(callback);
+}
+
+void NotifierExecutor::StartSingle(Handle handle, units::second_t delay) {
+  auto& thread = *m_threads.at(handle.thread);
+  std::scoped_lock lock(thread.mutex);
+  auto& entry = thread.Get(handle.index);
+  entry.period = 0;
+  ++entry.generation;
+  thread.wheel.Add({GetTime() + static_cast<uint64_t>(delay.value() * 1e6),
+                    handle.index, entry.generation});
+  thread.UpdateAlarm();
+}
+
+void NotifierExecutor::StartPeriodic(Handle handle, units::second_t period) {
+  auto& thread = *m_threads.at(handle.thread);
+  std::scoped_lock lock(thread.mutex);
+  auto& entry = thread.Get(handle.index);
+  entry.period = (std::max)(static_cast<uint64_t>(period.value() * 1e6),
+                            uint64_t{1});
+  ++entry.generation;
+  thread.wheel.Add({GetTime() + entry.period, handle.index, entry.generation});
+  thread.UpdateAlarm();
+}
+
+void NotifierExecutor::Stop(Handle handle) {
+  auto& thread = *m_threads.at(handle.thread);
+  std::unique_lock lock(thread.mutex);
+  ++thread.Get(handle.index).generation;
+  thread.WaitUntilIdle(lock, handle.index);
+}
+
+NotifierExecutor::Stats NotifierExecutor::GetStats(Handle handle) const {
+  auto& thread = *m_threads.at(handle.thread);
+  std::scoped_lock lock(thread.mutex);
+  return thread.Get(handle.index).stats;
+}
+
+std::string NotifierExecutor::GetName(Handle handle) const {
+  auto& thread = *m_threads.at(handle.thread);
+  std::scoped_lock lock(thread.mutex);
+  return thread.Get(handle.index).name;
+}
@@ -9,9 +9,11 @@
 #include <cstdio>
 #include <utility>
 
+#include <fmt/format.h>
 #include <hal/DriverStation.h>
 #include <hal/FRCUsageReporting.h>
 #include <hal/Notifier.h>
+#include <networktables/NetworkTableInstance.h>
 
 #include "frc/Errors.h"
 
@@ -48,7 +50,7 @@ void TimedRobot::StartCompetition() {
 
     m_loopStartTimeUs = RobotController::GetFPGATime();
 
-    callback.func();
+    RunCallback(callback, currentTime);
 
     // Increment the expiration time by the number of full periods it's behind
     // plus one to avoid rapid repeat fires from a large loop overrun. We assume
@@ -63,13 +65,17 @@ void TimedRobot::StartCompetition() {
     while (m_callbacks.top().expirationTime <= currentTime) {
       callback = m_callbacks.pop();
 
-      callback.func();
+      RunCallback(callback, currentTime);
 
       callback.expirationTime +=
           callback.period + (currentTime - callback.expirationTime) /
                                 callback.period * callback.period;
       m_callbacks.push(std::move(callback));
     }
+
+    if (m_profiler) {
+      PublishLoopProfiler(currentTime);
+    }
   }
 }
 
@@ -110,5 +116,110 @@ void TimedRobot::AddPeriodic(std::function<void()> callback,
   m_callbacks.emplace(
       callback, m_startTime,
       std::chrono::microseconds{static_cast<int64_t>(period.value() * 1e6)},
-      std::chrono::microseconds{static_cast<int64_t>(offset.value() * 1e6)});
+      std::chrono::microseconds{static_cast<int64_t>(offset.value() * 1e6)},
+      m_numCallbacks++);
+  if (m_profiler) {
+    AddProfilerCallbacks();
+  }
+}
+
+void TimedRobot::EnableLoopProfiler(units::second_t publishPeriod,
+                                    wpi::log::DataLog* log) {
+  if (!log) {
+    EnableLoopProfiler(publishPeriod, nt::NetworkTableInstance::GetDefault());
+    return;
+  }
+
+  DisableLoopProfiler();
+  auto profiler = MakeLoopProfiler(publishPeriod);
+  profiler->log = log;
+  wpi::log::IntegerArrayLogEntry{*log, "TimedRobot/Profiler/BucketBounds"}
+      .Append(TimingHistogram::kBucketBounds);
+  StartLoopProfiler(std::move(profiler));
+}
+
+void TimedRobot::EnableLoopProfiler(units::second_t publishPeriod,
+                                    nt::NetworkTableInstance inst) {
+  DisableLoopProfiler();
+  auto profiler = MakeLoopProfiler(publishPeriod);
+  profiler->inst = inst;
+  profiler->boundsPublisher =
+      inst.GetIntegerArrayTopic("/TimedRobot/Profiler/BucketBounds").Publish();
+  profiler->boundsPublisher.Set(TimingHistogram::kBucketBounds);
+  StartLoopProfiler(std::move(profiler));
+}
+
+std::unique_ptr<TimedRobot::LoopProfiler> TimedRobot::MakeLoopProfiler(
+    units::second_t publishPeriod) {
+  auto profiler = std::make_unique<LoopProfiler>();
+  profiler->publishPeriod = std::chrono::microseconds{
+      static_cast<int64_t>(publishPeriod.value() * 1e6)};
+  profiler->jitter.SetName("/TimedRobot/Profiler/Jitter");
+  static constexpr const char* kPeriodicNames[] = {
+      "RobotPeriodic", "DisabledPeriodic", "AutonomousPeriodic",
+      "TeleopPeriodic", "TestPeriodic"};
+  for (size_t i = 0; i < profiler->periodic.size(); ++i) {
+    profiler->periodic[i].SetName(
+        fmt::format("/TimedRobot/Profiler/{}", kPeriodicNames[i]));
+  }
+  return profiler;
+}
+
+void TimedRobot::StartLoopProfiler(std::unique_ptr<LoopProfiler> profiler) {
+  m_profiler = std::move(profiler);
+  AddProfilerCallbacks();
+  SetPeriodicHistograms(m_profiler->periodic.data());
+}
+
+void TimedRobot::DisableLoopProfiler() {
+  SetPeriodicHistograms(nullptr);
+  m_profiler.reset();
+}
+
+void TimedRobot::RunCallback(Callback& callback,
+                             std::chrono::microseconds currentTime) {
+  if (!m_profiler) {
+    callback.func();
+    return;
+  }
+
+  m_profiler->jitter.Record(currentTime - callback.expirationTime);
+
+  std::chrono::microseconds start{RobotController::GetFPGATime()};
+  callback.func();
+
+  // The callback may have disabled the profiler
+  if (m_profiler) {
+    m_profiler->callbacks[callback.index].Record(
+        std::chrono::microseconds{RobotController::GetFPGATime()} - start);
+  }
+}
+
+void TimedRobot::AddProfilerCallbacks() {
+  while (m_profiler->callbacks.size() < m_numCallbacks) {
+    m_profiler->callbacks.emplace_back(fmt::format(
+        "/TimedRobot/Profiler/Callbacks/{}", m_profiler->callbacks.size()));
+  }
+}
+
+void TimedRobot::PublishLoopProfiler(std::chrono::microseconds currentTime) {
+  if (currentTime - m_profiler->lastPublish < m_profiler->publishPeriod) {
+    return;
+  }
+  m_profiler->lastPublish = currentTime;
+
+  auto publish = [&](TimingHistogram& histogram) {
+    if (m_profiler->log) {
+      histogram.Publish(*m_profiler->log);
+    } else {
+      histogram.Publish(m_profiler->inst);
+    }
+  };
+  publish(m_profiler->jitter);
+  for (auto&& histogram : m_profiler->callbacks) {
+    publish(histogram);
+  }
+  for (auto&& histogram : m_profiler->periodic) {
+    publish(histogram);
+  }
 }
@@ -0,0 +1,63 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/TimingHistogram.h"
+
+#include <algorithm>
+
+#include <networktables/NetworkTableInstance.h>
+
+using namespace frc;
+
+TimingHistogram::TimingHistogram(std::string_view name) : m_name{name} {}
+
+void TimingHistogram::SetName(std::string_view name) {
+  m_name = name;
+}
+
+void TimingHistogram::Record(std::chrono::microseconds duration) {
+  ++m_counts[std::upper_bound(kBucketBounds.begin(), kBucketBounds.end(),
+                              duration.count()) -
+             kBucketBounds.begin()];
+  m_max = (std::max)(m_max, duration);
+  m_changed = true;
+}
+
+void TimingHistogram::Reset() {
+  m_counts.fill(0);
+  m_max = std::chrono::microseconds{0};
+  m_changed = true;
+}
+
+void TimingHistogram::Publish() {
+  Publish(nt::NetworkTableInstance::GetDefault());
+}
+
+void TimingHistogram::Publish(nt::NetworkTableInstance inst) {
+  if (!m_changed) {
+    return;
+  }
+  m_changed = false;
+
+  if (!m_publisher) {
+    m_publisher = inst.GetIntegerArrayTopic(m_name).Publish();
+  }
+  m_publisher.Set(m_counts);
+}
+
+void TimingHistogram::Publish(wpi::log::DataLog& log) {
+  if (!m_changed) {
+    return;
+  }
+  m_changed = false;
+
+  if (!m_logEntry) {
+    std::string_view name = m_name;
+    if (name.starts_with('/')) {
+      name.remove_prefix(1);
+    }
+    m_logEntry = wpi::log::IntegerArrayLogEntry{log, name};
+  }
+  m_logEntry.Append(m_counts);
+}
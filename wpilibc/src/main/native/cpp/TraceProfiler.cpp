@@ -0,0 +1,319 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/TraceProfiler.h"
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/DataLog.h>
+#include <wpi/StringMap.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+#include <wpi/timestamp.h>
+
+#include "frc/Errors.h"
+
+using namespace frc;
+
+namespace {
+
+// The events of one thread. The thread is the only writer of head and the
+// events; the flush is the only writer of tail.
+struct ThreadBuffer {
+  // size must be a power of 2
+  explicit ThreadBuffer(uint64_t size)
+      : events{std::make_unique<TraceEvent[]>(size)}, mask{size - 1} {}
+
+  std::unique_ptr<TraceEvent[]> events;
+  uint64_t mask;
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint64_t> tail{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> exited{false};
+
+  // Guarded by Instance::mutex
+  int id = 0;
+  std::string name;
+  bool nameChanged = false;
+  wpi::log::StructArrayLogEntry<TraceEvent> entry;
+};
+
+struct Instance {
+  ~Instance();
+
+  void Flush();
+  void Run();
+
+  wpi::mutex mutex;
+  std::vector<std::string> zones;
+  wpi::StringMap<uint16_t> zoneIds;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  int nextThreadId = 0;
+
+  wpi::log::DataLog* log = nullptr;
+  wpi::log::StringArrayLogEntry zonesEntry;
+  wpi::log::IntegerLogEntry droppedEntry;
+  size_t loggedZones = 0;
+  uint64_t exitedDropped = 0;
+  uint64_t loggedDropped = 0;
+  std::vector<TraceEvent> scratch;
+
+  // Added to the steady clock to get data log time, in nanoseconds
+  int64_t timeOffset = 0;
+
+  std::chrono::nanoseconds flushPeriod{0};
+  wpi::condition_variable cond;
+  bool stopping = false;
+  std::thread thread;
+};
+
+std::atomic<bool> gRunning{false};
+
+// Size of the buffers of threads that haven't recorded an event yet
+std::atomic<uint64_t> gBufferSize{TraceProfiler::kDefaultBufferSize};
+
+Instance& GetInstance() {
+  static Instance instance;
+  return instance;
+}
+
+int64_t SteadyNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Marks the thread's buffer as exited when the thread exits, so the flush
+// removes it after writing its remaining events
+struct ThreadState {
+  ~ThreadState() {
+    if (buffer) {
+      buffer->exited = true;
+    }
+  }
+
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+thread_local ThreadState tThreadState;
+
+ThreadBuffer& GetThreadBuffer() {
+  if (!tThreadState.buffer) {
+    auto buffer = std::make_shared<ThreadBuffer>(gBufferSize.load());
+    auto& instance = GetInstance();
+    std::scoped_lock lock{instance.mutex};
+    buffer->id = instance.nextThreadId++;
+    instance.buffers.emplace_back(buffer);
+    tThreadState.buffer = std::move(buffer);
+  }
+  return *tThreadState.buffer;
+}
+
+void Record(uint16_t zone, TraceEvent::Type type) noexcept {
+  if (!gRunning.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  auto& buffer = GetThreadBuffer();
+  uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  if (head - buffer.tail.load(std::memory_order_acquire) > buffer.mask) {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events[head & buffer.mask] = {SteadyNanoseconds(), zone, type};
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+}  // namespace
+
+Instance::~Instance() {
+  gRunning = false;
+  {
+    std::scoped_lock lock{mutex};
+    stopping = true;
+  }
+  cond.notify_all();
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+void Instance::Flush() {
+  if (!log) {
+    return;
+  }
+
+  if (loggedZones != zones.size()) {
+    zonesEntry.Append(zones);
+    loggedZones = zones.size();
+  }
+
+  uint64_t dropped = exitedDropped;
+  for (auto it = buffers.begin(); it != buffers.end();) {
+    auto& buffer = **it;
+    if (!buffer.entry) {
+      buffer.entry = wpi::log::StructArrayLogEntry<TraceEvent>{
+          *log, fmt::format("TraceProfiler/Threads/{}", buffer.id),
+          buffer.name};
+      buffer.nameChanged = false;
+    } else if (buffer.nameChanged) {
+      buffer.entry.SetMetadata(buffer.name);
+      buffer.nameChanged = false;
+    }
+
+    // Read exited before the events so no events are missed when the
+    // buffer is removed
+    bool exited = buffer.exited.load();
+    uint64_t tail = buffer.tail.load(std::memory_order_relaxed);
+    uint64_t head = buffer.head.load(std::memory_order_acquire);
+    scratch.clear();
+    for (; tail != head; ++tail) {
+      auto event = buffer.events[tail & buffer.mask];
+      event.time += timeOffset;
+      scratch.emplace_back(event);
+    }
+    buffer.tail.store(tail, std::memory_order_release);
+    if (!scratch.empty()) {
+      buffer.entry.Append(scratch);
+    }
+
+    uint64_t bufferDropped = buffer.dropped.load(std::memory_order_relaxed);
+    dropped += bufferDropped;
+    if (exited) {
+      exitedDropped += bufferDropped;
+      it = buffers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (dropped != loggedDropped) {
+    droppedEntry.Append(dropped);
+    loggedDropped = dropped;
+  }
+}
+
+void Instance::Run() {
+  std::unique_lock lock{mutex};
+  while (!stopping) {
+    cond.wait_for(lock, flushPeriod);
+    Flush();
+  }
+}
+
+void TraceProfiler::Start(wpi::log::DataLog& log, units::second_t flushPeriod,
+                          size_t bufferSize) {
+  auto& instance = GetInstance();
+  std::scoped_lock lock{instance.mutex};
+  if (instance.log) {
+    return;
+  }
+
+  gBufferSize = std::bit_ceil(bufferSize);
+  instance.log = &log;
+  instance.zonesEntry =
+      wpi::log::StringArrayLogEntry{log, "TraceProfiler/Zones"};
+  instance.droppedEntry =
+      wpi::log::IntegerLogEntry{log, "TraceProfiler/Dropped"};
+  instance.loggedZones = 0;
+  instance.loggedDropped = 0;
+  instance.exitedDropped = 0;
+  for (auto&& buffer : instance.buffers) {
+    buffer->entry = {};
+    buffer->dropped = 0;
+    buffer->tail = buffer->head.load();
+  }
+  instance.timeOffset =
+      static_cast<int64_t>(wpi::Now()) * 1000 - SteadyNanoseconds();
+  instance.flushPeriod = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>{flushPeriod.value()});
+  instance.stopping = false;
+  instance.thread = std::thread{[&instance] { instance.Run(); }};
+  gRunning = true;
+}
+
+void TraceProfiler::Stop() {
+  auto& instance = GetInstance();
+  gRunning = false;
+  {
+    std::scoped_lock lock{instance.mutex};
+    if (!instance.log) {
+      return;
+    }
+    instance.stopping = true;
+  }
+  instance.cond.notify_all();
+  if (instance.thread.joinable()) {
+    instance.thread.join();
+  }
+
+  std::scoped_lock lock{instance.mutex};
+  instance.Flush();
+  for (auto&& buffer : instance.buffers) {
+    buffer->entry = {};
+  }
+  instance.zonesEntry = {};
+  instance.droppedEntry = {};
+  instance.log = nullptr;
+}
+
+bool TraceProfiler::IsRunning() {
+  return gRunning;
+}
+
+void TraceProfiler::Flush() {
+  auto& instance = GetInstance();
+  std::scoped_lock lock{instance.mutex};
+  instance.Flush();
+}
+
+uint16_t TraceProfiler::GetZone(std::string_view name) {
+  auto& instance = GetInstance();
+  {
+    std::scoped_lock lock{instance.mutex};
+    auto it = instance.zoneIds.find(name);
+    if (it != instance.zoneIds.end()) {
+      return it->second;
+    }
+    if (instance.zones.size() < kOverflowZone) {
+      uint16_t zone = instance.zones.size();
+      instance.zoneIds.try_emplace(name, zone);
+      instance.zones.emplace_back(name);
+      return zone;
+    }
+    if (instance.zones.size() > kOverflowZone) {
+      return kOverflowZone;
+    }
+    // The IDs ran out, so this and later zones share the last one
+    instance.zones.emplace_back("(too many zones)");
+  }
+  FRC_ReportError(err::NoAvailableResources,
+                  "TraceProfiler has more than {} zones; recording zone '{}' "
+                  "and any later zones as zone {}",
+                  kOverflowZone, name, kOverflowZone);
+  return kOverflowZone;
+}
+
+void TraceProfiler::SetThreadName(std::string_view name) {
+  auto& buffer = GetThreadBuffer();
+  std::scoped_lock lock{GetInstance().mutex};
+  buffer.name = name;
+  buffer.nameChanged = true;
+}
+
+void TraceProfiler::Begin(uint16_t zone) noexcept {
+  Record(zone, TraceEvent::kBegin);
+}
+
+void TraceProfiler::End(uint16_t zone) noexcept {
+  Record(zone, TraceEvent::kEnd);
+}
@@ -22,7 +22,17 @@ void Tracer::ResetTimer() {
 
 void Tracer::ClearEpochs() {
   ResetTimer();
-  m_epochs.clear();
+
+  // Epochs added every cycle keep their entries so adding them again doesn't
+  // allocate. Entries that weren't added since the last clear are removed.
+  for (auto it = m_epochs.begin(); it != m_epochs.end();) {
+    auto current = it++;
+    if (current->second == kClearedEpoch) {
+      m_epochs.erase(current);
+    } else {
+      current->second = kClearedEpoch;
+    }
+  }
 }
 
 void Tracer::AddEpoch(std::string_view epochName) {
@@ -48,6 +58,9 @@ void Tracer::PrintEpochs(wpi::raw_ostream& os) {
   if (now - m_lastEpochsPrintTime > kMinPrintPeriod) {
     m_lastEpochsPrintTime = now;
     for (const auto& epoch : m_epochs) {
+      if (epoch.second == kClearedEpoch) {
+        continue;
+      }
       os << fmt::format(
           "\t{}: {:.6f}s\n", epoch.first,
           duration_cast<microseconds>(epoch.second).count() / 1.0e6);
@@ -0,0 +1,128 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/internal/TimerWheel.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace frc::internal;
+
+TimerWheel::TimerWheel(uint64_t now) : m_tick{now / kTickLength} {}
+
+void TimerWheel::Add(const Timer& timer) {
+  Insert(timer);
+  ++m_size;
+}
+
+void TimerWheel::Advance(uint64_t now, std::vector<Timer>* expired) {
+  uint64_t target = now / kTickLength;
+
+  if (target > m_tick && target - m_tick > m_size + kSlots) {
+    // Walking a long gap tick by tick costs more than reinserting everything
+    // relative to the new tick
+    std::vector<Timer> timers;
+    timers.reserve(m_size);
+    for (auto& level : m_slots) {
+      for (auto& slot : level) {
+        timers.insert(timers.end(), slot.begin(), slot.end());
+        slot.clear();
+      }
+    }
+    timers.insert(timers.end(), m_overflow.begin(), m_overflow.end());
+    m_overflow.clear();
+
+    m_tick = target;
+    for (auto&& timer : timers) {
+      Insert(timer);
+    }
+  }
+
+  for (;;) {
+    // Expire the due timers of the current tick. Timers added with deadlines
+    // in the past also end up here.
+    auto& slot = m_slots[0][m_tick & (kSlots - 1)];
+    auto due = std::stable_partition(
+        slot.begin(), slot.end(),
+        [&](const Timer& timer) { return timer.deadline > now; });
+    expired->insert(expired->end(), due, slot.end());
+    m_size -= slot.end() - due;
+    slot.erase(due, slot.end());
+
+    if (m_tick >= target) {
+      break;
+    }
+    ++m_tick;
+
+    // Move timers down from the higher levels that wrapped around, highest
+    // first so they can cascade through several levels in one tick
+    if ((m_tick & ((uint64_t{1} << (kSlotBits * kLevels)) - 1)) == 0) {
+      auto overflow = std::move(m_overflow);
+      m_overflow.clear();
+      for (auto&& timer : overflow) {
+        Insert(timer);
+      }
+    }
+    for (int level = kLevels - 1; level > 0; --level) {
+      if ((m_tick & ((uint64_t{1} << (kSlotBits * level)) - 1)) == 0) {
+        Cascade(level);
+      }
+    }
+  }
+}
+
+std::optional<uint64_t> TimerWheel::NextDeadline() const {
+  if (m_size == 0) {
+    return std::nullopt;
+  }
+
+  auto earliest = [](const std::vector<Timer>& timers) {
+    return std::min_element(timers.begin(), timers.end(),
+                            [](const Timer& a, const Timer& b) {
+                              return a.deadline < b.deadline;
+                            })
+        ->deadline;
+  };
+
+  // Each level only holds timers later than every timer on the levels below
+  // it, and its slots after the current one are in deadline order
+  for (int level = 0; level < kLevels; ++level) {
+    for (int i = (m_tick >> (kSlotBits * level)) & (kSlots - 1); i < kSlots;
+         ++i) {
+      if (!m_slots[level][i].empty()) {
+        return earliest(m_slots[level][i]);
+      }
+    }
+  }
+  return earliest(m_overflow);
+}
+
+void TimerWheel::Insert(const Timer& timer) {
+  uint64_t tick = timer.deadline / kTickLength;
+  if (tick <= m_tick) {
+    m_slots[0][m_tick & (kSlots - 1)].emplace_back(timer);
+    return;
+  }
+
+  // Use the lowest level on which the deadline is in the same block of slots
+  // as the current tick
+  for (int level = 0; level < kLevels; ++level) {
+    int shift = kSlotBits * (level + 1);
+    if ((tick >> shift) == (m_tick >> shift)) {
+      m_slots[level][(tick >> (kSlotBits * level)) & (kSlots - 1)]
+          .emplace_back(timer);
+      return;
+    }
+  }
+  m_overflow.emplace_back(timer);
+}
+
+void TimerWheel::Cascade(int level) {
+  auto timers = std::move(
+      m_slots[level][(m_tick >> (kSlotBits * level)) & (kSlots - 1)]);
+  m_slots[level][(m_tick >> (kSlotBits * level)) & (kSlots - 1)].clear();
+  for (auto&& timer : timers) {
+    Insert(timer);
+  }
+}
@@ -0,0 +1,87 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/simulation/LockstepSimulation.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <hal/simulation/MockHooks.h>
+#include <hal/simulation/SimContext.h>
+
+#include "frc/Errors.h"
+#include "frc/RobotBase.h"
+#include "frc/RobotController.h"
+
+using namespace frc;
+using namespace frc::sim;
+
+LockstepSimulation::LockstepSimulation(units::second_t physicsPeriod) {
+  // Physics steps are whole microseconds, so a shorter period would never
+  // advance
+  if (physicsPeriod < 1_us) {
+    throw FRC_MakeError(err::ParameterOutOfRange,
+                        "physicsPeriod must be at least 1 us, got {}",
+                        physicsPeriod);
+  }
+  m_physicsPeriod = static_cast<uint64_t>(physicsPeriod.value() * 1e6);
+  m_wasPaused = static_cast<bool>(HALSIM_IsTimingPaused());
+  HALSIM_PauseTiming();
+  m_nextPhysics = RobotController::GetFPGATime() + m_physicsPeriod;
+}
+
+LockstepSimulation::~LockstepSimulation() {
+  if (m_robot) {
+    m_robot->EndCompetition();
+    m_robotThread.join();
+  }
+  if (!m_wasPaused) {
+    HALSIM_ResumeTiming();
+  }
+}
+
+void LockstepSimulation::AddPhysics(
+    std::function<void(units::second_t)> update) {
+  m_physics.emplace_back(std::move(update));
+}
+
+void LockstepSimulation::StartRobot(RobotBase& robot) {
+  if (m_robot) {
+    throw FRC_MakeError(err::IncompatibleMode,
+                        "A robot was already started in this simulation");
+  }
+  m_robot = &robot;
+  // The robot runs in this thread's simulation context
+  int32_t simContext = HALSIM_GetThreadSimContext();
+  m_robotThread = std::thread{[&robot, simContext] {
+    HALSIM_SetThreadSimContext(simContext);
+    robot.StartCompetition();
+  }};
+  HALSIM_StepTimingLockstep(0);
+}
+
+void LockstepSimulation::Step(units::second_t duration) {
+  uint64_t time = RobotController::GetFPGATime();
+  uint64_t end = time + static_cast<uint64_t>(duration.value() * 1e6);
+  while (time < end) {
+    uint64_t next = (std::min)(m_nextPhysics, end);
+    HALSIM_StepTimingLockstep(next - time);
+    time = next;
+
+    // Physics runs after the notifiers due at the same time, so it sees the
+    // outputs they set
+    if (time == m_nextPhysics) {
+      units::second_t dt{m_physicsPeriod * 1e-6};
+      for (auto&& update : m_physics) {
+        update(dt);
+      }
+      m_nextPhysics += m_physicsPeriod;
+    }
+  }
+}
+
+units::second_t LockstepSimulation::GetTime() const {
+  return units::microsecond_t{
+      static_cast<double>(RobotController::GetFPGATime())};
+}
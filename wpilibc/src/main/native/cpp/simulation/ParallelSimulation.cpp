@@ -0,0 +1,116 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/simulation/ParallelSimulation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+#include <hal/simulation/SimContext.h>
+#include <wpi/DataLogWriter.h>
+#include <wpi/fs.h>
+#include <wpi/raw_ostream.h>
+#include <wpi/scope>
+
+#include "frc/Errors.h"
+
+using namespace frc::sim;
+
+ParallelSimulation::ParallelSimulation(int threads) : m_threads{threads} {
+  if (m_threads <= 0) {
+    m_threads =
+        (std::max)(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  }
+}
+
+void ParallelSimulation::SetLogDirectory(std::string_view directory) {
+  m_logDirectory = directory;
+}
+
+std::vector<ParallelSimulation::Result> ParallelSimulation::Run(
+    int count, RunFunction run) {
+  std::vector<Result> results(count);
+  std::atomic<int> nextIndex{0};
+  std::mutex errorMutex;
+  std::exception_ptr error;
+
+  auto worker = [&] {
+    for (int index = nextIndex++; index < count; index = nextIndex++) {
+      try {
+        results[index] = RunOne(index, run);
+      } catch (...) {
+        std::scoped_lock lock{errorMutex};
+        if (!error) {
+          error = std::current_exception();
+        }
+        nextIndex = count;
+      }
+    }
+  };
+
+  // The calling thread runs simulations too
+  std::vector<std::thread> threads;
+  for (int i = 1; i < (std::min)(m_threads, count); ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return results;
+}
+
+ParallelSimulation::Result ParallelSimulation::RunOne(int index,
+                                                      const RunFunction& run) {
+  Result result;
+
+  int32_t prevContext = HALSIM_GetThreadSimContext();
+  int32_t context = HALSIM_CreateSimContext();
+  HALSIM_SetThreadSimContext(context);
+  auto destroyContext = [&] {
+    HALSIM_SetThreadSimContext(prevContext);
+    return HALSIM_DestroySimContext(context);
+  };
+  wpi::scope_exit destroyOnError{[&] { destroyContext(); }};
+
+  std::unique_ptr<wpi::log::DataLogWriter> log;
+  if (m_logDirectory.empty()) {
+    log = std::make_unique<wpi::log::DataLogWriter>(
+        std::make_unique<wpi::raw_uvector_ostream>(result.log));
+  } else {
+    auto filename =
+        (fs::path{m_logDirectory} / fmt::format("run_{}.wpilog", index))
+            .string();
+    std::error_code ec;
+    log = std::make_unique<wpi::log::DataLogWriter>(filename, ec);
+    if (ec) {
+      throw FRC_MakeError(err::Error, "could not open log file {}: {}",
+                          filename, ec.message());
+    }
+  }
+
+  result.score = run(index, *log);
+  // Write out the rest of the log
+  log.reset();
+
+  destroyOnError.release();
+  if (!destroyContext()) {
+    throw FRC_MakeError(err::Error,
+                        "simulation run {} left threads (such as Notifiers) "
+                        "running in its simulation context",
+                        index);
+  }
+  return result;
+}
@@ -0,0 +1,168 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/simulation/SimBatch.h"
+
+#include <cmath>
+#include <limits>
+
+#include "frc/StateSpaceUtil.h"
+#include "frc/simulation/DCMotorSim.h"
+#include "frc/simulation/ElevatorSim.h"
+#include "frc/simulation/FlywheelSim.h"
+#include "frc/simulation/SingleJointedArmSim.h"
+#include "frc/system/Discretization.h"
+
+using namespace frc;
+using namespace frc::sim;
+
+void SimBatch::Add(FlywheelSim& sim) {
+  m_flywheels.sims.emplace_back(&sim);
+}
+
+void SimBatch::Add(DCMotorSim& sim) {
+  constexpr double kInf = std::numeric_limits<double>::infinity();
+  m_motors.Add(sim, 0.0, 0.0, -kInf, kInf);
+}
+
+void SimBatch::Add(ElevatorSim& sim) {
+  m_elevators.Add(sim, sim.m_simulateGravity ? -9.8 : 0.0, 0.0,
+                  sim.m_minHeight.value(), sim.m_maxHeight.value());
+}
+
+void SimBatch::Add(SingleJointedArmSim& sim) {
+  // See SingleJointedArmSim::UpdateX() for the derivation
+  m_arms.Add(sim, 0.0,
+             sim.m_simulateGravity ? 3.0 / 2.0 * -9.8 / sim.m_armLen.value()
+                                   : 0.0,
+             sim.m_minAngle.value(), sim.m_maxAngle.value());
+}
+
+void SimBatch::Update(units::second_t dt) {
+  bool redo = dt.value() != m_dt.value();
+  m_dt = dt;
+  m_flywheels.Update(dt, redo);
+  m_motors.Update(dt, redo);
+  m_elevators.Update(dt, redo);
+  m_arms.Update(dt, redo);
+}
+
+void SimBatch::FirstOrder::Update(units::second_t dt, bool redo) {
+  size_t size = sims.size();
+  if (redo) {
+    discretized = 0;
+  }
+  a.resize(size);
+  b.resize(size);
+  x.resize(size);
+  u.resize(size);
+  for (; discretized < size; ++discretized) {
+    Matrixd<1, 1> discA;
+    Matrixd<1, 1> discB;
+    auto& plant = sims[discretized]->m_plant;
+    DiscretizeAB<1, 1>(plant.A(), plant.B(), dt, &discA, &discB);
+    a[discretized] = discA(0, 0);
+    b[discretized] = discB(0, 0);
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = sims[i]->m_x(0);
+    u[i] = sims[i]->m_u(0);
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = a[i] * x[i] + b[i] * u[i];
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    auto& sim = *sims[i];
+    sim.m_x(0) = x[i];
+    sim.m_y = sim.m_plant.CalculateY(sim.m_x, sim.m_u);
+    if (sim.HasMeasurementNoise()) {
+      sim.m_y += MakeWhiteNoiseVector(sim.m_measurementStdDevs);
+    }
+  }
+}
+
+void SimBatch::SecondOrder::Add(LinearSystemSim<2, 1, 2>& sim, double accel,
+                                double cosAccel, double minPosition,
+                                double maxPosition) {
+  sims.emplace_back(&sim);
+  this->accel.emplace_back(accel);
+  this->cosAccel.emplace_back(cosAccel);
+  this->minPosition.emplace_back(minPosition);
+  this->maxPosition.emplace_back(maxPosition);
+}
+
+void SimBatch::SecondOrder::Update(units::second_t dt, bool redo) {
+  size_t size = sims.size();
+  if (redo) {
+    discretized = 0;
+  }
+  for (auto vec : {&a00, &a01, &a10, &a11, &b0, &b1, &g0, &g1, &x0, &x1, &u}) {
+    vec->resize(size);
+  }
+  for (; discretized < size; ++discretized) {
+    // Gravity is discretized as a second input, which accelerates the velocity
+    auto& plant = sims[discretized]->m_plant;
+    Matrixd<2, 2> contB;
+    contB << plant.B(0, 0), 0.0, plant.B(1, 0), 1.0;
+    Matrixd<2, 2> discA;
+    Matrixd<2, 2> discB;
+    DiscretizeAB<2, 2>(plant.A(), contB, dt, &discA, &discB);
+
+    size_t i = discretized;
+    a00[i] = discA(0, 0);
+    a01[i] = discA(0, 1);
+    a10[i] = discA(1, 0);
+    a11[i] = discA(1, 1);
+    b0[i] = discB(0, 0);
+    b1[i] = discB(1, 0);
+    g0[i] = discB(0, 1);
+    g1[i] = discB(1, 1);
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    x0[i] = sims[i]->m_x(0);
+    x1[i] = sims[i]->m_x(1);
+    u[i] = sims[i]->m_u(0);
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    double next0 = a00[i] * x0[i] + a01[i] * x1[i] + b0[i] * u[i];
+    double next1 = a10[i] * x0[i] + a11[i] * x1[i] + b1[i] * u[i];
+
+    // Predict the position at the end of the step with the gravity at the
+    // start, then use the gravity at the midpoint
+    double gravity = accel[i];
+    if (cosAccel[i] != 0.0) {
+      double predicted =
+          next0 + g0[i] * (gravity + cosAccel[i] * std::cos(x0[i]));
+      gravity += cosAccel[i] * std::cos((x0[i] + predicted) / 2.0);
+    }
+    next0 += g0[i] * gravity;
+    next1 += g1[i] * gravity;
+
+    // Check for collisions
+    if (next0 <= minPosition[i]) {
+      next0 = minPosition[i];
+      next1 = 0.0;
+    } else if (next0 >= maxPosition[i]) {
+      next0 = maxPosition[i];
+      next1 = 0.0;
+    }
+    x0[i] = next0;
+    x1[i] = next1;
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    auto& sim = *sims[i];
+    sim.m_x(0) = x0[i];
+    sim.m_x(1) = x1[i];
+    sim.m_y = sim.m_plant.CalculateY(sim.m_x, sim.m_u);
+    if (sim.HasMeasurementNoise()) {
+      sim.m_y += MakeWhiteNoiseVector(sim.m_measurementStdDevs);
+    }
+  }
+}
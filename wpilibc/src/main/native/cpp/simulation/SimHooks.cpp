@@ -44,6 +44,10 @@ void StepTiming(units::second_t delta) {
   HALSIM_StepTiming(static_cast<uint64_t>(delta.value() * 1e6));
 }
 
+void StepTimingLockstep(units::second_t delta) {
+  HALSIM_StepTimingLockstep(static_cast<uint64_t>(delta.value() * 1e6));
+}
+
 void StepTimingAsync(units::second_t delta) {
   HALSIM_StepTimingAsync(static_cast<uint64_t>(delta.value() * 1e6));
 }
@@ -7,7 +7,6 @@
 #include <memory>
 #include <utility>
 
-#include <networktables/DoubleArrayTopic.h>
 #include <networktables/NTSendableBuilder.h>
 #include <wpi/sendable/SendableRegistry.h>
 
@@ -22,6 +21,7 @@ Field2d::Field2d() {
 
 Field2d::Field2d(Field2d&& rhs) : SendableHelper(std::move(rhs)) {
   std::swap(m_table, rhs.m_table);
+  std::swap(m_structPublishing, rhs.m_structPublishing);
   std::swap(m_objects, rhs.m_objects);
 }
 
@@ -29,6 +29,7 @@ Field2d& Field2d::operator=(Field2d&& rhs) {
   SendableHelper::operator=(std::move(rhs));
 
   std::swap(m_table, rhs.m_table);
+  std::swap(m_structPublishing, rhs.m_structPublishing);
   std::swap(m_objects, rhs.m_objects);
 
   return *this;
@@ -61,7 +62,7 @@ FieldObject2d* Field2d::GetObject(std::string_view name) {
       std::make_unique<FieldObject2d>(name, FieldObject2d::private_init{}));
   auto obj = m_objects.back().get();
   if (m_table) {
-    obj->m_entry = m_table->GetDoubleArrayTopic(obj->m_name).GetEntry({});
+    obj->SetTable(m_table, m_structPublishing);
   }
   return obj;
 }
@@ -71,6 +72,22 @@ FieldObject2d* Field2d::GetRobotObject() {
   return m_objects[0].get();
 }
 
+void Field2d::SetStructPublishing(bool enable) {
+  std::scoped_lock lock(m_mutex);
+  if (m_structPublishing == enable) {
+    return;
+  }
+  m_structPublishing = enable;
+  if (m_table) {
+    for (auto&& obj : m_objects) {
+      std::scoped_lock lock2(obj->m_mutex);
+      obj->UpdateFromEntry();
+      obj->SetTable(m_table, m_structPublishing);
+      obj->UpdateEntry();
+    }
+  }
+}
+
 void Field2d::InitSendable(nt::NTSendableBuilder& builder) {
   builder.SetSmartDashboardType("Field2d");
 
@@ -78,7 +95,7 @@ void Field2d::InitSendable(nt::NTSendableBuilder& builder) {
   m_table = builder.GetTable();
   for (auto&& obj : m_objects) {
     std::scoped_lock lock2(obj->m_mutex);
-    obj->m_entry = m_table->GetDoubleArrayTopic(obj->m_name).GetEntry({});
+    obj->SetTable(m_table, m_structPublishing);
     obj->UpdateEntry(true);
   }
 }
@@ -4,23 +4,50 @@
 
 #include "frc/smartdashboard/FieldObject2d.h"
 
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+#include <ntcore_cpp.h>
+
 #include "frc/trajectory/Trajectory.h"
 
 using namespace frc;
 
+namespace {
+
+// Maximum number of poses in each chunk when publishing struct arrays
+constexpr size_t kChunkSize = 64;
+
+// Returns true if the poses serialize the same
+bool SamePose(const Pose2d& a, const Pose2d& b) {
+  return a.X().value() == b.X().value() && a.Y().value() == b.Y().value() &&
+         a.Rotation().Radians().value() == b.Rotation().Radians().value();
+}
+
+}  // namespace
+
 FieldObject2d::FieldObject2d(FieldObject2d&& rhs) {
   std::swap(m_name, rhs.m_name);
   std::swap(m_entry, rhs.m_entry);
   std::swap(m_poses, rhs.m_poses);
+  std::swap(m_table, rhs.m_table);
+  std::swap(m_chunks, rhs.m_chunks);
+  std::swap(m_chunkChanges, rhs.m_chunkChanges);
+  std::swap(m_resendChunks, rhs.m_resendChunks);
 }
 
 FieldObject2d& FieldObject2d::operator=(FieldObject2d&& rhs) {
   std::swap(m_name, rhs.m_name);
   std::swap(m_entry, rhs.m_entry);
   std::swap(m_poses, rhs.m_poses);
+  std::swap(m_table, rhs.m_table);
+  std::swap(m_chunks, rhs.m_chunks);
+  std::swap(m_chunkChanges, rhs.m_chunkChanges);
+  std::swap(m_resendChunks, rhs.m_resendChunks);
 
   return *this;
 }
@@ -45,8 +72,26 @@ Pose2d FieldObject2d::GetPose() const {
 
 void FieldObject2d::SetPoses(std::span<const Pose2d> poses) {
   std::scoped_lock lock(m_mutex);
+  if (m_chunks.empty()) {
+    m_poses.assign(poses.begin(), poses.end());
+    UpdateEntry();
+    return;
+  }
+
+  // Find the range of poses that changed, so only the chunks in it are set
+  size_t begin = 0;
+  size_t common = (std::min)(m_poses.size(), poses.size());
+  while (begin < common && SamePose(m_poses[begin], poses[begin])) {
+    ++begin;
+  }
+  size_t end = (std::max)(m_poses.size(), poses.size());
+  if (m_poses.size() == poses.size()) {
+    while (end > begin && SamePose(m_poses[end - 1], poses[end - 1])) {
+      --end;
+    }
+  }
   m_poses.assign(poses.begin(), poses.end());
-  UpdateEntry();
+  UpdateChunks(begin, end);
 }
 
 void FieldObject2d::SetPoses(std::initializer_list<Pose2d> poses) {
@@ -54,13 +99,12 @@ void FieldObject2d::SetPoses(std::initializer_list<Pose2d> poses) {
 }
 
 void FieldObject2d::SetTrajectory(const Trajectory& trajectory) {
-  std::scoped_lock lock(m_mutex);
-  m_poses.clear();
-  m_poses.reserve(trajectory.States().size());
+  std::vector<Pose2d> poses;
+  poses.reserve(trajectory.States().size());
   for (auto&& state : trajectory.States()) {
-    m_poses.push_back(state.pose);
+    poses.push_back(state.pose);
   }
-  UpdateEntry();
+  SetPoses(poses);
 }
 
 std::vector<Pose2d> FieldObject2d::GetPoses() const {
@@ -77,7 +121,28 @@ std::span<const Pose2d> FieldObject2d::GetPoses(
   return out;
 }
 
+void FieldObject2d::SetTable(std::shared_ptr<nt::NetworkTable> table,
+                             bool structPoses) {
+  m_entry = {};
+  m_chunks.clear();
+  m_chunkChanges.clear();
+  m_resendChunks = false;
+  m_table.reset();
+  if (structPoses) {
+    m_chunks.emplace_back(
+        table->GetStructArrayTopic<Pose2d>(m_name).GetEntry({}));
+    m_chunkChanges.emplace_back(-1);
+    m_table = std::move(table);
+  } else {
+    m_entry = table->GetDoubleArrayTopic(m_name).GetEntry({});
+  }
+}
+
 void FieldObject2d::UpdateEntry(bool setDefault) {
+  if (!m_chunks.empty()) {
+    UpdateChunks(0, (std::numeric_limits<size_t>::max)(), setDefault);
+    return;
+  }
   if (!m_entry) {
     return;
   }
@@ -95,7 +160,75 @@ void FieldObject2d::UpdateEntry(bool setDefault) {
   }
 }
 
+void FieldObject2d::UpdateChunks(size_t begin, size_t end, bool setDefault) {
+  size_t numChunks = (m_poses.size() + kChunkSize - 1) / kChunkSize;
+  while (m_chunks.size() < numChunks) {
+    m_chunks.emplace_back(
+        m_table
+            ->GetStructArrayTopic<Pose2d>(
+                fmt::format(".{}/{}", m_name, m_chunks.size()))
+            .GetEntry({}));
+    m_chunkChanges.emplace_back(-1);
+  }
+
+  if (m_resendChunks) {
+    begin = 0;
+    end = (std::numeric_limits<size_t>::max)();
+    m_resendChunks = false;
+  }
+
+  int64_t time = nt::Now();
+  std::span<const Pose2d> poses{m_poses};
+  for (size_t i = 0; i < m_chunks.size(); ++i) {
+    size_t chunkBegin = i * kChunkSize;
+    size_t chunkEnd = chunkBegin + kChunkSize;
+    // Chunks outside of the changed range are still set if a dashboard
+    // changed them
+    if ((chunkEnd <= begin || chunkBegin >= end) &&
+        m_chunks[i].GetLastChange() == m_chunkChanges[i]) {
+      continue;
+    }
+    auto chunk = poses.subspan((std::min)(chunkBegin, poses.size()));
+    chunk = chunk.first((std::min)(kChunkSize, chunk.size()));
+    if (setDefault) {
+      m_chunks[i].SetDefault(chunk);
+    } else {
+      m_chunks[i].Set(chunk, time);
+    }
+    // NT ignores a value equal to the current one, so the last change time
+    // isn't necessarily the time the chunk was set
+    m_chunkChanges[i] = m_chunks[i].GetLastChange();
+  }
+}
+
 void FieldObject2d::UpdateFromEntry() const {
+  if (!m_chunks.empty()) {
+    // Only read the chunks if a dashboard changed one of them
+    bool changed = false;
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+      if (m_chunks[i].GetLastChange() != m_chunkChanges[i]) {
+        changed = true;
+        break;
+      }
+    }
+    if (!changed) {
+      return;
+    }
+
+    // The poses are the chunks up to the first empty one
+    m_poses.clear();
+    m_resendChunks = true;
+    bool ended = false;
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+      m_chunkChanges[i] = m_chunks[i].GetLastChange();
+      auto chunk = m_chunks[i].Get();
+      ended = ended || chunk.empty();
+      if (!ended) {
+        m_poses.append(chunk.begin(), chunk.end());
+      }
+    }
+    return;
+  }
   if (!m_entry) {
     return;
   }
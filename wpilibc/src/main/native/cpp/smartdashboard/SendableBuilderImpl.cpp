@@ -4,9 +4,15 @@
 
 #include "frc/smartdashboard/SendableBuilderImpl.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <networktables/BooleanArrayTopic.h>
 #include <networktables/BooleanTopic.h>
@@ -24,17 +30,128 @@
 
 using namespace frc;
 
+namespace {
+
+// Batch of the innermost BatchScope on this thread
+thread_local SendableBuilderImpl::UpdateBatch* gThreadBatch = nullptr;
+
+void SetBatchValues(SendableBuilderImpl::UpdateBatch& batch) {
+  if (!batch.handles.empty()) {
+    nt::SetEntryValues(batch.handles, batch.values);
+    batch.handles.clear();
+    batch.values.clear();
+  }
+}
+
+// Makes a value from the result of a property getter
+nt::Value MakeValue(bool value, int64_t time) {
+  return nt::Value::MakeBoolean(value, time);
+}
+
+nt::Value MakeValue(int64_t value, int64_t time) {
+  return nt::Value::MakeInteger(value, time);
+}
+
+nt::Value MakeValue(float value, int64_t time) {
+  return nt::Value::MakeFloat(value, time);
+}
+
+nt::Value MakeValue(double value, int64_t time) {
+  return nt::Value::MakeDouble(value, time);
+}
+
+nt::Value MakeValue(std::string_view value, int64_t time) {
+  return nt::Value::MakeString(value, time);
+}
+
+nt::Value MakeValue(std::span<const int> value, int64_t time) {
+  return nt::Value::MakeBooleanArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const int64_t> value, int64_t time) {
+  return nt::Value::MakeIntegerArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const float> value, int64_t time) {
+  return nt::Value::MakeFloatArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const double> value, int64_t time) {
+  return nt::Value::MakeDoubleArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const std::string> value, int64_t time) {
+  return nt::Value::MakeStringArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const uint8_t> value, int64_t time) {
+  return nt::Value::MakeRaw(value, time);
+}
+
+// Wraps a property getter to only make a value when the result changed.
+// The last result is kept in the getter's own type so that comparing it
+// doesn't allocate.
+template <typename Getter>
+auto MakeChangedValueGetter(Getter getter) {
+  using T = std::invoke_result_t<Getter&>;
+  return [getter = std::move(getter), last = std::optional<T>{}](
+             int64_t time, bool force) mutable -> std::optional<nt::Value> {
+    auto value = getter();
+    if (!force && last && *last == value) {
+      return {};
+    }
+    auto ntValue = MakeValue(value, time);
+    last = std::move(value);
+    return ntValue;
+  };
+}
+
+// Same as MakeChangedValueGetter(), for getters that return a view of a
+// SmallVector buffer; the last result is copied into a vector.
+template <typename T, size_t Size, typename Getter>
+auto MakeSmallChangedValueGetter(Getter getter) {
+  return [getter = std::move(getter), last = std::optional<std::vector<T>>{}](
+             int64_t time, bool force) mutable -> std::optional<nt::Value> {
+    wpi::SmallVector<T, Size> buf;
+    auto value = getter(buf);
+    if (!force && last && std::ranges::equal(*last, value)) {
+      return {};
+    }
+    if (!last) {
+      last.emplace();
+    }
+    last->assign(value.begin(), value.end());
+    return MakeValue(value, time);
+  };
+}
+
+}  // namespace
+
 template <typename Topic>
 void SendableBuilderImpl::PropertyImpl<Topic>::Update(bool controllable,
-                                                      int64_t time) {
-  if (controllable && sub && updateLocal) {
-    updateLocal(sub);
-  }
-  if (pub && updateNetwork) {
-    updateNetwork(pub, time);
+                                                      int64_t time,
+                                                      UpdateBatch& batch) {
+  // The setter may not round trip the value, so set the getter's value even if
+  // it hasn't changed
+  bool force = controllable && sub && updateLocal && updateLocal(sub);
+  if (pub && getChangedValue) {
+    if (auto value = getChangedValue(time, force)) {
+      batch.handles.emplace_back(pub.GetHandle());
+      batch.values.emplace_back(std::move(*value));
+    }
   }
 }
 
+SendableBuilderImpl::BatchScope::BatchScope(UpdateBatch& batch)
+    : m_batch{batch}, m_previous{gThreadBatch} {
+  gThreadBatch = &m_batch;
+}
+
+SendableBuilderImpl::BatchScope::~BatchScope() {
+  gThreadBatch = m_previous;
+  SetBatchValues(m_batch);
+}
+
 void SendableBuilderImpl::SetTable(std::shared_ptr<nt::NetworkTable> table) {
   m_table = table;
   m_controllablePublisher = table->GetBooleanTopic(".controllable").Publish();
@@ -55,8 +172,12 @@ bool SendableBuilderImpl::IsActuator() const {
 
 void SendableBuilderImpl::Update() {
   uint64_t time = nt::Now();
+  auto& batch = gThreadBatch ? *gThreadBatch : m_batch;
   for (auto& property : m_properties) {
-    property->Update(m_controllable, time);
+    property->Update(m_controllable, time, batch);
+  }
+  if (&batch == &m_batch) {
+    SetBatchValues(m_batch);
   }
   for (auto& updateTable : m_updateTables) {
     updateTable();
@@ -129,17 +250,17 @@ void SendableBuilderImpl::AddPropertyImpl(Topic topic, Getter getter,
   auto prop = std::make_unique<PropertyImpl<Topic>>();
   if (getter) {
     prop->pub = topic.Publish();
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
-      pub.Set(getter(), time);
-    };
+    prop->getChangedValue = MakeChangedValueGetter(std::move(getter));
   }
   if (setter) {
     prop->sub =
         topic.Subscribe({}, {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -280,17 +401,17 @@ void SendableBuilderImpl::AddRawProperty(
   auto prop = std::make_unique<PropertyImpl<nt::RawTopic>>();
   if (getter) {
     prop->pub = topic.Publish(typeString);
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
-      pub.Set(getter(), time);
-    };
+    prop->getChangedValue = MakeChangedValueGetter(std::move(getter));
   }
   if (setter) {
     prop->sub = topic.Subscribe(typeString, {},
                                 {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -313,18 +434,18 @@ void SendableBuilderImpl::AddSmallPropertyImpl(Topic topic, Getter getter,
   auto prop = std::make_unique<PropertyImpl<Topic>>();
   if (getter) {
     prop->pub = topic.Publish();
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
-      wpi::SmallVector<T, Size> buf;
-      pub.Set(getter(buf), time);
-    };
+    prop->getChangedValue =
+        MakeSmallChangedValueGetter<T, Size>(std::move(getter));
   }
   if (setter) {
     prop->sub =
         topic.Subscribe({}, {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -392,18 +513,18 @@ void SendableBuilderImpl::AddSmallRawProperty(
   auto prop = std::make_unique<PropertyImpl<nt::RawTopic>>();
   if (getter) {
     prop->pub = topic.Publish(typeString);
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
-      wpi::SmallVector<uint8_t, 128> buf;
-      pub.Set(getter(buf), time);
-    };
+    prop->getChangedValue =
+        MakeSmallChangedValueGetter<uint8_t, 128>(std::move(getter));
   }
   if (setter) {
     prop->sub = topic.Subscribe(typeString, {},
                                 {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -15,6 +15,7 @@
 #include <wpi/StringMap.h>
 #include <wpi/mutex.h>
 #include <wpi/sendable/SendableRegistry.h>
+#include <wpi/timestamp.h>
 
 #include "frc/Errors.h"
 #include "frc/smartdashboard/ListenerExecutor.h"
@@ -23,12 +24,21 @@
 using namespace frc;
 
 namespace {
+struct Data {
+  wpi::SendableRegistry::UID uid = 0;
+  // Update period and next update time, in microseconds
+  uint64_t period = 0;
+  uint64_t nextUpdate = 0;
+};
+
 struct Instance {
   detail::ListenerExecutor listenerExecutor;
   std::shared_ptr<nt::NetworkTable> table =
       nt::NetworkTableInstance::GetDefault().GetTable("SmartDashboard");
-  wpi::StringMap<wpi::SendableRegistry::UID> tablesToData;
+  wpi::StringMap<Data> tablesToData;
   wpi::mutex tablesToDataMutex;
+  // Changed values of all the sendables, set together by UpdateValues()
+  SendableBuilderImpl::UpdateBatch batch;
 };
 }  // namespace
 
@@ -95,7 +105,7 @@ void SmartDashboard::PutData(std::string_view key, wpi::Sendable* data) {
   }
   auto& inst = GetInstance();
   std::scoped_lock lock(inst.tablesToDataMutex);
-  auto& uid = inst.tablesToData[key];
+  auto& uid = inst.tablesToData[key].uid;
   wpi::Sendable* sddata = wpi::SendableRegistry::GetSendable(uid);
   if (sddata != data) {
     uid = wpi::SendableRegistry::GetUniqueId(data);
@@ -126,7 +136,20 @@ wpi::Sendable* SmartDashboard::GetData(std::string_view key) {
   if (it == inst.tablesToData.end()) {
     throw FRC_MakeError(err::SmartDashboardMissingKey, "{}", key);
   }
-  return wpi::SendableRegistry::GetSendable(it->second);
+  return wpi::SendableRegistry::GetSendable(it->second.uid);
+}
+
+void SmartDashboard::SetUpdatePeriod(std::string_view key,
+                                     units::second_t period) {
+  auto& inst = GetInstance();
+  std::scoped_lock lock(inst.tablesToDataMutex);
+  auto it = inst.tablesToData.find(key);
+  if (it == inst.tablesToData.end()) {
+    throw FRC_MakeError(err::SmartDashboardMissingKey, "{}", key);
+  }
+  it->second.period =
+      period > 0_s ? static_cast<uint64_t>(period.value() * 1e6) : 0;
+  it->second.nextUpdate = 0;
 }
 
 bool SmartDashboard::PutBoolean(std::string_view keyName, bool value) {
@@ -253,7 +276,20 @@ void SmartDashboard::UpdateValues() {
   auto& inst = GetInstance();
   inst.listenerExecutor.RunListenerTasks();
   std::scoped_lock lock(inst.tablesToDataMutex);
+  SendableBuilderImpl::BatchScope batchScope{inst.batch};
+  uint64_t now = wpi::Now();
   for (auto& i : inst.tablesToData) {
-    wpi::SendableRegistry::Update(i.second);
+    auto& data = i.second;
+    if (data.period != 0) {
+      if (now < data.nextUpdate) {
+        continue;
+      }
+      data.nextUpdate += data.period;
+      if (data.nextUpdate <= now) {
+        // Skip missed updates rather than catching up on them
+        data.nextUpdate = now + data.period;
+      }
+    }
+    wpi::SendableRegistry::Update(data.uid);
   }
 }
@@ -11,6 +11,8 @@
 
 namespace frc {
 
+class TimingHistogram;
+
 /**
  * IterativeRobotBase implements a specific type of robot program framework,
  * extending the RobotBase class.
@@ -253,6 +255,18 @@ class IterativeRobotBase : public RobotBase {
    */
   void LoopFunc();
 
+  /**
+   * Sets the histograms LoopFunc() records the execution times of the periodic
+   * functions to.
+   *
+   * @param histograms An array of five histograms for RobotPeriodic(),
+   *                   DisabledPeriodic(), AutonomousPeriodic(),
+   *                   TeleopPeriodic(), and TestPeriodic(), in that order, or
+   *                   nullptr to stop recording. The array must outlive the
+   *                   recording.
+   */
+  void SetPeriodicHistograms(TimingHistogram* histograms);
+
  private:
   enum class Mode { kNone, kDisabled, kAutonomous, kTeleop, kTest };
 
@@ -262,6 +276,7 @@ class IterativeRobotBase : public RobotBase {
   bool m_ntFlushEnabled = true;
   bool m_lwEnabledInTest = false;
   bool m_calledDsConnected = false;
+  TimingHistogram* m_periodicHistograms = nullptr;
 
   void PrintLoopOverrunMessage();
 };
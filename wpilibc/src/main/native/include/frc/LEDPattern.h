@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <functional>
+#include <memory>
 #include <span>
 #include <utility>
+#include <vector>
 
 #include <units/frequency.h>
 #include <units/length.h>
@@ -18,6 +22,8 @@
 
 namespace frc {
 
+class CompiledLEDPattern;
+
 class LEDPattern {
  public:
   /**
@@ -79,6 +85,31 @@ class LEDPattern {
    */
   void ApplyTo(std::span<frc::AddressableLED::LEDData> data) const;
 
+  /**
+   * Compiles this pattern into a flat evaluation plan that writes whole
+   * buffers at a time, instead of calling through a chain of functions for
+   * every LED. The compiled pattern produces the same colors as ApplyTo(), but
+   * is much faster for long LED strips or deeply layered patterns.
+   *
+   * <p>Compile the pattern once (e.g. when a command or subsystem is
+   * constructed) and apply the compiled pattern periodically:
+   *
+   * <pre>
+   *   frc::CompiledLEDPattern m_pattern =
+   *     frc::LEDPattern::Rainbow(255, 128).ScrollAtRelativeSpeed(0.5_Hz)
+   *         .Compile();
+   *
+   *   void Periodic() override {
+   *     m_pattern.ApplyTo(m_buffer);
+   *     m_led.SetData(m_buffer);
+   *   }
+   * </pre>
+   *
+   * @return the compiled pattern
+   */
+  [[nodiscard]]
+  CompiledLEDPattern Compile() const;
+
   /**
    * Creates a pattern with remapped indices.
    *
@@ -397,8 +428,92 @@ class LEDPattern {
   static LEDPattern Rainbow(int saturation, int value);
 
  private:
+  friend class CompiledLEDPattern;
+
+  // A node of the pattern tree, used to compile the pattern
+  struct Node;
+
+  LEDPattern(std::function<void(frc::LEDPattern::LEDReader,
+                                std::function<void(int, frc::Color)>)>
+                 impl,
+             std::shared_ptr<const Node> node);
+
+  // Makes a pattern that writes each LED with impl when applied directly, and
+  // fills a whole color buffer with kernel when compiled. Both must produce
+  // the same colors.
+  static LEDPattern FromKernel(
+      std::function<void(frc::LEDPattern::LEDReader,
+                         std::function<void(int, frc::Color)>)>
+          impl,
+      std::function<void(std::span<Color>)> kernel);
+
+  LEDPattern MapIndex(std::function<size_t(size_t, size_t)> indexMapper,
+                      std::function<int64_t(size_t)> offset);
+
   std::function<void(frc::LEDPattern::LEDReader,
                      std::function<void(int, frc::Color)>)>
       m_impl;
+  std::shared_ptr<const Node> m_node;
+};
+
+/**
+ * An LEDPattern compiled into a flat list of instructions that each process a
+ * whole LED buffer at a time. Create one with LEDPattern::Compile().
+ *
+ * A compiled pattern keeps scratch buffers between calls to ApplyTo(), so
+ * applying it doesn't allocate memory unless the buffer length changes. For
+ * the same reason, a compiled pattern must not be applied from multiple
+ * threads at once.
+ */
+class CompiledLEDPattern {
+ public:
+  /**
+   * Compiles a pattern.
+   *
+   * @param pattern the pattern to compile
+   */
+  explicit CompiledLEDPattern(const LEDPattern& pattern);
+
+  /**
+   * Writes the pattern to an LED buffer. This produces the same colors as
+   * LEDPattern::ApplyTo(std::span<frc::AddressableLED::LEDData>) on the
+   * pattern that was compiled.
+   *
+   * @param data the current data of the LED strip
+   */
+  void ApplyTo(std::span<frc::AddressableLED::LEDData> data);
+
+ private:
+  struct Instruction {
+    enum Op : uint8_t {
+      kKernel,
+      kOpaque,
+      kOff,
+      kPushMap,
+      kPopMap,
+      kPushStage,
+      kPopStage,
+      kJumpUnless,
+      kJump
+    };
+    Op op;
+    const LEDPattern::Node* node = nullptr;
+    size_t target = 0;
+  };
+
+  void Emit(const LEDPattern::Node& node, size_t mapDepth, size_t stageDepth);
+  void Write(std::span<frc::AddressableLED::LEDData> data,
+             std::span<Color> colors, std::span<const size_t> indices,
+             std::span<uint8_t> valid);
+
+  std::shared_ptr<const LEDPattern::Node> m_root;
+  std::vector<Instruction> m_program;
+
+  // Scratch buffers
+  std::vector<std::vector<size_t>> m_maps;
+  std::vector<const LEDPattern::Node*> m_stages;
+  std::vector<Color> m_colors;
+  std::vector<uint8_t> m_valid;
+  size_t m_length = 0;
 };
 }  // namespace frc
@@ -18,6 +18,8 @@
 #include <units/time.h>
 #include <wpi/mutex.h>
 
+#include "frc/NotifierExecutor.h"
+
 namespace frc {
 
 /**
@@ -68,6 +70,34 @@ class Notifier {
                                      std::forward<Arg>(arg),
                                      std::forward<Args>(args)...)) {}
 
+  /**
+   * Create a Notifier with the given callback that runs on one of an
+   * executor's shared threads instead of its own thread.
+   *
+   * Configure when the callback runs with StartSingle() or StartPeriodic().
+   *
+   * @param executor The executor to run the callback on. It must outlive the
+   *                 Notifier.
+   * @param callback The callback to run.
+   */
+  Notifier(NotifierExecutor& executor, std::function<void()> callback);
+
+  /**
+   * Create a Notifier with the given callback that runs on one of an
+   * executor's shared threads instead of its own thread.
+   *
+   * Configure when the callback runs with StartSingle() or StartPeriodic().
+   *
+   * @param executor The executor to run the callback on. It must outlive the
+   *                 Notifier.
+   * @param priority The callback's priority relative to other callbacks on the
+   *                 executor that are due at the same time. Higher numbers run
+   *                 first.
+   * @param callback The callback to run.
+   */
+  Notifier(NotifierExecutor& executor, int priority,
+           std::function<void()> callback);
+
   /**
    * Free the resources for a timer event.
    */
@@ -130,6 +160,12 @@ class Notifier {
    */
   void Stop();
 
+  /**
+   * Returns the timing statistics of the callback. They're only tracked for
+   * Notifiers that run on a NotifierExecutor.
+   */
+  NotifierExecutor::Stats GetStats() const;
+
   /**
    * Sets the HAL notifier thread priority.
    *
@@ -182,6 +218,13 @@ class Notifier {
 
   // True if the callback is periodic
   bool m_periodic = false;
+
+  // The executor the callback runs on, if any, in which case there's no thread
+  // or HAL notifier
+  NotifierExecutor* m_executor = nullptr;
+
+  // The callback's handle on the executor
+  NotifierExecutor::Handle m_handle;
 };
 
 }  // namespace frc
@@ -0,0 +1,177 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <units/time.h>
+
+namespace frc {
+
+/**
+ * Runs many periodic or one-shot callbacks on a small, fixed number of
+ * threads.
+ *
+ * Each Notifier normally has its own HAL notifier and its own thread. A
+ * Notifier constructed with an executor instead shares one of the executor's
+ * threads, each of which waits on a single HAL notifier and keeps its
+ * callbacks' deadlines in a hierarchical timer wheel. This saves a thread
+ * (and its stack and context switches) per Notifier.
+ *
+ * Callbacks sharing a thread run one after another, so a slow callback delays
+ * the others on its thread. When several callbacks are due at the same time,
+ * the ones with higher priority run first. If a periodic callback falls more
+ * than a period behind, the missed periods are skipped and counted as
+ * overruns instead of being run back-to-back.
+ *
+ * The executor must outlive the Notifiers that use it.
+ */
+class NotifierExecutor {
+ public:
+  /**
+   * Timing statistics of a callback.
+   */
+  struct Stats {
+    /// Number of times the callback ran.
+    uint64_t runs = 0;
+
+    /// Number of periods the callback missed because it or other callbacks on
+    /// its thread ran too long.
+    uint64_t overruns = 0;
+
+    /// Execution time of the last run.
+    units::second_t lastRunTime = 0_s;
+
+    /// Longest execution time of any run.
+    units::second_t maxRunTime = 0_s;
+
+    /// Longest delay from a deadline to the start of the callback.
+    units::second_t maxLatency = 0_s;
+  };
+
+  /**
+   * Identifies a callback registered with an executor.
+   */
+  struct Handle {
+    /// Index of the thread that runs the callback.
+    int thread = -1;
+
+    /// Index of the callback on its thread.
+    uint32_t index = 0;
+
+    /// Returns true if the handle refers to a callback.
+    explicit operator bool() const { return thread >= 0; }
+  };
+
+  /**
+   * Creates an executor.
+   *
+   * @param numThreads The number of threads to run callbacks on. Callbacks are
+   *                   assigned to the thread with the fewest callbacks when
+   *                   they're added.
+   */
+  explicit NotifierExecutor(int numThreads = 1);
+
+  /**
+   * Creates an executor whose threads run with a real-time priority.
+   *
+   * @param numThreads The number of threads to run callbacks on.
+   * @param priority The FIFO real-time scheduler priority ([1..99] where a
+   *                 higher number represents higher priority). See "man 7
+   *                 sched" for more details.
+   */
+  NotifierExecutor(int numThreads, int priority);
+
+  ~NotifierExecutor();
+
+  NotifierExecutor(const NotifierExecutor&) = delete;
+  NotifierExecutor& operator=(const NotifierExecutor&) = delete;
+
+  /**
+   * Adds a callback. It doesn't run until it's started with StartSingle() or
+   * StartPeriodic().
+   *
+   * @param callback The callback.
+   * @param priority The callback's priority relative to other callbacks due at
+   *                 the same time. Higher numbers run first.
+   * @return The callback's handle.
+   */
+  Handle Add(std::function<void()> callback, int priority = 0);
+
+  /**
+   * Removes a callback. If the callback is running on another thread, this
+   * blocks until it's done.
+   *
+   * @param handle The callback's handle.
+   */
+  void Remove(Handle handle);
+
+  /**
+   * Sets the name of a callback, used for debugging purposes only.
+   *
+   * @param handle The callback's handle.
+   * @param name Name
+   */
+  void SetName(Handle handle, std::string_view name);
+
+  /**
+   * Changes a callback function.
+   *
+   * @param handle The callback's handle.
+   * @param callback The callback function.
+   */
+  void SetCallback(Handle handle, std::function<void()> callback);
+
+  /**
+   * Runs a callback once after the given delay.
+   *
+   * @param handle The callback's handle.
+   * @param delay Time to wait before the callback is called.
+   */
+  void StartSingle(Handle handle, units::second_t delay);
+
+  /**
+   * Runs a callback periodically, starting one period from now.
+   *
+   * @param handle The callback's handle.
+   * @param period The period.
+   */
+  void StartPeriodic(Handle handle, units::second_t period);
+
+  /**
+   * Stops further invocations of a callback. If the callback is running on
+   * another thread, this blocks until it's done.
+   *
+   * @param handle The callback's handle.
+   */
+  void Stop(Handle handle);
+
+  /**
+   * Returns the timing statistics of a callback.
+   *
+   * @param handle The callback's handle.
+   */
+  Stats GetStats(Handle handle) const;
+
+  /**
+   * Returns the name of a callback.
+   *
+   * @param handle The callback's handle.
+   */
+  std::string GetName(Handle handle) const;
+
+ private:
+  struct Thread;
+
+  std::vector<std::unique_ptr<Thread>> m_threads;
+};
+
+}  // namespace frc
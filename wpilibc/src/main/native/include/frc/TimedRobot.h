@@ -4,13 +4,16 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include <hal/Notifier.h>
 #include <hal/Types.h>
+#include <networktables/NetworkTableInstance.h>
 #include <units/frequency.h>
 #include <units/math.h>
 #include <units/time.h>
@@ -18,6 +21,7 @@
 
 #include "frc/IterativeRobotBase.h"
 #include "frc/RobotController.h"
+#include "frc/TimingHistogram.h"
 
 namespace frc {
 
@@ -90,12 +94,61 @@ class TimedRobot : public IterativeRobotBase {
   void AddPeriodic(std::function<void()> callback, units::second_t period,
                    units::second_t offset = 0_s);
 
+  /**
+   * Enables the loop profiler, which keeps histograms of how late the robot
+   * loop's Notifier wakes up and of how long each callback takes, to show
+   * scheduling jitter caused by other threads and which callbacks use up the
+   * loop.
+   *
+   * The histograms are frc::TimingHistogram, published to the
+   * "/TimedRobot/Profiler" NetworkTables table or recorded to a data log under
+   * "TimedRobot/Profiler":
+   * - "Jitter": the time from when each callback was scheduled to run until
+   *   the Notifier woke up to run it
+   * - "Callbacks/<n>": the execution time of each callback, numbered in the
+   *   order they were added, starting with the robot loop at 0
+   * - "RobotPeriodic", "DisabledPeriodic", "AutonomousPeriodic",
+   *   "TeleopPeriodic", and "TestPeriodic": the execution time of the periodic
+   *   functions
+   *
+   * The bucket bounds are published as "BucketBounds". Recording doesn't
+   * allocate memory, and publishing only sends the histograms that changed.
+   *
+   * This should be called from the robot thread, e.g. in RobotInit().
+   *
+   * @param publishPeriod How often to publish the histograms. If zero, they're
+   *                      published every time the Notifier wakes up, after
+   *                      the callbacks that were due have run.
+   * @param log The data log to record the histograms to, or nullptr to publish
+   *            them to NetworkTables.
+   */
+  void EnableLoopProfiler(units::second_t publishPeriod = 1_s,
+                          wpi::log::DataLog* log = nullptr);
+
+  /**
+   * Enables the loop profiler, publishing the histograms to the given
+   * NetworkTables instance instead of the default one.
+   *
+   * @param publishPeriod How often to publish the histograms. If zero, they're
+   *                      published every time the Notifier wakes up, after
+   *                      the callbacks that were due have run.
+   * @param inst The NetworkTables instance to publish the histograms to.
+   */
+  void EnableLoopProfiler(units::second_t publishPeriod,
+                          nt::NetworkTableInstance inst);
+
+  /**
+   * Disables and clears the loop profiler.
+   */
+  void DisableLoopProfiler();
+
  private:
   class Callback {
    public:
     std::function<void()> func;
     std::chrono::microseconds period;
     std::chrono::microseconds expirationTime;
+    size_t index;
 
     /**
      * Construct a callback container.
@@ -104,16 +157,19 @@ class TimedRobot : public IterativeRobotBase {
      * @param startTime The common starting point for all callback scheduling.
      * @param period    The period at which to run the callback.
      * @param offset    The offset from the common starting time.
+     * @param index     The number of callbacks added before this one.
      */
     Callback(std::function<void()> func, std::chrono::microseconds startTime,
-             std::chrono::microseconds period, std::chrono::microseconds offset)
+             std::chrono::microseconds period, std::chrono::microseconds offset,
+             size_t index)
         : func{std::move(func)},
           period{period},
           expirationTime(
               startTime + offset + period +
               (std::chrono::microseconds{frc::RobotController::GetFPGATime()} -
                startTime) /
-                  period * period) {}
+                  period * period),
+          index{index} {}
 
     bool operator>(const Callback& rhs) const {
       return expirationTime > rhs.expirationTime;
@@ -126,6 +182,29 @@ class TimedRobot : public IterativeRobotBase {
 
   wpi::priority_queue<Callback, std::vector<Callback>, std::greater<Callback>>
       m_callbacks;
+  size_t m_numCallbacks = 0;
+
+  struct LoopProfiler {
+    std::chrono::microseconds publishPeriod;
+    wpi::log::DataLog* log = nullptr;
+    nt::NetworkTableInstance inst;
+    std::chrono::microseconds lastPublish{0};
+
+    TimingHistogram jitter;
+    std::vector<TimingHistogram> callbacks;
+    // Indexed as expected by IterativeRobotBase::SetPeriodicHistograms()
+    std::array<TimingHistogram, 5> periodic;
+    nt::IntegerArrayPublisher boundsPublisher;
+  };
+
+  std::unique_ptr<LoopProfiler> m_profiler;
+
+  std::unique_ptr<LoopProfiler> MakeLoopProfiler(
+      units::second_t publishPeriod);
+  void StartLoopProfiler(std::unique_ptr<LoopProfiler> profiler);
+  void RunCallback(Callback& callback, std::chrono::microseconds currentTime);
+  void AddProfilerCallbacks();
+  void PublishLoopProfiler(std::chrono::microseconds currentTime);
 };
 
 }  // namespace frc
@@ -0,0 +1,121 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <networktables/IntegerArrayTopic.h>
+#include <networktables/NetworkTableInstance.h>
+#include <wpi/DataLog.h>
+
+namespace frc {
+
+/**
+ * A histogram of durations with fixed buckets, which can be published to
+ * NetworkTables or recorded to a data log as an integer array of counts.
+ *
+ * Recording a duration doesn't allocate memory or take a lock, so it's cheap
+ * enough to do in every robot loop. Publishing only sends the counts if they
+ * changed since they were last published.
+ *
+ * The histogram's name is its NetworkTables topic name. When it's recorded to a
+ * data log, the entry name is the same without the leading slash.
+ */
+class TimingHistogram {
+ public:
+  /**
+   * The exclusive upper bounds of the buckets in microseconds. The last bucket,
+   * which isn't listed, counts everything at least as long as the last bound.
+   */
+  static constexpr std::array<int64_t, 12> kBucketBounds{
+      10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000};
+
+  /// The number of buckets.
+  static constexpr size_t kNumBuckets = kBucketBounds.size() + 1;
+
+  TimingHistogram() = default;
+
+  /**
+   * Constructs an empty histogram.
+   *
+   * @param name The histogram's topic name.
+   */
+  explicit TimingHistogram(std::string_view name);
+
+  /**
+   * Sets the histogram's topic name. This has no effect after the histogram
+   * was published.
+   *
+   * @param name The topic name.
+   */
+  void SetName(std::string_view name);
+
+  /**
+   * Returns the histogram's topic name.
+   */
+  const std::string& GetName() const { return m_name; }
+
+  /**
+   * Counts a duration in its bucket.
+   *
+   * @param duration The duration.
+   */
+  void Record(std::chrono::microseconds duration);
+
+  /**
+   * Returns the number of durations counted in each bucket.
+   */
+  std::span<const int64_t, kNumBuckets> GetCounts() const { return m_counts; }
+
+  /**
+   * Returns the longest duration counted.
+   */
+  std::chrono::microseconds GetMax() const { return m_max; }
+
+  /**
+   * Clears the counts.
+   */
+  void Reset();
+
+  /**
+   * Publishes the counts to NetworkTables if they changed since they were last
+   * published. The topic is created the first time the counts are published.
+   */
+  void Publish();
+
+  /**
+   * Publishes the counts to a NetworkTables instance if they changed since they
+   * were last published. The topic is created the first time the counts are
+   * published, and later calls keep publishing to that instance.
+   *
+   * @param inst The NetworkTables instance.
+   */
+  void Publish(nt::NetworkTableInstance inst);
+
+  /**
+   * Records the counts to a data log if they changed since they were last
+   * recorded. The entry is created the first time the counts are recorded.
+   *
+   * @param log The data log.
+   */
+  void Publish(wpi::log::DataLog& log);
+
+ private:
+  std::string m_name;
+  std::array<int64_t, kNumBuckets> m_counts{};
+  std::chrono::microseconds m_max{0};
+  bool m_changed = false;
+
+  nt::IntegerArrayPublisher m_publisher;
+  wpi::log::IntegerArrayLogEntry m_logEntry;
+};
+
+}  // namespace frc
@@ -0,0 +1,224 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <limits>
+#include <span>
+#include <string_view>
+
+#include <units/time.h>
+#include <wpi/struct/Struct.h>
+
+namespace wpi::log {
+class DataLog;
+}  // namespace wpi::log
+
+namespace frc {
+
+/**
+ * An event recorded by TraceProfiler.
+ */
+struct TraceEvent {
+  /// Event type.
+  enum Type : uint8_t {
+    /// The zone was entered.
+    kBegin = 0,
+    /// The zone was exited.
+    kEnd = 1
+  };
+
+  /// Time in nanoseconds, in the data log's time base.
+  int64_t time = 0;
+
+  /// Zone ID, the index of the zone's name in the zone names entry.
+  uint16_t zone = 0;
+
+  /// Event type.
+  Type type = kBegin;
+};
+
+/**
+ * A low-overhead profiler that records when each thread enters and exits named
+ * zones of code, so nested timings can be analyzed after the fact, e.g. as a
+ * flame graph.
+ *
+ * Zones are marked with TraceZone, usually through the FRC_TRACE_ZONE() macro:
+ *
+ * <pre>
+ * void Subsystem::Periodic() {
+ *   FRC_TRACE_ZONE("Subsystem::Periodic");
+ *   ...
+ * }
+ * </pre>
+ *
+ * Each thread records its events into its own fixed-size ring buffer without
+ * locking or allocating, and a background thread periodically moves them to a
+ * data log. If a thread records events faster than they're flushed, the events
+ * that don't fit are dropped and counted. The buffer is allocated when the
+ * thread records its first event and is kept until the thread exits; each event
+ * takes 16 bytes, so the default buffer size costs 128 KiB per thread.
+ *
+ * This is separate from Tracer, which Watchdog and the command scheduler use to
+ * print epoch timings on loop overruns; those epochs aren't recorded here.
+ *
+ * The data log has these entries:
+ * - "TraceProfiler/Zones": string[] of the zone names, indexed by zone ID,
+ *   appended whenever zones are added
+ * - "TraceProfiler/Threads/<n>": struct:TraceEvent[] of the events of each
+ *   thread, numbered in the order they first recorded an event. The entry's
+ *   metadata is the thread's name, if set with SetThreadName().
+ * - "TraceProfiler/Dropped": int64 total number of dropped events, appended
+ *   when it changes
+ *
+ * The data log tool can export these entries as a Chrome trace (JSON), which
+ * can be opened with Perfetto or chrome://tracing.
+ */
+class TraceProfiler final {
+ public:
+  /// The default number of events each thread can record between flushes.
+  static constexpr size_t kDefaultBufferSize = 8192;
+
+  /// The zone ID shared by all zones added after the first 65535, named
+  /// "(too many zones)".
+  static constexpr uint16_t kOverflowZone =
+      std::numeric_limits<uint16_t>::max();
+
+  TraceProfiler() = delete;
+
+  /**
+   * Starts recording events to a data log. Does nothing if already started.
+   *
+   * @param log The data log.
+   * @param flushPeriod How often to move the recorded events to the data log.
+   * @param bufferSize The number of events each thread can record between
+   *                   flushes, rounded up to a power of 2. This only applies to
+   *                   threads that haven't recorded an event yet; the others
+   *                   keep their buffers.
+   */
+  static void Start(wpi::log::DataLog& log,
+                    units::second_t flushPeriod = 100_ms,
+                    size_t bufferSize = kDefaultBufferSize);
+
+  /**
+   * Stops recording events and moves the events recorded so far to the data
+   * log.
+   */
+  static void Stop();
+
+  /**
+   * Returns true if events are being recorded.
+   */
+  static bool IsRunning();
+
+  /**
+   * Moves the events recorded so far to the data log without waiting for the
+   * next flush period.
+   */
+  static void Flush();
+
+  /**
+   * Returns the ID of a zone, adding it if it doesn't exist yet. This takes a
+   * lock, so the ID should be looked up once and reused, as FRC_TRACE_ZONE()
+   * does.
+   *
+   * Zone IDs are 16 bits. Once there are 65535 zones, new zones get
+   * kOverflowZone, and an error is reported the first time that happens.
+   *
+   * @param name The zone name.
+   * @return The zone ID.
+   */
+  static uint16_t GetZone(std::string_view name);
+
+
+  /**
+   * Sets the name of the calling thread shown in traces.
+   *
+   * @param name The thread name.
+   */
+  static void SetThreadName(std::string_view name);
+
+  /**
+   * Records that the calling thread entered a zone. Does nothing if the
+   * profiler isn't running.
+   *
+   * @param zone The zone ID.
+   */
+  static void Begin(uint16_t zone) noexcept;
+
+  /**
+   * Records that the calling thread exited a zone. Does nothing if the
+   * profiler isn't running.
+   *
+   * @param zone The zone ID.
+   */
+  static void End(uint16_t zone) noexcept;
+};
+
+/**
+ * Records a TraceProfiler zone for the lifetime of the object.
+ */
+class TraceZone {
+ public:
+  /**
+   * Enters a zone.
+   *
+   * @param zone The zone ID from TraceProfiler::GetZone().
+   */
+  explicit TraceZone(uint16_t zone) noexcept : m_zone{zone} {
+    TraceProfiler::Begin(zone);
+  }
+
+  ~TraceZone() { TraceProfiler::End(m_zone); }
+
+  TraceZone(const TraceZone&) = delete;
+  TraceZone& operator=(const TraceZone&) = delete;
+
+ private:
+  uint16_t m_zone;
+};
+
+}  // namespace frc
+
+#define FRC_TRACE_ZONE_CONCAT_IMPL(a, b) a##b
+#define FRC_TRACE_ZONE_CONCAT(a, b) FRC_TRACE_ZONE_CONCAT_IMPL(a, b)
+
+/**
+ * Records a TraceProfiler zone until the end of the enclosing scope. The zone
+ * ID is looked up once per call site.
+ *
+ * @param name The zone name.
+ */
+#define FRC_TRACE_ZONE(name)                                              \
+  static const uint16_t FRC_TRACE_ZONE_CONCAT(frcTraceZoneId, __LINE__) = \
+      ::frc::TraceProfiler::GetZone(name);                                \
+  ::frc::TraceZone FRC_TRACE_ZONE_CONCAT(frcTraceZone, __LINE__) {        \
+    FRC_TRACE_ZONE_CONCAT(frcTraceZoneId, __LINE__)                       \
+  }
+
+template <>
+struct wpi::Struct<frc::TraceEvent> {
+  static constexpr std::string_view GetTypeName() { return "TraceEvent"; }
+  static constexpr size_t GetSize() { return 11; }
+  static constexpr std::string_view GetSchema() {
+    return "int64 time;uint16 zone;uint8 type";
+  }
+
+  static frc::TraceEvent Unpack(std::span<const uint8_t> data) {
+    return {wpi::UnpackStruct<int64_t, 0>(data),
+            wpi::UnpackStruct<uint16_t, 8>(data),
+            static_cast<frc::TraceEvent::Type>(
+                wpi::UnpackStruct<uint8_t, 10>(data))};
+  }
+
+  static void Pack(std::span<uint8_t> data, const frc::TraceEvent& value) {
+    wpi::PackStruct<0>(data, value.time);
+    wpi::PackStruct<8>(data, value.zone);
+    wpi::PackStruct<10>(data, static_cast<uint8_t>(value.type));
+  }
+};
+
+static_assert(wpi::StructSerializable<frc::TraceEvent>);
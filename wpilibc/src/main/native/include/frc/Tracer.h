@@ -65,6 +65,9 @@ class Tracer {
  private:
   static constexpr std::chrono::milliseconds kMinPrintPeriod{1000};
 
+  // Marks an epoch that hasn't been added since the epochs were cleared
+  static constexpr std::chrono::nanoseconds kClearedEpoch{-1};
+
   hal::fpga_clock::time_point m_startTime;
   hal::fpga_clock::time_point m_lastEpochsPrintTime = hal::fpga_clock::epoch();
 
@@ -0,0 +1,99 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace frc::internal {
+
+/**
+ * For internal use only.
+ *
+ * Hierarchical timer wheel with 1 ms ticks. Timers are identified by an index
+ * and a generation; a timer whose generation no longer matches its owner's is
+ * treated as cancelled when it expires, so cancelling never has to search the
+ * wheel.
+ *
+ * Each of the four levels has 64 slots. A timer is stored on the lowest level
+ * whose slots are wide enough to reach its deadline and moves down a level each
+ * time the level below wraps around, so adding a timer is constant time and
+ * advancing costs one step per elapsed tick plus one move per level per timer.
+ * Timers more than 2^24 ticks (about 4.6 hours) away are kept in an overflow
+ * list until they're in range.
+ */
+class TimerWheel {
+ public:
+  /**
+   * An expired timer.
+   */
+  struct Timer {
+    /// Deadline in microseconds.
+    uint64_t deadline;
+
+    /// Index of the timer's owner.
+    uint32_t index;
+
+    /// Generation of the timer's owner when the timer was added.
+    uint32_t generation;
+  };
+
+  /**
+   * Constructs an empty timer wheel.
+   *
+   * @param now The current time in microseconds.
+   */
+  explicit TimerWheel(uint64_t now);
+
+  /**
+   * Adds a timer. Deadlines in the past expire on the next call to Advance().
+   *
+   * @param timer The timer.
+   */
+  void Add(const Timer& timer);
+
+  /**
+   * Advances the wheel to the given time, appending the timers whose deadlines
+   * are at or before it to expired.
+   *
+   * @param now The current time in microseconds.
+   * @param expired Output for the expired timers.
+   */
+  void Advance(uint64_t now, std::vector<Timer>* expired);
+
+  /**
+   * Returns the earliest deadline in the wheel, or an empty optional if the
+   * wheel is empty. Cancelled timers that haven't been removed yet are
+   * included.
+   */
+  std::optional<uint64_t> NextDeadline() const;
+
+  /**
+   * Returns true if the wheel has no timers.
+   */
+  bool Empty() const { return m_size == 0; }
+
+ private:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+  static constexpr uint64_t kTickLength = 1000;
+
+  // Inserts a timer relative to the current tick
+  void Insert(const Timer& timer);
+
+  // Moves the timers of the current slot of the given level down
+  void Cascade(int level);
+
+  std::array<std::array<std::vector<Timer>, kSlots>, kLevels> m_slots;
+  std::vector<Timer> m_overflow;
+  uint64_t m_tick;
+  size_t m_size = 0;
+};
+
+}  // namespace frc::internal
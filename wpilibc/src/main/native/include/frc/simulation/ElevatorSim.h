@@ -171,6 +171,8 @@ class ElevatorSim : public LinearSystemSim<2, 1, 2> {
                      units::second_t dt) override;
 
  private:
+  friend class SimBatch;
+
   DCMotor m_gearbox;
   units::meter_t m_minHeight;
   units::meter_t m_maxHeight;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 
 #include <units/current.h>
@@ -11,9 +12,13 @@
 
 #include "frc/EigenCore.h"
 #include "frc/StateSpaceUtil.h"
+#include "frc/system/Discretization.h"
 #include "frc/system/LinearSystem.h"
 
 namespace frc::sim {
+
+class SimBatch;
+
 /**
  * This class helps simulate linear systems. To use this class, do the following
  * in the simulationPeriodic() method.
@@ -60,9 +65,11 @@ class LinearSystemSim {
     m_y = m_plant.CalculateY(m_x, m_u);
 
     // Add noise. If the user did not pass a noise vector to the
-    // constructor, then this method will not do anything because
-    // the standard deviations default to zero.
-    m_y += frc::MakeWhiteNoiseVector<Outputs>(m_measurementStdDevs);
+    // constructor, the standard deviations default to zero, and the noise
+    // generator isn't seeded at all.
+    if (HasMeasurementNoise()) {
+      m_y += frc::MakeWhiteNoiseVector<Outputs>(m_measurementStdDevs);
+    }
   }
 
   /**
@@ -135,7 +142,14 @@ class LinearSystemSim {
   virtual Vectord<States> UpdateX(const Vectord<States>& currentXhat,
                                   const Vectord<Inputs>& u,
                                   units::second_t dt) {
-    return m_plant.CalculateX(currentXhat, u, dt);
+    // Discretization takes a matrix exponential, so it's only redone when the
+    // timestep changes
+    if (dt.value() != m_discDt.value()) {
+      DiscretizeAB<States, Inputs>(m_plant.A(), m_plant.B(), dt, &m_discA,
+                                   &m_discB);
+      m_discDt = dt;
+    }
+    return m_discA * currentXhat + m_discB * u;
   }
 
   /**
@@ -163,5 +177,19 @@ class LinearSystemSim {
   /// The standard deviations of measurements, used for adding noise to the
   /// measurements.
   std::array<double, Outputs> m_measurementStdDevs;
+
+ private:
+  friend class SimBatch;
+
+  bool HasMeasurementNoise() const {
+    return std::any_of(m_measurementStdDevs.begin(),
+                       m_measurementStdDevs.end(),
+                       [](double stdDev) { return stdDev != 0.0; });
+  }
+
+  // The discretized plant for m_discDt, which is negative if not computed yet
+  Matrixd<States, States> m_discA;
+  Matrixd<States, Inputs> m_discB;
+  units::second_t m_discDt{-1};
 };
 }  // namespace frc::sim
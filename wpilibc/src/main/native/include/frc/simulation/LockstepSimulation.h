@@ -0,0 +1,109 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <units/time.h>
+
+#include "frc/simulation/LinearSystemSim.h"
+
+namespace frc {
+class RobotBase;
+}  // namespace frc
+
+namespace frc::sim {
+
+/**
+ * Runs a robot program and physics simulations in deterministic lockstep, as
+ * fast as the host can run them.
+ *
+ * Simulator time is paused while this object exists, and only advances in
+ * Step(). Time advances to the next notifier alarm or physics tick, whichever
+ * is first, and then the robot's notifiers due at that time run one at a time,
+ * followed by the physics updates. The robot program runs on its own thread,
+ * but only while the stepping thread waits for it, so a run with the same
+ * inputs produces the same outputs regardless of the host's speed.
+ *
+ * Measurement noise in LinearSystemSim is random, so physics simulations that
+ * use it aren't deterministic.
+ */
+class LockstepSimulation {
+ public:
+  /**
+   * Creates a lockstep simulation, and pauses simulator time.
+   *
+   * @param physicsPeriod The period of the physics updates.
+   * @throws frc::RuntimeError if physicsPeriod is less than 1 microsecond
+   */
+  explicit LockstepSimulation(units::second_t physicsPeriod = 5_ms);
+
+  /**
+   * Ends the robot program if one was started, and resumes simulator time if
+   * it was running before this object was created.
+   */
+  ~LockstepSimulation();
+
+  LockstepSimulation(const LockstepSimulation&) = delete;
+  LockstepSimulation& operator=(const LockstepSimulation&) = delete;
+
+  /**
+   * Adds a physics update, which is called every physics period with the
+   * period. Updates are called in the order they were added.
+   *
+   * @param update The physics update.
+   */
+  void AddPhysics(std::function<void(units::second_t)> update);
+
+  /**
+   * Adds a linear system simulation, which is updated every physics period.
+   * The simulation must outlive this object.
+   *
+   * @param sim The simulation.
+   */
+  template <int States, int Inputs, int Outputs>
+  void AddPhysics(LinearSystemSim<States, Inputs, Outputs>& sim) {
+    AddPhysics([&sim](units::second_t dt) { sim.Update(dt); });
+  }
+
+  /**
+   * Starts a robot program on its own thread, and waits for it to wait on its
+   * notifiers. The robot must outlive this object; its program is ended when
+   * this object is destroyed. Only one robot can be started per simulation.
+   *
+   * @param robot The robot.
+   * @throws frc::RuntimeError if a robot was already started
+   */
+  void StartRobot(RobotBase& robot);
+
+  /**
+   * Advances the simulation, running all notifiers and physics updates due
+   * before the end time.
+   *
+   * @param duration The amount of time to advance.
+   */
+  void Step(units::second_t duration);
+
+  /**
+   * Gets the current simulator time.
+   *
+   * @return The current simulator time.
+   */
+  units::second_t GetTime() const;
+
+ private:
+  uint64_t m_physicsPeriod;
+  uint64_t m_nextPhysics;
+  bool m_wasPaused;
+  std::vector<std::function<void(units::second_t)>> m_physics;
+  RobotBase* m_robot = nullptr;
+  std::thread m_robotThread;
+};
+
+}  // namespace frc::sim
@@ -0,0 +1,97 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wpi::log {
+class DataLog;
+}  // namespace wpi::log
+
+namespace frc::sim {
+
+/**
+ * Runs many simulations in parallel, such as to evaluate an autonomous routine
+ * with varied starting poses, sensor noise and motor variance.
+ *
+ * @warning Full robot programs can't be run in parallel. Only the HAL
+ * simulation state is separate for each run: driver station data, the
+ * DriverStation class, NetworkTables, SmartDashboard, LiveWindow, the command
+ * scheduler and the other wpilibc singletons are shared by all runs in the
+ * process. A run must not start a TimedRobot or other RobotBase, and the code
+ * it simulates shouldn't use any of those; simulate subsystems, mechanisms and
+ * controllers driven directly by the run instead.
+ *
+ * Each run gets its own HAL simulation context, so it has its own simulated
+ * hardware (device data and handles, SimDevices and Notifiers) and its own
+ * simulator time, which starts paused at 0. Runs are spread across a pool of
+ * threads, and each run records to its own data log.
+ *
+ * Any threads a run starts in its context, such as those of frc::Notifier,
+ * must be stopped before the run returns, so its context can be destroyed.
+ * Objects holding HAL handles, such as frc::PWM and frc::Notifier, must be
+ * created and destroyed within the run; see HALSIM_SetThreadSimContext().
+ */
+class ParallelSimulation {
+ public:
+  /**
+   * The result of a run.
+   */
+  struct Result {
+    /// The score returned by the run.
+    double score = 0;
+
+    /// The run's data log, if it isn't written to a file.
+    std::vector<uint8_t> log;
+  };
+
+  /**
+   * A run, which is called with the run's index (for example, to seed its
+   * random number generator) and its data log, and returns its score.
+   */
+  using RunFunction = std::function<double(int index, wpi::log::DataLog& log)>;
+
+  /**
+   * Creates a parallel simulation.
+   *
+   * @param threads The number of threads to run simulations on, or 0 for one
+   *                per hardware thread.
+   */
+  explicit ParallelSimulation(int threads = 0);
+
+  /**
+   * Sets the directory to write data logs to. Each run's log is written to
+   * run_<index>.wpilog in the directory, instead of being kept in its result.
+   *
+   * @param directory The directory, or empty to keep the logs in memory.
+   */
+  void SetLogDirectory(std::string_view directory);
+
+  /**
+   * Runs simulations, and waits for them to finish. If a run throws, or
+   * returns with threads still running in its simulation context, no more
+   * runs are started, and the exception is rethrown once the running ones
+   * finish.
+   *
+   * @param count The number of runs.
+   * @param run The run, which is called once for each index in [0, count).
+   *            It may be called from several threads at once.
+   * @return The results, in order of index.
+   */
+  std::vector<Result> Run(int count, RunFunction run);
+
+ private:
+  Result RunOne(int index, const RunFunction& run);
+
+  int m_threads;
+  std::string m_logDirectory;
+};
+
+}  // namespace frc::sim
@@ -0,0 +1,142 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <units/time.h>
+
+#include "frc/simulation/LinearSystemSim.h"
+
+namespace frc::sim {
+
+class DCMotorSim;
+class ElevatorSim;
+class FlywheelSim;
+class SingleJointedArmSim;
+
+/**
+ * Updates many mechanism simulations together.
+ *
+ * Updating each simulation separately discretizes its model (a matrix
+ * exponential) every update, or integrates it with an adaptive Runge-Kutta
+ * method. A batch instead discretizes each model once per timestep, and steps
+ * every mechanism of the same kind in one loop over contiguous arrays.
+ *
+ * The simulations still hold the state; each update copies the states and
+ * inputs in, and the new states and outputs back out. Getters and setters on
+ * the simulations can be used as usual between updates.
+ *
+ * Elevator gravity is constant, so elevators are discretized exactly. Arm
+ * gravity depends on the angle, so it's evaluated at the midpoint of each
+ * step, while the rest of the arm model is discretized exactly. This stays
+ * stable for stiff motor models without smaller steps. The results differ
+ * slightly from ElevatorSim::Update() and SingleJointedArmSim::Update(), whose
+ * adaptive integrator has a looser tolerance.
+ */
+class SimBatch {
+ public:
+  /**
+   * Adds a flywheel simulation. The simulation must outlive this object.
+   *
+   * @param sim The simulation.
+   */
+  void Add(FlywheelSim& sim);
+
+  /**
+   * Adds a DC motor simulation. The simulation must outlive this object.
+   *
+   * @param sim The simulation.
+   */
+  void Add(DCMotorSim& sim);
+
+  /**
+   * Adds an elevator simulation. The simulation must outlive this object.
+   *
+   * @param sim The simulation.
+   */
+  void Add(ElevatorSim& sim);
+
+  /**
+   * Adds a single jointed arm simulation. The simulation must outlive this
+   * object.
+   *
+   * @param sim The simulation.
+   */
+  void Add(SingleJointedArmSim& sim);
+
+  /**
+   * Updates all of the simulations. This is equivalent to calling Update() on
+   * each of them.
+   *
+   * @param dt The time between updates.
+   */
+  void Update(units::second_t dt);
+
+ private:
+  // Mechanisms with one state, like flywheels
+  struct FirstOrder {
+    std::vector<LinearSystemSim<1, 1, 1>*> sims;
+
+    // Discrete model, as xₖ₊₁ = axₖ + buₖ
+    std::vector<double> a;
+    std::vector<double> b;
+
+    // State and input, copied from the simulations for each update
+    std::vector<double> x;
+    std::vector<double> u;
+
+    // Number of simulations with a discrete model for the current timestep
+    size_t discretized = 0;
+
+    void Update(units::second_t dt, bool redo);
+  };
+
+  // Mechanisms with position and velocity states. The velocity is also
+  // accelerated by accel + cosAccel⋅cos(position), which models gravity. The
+  // position is limited to [minPosition, maxPosition], stopping the mechanism
+  // at the limits.
+  struct SecondOrder {
+    std::vector<LinearSystemSim<2, 1, 2>*> sims;
+
+    // Discrete model, as xₖ₊₁ = Axₖ + Buₖ + Gαₖ, where α is the acceleration
+    // from gravity
+    std::vector<double> a00;
+    std::vector<double> a01;
+    std::vector<double> a10;
+    std::vector<double> a11;
+    std::vector<double> b0;
+    std::vector<double> b1;
+    std::vector<double> g0;
+    std::vector<double> g1;
+
+    std::vector<double> accel;
+    std::vector<double> cosAccel;
+    std::vector<double> minPosition;
+    std::vector<double> maxPosition;
+
+    // State and input, copied from the simulations for each update
+    std::vector<double> x0;
+    std::vector<double> x1;
+    std::vector<double> u;
+
+    // Number of simulations with a discrete model for the current timestep
+    size_t discretized = 0;
+
+    void Add(LinearSystemSim<2, 1, 2>& sim, double accel, double cosAccel,
+             double minPosition, double maxPosition);
+    void Update(units::second_t dt, bool redo);
+  };
+
+  units::second_t m_dt{-1};
+  FirstOrder m_flywheels;
+  SecondOrder m_motors;
+  SecondOrder m_elevators;
+  SecondOrder m_arms;
+};
+
+}  // namespace frc::sim
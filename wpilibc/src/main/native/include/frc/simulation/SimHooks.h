@@ -53,6 +53,16 @@ bool IsTimingPaused();
  */
 void StepTiming(units::second_t delta);
 
+/**
+ * Advance the simulator time, running expired notifiers one at a time in order
+ * of their alarm times. Each notifier's callback finishes, and all notifiers
+ * are waiting again, before the next one is woken. The time is only advanced
+ * to the next alarm time once every earlier alarm has run.
+ *
+ * @param delta the amount to advance (in seconds)
+ */
+void StepTimingLockstep(units::second_t delta);
+
 /**
  * Advance the simulator time and return immediately.
  *
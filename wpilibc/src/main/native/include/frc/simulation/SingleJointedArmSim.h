@@ -161,6 +161,8 @@ class SingleJointedArmSim : public LinearSystemSim<2, 1, 2> {
                      units::second_t dt) override;
 
  private:
+  friend class SimBatch;
+
   units::meter_t m_armLen;
   units::radian_t m_minAngle;
   units::radian_t m_maxAngle;
@@ -85,10 +85,27 @@ class Field2d : public nt::NTSendable, public wpi::SendableHelper<Field2d> {
    */
   FieldObject2d* GetRobotObject();
 
+  /**
+   * Sets whether object poses are published as Pose2d struct arrays rather
+   * than double arrays of x, y, and degrees.
+   *
+   * Struct arrays are published in chunks, and only the chunks that changed
+   * are published again, so appending to or changing part of a large
+   * trajectory doesn't republish the whole trajectory. The first chunk of
+   * each object is published to the object's usual topic, so dashboards that
+   * only read that topic show the first poses of large trajectories. Glass
+   * shows all of the poses.
+   *
+   * @param enable true to publish struct arrays, false to publish double
+   *               arrays (the default)
+   */
+  void SetStructPublishing(bool enable);
+
   void InitSendable(nt::NTSendableBuilder& builder) override;
 
  private:
   std::shared_ptr<nt::NetworkTable> m_table;
+  bool m_structPublishing = false;
 
   mutable wpi::mutex m_mutex;
   std::vector<std::unique_ptr<FieldObject2d>> m_objects;
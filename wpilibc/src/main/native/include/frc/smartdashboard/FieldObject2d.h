@@ -4,13 +4,18 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <initializer_list>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include <networktables/DoubleArrayTopic.h>
+#include <networktables/NetworkTable.h>
+#include <networktables/StructArrayTopic.h>
 #include <units/length.h>
 #include <wpi/SmallVector.h>
 #include <wpi/mutex.h>
@@ -98,13 +103,27 @@ class FieldObject2d {
   std::span<const Pose2d> GetPoses(wpi::SmallVectorImpl<Pose2d>& out) const;
 
  private:
+  void SetTable(std::shared_ptr<nt::NetworkTable> table, bool structPoses);
   void UpdateEntry(bool setDefault = false);
+  void UpdateChunks(size_t begin, size_t end, bool setDefault = false);
   void UpdateFromEntry() const;
 
   mutable wpi::mutex m_mutex;
   std::string m_name;
   nt::DoubleArrayEntry m_entry;
   mutable wpi::SmallVector<Pose2d, 1> m_poses;
+
+  // When publishing struct arrays, the poses are split into chunks. The first
+  // chunk is published to the object's topic, and the rest to ".name/1",
+  // ".name/2", etc. Chunks past the end of the poses are empty.
+  std::shared_ptr<nt::NetworkTable> m_table;
+  std::vector<nt::StructArrayEntry<Pose2d>> m_chunks;
+  // The last change time of each chunk after it was last set or read, to
+  // detect chunks changed by dashboards
+  mutable std::vector<int64_t> m_chunkChanges;
+  // Set when the poses were read from chunks changed by a dashboard, which
+  // may have split them into chunks differently
+  mutable bool m_resendChunks = false;
 };
 
 }  // namespace frc
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -15,7 +16,9 @@
 #include <networktables/BooleanTopic.h>
 #include <networktables/NTSendableBuilder.h>
 #include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableValue.h>
 #include <networktables/StringTopic.h>
+#include <ntcore_c.h>
 #include <wpi/FunctionExtras.h>
 #include <wpi/SmallVector.h>
 
@@ -26,6 +29,38 @@ namespace frc {
  */
 class SendableBuilderImpl : public nt::NTSendableBuilder {
  public:
+  /**
+   * Values staged by Update() to be set in one call.
+   */
+  struct UpdateBatch {
+    std::vector<NT_Handle> handles;
+    std::vector<nt::Value> values;
+  };
+
+  /**
+   * While a BatchScope exists, every Update() on the same thread stages its
+   * changed values in the scope's batch instead of setting them itself. The
+   * batch is set in one call when the scope is destroyed.
+   */
+  class BatchScope {
+   public:
+    /**
+     * Starts staging updates on this thread.
+     *
+     * @param batch The batch to stage the values in. It must not be used by
+     *     another thread while the scope exists.
+     */
+    explicit BatchScope(UpdateBatch& batch);
+    ~BatchScope();
+
+    BatchScope(const BatchScope&) = delete;
+    BatchScope& operator=(const BatchScope&) = delete;
+
+   private:
+    UpdateBatch& m_batch;
+    UpdateBatch* m_previous;
+  };
+
   SendableBuilderImpl() = default;
   ~SendableBuilderImpl() override = default;
 
@@ -60,6 +95,10 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
   /**
    * Synchronize with network table values by calling the getters for all
    * properties and setters when the network table value has changed.
+   *
+   * Only the values that have changed since the last update are set, all in
+   * one call. If a BatchScope exists on this thread, they are set together
+   * with the values of other builders when the scope ends instead.
    */
   void Update() override;
 
@@ -212,19 +251,24 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
  private:
   struct Property {
     virtual ~Property() = default;
-    virtual void Update(bool controllable, int64_t time) = 0;
+    virtual void Update(bool controllable, int64_t time,
+                        UpdateBatch& batch) = 0;
   };
 
   template <typename Topic>
   struct PropertyImpl : public Property {
-    void Update(bool controllable, int64_t time) override;
+    void Update(bool controllable, int64_t time, UpdateBatch& batch) override;
 
     using Publisher = typename Topic::PublisherType;
     using Subscriber = typename Topic::SubscriberType;
     Publisher pub;
     Subscriber sub;
-    std::function<void(Publisher& pub, int64_t time)> updateNetwork;
-    std::function<void(Subscriber& sub)> updateLocal;
+    // Calls the getter and returns its value if it changed since the last
+    // call, or unconditionally if force is true
+    std::function<std::optional<nt::Value>(int64_t time, bool force)>
+        getChangedValue;
+    // Returns true if any values were read
+    std::function<bool(Subscriber& sub)> updateLocal;
   };
 
   template <typename Topic, typename Getter, typename Setter>
@@ -241,6 +285,7 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
   std::function<void()> m_safeState;
   std::vector<wpi::unique_function<void()>> m_updateTables;
   std::shared_ptr<nt::NetworkTable> m_table;
+  UpdateBatch m_batch;
   bool m_controllable = false;
   bool m_actuator = false;
 
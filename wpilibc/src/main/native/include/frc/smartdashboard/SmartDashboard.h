@@ -13,6 +13,7 @@
 
 #include <networktables/NetworkTableEntry.h>
 #include <networktables/NetworkTableValue.h>
+#include <units/time.h>
 
 namespace wpi {
 class Sendable;
@@ -109,6 +110,17 @@ class SmartDashboard {
    */
   static wpi::Sendable* GetData(std::string_view keyName);
 
+  /**
+   * Sets how often the sendable data at the specified key is updated by
+   * UpdateValues(). By default it's updated on every call. Slowly changing or
+   * expensive data can be updated less often to reduce the time spent in
+   * UpdateValues().
+   *
+   * @param key the key the data was put with
+   * @param period the time between updates, or 0 to update on every call
+   */
+  static void SetUpdatePeriod(std::string_view key, units::second_t period);
+
   /**
    * Maps the specified key to the specified value in this table.
    *
@@ -401,6 +413,9 @@ class SmartDashboard {
 
   /**
    * Puts all sendable data to the dashboard.
+   *
+   * Only the values that changed since they were last put are sent, and they
+   * are sent together after all of the data has been updated.
    */
   static void UpdateValues();
 };
@@ -0,0 +1,193 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/timestamp.h>
+
+#include "frc/LEDPattern.h"
+
+namespace frc {
+
+namespace {
+
+uint64_t now = 0;
+
+constexpr std::array<size_t, 4> kLengths{7, 60, 300, 13};
+constexpr std::array<uint64_t, 5> kTimes{0, 123456, 750000, 2500000,
+                                         7777777};
+
+// A pattern defined by a function, which the compiled pattern can't look into
+LEDPattern whiteYellowPurple{[](auto data, auto writer) {
+  for (size_t led = 0; led < data.size(); led++) {
+    switch (led % 3) {
+      case 0:
+        writer(led, Color::kWhite);
+        break;
+      case 1:
+        writer(led, Color::kYellow);
+        break;
+      case 2:
+        writer(led, Color::kPurple);
+        break;
+    }
+  }
+}};
+
+// A pattern defined by a function that reads the current LED data, and writes
+// in reverse order
+LEDPattern invert{[](auto data, auto writer) {
+  for (size_t led = data.size(); led-- > 0;) {
+    writer(led, Color{255 - data[led].r, 255 - data[led].g, 255 - data[led].b});
+  }
+}};
+
+LEDPattern Gradient() {
+  return LEDPattern::Gradient(LEDPattern::kContinuous,
+                              {Color::kRed, Color::kGreen, Color::kBlue});
+}
+
+// Fills a buffer with a different color for each LED, so patterns that read
+// the buffer or don't write every LED are checked too
+void Prefill(std::span<AddressableLED::LEDData> buffer) {
+  for (size_t i = 0; i < buffer.size(); i++) {
+    buffer[i].SetRGB(i * 7 % 256, i * 13 % 256, 255 - i % 256);
+  }
+}
+
+// Checks that a compiled pattern writes the same data as the pattern, for a
+// few buffer lengths and times. The compiled pattern is reused for every
+// length and time.
+void ExpectEquivalent(const LEDPattern& pattern) {
+  WPI_SetNowImpl([] { return now; });
+  auto compiled = pattern.Compile();
+  for (size_t length : kLengths) {
+    for (uint64_t time : kTimes) {
+      now = time;
+      std::vector<AddressableLED::LEDData> expected(length);
+      std::vector<AddressableLED::LEDData> actual(length);
+      Prefill(expected);
+      Prefill(actual);
+
+      pattern.ApplyTo(expected);
+      compiled.ApplyTo(actual);
+
+      for (size_t i = 0; i < length; i++) {
+        SCOPED_TRACE(testing::Message()
+                     << "length " << length << ", time " << time << ", LED "
+                     << i);
+        EXPECT_EQ(expected[i].r, actual[i].r);
+        EXPECT_EQ(expected[i].g, actual[i].g);
+        EXPECT_EQ(expected[i].b, actual[i].b);
+        EXPECT_EQ(expected[i].padding, actual[i].padding);
+      }
+    }
+  }
+  WPI_SetNowImpl(nullptr);  // cleanup
+}
+
+}  // namespace
+
+TEST(CompiledLEDPatternTest, Solid) {
+  ExpectEquivalent(LEDPattern::Solid(Color::kYellow));
+  ExpectEquivalent(LEDPattern::Off());
+}
+
+TEST(CompiledLEDPatternTest, Gradient) {
+  ExpectEquivalent(Gradient());
+  ExpectEquivalent(LEDPattern::Gradient(LEDPattern::kDiscontinuous,
+                                        {Color::kYellow, Color::kPurple}));
+}
+
+TEST(CompiledLEDPatternTest, Steps) {
+  ExpectEquivalent(
+      LEDPattern::Steps({{0.25, Color::kRed}, {0.5, Color::kBlue}}));
+
+  // Duplicate and out of range positions
+  ExpectEquivalent(LEDPattern::Steps({{0.5, Color::kYellow},
+                                      {0.0, Color::kRed},
+                                      {0.25, Color::kBlue},
+                                      {0.25, Color::kGreen},
+                                      {-0.5, Color::kPurple},
+                                      {1.5, Color::kWhite}}));
+}
+
+TEST(CompiledLEDPatternTest, Rainbow) {
+  ExpectEquivalent(LEDPattern::Rainbow(255, 128));
+}
+
+TEST(CompiledLEDPatternTest, ProgressMaskLayer) {
+  ExpectEquivalent(LEDPattern::ProgressMaskLayer([] { return 0.4; }));
+  ExpectEquivalent(LEDPattern::ProgressMaskLayer([] { return 2.0; }));
+}
+
+TEST(CompiledLEDPatternTest, Opaque) {
+  ExpectEquivalent(whiteYellowPurple);
+  ExpectEquivalent(invert);
+}
+
+TEST(CompiledLEDPatternTest, MapIndex) {
+  ExpectEquivalent(Gradient().Reversed());
+  ExpectEquivalent(Gradient().OffsetBy(-3));
+  ExpectEquivalent(Gradient().OffsetBy(5).Reversed());
+  ExpectEquivalent(whiteYellowPurple.Reversed());
+}
+
+TEST(CompiledLEDPatternTest, Scroll) {
+  ExpectEquivalent(LEDPattern::Rainbow(255, 255).ScrollAtRelativeSpeed(2_Hz));
+  ExpectEquivalent(Gradient().ScrollAtRelativeSpeed(-0.5_Hz));
+  ExpectEquivalent(
+      Gradient().ScrollAtAbsoluteSpeed(0.5_mps, units::meter_t{1 / 60.0}));
+}
+
+TEST(CompiledLEDPatternTest, Blink) {
+  ExpectEquivalent(Gradient().Blink(0.5_s));
+  ExpectEquivalent(Gradient().Blink(1.5_s, 0.25_s).AtBrightness(0.5));
+  ExpectEquivalent(Gradient().SynchronizedBlink([] { return true; }));
+  ExpectEquivalent(Gradient().SynchronizedBlink([] { return false; }));
+}
+
+TEST(CompiledLEDPatternTest, Brightness) {
+  ExpectEquivalent(Gradient().Breathe(2_s));
+  ExpectEquivalent(Gradient().AtBrightness(0.25));
+  ExpectEquivalent(Gradient().AtBrightness(1.5).AtBrightness(0.5));
+}
+
+TEST(CompiledLEDPatternTest, Combinators) {
+  auto steps = LEDPattern::Steps({{0.25, Color::kRed}, {0.75, Color::kBlack}});
+  ExpectEquivalent(steps.OverlayOn(Gradient()));
+  ExpectEquivalent(steps.Blend(Gradient()));
+  ExpectEquivalent(Gradient().Mask(steps));
+  ExpectEquivalent(
+      Gradient().Mask(LEDPattern::ProgressMaskLayer([] { return 0.6; })));
+  ExpectEquivalent(whiteYellowPurple.Blend(invert));
+  ExpectEquivalent(invert.Mask(whiteYellowPurple).OverlayOn(steps));
+}
+
+TEST(CompiledLEDPatternTest, Layered) {
+  auto progress = LEDPattern::ProgressMaskLayer([] { return 0.7; });
+  auto steps = LEDPattern::Steps({{0.1, Color::kWhite}, {0.3, Color::kBlack}});
+
+  ExpectEquivalent(LEDPattern::Rainbow(255, 128)
+                       .ScrollAtRelativeSpeed(0.5_Hz)
+                       .Mask(progress)
+                       .Blend(Gradient().Reversed())
+                       .Breathe(2_s)
+                       .AtBrightness(0.5));
+  ExpectEquivalent(steps.ScrollAtRelativeSpeed(1_Hz)
+                       .OverlayOn(Gradient().Blend(invert.OffsetBy(4)))
+                       .Blink(0.5_s)
+                       .Reversed());
+  ExpectEquivalent(Gradient()
+                       .Blend(steps.Mask(progress.Reversed()).OffsetBy(-7))
+                       .Mask(whiteYellowPurple.AtBrightness(0.8))
+                       .OverlayOn(LEDPattern::Solid(Color::kDenim)));
+}
+
+}  // namespace frc
@@ -0,0 +1,162 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/mutex.h>
+
+#include "frc/Notifier.h"
+#include "frc/NotifierExecutor.h"
+#include "frc/simulation/SimHooks.h"
+
+using namespace frc;
+
+namespace {
+
+class NotifierExecutorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sim::PauseTiming();
+    sim::RestartTiming();
+  }
+
+  void TearDown() override { sim::ResumeTiming(); }
+};
+
+}  // namespace
+
+TEST_F(NotifierExecutorTest, StartPeriodicAndStop) {
+  NotifierExecutor executor;
+  std::atomic<uint32_t> counter{0};
+
+  Notifier notifier{executor, [&] { ++counter; }};
+  notifier.StartPeriodic(1_s);
+
+  sim::StepTiming(10.5_s);
+
+  notifier.Stop();
+  EXPECT_EQ(10u, counter);
+
+  sim::StepTiming(3_s);
+
+  EXPECT_EQ(10u, counter);
+  EXPECT_EQ(10u, notifier.GetStats().runs);
+  EXPECT_EQ(0u, notifier.GetStats().overruns);
+}
+
+TEST_F(NotifierExecutorTest, StartSingle) {
+  NotifierExecutor executor;
+  std::atomic<uint32_t> counter{0};
+
+  Notifier notifier{executor, [&] { ++counter; }};
+  notifier.StartSingle(1_s);
+
+  sim::StepTiming(10.5_s);
+
+  EXPECT_EQ(1u, counter);
+}
+
+TEST_F(NotifierExecutorTest, ManyNotifiersShareThreads) {
+  NotifierExecutor executor{2};
+  std::vector<std::atomic<uint32_t>> counters(15);
+
+  std::vector<Notifier> notifiers;
+  notifiers.reserve(counters.size());
+  for (size_t i = 0; i < counters.size(); ++i) {
+    notifiers.emplace_back(executor, [&counters, i] { ++counters[i]; });
+    notifiers.back().StartPeriodic(units::millisecond_t{20.0 * (i + 1)});
+  }
+
+  sim::StepTiming(3.01_s);
+
+  for (size_t i = 0; i < counters.size(); ++i) {
+    EXPECT_EQ(static_cast<uint32_t>(3.0 / (0.02 * (i + 1)) + 1e-9),
+              counters[i])
+        << "notifier " << i;
+  }
+}
+
+TEST_F(NotifierExecutorTest, HigherPriorityRunsFirst) {
+  NotifierExecutor executor;
+  wpi::mutex mutex;
+  std::vector<int> order;
+
+  Notifier low{executor, 1, [&] {
+                 std::scoped_lock lock(mutex);
+                 order.emplace_back(1);
+               }};
+  Notifier high{executor, 5, [&] {
+                  std::scoped_lock lock(mutex);
+                  order.emplace_back(5);
+                }};
+  low.StartSingle(1_s);
+  high.StartSingle(1_s);
+
+  sim::StepTiming(1.5_s);
+
+  std::scoped_lock lock(mutex);
+  EXPECT_EQ((std::vector<int>{5, 1}), order);
+}
+
+TEST_F(NotifierExecutorTest, Overruns) {
+  NotifierExecutor executor;
+  std::atomic<uint32_t> counter{0};
+
+  Notifier notifier{executor, [&] {
+                      // The first run takes 2.5 periods
+                      if (counter++ == 0) {
+                        sim::StepTimingAsync(2.5_s);
+                      }
+                    }};
+  notifier.StartPeriodic(1_s);
+
+  // Runs at 1 s and overruns until 3.5 s, so 2 s and 3 s are skipped
+  sim::StepTiming(1.2_s);
+  EXPECT_EQ(1u, counter);
+
+  // Runs again at 4 s
+  sim::StepTiming(0.5_s);
+  EXPECT_EQ(2u, counter);
+
+  auto stats = notifier.GetStats();
+  EXPECT_EQ(2u, stats.runs);
+  EXPECT_EQ(2u, stats.overruns);
+  EXPECT_DOUBLE_EQ(2.5, stats.maxRunTime.value());
+}
+
+TEST_F(NotifierExecutorTest, StopFromCallback) {
+  NotifierExecutor executor;
+  std::atomic<uint32_t> counter{0};
+
+  Notifier notifier{executor, [] {}};
+  notifier.SetCallback([&] {
+    if (++counter == 3) {
+      notifier.Stop();
+    }
+  });
+  notifier.StartPeriodic(1_s);
+
+  sim::StepTiming(10.5_s);
+
+  EXPECT_EQ(3u, counter);
+}
+
+TEST_F(NotifierExecutorTest, MoveAssignRemovesExisting) {
+  NotifierExecutor executor;
+  std::atomic<uint32_t> oldCounter{0};
+  std::atomic<uint32_t> newCounter{0};
+
+  Notifier notifier{executor, [&] { ++oldCounter; }};
+  notifier.StartPeriodic(1_s);
+
+  notifier = Notifier{executor, [&] { ++newCounter; }};
+  notifier.StartPeriodic(1_s);
+
+  sim::StepTiming(3.5_s);
+
+  EXPECT_EQ(0u, oldCounter);
+  EXPECT_EQ(3u, newCounter);
+}
@@ -7,9 +7,13 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <numeric>
+#include <string_view>
 #include <thread>
 
 #include <gtest/gtest.h>
+#include <networktables/IntegerArrayTopic.h>
+#include <networktables/NetworkTableInstance.h>
 
 #include "frc/livewindow/LiveWindow.h"
 #include "frc/simulation/DriverStationSim.h"
@@ -610,4 +614,93 @@ TEST_F(TimedRobotTest, AddPeriodicWithOffset) {
   robotThread.join();
 }
 
+TEST_F(TimedRobotTest, LoopProfiler) {
+  auto inst = nt::NetworkTableInstance::Create();
+  inst.StartLocal();
+
+  MockRobot robot;
+
+  std::atomic<uint32_t> callbackCount{0};
+  robot.AddPeriodic([&] { callbackCount++; }, kPeriod / 2.0);
+  robot.EnableLoopProfiler(0_s, inst);
+
+  std::thread robotThread{[&] { robot.StartCompetition(); }};
+
+  frc::sim::DriverStationSim::SetEnabled(false);
+  frc::sim::DriverStationSim::NotifyNewData();
+  frc::sim::StepTiming(0_ms);  // Wait for Notifiers
+
+  frc::sim::StepTiming(kPeriod);
+
+  EXPECT_EQ(1u, robot.m_disabledPeriodicCount);
+  EXPECT_EQ(2u, callbackCount);
+
+  auto count = [&](std::string_view name) {
+    auto counts = inst.GetIntegerArrayTopic(name).Subscribe({}).Get();
+    return std::accumulate(counts.begin(), counts.end(), int64_t{0});
+  };
+
+  // The Notifier wakes up at 0.5p for the callback and at p for both, and
+  // jitter is recorded for every callback run
+  EXPECT_EQ(3, count("/TimedRobot/Profiler/Jitter"));
+  EXPECT_EQ(1, count("/TimedRobot/Profiler/Callbacks/0"));
+  EXPECT_EQ(2, count("/TimedRobot/Profiler/Callbacks/1"));
+  EXPECT_EQ(1, count("/TimedRobot/Profiler/RobotPeriodic"));
+  EXPECT_EQ(1, count("/TimedRobot/Profiler/DisabledPeriodic"));
+  EXPECT_EQ(0, count("/TimedRobot/Profiler/TeleopPeriodic"));
+
+  robot.EndCompetition();
+  robotThread.join();
+  nt::NetworkTableInstance::Destroy(inst);
+}
+
+TEST_F(TimedRobotTest, LoopProfilerEnabledInPeriodic) {
+  auto inst = nt::NetworkTableInstance::Create();
+  inst.StartLocal();
+
+  // Enables the profiler in the middle of its first loop
+  class EnablingRobot : public MockRobot {
+   public:
+    explicit EnablingRobot(nt::NetworkTableInstance inst) : m_inst{inst} {}
+
+    void DisabledPeriodic() override {
+      MockRobot::DisabledPeriodic();
+      if (m_disabledPeriodicCount == 1) {
+        EnableLoopProfiler(0_s, m_inst);
+      }
+    }
+
+    nt::NetworkTableInstance m_inst;
+  };
+  EnablingRobot robot{inst};
+
+  std::thread robotThread{[&] { robot.StartCompetition(); }};
+
+  frc::sim::DriverStationSim::SetEnabled(false);
+  frc::sim::DriverStationSim::NotifyNewData();
+  frc::sim::StepTiming(0_ms);  // Wait for Notifiers
+
+  frc::sim::StepTiming(kPeriod);
+
+  EXPECT_EQ(1u, robot.m_disabledPeriodicCount);
+
+  auto counts = [&](std::string_view name) {
+    return inst.GetIntegerArrayTopic(name).Subscribe({}).Get();
+  };
+
+  // DisabledPeriodic() started before the profiler was enabled, so it isn't
+  // recorded
+  auto disabled = counts("/TimedRobot/Profiler/DisabledPeriodic");
+  EXPECT_EQ(0, std::accumulate(disabled.begin(), disabled.end(), int64_t{0}));
+  auto robotPeriodic = counts("/TimedRobot/Profiler/RobotPeriodic");
+  ASSERT_EQ(frc::TimingHistogram::kNumBuckets, robotPeriodic.size());
+  EXPECT_EQ(1, std::accumulate(robotPeriodic.begin(), robotPeriodic.end(),
+                               int64_t{0}));
+  EXPECT_EQ(0, robotPeriodic.back());
+
+  robot.EndCompetition();
+  robotThread.join();
+  nt::NetworkTableInstance::Destroy(inst);
+}
+
 INSTANTIATE_TEST_SUITE_P(TimedRobotTests, TimedRobotTest, testing::Bool());
@@ -0,0 +1,82 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/internal/TimerWheel.h"
+
+using frc::internal::TimerWheel;
+
+TEST(TimerWheelTest, Empty) {
+  TimerWheel wheel{0};
+  EXPECT_TRUE(wheel.Empty());
+  EXPECT_FALSE(wheel.NextDeadline());
+
+  std::vector<TimerWheel::Timer> expired;
+  wheel.Advance(1'000'000, &expired);
+  EXPECT_TRUE(expired.empty());
+}
+
+TEST(TimerWheelTest, ExpiresInDeadlineOrder) {
+  // Deadlines on every level and in the overflow list, relative to a start
+  // time that isn't aligned to any level
+  uint64_t start = 123'456'789;
+  std::vector<uint64_t> delays{5'000'000'000'000, 300, 1'500, 64'000, 64'001,
+                               70'000, 4'096'000, 5'000'000, 262'144'000,
+                               300'000'000};
+
+  TimerWheel wheel{start};
+  for (uint32_t i = 0; i < delays.size(); ++i) {
+    wheel.Add({start + delays[i], i, 0});
+  }
+
+  std::sort(delays.begin(), delays.end());
+  std::vector<TimerWheel::Timer> expired;
+  for (auto delay : delays) {
+    ASSERT_EQ(start + delay, wheel.NextDeadline());
+
+    // Nothing expires just before the deadline
+    wheel.Advance(start + delay - 1, &expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.Advance(start + delay, &expired);
+    ASSERT_EQ(1u, expired.size());
+    EXPECT_EQ(start + delay, expired[0].deadline);
+    expired.clear();
+  }
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheelTest, TickByTick) {
+  TimerWheel wheel{0};
+  for (uint32_t i = 0; i < 10'000; ++i) {
+    wheel.Add({(i * 7919) % 10'000 * 1'000 + 500, i, 0});
+  }
+
+  std::vector<TimerWheel::Timer> expired;
+  for (uint64_t time = 0; time <= 10'000'000; time += 500) {
+    size_t before = expired.size();
+    wheel.Advance(time, &expired);
+    for (size_t i = before; i < expired.size(); ++i) {
+      EXPECT_EQ(time, expired[i].deadline);
+    }
+  }
+  EXPECT_EQ(10'000u, expired.size());
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheelTest, PastDeadline) {
+  TimerWheel wheel{1'000'000};
+  wheel.Add({500, 7, 3});
+  EXPECT_EQ(500u, wheel.NextDeadline());
+
+  std::vector<TimerWheel::Timer> expired;
+  wheel.Advance(1'000'000, &expired);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(7u, expired[0].index);
+  EXPECT_EQ(3u, expired[0].generation);
+}
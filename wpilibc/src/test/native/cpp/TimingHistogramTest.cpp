@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/TimingHistogram.h"  // NOLINT(build/include_order)
+
+#include <gtest/gtest.h>
+#include <networktables/IntegerArrayTopic.h>
+#include <networktables/NetworkTableInstance.h>
+
+using namespace std::chrono_literals;
+
+TEST(TimingHistogramTest, Buckets) {
+  frc::TimingHistogram histogram;
+  histogram.Record(0us);
+  histogram.Record(10us);
+  histogram.Record(11us);
+  histogram.Record(50ms);
+  histogram.Record(1s);
+
+  auto counts = histogram.GetCounts();
+  // Each bound is the lower bound of the next bucket
+  EXPECT_EQ(1, counts[0]);
+  EXPECT_EQ(2, counts[1]);
+  EXPECT_EQ(0, counts[frc::TimingHistogram::kNumBuckets - 2]);
+  EXPECT_EQ(2, counts[frc::TimingHistogram::kNumBuckets - 1]);
+  EXPECT_EQ(1s, histogram.GetMax());
+
+  histogram.Reset();
+  for (auto count : histogram.GetCounts()) {
+    EXPECT_EQ(0, count);
+  }
+  EXPECT_EQ(0us, histogram.GetMax());
+}
+
+TEST(TimingHistogramTest, Publish) {
+  frc::TimingHistogram histogram{"/TimingHistogramTest/Histogram"};
+  histogram.Record(100us);
+  histogram.Record(150us);
+  histogram.Publish();
+
+  auto counts = nt::NetworkTableInstance::GetDefault()
+                    .GetIntegerArrayTopic("/TimingHistogramTest/Histogram")
+                    .Subscribe({})
+                    .Get();
+  ASSERT_EQ(frc::TimingHistogram::kNumBuckets, counts.size());
+  EXPECT_EQ(0, counts[3]);
+  EXPECT_EQ(2, counts[4]);
+}
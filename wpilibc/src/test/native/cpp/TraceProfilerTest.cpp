@@ -0,0 +1,192 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/TraceProfiler.h"  // NOLINT(build/include_order)
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <wpi/DataLogReader.h>
+#include <wpi/DataLogWriter.h>
+#include <wpi/Logger.h>
+#include <wpi/MemoryBuffer.h>
+#include <wpi/raw_ostream.h>
+
+namespace {
+
+void TraceInner() {
+  FRC_TRACE_ZONE("Inner");
+}
+
+void TraceOuter() {
+  FRC_TRACE_ZONE("Outer");
+  TraceInner();
+  TraceInner();
+}
+
+}  // namespace
+
+TEST(TraceProfilerTest, Record) {
+  wpi::Logger msglog;
+  std::vector<uint8_t> data;
+  {
+    wpi::log::DataLogWriter log{
+        msglog, std::make_unique<wpi::raw_uvector_ostream>(data)};
+
+    // Not recorded, since the profiler isn't running
+    TraceOuter();
+
+    frc::TraceProfiler::Start(log, 10_s);
+    EXPECT_TRUE(frc::TraceProfiler::IsRunning());
+    frc::TraceProfiler::SetThreadName("Main");
+    TraceOuter();
+    std::thread{[] {
+      frc::TraceProfiler::SetThreadName("Worker");
+      TraceInner();
+    }}.join();
+    frc::TraceProfiler::Stop();
+    EXPECT_FALSE(frc::TraceProfiler::IsRunning());
+
+    // Not recorded, since the profiler isn't running
+    TraceOuter();
+    log.Flush();
+  }
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data)};
+  ASSERT_TRUE(reader);
+
+  std::map<int, std::string> entryNames;
+  std::map<int, std::string> entryMetadata;
+  std::vector<std::string_view> zones;
+  std::map<std::string, std::vector<frc::TraceEvent>> threads;
+  for (auto&& record : reader) {
+    if (record.IsStart()) {
+      wpi::log::StartRecordData start;
+      ASSERT_TRUE(record.GetStartData(&start));
+      entryNames[start.entry] = start.name;
+      entryMetadata[start.entry] = start.metadata;
+      if (start.name.starts_with("TraceProfiler/Threads/")) {
+        EXPECT_EQ("struct:TraceEvent[]", start.type);
+      }
+    } else if (record.IsSetMetadata()) {
+      wpi::log::MetadataRecordData metadata;
+      ASSERT_TRUE(record.GetSetMetadataData(&metadata));
+      entryMetadata[metadata.entry] = metadata.metadata;
+    } else if (!record.IsControl()) {
+      auto& name = entryNames[record.GetEntry()];
+      if (name == "TraceProfiler/Zones") {
+        ASSERT_TRUE(record.GetStringArray(&zones));
+      } else if (name.starts_with("TraceProfiler/Threads/")) {
+        auto raw = record.GetRaw();
+        ASSERT_EQ(0u, raw.size() % 11);
+        auto& events = threads[entryMetadata[record.GetEntry()]];
+        for (size_t i = 0; i < raw.size(); i += 11) {
+          events.emplace_back(
+              wpi::UnpackStruct<frc::TraceEvent>(raw.subspan(i, 11)));
+        }
+      }
+    }
+  }
+
+  ASSERT_EQ(2u, zones.size());
+  EXPECT_EQ("Outer", zones[0]);
+  EXPECT_EQ("Inner", zones[1]);
+
+  ASSERT_EQ(2u, threads.size());
+  auto& main = threads["Main"];
+  ASSERT_EQ(6u, main.size());
+  EXPECT_EQ(0, main[0].zone);
+  EXPECT_EQ(frc::TraceEvent::kBegin, main[0].type);
+  EXPECT_EQ(1, main[1].zone);
+  EXPECT_EQ(frc::TraceEvent::kBegin, main[1].type);
+  EXPECT_EQ(1, main[2].zone);
+  EXPECT_EQ(frc::TraceEvent::kEnd, main[2].type);
+  EXPECT_EQ(1, main[3].zone);
+  EXPECT_EQ(frc::TraceEvent::kBegin, main[3].type);
+  EXPECT_EQ(1, main[4].zone);
+  EXPECT_EQ(frc::TraceEvent::kEnd, main[4].type);
+  EXPECT_EQ(0, main[5].zone);
+  EXPECT_EQ(frc::TraceEvent::kEnd, main[5].type);
+  for (size_t i = 1; i < main.size(); ++i) {
+    EXPECT_LE(main[i - 1].time, main[i].time);
+  }
+
+  auto& worker = threads["Worker"];
+  ASSERT_EQ(2u, worker.size());
+  EXPECT_EQ(1, worker[0].zone);
+  EXPECT_EQ(frc::TraceEvent::kBegin, worker[0].type);
+  EXPECT_EQ(1, worker[1].zone);
+  EXPECT_EQ(frc::TraceEvent::kEnd, worker[1].type);
+}
+
+TEST(TraceProfilerTest, BufferSize) {
+  wpi::Logger msglog;
+  std::vector<uint8_t> data;
+  {
+    wpi::log::DataLogWriter log{
+        msglog, std::make_unique<wpi::raw_uvector_ostream>(data)};
+
+    // Rounded up to 4 events, so the last 2 of 6 are dropped. The buffer size
+    // only applies to threads that haven't recorded events yet.
+    frc::TraceProfiler::Start(log, 10_s, 3);
+    std::thread{[] {
+      TraceInner();
+      TraceInner();
+      TraceInner();
+    }}.join();
+    frc::TraceProfiler::Stop();
+    log.Flush();
+  }
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data)};
+  ASSERT_TRUE(reader);
+
+  std::map<int, std::string> entryNames;
+  size_t numEvents = 0;
+  int64_t dropped = 0;
+  for (auto&& record : reader) {
+    if (record.IsStart()) {
+      wpi::log::StartRecordData start;
+      ASSERT_TRUE(record.GetStartData(&start));
+      entryNames[start.entry] = start.name;
+    } else if (!record.IsControl()) {
+      auto& name = entryNames[record.GetEntry()];
+      if (name == "TraceProfiler/Dropped") {
+        ASSERT_TRUE(record.GetInteger(&dropped));
+      } else if (name.starts_with("TraceProfiler/Threads/")) {
+        numEvents += record.GetRaw().size() / 11;
+      }
+    }
+  }
+
+  EXPECT_EQ(4u, numEvents);
+  EXPECT_EQ(2, dropped);
+}
+
+TEST(TraceProfilerTest, TooManyZones) {
+  // Add zones until the last regular ID is used, on top of the zones other
+  // tests added
+  uint16_t zone = 0;
+  int numZones = 0;
+  while (zone < frc::TraceProfiler::kOverflowZone - 1) {
+    zone = frc::TraceProfiler::GetZone(
+        fmt::format("TooManyZones{}", numZones++));
+  }
+
+  // New zones share the overflow ID instead of wrapping around
+  EXPECT_EQ(frc::TraceProfiler::kOverflowZone,
+            frc::TraceProfiler::GetZone("Overflow1"));
+  EXPECT_EQ(frc::TraceProfiler::kOverflowZone,
+            frc::TraceProfiler::GetZone("Overflow2"));
+
+  // Existing zones keep their IDs
+  EXPECT_EQ(zone, frc::TraceProfiler::GetZone(
+                      fmt::format("TooManyZones{}", numZones - 1)));
+}
@@ -0,0 +1,174 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/simulation/LockstepSimulation.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <units/angular_acceleration.h>
+#include <units/angular_velocity.h>
+#include <wpi/mutex.h>
+
+#include "frc/Errors.h"
+#include "frc/Notifier.h"
+#include "frc/RobotController.h"
+#include "frc/TimedRobot.h"
+#include "frc/simulation/DriverStationSim.h"
+#include "frc/simulation/FlywheelSim.h"
+#include "frc/simulation/SimHooks.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+using namespace frc;
+
+namespace {
+
+class LockstepSimulationTest : public ::testing::Test {
+ protected:
+  // The robots' notifiers are created before the simulation pauses timing
+  void SetUp() override { sim::PauseTiming(); }
+
+  void TearDown() override { sim::ResumeTiming(); }
+};
+
+class CountingRobot : public TimedRobot {
+ public:
+  void AutonomousPeriodic() override { ++m_autonomousPeriodicCount; }
+
+  int m_autonomousPeriodicCount = 0;
+};
+
+class FlywheelRobot : public TimedRobot {
+ public:
+  void RobotPeriodic() override {
+    // Proportional control with a feedforward for the steady state voltage
+    m_voltage = 0.02_V / 1_rad_per_s * 200_rad_per_s +
+                0.05_V / 1_rad_per_s * (200_rad_per_s - m_velocity);
+  }
+
+  units::radians_per_second_t m_velocity = 0_rad_per_s;
+  units::volt_t m_voltage = 0_V;
+};
+
+// Logs the time of every callback, from both the TimedRobot's own notifier and
+// separate notifiers
+class LoggingRobot : public TimedRobot {
+ public:
+  LoggingRobot() {
+    AddPeriodic([this] { Log("periodic"); }, 7_ms);
+    m_fast.StartPeriodic(3_ms);
+    m_slow.StartPeriodic(11_ms);
+  }
+
+  void RobotPeriodic() override { Log("robot"); }
+
+  void Log(std::string name) {
+    std::scoped_lock lock(m_mutex);
+    m_log.emplace_back(std::move(name), RobotController::GetFPGATime());
+  }
+
+  wpi::mutex m_mutex;
+  std::vector<std::pair<std::string, uint64_t>> m_log;
+  Notifier m_fast{[this] { Log("fast"); }};
+  Notifier m_slow{[this] { Log("slow"); }};
+};
+
+std::vector<std::pair<std::string, uint64_t>> RunLoggingRobot() {
+  uint64_t start = RobotController::GetFPGATime();
+  LoggingRobot robot;
+  sim::LockstepSimulation simulation;
+  simulation.StartRobot(robot);
+  simulation.Step(2_s);
+  robot.m_fast.Stop();
+  robot.m_slow.Stop();
+
+  // Times are compared relative to the start
+  std::scoped_lock lock(robot.m_mutex);
+  auto log = robot.m_log;
+  for (auto&& entry : log) {
+    entry.second -= start;
+  }
+  return log;
+}
+
+void SetAutonomous() {
+  sim::DriverStationSim::SetAutonomous(true);
+  sim::DriverStationSim::SetEnabled(true);
+  sim::DriverStationSim::NotifyNewData();
+}
+
+}  // namespace
+
+TEST_F(LockstepSimulationTest, Autonomous) {
+  SetAutonomous();
+  CountingRobot robot;
+  sim::LockstepSimulation simulation;
+  simulation.StartRobot(robot);
+
+  auto start = simulation.GetTime();
+  simulation.Step(15_s);
+  EXPECT_EQ(750, robot.m_autonomousPeriodicCount);
+  EXPECT_DOUBLE_EQ(15.0, (simulation.GetTime() - start).value());
+
+  simulation.Step(135_s);
+  EXPECT_EQ(7500, robot.m_autonomousPeriodicCount);
+
+  sim::DriverStationSim::ResetData();
+}
+
+TEST_F(LockstepSimulationTest, StartRobotTwice) {
+  CountingRobot robot;
+  CountingRobot other;
+  sim::LockstepSimulation simulation;
+  simulation.StartRobot(robot);
+  EXPECT_THROW(simulation.StartRobot(other), frc::RuntimeError);
+  EXPECT_THROW(simulation.StartRobot(robot), frc::RuntimeError);
+}
+
+TEST_F(LockstepSimulationTest, InvalidPhysicsPeriod) {
+  EXPECT_THROW(sim::LockstepSimulation{0_s}, frc::RuntimeError);
+  EXPECT_THROW(sim::LockstepSimulation{-5_ms}, frc::RuntimeError);
+  EXPECT_THROW(sim::LockstepSimulation{0.5_us}, frc::RuntimeError);
+}
+
+TEST_F(LockstepSimulationTest, Physics) {
+  SetAutonomous();
+  FlywheelRobot robot;
+  sim::FlywheelSim flywheel{LinearSystemId::IdentifyVelocitySystem<units::radian>(
+                                0.02_V / 1_rad_per_s, 0.01_V / 1_rad_per_s_sq),
+                            DCMotor::NEO(2)};
+  int physicsCount = 0;
+
+  sim::LockstepSimulation simulation{5_ms};
+  simulation.AddPhysics([&](units::second_t) {
+    flywheel.SetInputVoltage(robot.m_voltage);
+    ++physicsCount;
+  });
+  simulation.AddPhysics(flywheel);
+  simulation.AddPhysics(
+      [&](units::second_t) { robot.m_velocity = flywheel.GetAngularVelocity(); });
+  simulation.StartRobot(robot);
+
+  simulation.Step(5_s);
+  EXPECT_EQ(1000, physicsCount);
+  EXPECT_NEAR(200.0, flywheel.GetAngularVelocity().value(), 0.1);
+
+  sim::DriverStationSim::ResetData();
+}
+
+TEST_F(LockstepSimulationTest, Deterministic) {
+  auto log = RunLoggingRobot();
+
+  // Callbacks run in time order
+  ASSERT_FALSE(log.empty());
+  for (size_t i = 1; i < log.size(); ++i) {
+    EXPECT_LE(log[i - 1].second, log[i].second);
+  }
+
+  EXPECT_EQ(log, RunLoggingRobot());
+}
@@ -0,0 +1,158 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/simulation/ParallelSimulation.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <hal/simulation/SimContext.h>
+#include <units/angular_acceleration.h>
+#include <units/angular_velocity.h>
+#include <wpi/DataLog.h>
+#include <wpi/DataLogReader.h>
+#include <wpi/MemoryBuffer.h>
+#include <wpi/Synchronization.h>
+
+#include "frc/Errors.h"
+#include "frc/Notifier.h"
+#include "frc/RobotController.h"
+#include "frc/motorcontrol/PWMSparkMax.h"
+#include "frc/simulation/FlywheelSim.h"
+#include "frc/simulation/LockstepSimulation.h"
+#include "frc/simulation/PWMSim.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+using namespace frc;
+
+namespace {
+
+constexpr int kRuns = 12;
+
+// Spins up a flywheel for a second, with a different output for each run. All
+// runs use the same PWM channel, and a Notifier that logs the velocity.
+double RunFlywheel(int index, wpi::log::DataLog& log) {
+  PWMSparkMax motor{0};
+  sim::PWMSim motorSim{motor};
+  sim::FlywheelSim flywheel{
+      LinearSystemId::IdentifyVelocitySystem<units::radian>(
+          0.02_V / 1_rad_per_s, 0.01_V / 1_rad_per_s_sq),
+      DCMotor::NEO(2)};
+  wpi::log::DoubleLogEntry velocityLog{log, "velocity"};
+
+  int notifierCount = 0;
+  Notifier logger{[&] {
+    ++notifierCount;
+    velocityLog.Append(flywheel.GetAngularVelocity().value());
+  }};
+  logger.StartPeriodic(20_ms);
+  motor.Set(0.05 * (index + 1));
+
+  sim::LockstepSimulation simulation{5_ms};
+  simulation.AddPhysics([&](units::second_t) {
+    flywheel.SetInputVoltage(motorSim.GetSpeed() * 12_V);
+  });
+  simulation.AddPhysics(flywheel);
+  simulation.Step(1_s);
+  logger.Stop();
+
+  // Simulator time is separate for each run
+  EXPECT_EQ(1000000u, RobotController::GetFPGATime());
+  EXPECT_EQ(50, notifierCount);
+  return flywheel.GetAngularVelocity().value();
+}
+
+std::vector<double> ReadVelocities(const std::vector<uint8_t>& data) {
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data)};
+  EXPECT_TRUE(reader);
+  int entry = -1;
+  std::vector<double> velocities;
+  for (auto&& record : reader) {
+    if (record.IsStart()) {
+      wpi::log::StartRecordData start;
+      EXPECT_TRUE(record.GetStartData(&start));
+      if (start.name == "velocity") {
+        entry = start.entry;
+      }
+    } else if (record.GetEntry() == entry) {
+      double velocity;
+      EXPECT_TRUE(record.GetDouble(&velocity));
+      velocities.emplace_back(velocity);
+    }
+  }
+  return velocities;
+}
+
+}  // namespace
+
+TEST(ParallelSimulationTest, Isolated) {
+  auto results = sim::ParallelSimulation{4}.Run(kRuns, RunFlywheel);
+  ASSERT_EQ(static_cast<size_t>(kRuns), results.size());
+  for (int i = 1; i < kRuns; ++i) {
+    EXPECT_GT(results[i].score, results[i - 1].score);
+  }
+
+  // The runs are deterministic, regardless of the number of threads
+  auto sequential = sim::ParallelSimulation{1}.Run(kRuns, RunFlywheel);
+  for (int i = 0; i < kRuns; ++i) {
+    EXPECT_EQ(sequential[i].score, results[i].score);
+  }
+
+  // The calling thread's simulation is untouched
+  EXPECT_FALSE(sim::PWMSim{0}.GetInitialized());
+}
+
+TEST(ParallelSimulationTest, Logs) {
+  auto results = sim::ParallelSimulation{3}.Run(kRuns, RunFlywheel);
+  for (int i = 0; i < kRuns; ++i) {
+    auto velocities = ReadVelocities(results[i].log);
+    ASSERT_EQ(50u, velocities.size());
+    EXPECT_GT(velocities.front(), 0.0);
+    EXPECT_GT(velocities.back(), velocities.front());
+  }
+}
+
+TEST(ParallelSimulationTest, Exception) {
+  int runs = 0;
+  EXPECT_THROW(sim::ParallelSimulation{1}.Run(
+                   kRuns,
+                   [&](int index, wpi::log::DataLog&) -> double {
+                     ++runs;
+                     if (index == 3) {
+                       throw std::runtime_error{"run failed"};
+                     }
+                     return index;
+                   }),
+               std::runtime_error);
+
+  // No more runs are started after one throws
+  EXPECT_EQ(4, runs);
+}
+
+TEST(ParallelSimulationTest, ThreadLeftRunning) {
+  std::thread thread;
+  wpi::Event bound;
+  wpi::Event done;
+  EXPECT_THROW(
+      sim::ParallelSimulation{1}.Run(
+          1,
+          [&](int, wpi::log::DataLog&) -> double {
+            int32_t context = HALSIM_GetThreadSimContext();
+            thread = std::thread{[&, context] {
+              HALSIM_SetThreadSimContext(context);
+              bound.Set();
+              wpi::WaitForObject(done.GetHandle());
+            }};
+            wpi::WaitForObject(bound.GetHandle());
+            return 0;
+          }),
+      frc::RuntimeError);
+  done.Set();
+  thread.join();
+}
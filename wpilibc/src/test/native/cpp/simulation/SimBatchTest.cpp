@@ -0,0 +1,194 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/simulation/SimBatch.h"  // NOLINT(build/include_order)
+
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/simulation/DCMotorSim.h"
+#include "frc/simulation/ElevatorSim.h"
+#include "frc/simulation/FlywheelSim.h"
+#include "frc/simulation/SingleJointedArmSim.h"
+#include "frc/system/NumericalIntegration.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+using namespace frc;
+
+namespace {
+
+constexpr int kSims = 5;
+constexpr int kSteps = 250;
+
+// A voltage that varies over time, and differs between mechanisms
+units::volt_t Voltage(int step, int index) {
+  return units::volt_t{8.0 * std::sin(step * 0.05 + index)};
+}
+
+// Checks that batched simulations match simulations updated separately. This
+// is for models that LinearSystemSim discretizes exactly.
+template <typename Sim>
+void ExpectEquivalent(std::function<Sim(int)> makeSim) {
+  std::vector<Sim> separate;
+  std::vector<Sim> batched;
+  for (int i = 0; i < kSims; ++i) {
+    separate.emplace_back(makeSim(i));
+    batched.emplace_back(makeSim(i));
+  }
+  sim::SimBatch batch;
+  for (auto&& sim : batched) {
+    batch.Add(sim);
+  }
+
+  for (int step = 0; step < kSteps; ++step) {
+    for (int i = 0; i < kSims; ++i) {
+      separate[i].SetInputVoltage(Voltage(step, i));
+      separate[i].Update(20_ms);
+      batched[i].SetInputVoltage(Voltage(step, i));
+    }
+    batch.Update(20_ms);
+
+    for (int i = 0; i < kSims; ++i) {
+      SCOPED_TRACE(testing::Message() << "step " << step << ", sim " << i);
+      for (int row = 0; row < separate[i].GetOutput().rows(); ++row) {
+        EXPECT_NEAR(separate[i].GetOutput(row), batched[i].GetOutput(row),
+                    1e-9);
+      }
+    }
+  }
+}
+
+// The continuous model of a mechanism with gravity and limits
+struct Model {
+  LinearSystem<2, 1, 2> plant;
+  std::function<double(double)> gravity;
+  double minPosition;
+  double maxPosition;
+};
+
+// Checks that batched simulations of mechanisms with gravity and limits match
+// the continuous model integrated with many small steps. The batch is more
+// accurate than the separate simulations here, which use an adaptive
+// integrator with a loose tolerance.
+template <typename Sim>
+void ExpectMatchesModel(std::vector<Sim>& sims, const std::vector<Model>& models,
+                        double tolerance) {
+  sim::SimBatch batch;
+  std::vector<Vectord<2>> expected;
+  for (auto&& sim : sims) {
+    batch.Add(sim);
+    expected.emplace_back(sim.GetOutput());
+  }
+
+  for (int step = 0; step < kSteps; ++step) {
+    for (int i = 0; i < kSims; ++i) {
+      auto& model = models[i];
+      Vectord<1> u{Voltage(step, i).value()};
+      sims[i].SetInput(u);
+
+      for (int substep = 0; substep < 200; ++substep) {
+        expected[i] = RK4(
+            [&](const Vectord<2>& x, const Vectord<1>& u) -> Vectord<2> {
+              return model.plant.A() * x + model.plant.B() * u +
+                     Vectord<2>{0.0, model.gravity(x(0))};
+            },
+            expected[i], u, 0.1_ms);
+      }
+      if (expected[i](0) <= model.minPosition) {
+        expected[i] = Vectord<2>{model.minPosition, 0.0};
+      } else if (expected[i](0) >= model.maxPosition) {
+        expected[i] = Vectord<2>{model.maxPosition, 0.0};
+      }
+    }
+    batch.Update(20_ms);
+
+    for (int i = 0; i < kSims; ++i) {
+      SCOPED_TRACE(testing::Message() << "step " << step << ", sim " << i);
+      EXPECT_NEAR(expected[i](0), sims[i].GetOutput(0), tolerance);
+      EXPECT_NEAR(expected[i](1), sims[i].GetOutput(1), tolerance * 10);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(SimBatchTest, Flywheel) {
+  ExpectEquivalent<sim::FlywheelSim>([](int i) {
+    return sim::FlywheelSim{
+        LinearSystemId::FlywheelSystem(DCMotor::NEO(2),
+                                       0.002_kg_sq_m * (i + 1), 1.0 + i),
+        DCMotor::NEO(2)};
+  });
+}
+
+TEST(SimBatchTest, DCMotor) {
+  ExpectEquivalent<sim::DCMotorSim>([](int i) {
+    return sim::DCMotorSim{
+        LinearSystemId::DCMotorSystem(DCMotor::KrakenX60(1),
+                                      0.001_kg_sq_m * (i + 1), 6.75),
+        DCMotor::KrakenX60(1)};
+  });
+}
+
+TEST(SimBatchTest, Elevator) {
+  std::vector<sim::ElevatorSim> sims;
+  std::vector<Model> models;
+  for (int i = 0; i < kSims; ++i) {
+    bool gravity = i % 2 == 0;
+    auto plant = LinearSystemId::ElevatorSystem(
+        DCMotor::Vex775Pro(4), 8_kg + i * 1_kg, 0.75_in, 14.67);
+    sims.emplace_back(plant, DCMotor::Vex775Pro(4), 0_m, 1.5_m, gravity, 1_m);
+    models.push_back(
+        {plant, [=](double) { return gravity ? -9.8 : 0.0; }, 0.0, 1.5});
+  }
+  ExpectMatchesModel(sims, models, 1e-9);
+}
+
+TEST(SimBatchTest, SingleJointedArm) {
+  std::vector<sim::SingleJointedArmSim> sims;
+  std::vector<Model> models;
+  for (int i = 0; i < kSims; ++i) {
+    bool gravity = i % 2 == 0;
+    units::meter_t armLength = 30_in + i * 5_in;
+    auto plant = LinearSystemId::SingleJointedArmSystem(DCMotor::Vex775Pro(2),
+                                                        3_kg_sq_m, 300);
+    sims.emplace_back(plant, DCMotor::Vex775Pro(2), 300, armLength, -180_deg,
+                      180_deg, gravity, 0_deg);
+    models.push_back({plant,
+                      [=](double angle) {
+                        return gravity ? 3.0 / 2.0 * -9.8 /
+                                             armLength.value() *
+                                             std::cos(angle)
+                                       : 0.0;
+                      },
+                      -std::numbers::pi, std::numbers::pi});
+  }
+  ExpectMatchesModel(sims, models, 1e-3);
+}
+
+TEST(SimBatchTest, SetState) {
+  sim::DCMotorSim sim{
+      LinearSystemId::DCMotorSystem(DCMotor::NEO(1), 0.001_kg_sq_m, 1.0),
+      DCMotor::NEO(1)};
+  sim::SimBatch batch;
+  batch.Add(sim);
+  batch.Update(20_ms);
+
+  // Changes to a simulation between updates are used by the next update
+  sim.SetState(1_rad, 0_rad_per_s);
+  batch.Update(20_ms);
+  EXPECT_DOUBLE_EQ(1.0, sim.GetAngularPosition().value());
+
+  // Changing the timestep redoes the discretization
+  sim.SetInputVoltage(12_V);
+  sim::DCMotorSim separate = sim;
+  batch.Update(5_ms);
+  separate.Update(5_ms);
+  EXPECT_NEAR(separate.GetAngularVelocity().value(),
+              sim.GetAngularVelocity().value(), 1e-9);
+}
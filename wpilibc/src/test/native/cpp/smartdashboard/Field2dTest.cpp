@@ -0,0 +1,134 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <frc/smartdashboard/Field2d.h>
+#include <frc/smartdashboard/SmartDashboard.h>
+
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <networktables/DoubleArrayTopic.h>
+#include <networktables/NetworkTableInstance.h>
+#include <networktables/StructArrayTopic.h>
+#include <ntcore_cpp.h>
+
+namespace {
+
+std::vector<frc::Pose2d> MakePoses(size_t count) {
+  std::vector<frc::Pose2d> poses;
+  for (size_t i = 0; i < count; ++i) {
+    poses.emplace_back(units::meter_t{i * 0.1}, 1_m, units::degree_t{i * 1.0});
+  }
+  return poses;
+}
+
+nt::StructArraySubscriber<frc::Pose2d> SubscribeChunk(std::string_view name) {
+  return nt::NetworkTableInstance::GetDefault()
+      .GetStructArrayTopic<frc::Pose2d>(name)
+      .Subscribe({});
+}
+
+}  // namespace
+
+TEST(Field2dTest, DoubleArray) {
+  frc::Field2d field;
+  auto entry = nt::NetworkTableInstance::GetDefault()
+                   .GetDoubleArrayTopic("/SmartDashboard/DoubleArrayField/Robot")
+                   .Subscribe({});
+  frc::SmartDashboard::PutData("DoubleArrayField", &field);
+  field.SetRobotPose(1_m, 2_m, 90_deg);
+  EXPECT_EQ((std::vector<double>{1.0, 2.0, 90.0}), entry.Get());
+  EXPECT_EQ(frc::Pose2d(1_m, 2_m, 90_deg), field.GetRobotPose());
+}
+
+TEST(Field2dTest, StructArray) {
+  frc::Field2d field;
+  field.SetStructPublishing(true);
+  auto sub = SubscribeChunk("/SmartDashboard/StructArrayField/Robot");
+  frc::SmartDashboard::PutData("StructArrayField", &field);
+  field.SetRobotPose(1_m, 2_m, 90_deg);
+  auto poses = sub.Get();
+  ASSERT_EQ(1u, poses.size());
+  EXPECT_EQ(frc::Pose2d(1_m, 2_m, 90_deg), poses[0]);
+  EXPECT_EQ(frc::Pose2d(1_m, 2_m, 90_deg), field.GetRobotPose());
+}
+
+TEST(Field2dTest, StructArrayChunks) {
+  frc::Field2d field;
+  field.SetStructPublishing(true);
+  frc::SmartDashboard::PutData("ChunksField", &field);
+  auto obj = field.GetObject("Traj");
+  std::vector<nt::StructArraySubscriber<frc::Pose2d>> chunks;
+  chunks.emplace_back(SubscribeChunk("/SmartDashboard/ChunksField/Traj"));
+  for (int i = 1; i < 4; ++i) {
+    chunks.emplace_back(SubscribeChunk(
+        fmt::format("/SmartDashboard/ChunksField/.Traj/{}", i)));
+  }
+  auto readChanged = [&] {
+    std::vector<bool> changed;
+    for (auto&& chunk : chunks) {
+      // Empty arrays are skipped by ReadQueue(), so read the raw values
+      changed.emplace_back(!nt::ReadQueueRaw(chunk.GetHandle()).empty());
+    }
+    return changed;
+  };
+
+  auto poses = MakePoses(200);
+  obj->SetPoses(poses);
+  EXPECT_EQ((std::vector<bool>{true, true, true, true}), readChanged());
+  EXPECT_EQ(64u, chunks[0].Get().size());
+  EXPECT_EQ(64u, chunks[1].Get().size());
+  EXPECT_EQ(64u, chunks[2].Get().size());
+  EXPECT_EQ(8u, chunks[3].Get().size());
+  EXPECT_EQ(poses, obj->GetPoses());
+
+  // Change one pose
+  poses[150] = frc::Pose2d{};
+  obj->SetPoses(poses);
+  EXPECT_EQ((std::vector<bool>{false, false, true, false}), readChanged());
+  EXPECT_EQ(frc::Pose2d{}, chunks[2].Get()[150 - 128]);
+
+  // Append poses
+  poses.emplace_back(5_m, 5_m, 0_deg);
+  obj->SetPoses(poses);
+  EXPECT_EQ((std::vector<bool>{false, false, false, true}), readChanged());
+  EXPECT_EQ(9u, chunks[3].Get().size());
+
+  // Remove poses
+  poses.resize(10);
+  obj->SetPoses(poses);
+  EXPECT_EQ((std::vector<bool>{true, true, true, true}), readChanged());
+  EXPECT_EQ(10u, chunks[0].Get().size());
+  EXPECT_TRUE(chunks[1].Get().empty());
+  EXPECT_TRUE(chunks[2].Get().empty());
+  EXPECT_TRUE(chunks[3].Get().empty());
+  EXPECT_EQ(poses, obj->GetPoses());
+}
+
+TEST(Field2dTest, StructArrayDashboardChange) {
+  frc::Field2d field;
+  field.SetStructPublishing(true);
+  frc::SmartDashboard::PutData("DashboardField", &field);
+  auto obj = field.GetObject("Traj");
+  auto poses = MakePoses(100);
+  obj->SetPoses(poses);
+
+  // A dashboard moves a pose in the second chunk
+  auto pub = nt::NetworkTableInstance::GetDefault()
+                 .GetStructArrayTopic<frc::Pose2d>(
+                     "/SmartDashboard/DashboardField/.Traj/1")
+                 .Publish();
+  auto changed = MakePoses(100);
+  changed[70] = frc::Pose2d{3_m, 3_m, 0_deg};
+  pub.Set(std::span{changed}.subspan(64));
+  EXPECT_EQ(changed, obj->GetPoses());
+
+  // Setting the poses again overwrites the change
+  auto sub = SubscribeChunk("/SmartDashboard/DashboardField/.Traj/1");
+  obj->SetPoses(poses);
+  EXPECT_EQ(poses[70], sub.Get()[70 - 64]);
+  EXPECT_EQ(poses, obj->GetPoses());
+}
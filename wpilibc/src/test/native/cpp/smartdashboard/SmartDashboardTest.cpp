@@ -0,0 +1,131 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <frc/smartdashboard/SendableBuilderImpl.h>
+#include <frc/smartdashboard/SmartDashboard.h>
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <networktables/DoubleTopic.h>
+#include <networktables/NetworkTableInstance.h>
+#include <wpi/sendable/Sendable.h>
+#include <wpi/sendable/SendableBuilder.h>
+#include <wpi/sendable/SendableHelper.h>
+#include <wpi/sendable/SendableRegistry.h>
+
+namespace {
+
+// Removed from SmartDashboard when destroyed
+class Value : public wpi::Sendable, public wpi::SendableHelper<Value> {
+ public:
+  void InitSendable(wpi::SendableBuilder& builder) override {
+    builder.AddDoubleProperty(
+        "value",
+        [this] {
+          ++getterCalls;
+          return value;
+        },
+        [this](double newValue) {
+          // Only accept values in [0, 1], and clamp to 0.75
+          if (newValue >= 0 && newValue <= 1) {
+            value = (std::min)(newValue, 0.75);
+          }
+        });
+  }
+
+  double value = 0.5;
+  int getterCalls = 0;
+};
+
+}  // namespace
+
+TEST(SmartDashboardTest, UpdateValues) {
+  Value data;
+  auto sub = nt::NetworkTableInstance::GetDefault()
+                 .GetDoubleTopic("/SmartDashboard/UpdateValues/value")
+                 .Subscribe(0.0);
+  frc::SmartDashboard::PutData("UpdateValues", &data);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(0.5, sub.Get());
+
+  data.value = 0.25;
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(0.25, sub.Get());
+}
+
+TEST(SmartDashboardTest, UpdatePeriod) {
+  Value data;
+  auto sub = nt::NetworkTableInstance::GetDefault()
+                 .GetDoubleTopic("/SmartDashboard/UpdatePeriod/value")
+                 .Subscribe(0.0);
+  frc::SmartDashboard::PutData("UpdatePeriod", &data);
+  frc::SmartDashboard::SetUpdatePeriod("UpdatePeriod", 1000_s);
+
+  // The first update is immediate; the next isn't due for a long time
+  frc::SmartDashboard::UpdateValues();
+  int getterCalls = data.getterCalls;
+  EXPECT_EQ(0.5, sub.Get());
+  data.value = 0.25;
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(getterCalls, data.getterCalls);
+  EXPECT_EQ(0.5, sub.Get());
+
+  frc::SmartDashboard::SetUpdatePeriod("UpdatePeriod", 0_s);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(getterCalls + 1, data.getterCalls);
+  EXPECT_EQ(0.25, sub.Get());
+}
+
+TEST(SmartDashboardTest, RemoteSet) {
+  Value data;
+  auto topic = nt::NetworkTableInstance::GetDefault().GetDoubleTopic(
+      "/SmartDashboard/RemoteSet/value");
+  auto sub = topic.Subscribe(0.0);
+  auto pub = topic.Publish();
+  frc::SmartDashboard::PutData("RemoteSet", &data);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(0.5, sub.Get());
+
+  // Set to a different value than the one sent
+  pub.Set(1.0);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(0.75, data.value);
+  EXPECT_EQ(0.75, sub.Get());
+
+  // Rejected, so the unchanged value is sent again
+  pub.Set(2.0);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ(0.75, data.value);
+  EXPECT_EQ(0.75, sub.Get());
+}
+
+TEST(SmartDashboardTest, BatchScope) {
+  Value data1;
+  Value data2;
+  auto inst = nt::NetworkTableInstance::GetDefault();
+  auto sub1 = inst.GetDoubleTopic("/SmartDashboard/BatchScope1/value")
+                  .Subscribe(0.0);
+  auto sub2 = inst.GetDoubleTopic("/SmartDashboard/BatchScope2/value")
+                  .Subscribe(0.0);
+  frc::SmartDashboard::PutData("BatchScope1", &data1);
+  frc::SmartDashboard::PutData("BatchScope2", &data2);
+  frc::SmartDashboard::UpdateValues();
+
+  // Both builders stage their values until the scope ends
+  data1.value = 0.25;
+  data2.value = 0.125;
+  frc::SendableBuilderImpl::UpdateBatch batch;
+  {
+    frc::SendableBuilderImpl::BatchScope scope{batch};
+    wpi::SendableRegistry::Update(wpi::SendableRegistry::GetUniqueId(&data1));
+    wpi::SendableRegistry::Update(wpi::SendableRegistry::GetUniqueId(&data2));
+    EXPECT_EQ(2u, batch.handles.size());
+    EXPECT_EQ(0.5, sub1.Get());
+    EXPECT_EQ(0.5, sub2.Get());
+  }
+  EXPECT_TRUE(batch.handles.empty());
+  EXPECT_EQ(0.25, sub1.Get());
+  EXPECT_EQ(0.125, sub2.Get());
+}
@@ -7,9 +7,6 @@
 #include <cmath>
 #include <stdexcept>
 
-#include <Eigen/Cholesky>
-
-#include "frc/DARE.h"
 #include "frc/MathUtil.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/system/Discretization.h"
@@ -48,13 +45,27 @@ LTVDifferentialDriveController::LTVDifferentialDriveController(
     const frc::LinearSystem<2, 2, 2>& plant, units::meter_t trackwidth,
     const wpi::array<double, 5>& Qelems, const wpi::array<double, 2>& Relems,
     units::second_t dt)
-    : m_trackwidth{trackwidth} {
+    : LTVDifferentialDriveController{plant, trackwidth, Qelems, Relems, dt, {}} {
+}
+
+LTVDifferentialDriveController::LTVDifferentialDriveController(
+    const frc::LinearSystem<2, 2, 2>& plant, units::meter_t trackwidth,
+    const wpi::array<double, 5>& Qelems, const wpi::array<double, 2>& Relems,
+    units::second_t dt, const LTVGainTableOptions& options)
+    : m_trackwidth{trackwidth},
+      m_table{
+          MakeGainTable(plant, trackwidth, Qelems, Relems, dt, options)} {}
+
+detail::LTVGainTable<5, 2> LTVDifferentialDriveController::MakeGainTable(
+    const frc::LinearSystem<2, 2, 2>& plant, units::meter_t trackwidth,
+    const wpi::array<double, 5>& Qelems, const wpi::array<double, 2>& Relems,
+    units::second_t dt, const LTVGainTableOptions& options) {
   // Control law derivation is in section 8.7 of
   // https://file.tavsys.net/control/controls-engineering-in-frc.pdf
   Matrixd<5, 5> A{
       {0.0, 0.0, 0.0, 0.5, 0.5},
       {0.0, 0.0, 0.0, 0.0, 0.0},
-      {0.0, 0.0, 0.0, -1.0 / m_trackwidth.value(), 1.0 / m_trackwidth.value()},
+      {0.0, 0.0, 0.0, -1.0 / trackwidth.value(), 1.0 / trackwidth.value()},
       {0.0, 0.0, 0.0, plant.A(0, 0), plant.A(0, 1)},
       {0.0, 0.0, 0.0, plant.A(1, 0), plant.A(1, 1)}};
   Matrixd<5, 2> B{{0.0, 0.0},
@@ -82,28 +93,31 @@ LTVDifferentialDriveController::LTVDifferentialDriveController(
         "Max velocity of plant with 12 V input must be less than 15 m/s.");
   }
 
-  auto R_llt = R.llt();
+  // This may be called from multiple threads, so it can't modify A in place
+  auto model = [=](units::meters_per_second_t velocity, Matrixd<5, 5>* discA,
+                   Matrixd<5, 2>* discB) {
+    Matrixd<5, 5> A_v = A;
 
-  for (auto velocity = -maxV; velocity < maxV; velocity += 0.01_mps) {
     // The DARE is ill-conditioned if the velocity is close to zero, so don't
     // let the system stop.
     if (units::math::abs(velocity) < 1e-4_mps) {
-      A(State::kY, State::kHeading) = 1e-4;
+      A_v(State::kY, State::kHeading) = 1e-4;
     } else {
-      A(State::kY, State::kHeading) = velocity.value();
+      A_v(State::kY, State::kHeading) = velocity.value();
     }
 
-    Matrixd<5, 5> discA;
-    Matrixd<5, 2> discB;
-    DiscretizeAB(A, B, dt, &discA, &discB);
-
-    auto S = detail::DARE<5, 2>(discA, discB, Q, R_llt);
-
-    // K = (BᵀSB + R)⁻¹BᵀSA
-    m_table.insert(velocity, (discB.transpose() * S * discB + R)
-                                 .llt()
-                                 .solve(discB.transpose() * S * discA));
-  }
+    DiscretizeAB(A_v, B, dt, discA, discB);
+  };
+
+  return {model,
+          Q,
+          R,
+          maxV,
+          {plant.A(0, 0), plant.A(0, 1), plant.A(1, 0), plant.A(1, 1),
+           plant.B(0, 0), plant.B(0, 1), plant.B(1, 0), plant.B(1, 1),
+           trackwidth.value(), Qelems[0], Qelems[1], Qelems[2], Qelems[3],
+           Qelems[4], Relems[0], Relems[1], dt.value()},
+          options};
 }
 
 bool LTVDifferentialDriveController::AtReference() const {
@@ -0,0 +1,156 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/controller/LTVGainTable.h"
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+#include <wpi/Endian.h>
+#include <wpi/MemoryBuffer.h>
+#include <wpi/raw_ostream.h>
+
+using namespace frc;
+
+// File format (all values little-endian):
+//
+//   magic[4] = "LTVG"
+//   uint32 version
+//   uint32 rows, cols
+//   uint32 numParams, numEntries
+//   double params[numParams]
+//   entries[numEntries]: double velocity, double gain[rows * cols] (row-major)
+static constexpr char kMagic[4] = {'L', 'T', 'V', 'G'};
+static constexpr uint32_t kVersion = 1;
+static constexpr size_t kHeaderSize = 4 + 5 * 4;
+
+namespace {
+
+class Writer {
+ public:
+  void U32(uint32_t value) {
+    uint8_t buf[4];
+    wpi::support::endian::write32le(buf, value);
+    m_data.insert(m_data.end(), buf, buf + 4);
+  }
+  void Double(double value) {
+    uint8_t buf[8];
+    wpi::support::endian::write64le(buf, std::bit_cast<uint64_t>(value));
+    m_data.insert(m_data.end(), buf, buf + 8);
+  }
+  std::vector<uint8_t>& Data() { return m_data; }
+
+ private:
+  std::vector<uint8_t> m_data;
+};
+
+}  // namespace
+
+bool detail::SaveLTVGainTable(std::string_view path,
+                              std::span<const double> params, int rows,
+                              int cols, std::span<const double> velocities,
+                              std::span<const double> gains) {
+  if (gains.size() != velocities.size() * rows * cols) {
+    return false;
+  }
+
+  Writer writer;
+  auto& data = writer.Data();
+  data.reserve(kHeaderSize + 8 * (params.size() + gains.size() +
+                                  velocities.size()));
+  data.insert(data.end(), kMagic, kMagic + 4);
+  writer.U32(kVersion);
+  writer.U32(rows);
+  writer.U32(cols);
+  writer.U32(params.size());
+  writer.U32(velocities.size());
+  for (double param : params) {
+    writer.Double(param);
+  }
+  for (size_t i = 0; i < velocities.size(); ++i) {
+    writer.Double(velocities[i]);
+    for (int j = 0; j < rows * cols; ++j) {
+      writer.Double(gains[i * rows * cols + j]);
+    }
+  }
+
+  std::error_code ec;
+  wpi::raw_fd_ostream os{path, ec};
+  if (ec) {
+    return false;
+  }
+  os.write(data.data(), data.size());
+  os.close();
+  return !os.has_error();
+}
+
+bool detail::LoadLTVGainTable(std::string_view path,
+                              std::span<const double> params, int rows,
+                              int cols, std::vector<double>* velocities,
+                              std::vector<double>* gains) {
+  auto fileBuffer = wpi::MemoryBuffer::GetFile(path);
+  if (!fileBuffer) {
+    return false;
+  }
+  auto data = fileBuffer.value()->GetBuffer();
+
+  if (data.size() < kHeaderSize || std::memcmp(data.data(), kMagic, 4) != 0) {
+    return false;
+  }
+  auto u32 = [&](size_t pos) {
+    return wpi::support::endian::read32le(&data[pos]);
+  };
+  auto dbl = [&](size_t pos) {
+    return std::bit_cast<double>(wpi::support::endian::read64le(&data[pos]));
+  };
+
+  if (u32(4) != kVersion || u32(8) != static_cast<uint32_t>(rows) ||
+      u32(12) != static_cast<uint32_t>(cols) || u32(16) != params.size()) {
+    return false;
+  }
+  size_t numEntries = u32(20);
+  size_t entrySize = 8 * (1 + rows * cols);
+  if (data.size() != kHeaderSize + 8 * params.size() + numEntries * entrySize) {
+    return false;
+  }
+
+  // The gains are only valid for the exact same parameters
+  size_t pos = kHeaderSize;
+  for (double param : params) {
+    if (dbl(pos) != param) {
+      return false;
+    }
+    pos += 8;
+  }
+
+  velocities->clear();
+  gains->clear();
+  velocities->reserve(numEntries);
+  gains->reserve(numEntries * rows * cols);
+  for (size_t i = 0; i < numEntries; ++i) {
+    velocities->emplace_back(dbl(pos));
+    pos += 8;
+    for (int j = 0; j < rows * cols; ++j) {
+      gains->emplace_back(dbl(pos));
+      pos += 8;
+    }
+  }
+
+  // Reject corrupt files instead of handing out NaN gains
+  for (size_t i = 0; i < numEntries; ++i) {
+    if (!std::isfinite((*velocities)[i]) ||
+        (i > 0 && (*velocities)[i] <= (*velocities)[i - 1])) {
+      return false;
+    }
+  }
+  for (double gain : *gains) {
+    if (!std::isfinite(gain)) {
+      return false;
+    }
+  }
+  return true;
+}
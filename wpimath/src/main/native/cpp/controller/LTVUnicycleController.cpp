@@ -6,9 +6,6 @@
 
 #include <stdexcept>
 
-#include <Eigen/Cholesky>
-
-#include "frc/DARE.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/system/Discretization.h"
 #include "units/math.h"
@@ -42,7 +39,19 @@ LTVUnicycleController::LTVUnicycleController(
 
 LTVUnicycleController::LTVUnicycleController(
     const wpi::array<double, 3>& Qelems, const wpi::array<double, 2>& Relems,
-    units::second_t dt, units::meters_per_second_t maxVelocity) {
+    units::second_t dt, units::meters_per_second_t maxVelocity)
+    : LTVUnicycleController{Qelems, Relems, dt, maxVelocity, {}} {}
+
+LTVUnicycleController::LTVUnicycleController(
+    const wpi::array<double, 3>& Qelems, const wpi::array<double, 2>& Relems,
+    units::second_t dt, units::meters_per_second_t maxVelocity,
+    const LTVGainTableOptions& options)
+    : m_table{MakeGainTable(Qelems, Relems, dt, maxVelocity, options)} {}
+
+detail::LTVGainTable<3, 2> LTVUnicycleController::MakeGainTable(
+    const wpi::array<double, 3>& Qelems, const wpi::array<double, 2>& Relems,
+    units::second_t dt, units::meters_per_second_t maxVelocity,
+    const LTVGainTableOptions& options) {
   if (maxVelocity <= 0_mps) {
     throw std::domain_error("Max velocity must be greater than 0 m/s.");
   }
@@ -87,29 +96,29 @@ LTVUnicycleController::LTVUnicycleController(
   Matrixd<3, 3> Q = frc::MakeCostMatrix(Qelems);
   Matrixd<2, 2> R = frc::MakeCostMatrix(Relems);
 
-  auto R_llt = R.llt();
+  // This may be called from multiple threads, so it can't modify A in place
+  auto model = [=](units::meters_per_second_t velocity, Matrixd<3, 3>* discA,
+                   Matrixd<3, 2>* discB) {
+    Matrixd<3, 3> A_v = A;
 
-  for (auto velocity = -maxVelocity; velocity < maxVelocity;
-       velocity += 0.01_mps) {
     // The DARE is ill-conditioned if the velocity is close to zero, so don't
     // let the system stop.
     if (units::math::abs(velocity) < 1e-4_mps) {
-      A(State::kY, State::kHeading) = 1e-4;
+      A_v(State::kY, State::kHeading) = 1e-4;
     } else {
-      A(State::kY, State::kHeading) = velocity.value();
+      A_v(State::kY, State::kHeading) = velocity.value();
     }
 
-    Matrixd<3, 3> discA;
-    Matrixd<3, 2> discB;
-    DiscretizeAB(A, B, dt, &discA, &discB);
+    DiscretizeAB(A_v, B, dt, discA, discB);
+  };
 
-    auto S = detail::DARE<3, 2>(discA, discB, Q, R_llt);
-
-    // K = (BᵀSB + R)⁻¹BᵀSA
-    m_table.insert(velocity, (discB.transpose() * S * discB + R)
-                                 .llt()
-                                 .solve(discB.transpose() * S * discA));
-  }
+  return {model,
+          Q,
+          R,
+          maxVelocity,
+          {Qelems[0], Qelems[1], Qelems[2], Relems[0], Relems[1], dt.value(),
+           maxVelocity.value()},
+          options};
 }
 
 bool LTVUnicycleController::AtReference() const {
@@ -0,0 +1,245 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/path/TravelingSalesman.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace frc;
+
+namespace {
+
+// Simulated annealing over tours of a precomputed cost matrix, where each
+// proposed move's change in cost is computed without re-evaluating the tour.
+class TourAnnealer {
+ public:
+  TourAnnealer(std::span<const double> costs, size_t n, bool symmetric)
+      : m_costs{costs}, m_n{n}, m_symmetric{symmetric} {}
+
+  // Cost of the edge from pose a to pose b
+  double Cost(size_t a, size_t b) const { return m_costs[a * m_n + b]; }
+
+  double TourCost(std::span<const size_t> tour) const {
+    double sum = 0.0;
+    for (size_t i = 0; i < tour.size(); ++i) {
+      sum += Cost(tour[i], tour[(i + 1) % tour.size()]);
+    }
+    return sum;
+  }
+
+  // Runs one annealing restart from the given tour, leaving the best tour
+  // found in it. Returns the best tour's cost.
+  double Anneal(std::vector<size_t>& tour, int iterations,
+                std::mt19937& gen) const;
+
+ private:
+  // Change in cost from reversing the tour between positions i and j
+  // (inclusive), where 0 < i < j < n
+  double ReverseDelta(std::span<const size_t> tour, size_t i, size_t j) const;
+
+  // Change in cost from moving the segment of the given length at position i
+  // to between positions p and p + 1 (modulo n), where p is outside the
+  // segment and isn't the position just before it
+  double MoveDelta(std::span<const size_t> tour, size_t i, size_t length,
+                   size_t p) const;
+
+  std::span<const double> m_costs;
+  size_t m_n;
+  bool m_symmetric;
+};
+
+double TourAnnealer::ReverseDelta(std::span<const size_t> tour, size_t i,
+                                  size_t j) const {
+  size_t a = tour[i - 1];
+  size_t b = tour[i];
+  size_t c = tour[j];
+  size_t d = tour[(j + 1) % m_n];
+  double delta = Cost(a, c) + Cost(b, d) - Cost(a, b) - Cost(c, d);
+  if (!m_symmetric) {
+    // The edges within the reversed range change direction
+    for (size_t k = i; k < j; ++k) {
+      delta += Cost(tour[k + 1], tour[k]) - Cost(tour[k], tour[k + 1]);
+    }
+  }
+  return delta;
+}
+
+double TourAnnealer::MoveDelta(std::span<const size_t> tour, size_t i,
+                               size_t length, size_t p) const {
+  size_t first = tour[i];
+  size_t last = tour[(i + length - 1) % m_n];
+  size_t prev = tour[(i + m_n - 1) % m_n];
+  size_t next = tour[(i + length) % m_n];
+  size_t to = tour[p];
+  size_t toNext = tour[(p + 1) % m_n];
+  return Cost(prev, next) + Cost(to, first) + Cost(last, toNext) -
+         Cost(prev, first) - Cost(last, next) - Cost(to, toNext);
+}
+
+double TourAnnealer::Anneal(std::vector<size_t>& tour, int iterations,
+                            std::mt19937& gen) const {
+  double cost = TourCost(tour);
+  double minCost = cost;
+  std::vector<size_t> minTour = tour;
+  if (m_n < 4) {
+    // Every tour of three or fewer poses is the same cycle
+    return minCost;
+  }
+
+  // Scale the temperature to the average edge cost so the acceptance
+  // probability doesn't depend on the units of the cost function
+  double initialTemperature = cost / m_n;
+
+  std::uniform_real_distribution<> probability{0.0, 1.0};
+  std::uniform_int_distribution<size_t> position{0, m_n - 1};
+  std::uniform_int_distribution<size_t> segmentLength{1, 3};
+  std::vector<size_t> segment;
+
+  for (int iteration = 1; iteration <= iterations; ++iteration) {
+    double temperature = initialTemperature / iteration;
+
+    // Propose either a 2-opt move (reverse a range) or an Or-opt move (move a
+    // segment of up to three poses elsewhere), keeping tour[0] in place for
+    // the 2-opt move so the range never wraps around.
+    bool reverse = iteration % 2 == 0;
+    size_t i = 0;
+    size_t j = 0;
+    size_t length = 0;
+    double delta = 0.0;
+    if (reverse) {
+      i = 1 + position(gen) % (m_n - 1);
+      j = 1 + position(gen) % (m_n - 1);
+      if (i == j) {
+        continue;
+      }
+      if (j < i) {
+        std::swap(i, j);
+      }
+      delta = ReverseDelta(tour, i, j);
+    } else {
+      length = (std::min)(segmentLength(gen), m_n - 2);
+      i = position(gen);
+      // Insert after one of the n - length - 1 positions that are neither in
+      // the segment nor just before it
+      j = (i + length + position(gen) % (m_n - length - 1)) % m_n;
+      delta = MoveDelta(tour, i, length, j);
+    }
+
+    if (delta >= 0 && std::exp(-delta / temperature) < probability(gen)) {
+      continue;
+    }
+
+    if (reverse) {
+      std::reverse(tour.begin() + i, tour.begin() + j + 1);
+    } else {
+      // Rotate the tour so the segment is at the front, then move it
+      std::rotate(tour.begin(), tour.begin() + i, tour.end());
+      size_t to = (j + m_n - i) % m_n;
+      std::rotate(tour.begin(), tour.begin() + length, tour.begin() + to + 1);
+    }
+    cost += delta;
+
+    if (cost < minCost) {
+      minCost = cost;
+      minTour = tour;
+    }
+  }
+
+  tour = std::move(minTour);
+  // Remove accumulated rounding error from the incremental updates
+  return TourCost(tour);
+}
+
+}  // namespace
+
+std::vector<size_t> TravelingSalesman::SolveIndices(
+    std::span<const Pose2d> poses, int iterations, int restarts, int numThreads,
+    unsigned int seed) const {
+  size_t n = poses.size();
+  if (n == 0) {
+    return {};
+  }
+
+  // Precompute the cost between every pair of poses
+  std::vector<double> costs(n * n);
+  for (size_t a = 0; a < n; ++a) {
+    for (size_t b = 0; b < n; ++b) {
+      costs[a * n + b] = a == b ? 0.0 : m_cost(poses[a], poses[b]);
+    }
+  }
+  bool symmetric = true;
+  for (size_t a = 0; a < n && symmetric; ++a) {
+    for (size_t b = a + 1; b < n; ++b) {
+      if (costs[a * n + b] != costs[b * n + a]) {
+        symmetric = false;
+        break;
+      }
+    }
+  }
+  TourAnnealer annealer{costs, n, symmetric};
+
+  // Run the restarts, split between threads, keeping each thread's best tour
+  restarts = (std::max)(restarts, 1);
+  size_t threadCount = std::clamp(numThreads, 1, restarts);
+  std::vector<std::vector<size_t>> bestTours(threadCount);
+  std::vector<double> bestCosts(threadCount,
+                                std::numeric_limits<double>::infinity());
+  std::vector<int> bestRestarts(threadCount, restarts);
+
+  auto runRestarts = [&](size_t thread) {
+    std::mt19937 gen;
+    std::vector<size_t> tour(n);
+    for (int restart = static_cast<int>(thread); restart < restarts;
+         restart += static_cast<int>(threadCount)) {
+      // Seed each restart separately so the result doesn't depend on how the
+      // restarts are split between threads
+      std::seed_seq seq{seed, static_cast<unsigned int>(restart)};
+      gen.seed(seq);
+
+      // The first restart starts from the given order, the rest from random
+      // orders
+      std::iota(tour.begin(), tour.end(), size_t{0});
+      if (restart > 0) {
+        std::shuffle(tour.begin(), tour.end(), gen);
+      }
+      double cost = annealer.Anneal(tour, iterations, gen);
+      if (cost < bestCosts[thread]) {
+        bestCosts[thread] = cost;
+        bestRestarts[thread] = restart;
+        bestTours[thread] = tour;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t thread = 1; thread < threadCount; ++thread) {
+    threads.emplace_back(runRestarts, thread);
+  }
+  runRestarts(0);
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  // Break ties by the earliest restart, as a single thread would
+  size_t best = 0;
+  for (size_t thread = 1; thread < threadCount; ++thread) {
+    if (bestCosts[thread] < bestCosts[best] ||
+        (bestCosts[thread] == bestCosts[best] &&
+         bestRestarts[thread] < bestRestarts[best])) {
+      best = thread;
+    }
+  }
+  auto& tour = bestTours[best];
+
+  // Rotate the tour until it starts with the first pose
+  std::rotate(tour.begin(), std::find(tour.begin(), tour.end(), size_t{0}),
+              tour.end());
+  return tour;
+}
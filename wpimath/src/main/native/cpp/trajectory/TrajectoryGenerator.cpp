@@ -4,6 +4,9 @@
 
 #include "frc/trajectory/TrajectoryGenerator.h"
 
+#include <algorithm>
+#include <exception>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -27,12 +30,105 @@ void TrajectoryGenerator::ReportError(const char* error) {
   }
 }
 
+TrajectoryGenerator::Workspace::Workspace(int numThreads)
+    : m_numThreads{(std::max)(numThreads, 1)},
+      m_splineWorkspaces(m_numThreads) {}
+
+template <typename Spline>
+void TrajectoryGenerator::SplinePointsFromSplines(
+    const std::vector<Spline>& splines, Workspace& workspace) {
+  if (workspace.m_splinePoints.size() < splines.size()) {
+    workspace.m_splinePoints.resize(splines.size());
+  }
+
+  // Parameterizes a contiguous range of splines into their own buffers. The
+  // first point of each spline is skipped because it's a duplicate of the
+  // last point of the previous spline.
+  auto parameterizeRange = [&](size_t thread, size_t begin, size_t end) {
+    auto& splineWorkspace = workspace.m_splineWorkspaces[thread];
+    for (size_t i = begin; i < end; ++i) {
+      auto& points = workspace.m_splinePoints[i];
+      points.clear();
+      SplineParameterizer::Parameterize(splines[i], &points, &splineWorkspace,
+                                        false);
+    }
+  };
+
+  // Don't bother with threads for fewer than 4 splines each
+  size_t numThreads = std::clamp<size_t>(workspace.m_numThreads, 1,
+                                         (splines.size() + 3) / 4);
+  size_t chunkSize = (splines.size() + numThreads - 1) / numThreads;
+  std::vector<std::exception_ptr> errors(numThreads);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numThreads; ++i) {
+    threads.emplace_back([&, i] {
+      try {
+        parameterizeRange(i, i * chunkSize,
+                          (std::min)((i + 1) * chunkSize, splines.size()));
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  try {
+    parameterizeRange(0, 0, (std::min)(chunkSize, splines.size()));
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  for (auto&& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  size_t size = 1;
+  for (size_t i = 0; i < splines.size(); ++i) {
+    size += workspace.m_splinePoints[i].size();
+  }
+  auto& points = workspace.m_points;
+  points.clear();
+  points.reserve(size);
+  points.push_back(splines.front().GetPoint(0.0).value());
+  for (size_t i = 0; i < splines.size(); ++i) {
+    points.insert(points.end(), workspace.m_splinePoints[i].begin(),
+                  workspace.m_splinePoints[i].end());
+  }
+}
+
+Trajectory TrajectoryGenerator::TimeParameterize(const TrajectoryConfig& config,
+                                                 Workspace& workspace) {
+  // After trajectory generation, flip theta back so it's relative to the
+  // field. Also fix curvature.
+  if (config.IsReversed()) {
+    const Transform2d flip{Translation2d{}, 180_deg};
+    for (auto& point : workspace.m_points) {
+      point = {point.first + flip, -point.second};
+    }
+  }
+
+  return TrajectoryParameterizer::TimeParameterizeTrajectory(
+      workspace.m_points, config.Constraints(), config.StartVelocity(),
+      config.EndVelocity(), config.MaxVelocity(), config.MaxAcceleration(),
+      config.IsReversed());
+}
+
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     Spline<3>::ControlVector initial,
     const std::vector<Translation2d>& interiorWaypoints,
     Spline<3>::ControlVector end, const TrajectoryConfig& config) {
-  const Transform2d flip{Translation2d{}, 180_deg};
+  Workspace workspace;
+  return GenerateTrajectory(initial, interiorWaypoints, end, config,
+                            workspace);
+}
 
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    Spline<3>::ControlVector initial,
+    const std::vector<Translation2d>& interiorWaypoints,
+    Spline<3>::ControlVector end, const TrajectoryConfig& config,
+    Workspace& workspace) {
   // Make theta normal for trajectory generation if path is reversed.
   // Flip the headings.
   if (config.IsReversed()) {
@@ -42,42 +138,44 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
     end.y[1] *= -1;
   }
 
-  std::vector<frc::SplineParameterizer::PoseWithCurvature> points;
   try {
-    points =
-        SplinePointsFromSplines(SplineHelper::CubicSplinesFromControlVectors(
-            initial, interiorWaypoints, end));
+    SplinePointsFromSplines(SplineHelper::CubicSplinesFromControlVectors(
+                                initial, interiorWaypoints, end),
+                            workspace);
   } catch (SplineParameterizer::MalformedSplineException& e) {
     ReportError(e.what());
     return kDoNothingTrajectory;
   }
 
-  // After trajectory generation, flip theta back so it's relative to the
-  // field. Also fix curvature.
-  if (config.IsReversed()) {
-    for (auto& point : points) {
-      point = {point.first + flip, -point.second};
-    }
-  }
-
-  return TrajectoryParameterizer::TimeParameterizeTrajectory(
-      points, config.Constraints(), config.StartVelocity(),
-      config.EndVelocity(), config.MaxVelocity(), config.MaxAcceleration(),
-      config.IsReversed());
+  return TimeParameterize(config, workspace);
 }
 
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
     const Pose2d& end, const TrajectoryConfig& config) {
+  Workspace workspace;
+  return GenerateTrajectory(start, interiorWaypoints, end, config, workspace);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
+    const Pose2d& end, const TrajectoryConfig& config, Workspace& workspace) {
   auto [startCV, endCV] = SplineHelper::CubicControlVectorsFromWaypoints(
       start, interiorWaypoints, end);
-  return GenerateTrajectory(startCV, interiorWaypoints, endCV, config);
+  return GenerateTrajectory(startCV, interiorWaypoints, endCV, config,
+                            workspace);
 }
 
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     std::vector<Spline<5>::ControlVector> controlVectors,
     const TrajectoryConfig& config) {
-  const Transform2d flip{Translation2d{}, 180_deg};
+  Workspace workspace;
+  return GenerateTrajectory(std::move(controlVectors), config, workspace);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    std::vector<Spline<5>::ControlVector> controlVectors,
+    const TrajectoryConfig& config, Workspace& workspace) {
   // Make theta normal for trajectory generation if path is reversed.
   if (config.IsReversed()) {
     for (auto& vector : controlVectors) {
@@ -87,31 +185,27 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
     }
   }
 
-  std::vector<frc::SplineParameterizer::PoseWithCurvature> points;
   try {
-    points = SplinePointsFromSplines(
-        SplineHelper::QuinticSplinesFromControlVectors(controlVectors));
+    SplinePointsFromSplines(
+        SplineHelper::QuinticSplinesFromControlVectors(controlVectors),
+        workspace);
   } catch (SplineParameterizer::MalformedSplineException& e) {
     ReportError(e.what());
     return kDoNothingTrajectory;
   }
 
-  // After trajectory generation, flip theta back so it's relative to the
-  // field. Also fix curvature.
-  if (config.IsReversed()) {
-    for (auto& point : points) {
-      point = {point.first + flip, -point.second};
-    }
-  }
-
-  return TrajectoryParameterizer::TimeParameterizeTrajectory(
-      points, config.Constraints(), config.StartVelocity(),
-      config.EndVelocity(), config.MaxVelocity(), config.MaxAcceleration(),
-      config.IsReversed());
+  return TimeParameterize(config, workspace);
 }
 
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config) {
+  Workspace workspace;
+  return GenerateTrajectory(waypoints, config, workspace);
+}
+
+Trajectory TrajectoryGenerator::GenerateTrajectory(
+    const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config,
+    Workspace& workspace) {
   auto newWaypoints = waypoints;
   const Transform2d flip{Translation2d{}, 180_deg};
   if (config.IsReversed()) {
@@ -120,27 +214,17 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
     }
   }
 
-  std::vector<SplineParameterizer::PoseWithCurvature> points;
   try {
-    points = SplinePointsFromSplines(SplineHelper::OptimizeCurvature(
-        SplineHelper::QuinticSplinesFromWaypoints(newWaypoints)));
+    SplinePointsFromSplines(
+        SplineHelper::OptimizeCurvature(
+            SplineHelper::QuinticSplinesFromWaypoints(newWaypoints)),
+        workspace);
   } catch (SplineParameterizer::MalformedSplineException& e) {
     ReportError(e.what());
     return kDoNothingTrajectory;
   }
 
-  // After trajectory generation, flip theta back so it's relative to the
-  // field. Also fix curvature.
-  if (config.IsReversed()) {
-    for (auto& point : points) {
-      point = {point.first + flip, -point.second};
-    }
-  }
-
-  return TrajectoryParameterizer::TimeParameterizeTrajectory(
-      points, config.Constraints(), config.StartVelocity(),
-      config.EndVelocity(), config.MaxVelocity(), config.MaxAcceleration(),
-      config.IsReversed());
+  return TimeParameterize(config, workspace);
 }
 
 void TrajectoryGenerator::SetErrorHandler(
@@ -0,0 +1,353 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/TrajectoryOptimizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+#include <sleipnir/optimization/ocp.hpp>
+
+#include "frc/MathUtil.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+using namespace frc;
+
+namespace {
+
+// Each interior waypoint needs its own sample between the first and last
+void CheckOptions(std::span<const Translation2d> interiorWaypoints,
+                  const TrajectoryOptimizer::Options& options) {
+  if (options.numSamples < 2) {
+    throw std::invalid_argument(fmt::format(
+        "numSamples must be at least 2, got {}", options.numSamples));
+  }
+  if (interiorWaypoints.size() >= static_cast<size_t>(options.numSamples)) {
+    throw std::invalid_argument(fmt::format(
+        "numSamples must be greater than the number of interior waypoints "
+        "({}), got {}",
+        interiorWaypoints.size(), options.numSamples));
+  }
+}
+
+// Samples the initial guess at numSamples + 1 evenly spaced times
+std::vector<Trajectory::State> SampleGuess(const Trajectory& initialGuess,
+                                           int numSamples) {
+  std::vector<Trajectory::State> samples;
+  samples.reserve(numSamples + 1);
+  Trajectory::Sampler sampler{initialGuess};
+  for (int k = 0; k <= numSamples; ++k) {
+    samples.emplace_back(
+        sampler.Sample(initialGuess.TotalTime() * k / numSamples));
+  }
+  return samples;
+}
+
+// Assigns each interior waypoint to the closest sample of the initial guess,
+// keeping the waypoints in order and off the first and last samples
+std::vector<int> WaypointIndices(
+    const std::vector<Trajectory::State>& samples,
+    std::span<const Translation2d> interiorWaypoints) {
+  std::vector<int> indices;
+  int numSamples = samples.size() - 1;
+  int begin = 1;
+  for (size_t i = 0; i < interiorWaypoints.size(); ++i) {
+    // Leave room for the remaining waypoints
+    int end = numSamples - (interiorWaypoints.size() - i);
+    int best = begin;
+    for (int k = begin; k <= end; ++k) {
+      if (samples[k].pose.Translation().Distance(interiorWaypoints[i]) <
+          samples[best].pose.Translation().Distance(interiorWaypoints[i])) {
+        best = k;
+      }
+    }
+    indices.emplace_back(best);
+    begin = best + 1;
+  }
+  return indices;
+}
+
+// Builds the time-optimal problem common to both drivetrains. The first two
+// states must be the x and y position.
+void ConstrainProblem(slp::OCP& problem, int numSamples,
+                      std::span<const Translation2d> interiorWaypoints,
+                      const std::vector<int>& waypointIndices,
+                      const TrajectoryOptimizer::Options& options) {
+  problem.set_min_timestep(std::chrono::duration<double>{1e-3});
+  problem.minimize(numSamples * problem.dt()(0, 0));
+
+  for (size_t i = 0; i < interiorWaypoints.size(); ++i) {
+    problem.subject_to(problem.X()(0, waypointIndices[i]) ==
+                       interiorWaypoints[i].X().value());
+    problem.subject_to(problem.X()(1, waypointIndices[i]) ==
+                       interiorWaypoints[i].Y().value());
+  }
+
+  for (const auto& obstacle : options.obstacles) {
+    double minDistance = (obstacle.radius + options.robotRadius).value();
+    problem.for_each_step(
+        [&](const slp::VariableMatrix& x, const slp::VariableMatrix&) {
+          problem.subject_to(
+              slp::pow(x[0] - obstacle.center.X().value(), 2) +
+                  slp::pow(x[1] - obstacle.center.Y().value(), 2) >=
+              minDistance * minDistance);
+        });
+  }
+}
+
+bool Solve(slp::OCP& problem, const TrajectoryOptimizer::Options& options) {
+  slp::Options solverOptions;
+  solverOptions.timeout =
+      std::chrono::duration<double>{options.timeout.value()};
+  return problem.solve(solverOptions) == slp::ExitStatus::SUCCESS;
+}
+
+}  // namespace
+
+std::optional<Trajectory> TrajectoryOptimizer::OptimizeDifferential(
+    const Trajectory& initialGuess,
+    std::span<const Translation2d> interiorWaypoints,
+    const DifferentialDrive& drive, const Options& options) {
+  CheckOptions(interiorWaypoints, options);
+  const int N = options.numSamples;
+  const double trackwidth = drive.trackwidth.value();
+
+  // Left and right wheel velocity dynamics with voltage inputs
+  auto plant = LinearSystemId::DrivetrainVelocitySystem(
+      drive.motor, drive.mass, drive.wheelRadius, drive.trackwidth / 2,
+      drive.moi, drive.gearing);
+  const Matrixd<2, 2> A = plant.A();
+  const Matrixd<2, 2> B = plant.B();
+
+  // States are x, y, heading, left velocity, and right velocity. Inputs are
+  // left and right voltage.
+  auto dynamics = [&](const slp::VariableMatrix& x,
+                      const slp::VariableMatrix& u) {
+    slp::VariableMatrix xdot{5};
+    auto v = (x[3] + x[4]) / 2;
+    xdot[0] = v * slp::cos(x[2]);
+    xdot[1] = v * slp::sin(x[2]);
+    xdot[2] = (x[4] - x[3]) / trackwidth;
+    xdot[3] = A(0, 0) * x[3] + A(0, 1) * x[4] + B(0, 0) * u[0] + B(0, 1) * u[1];
+    xdot[4] = A(1, 0) * x[3] + A(1, 1) * x[4] + B(1, 0) * u[0] + B(1, 1) * u[1];
+    return xdot;
+  };
+
+  auto samples = SampleGuess(initialGuess, N);
+  double guessDt = initialGuess.TotalTime().value() / N;
+  slp::OCP problem{5,
+                   2,
+                   std::chrono::duration<double>{guessDt},
+                   N,
+                   dynamics,
+                   slp::DynamicsType::EXPLICIT_ODE,
+                   slp::TimestepMethod::VARIABLE_SINGLE,
+                   slp::TranscriptionMethod::DIRECT_TRANSCRIPTION};
+
+  // Initial guess, with the heading unwrapped so it's continuous
+  Eigen::Matrix<double, 5, Eigen::Dynamic> X{5, N + 1};
+  for (int k = 0; k <= N; ++k) {
+    const auto& sample = samples[k];
+    double v = sample.velocity.value();
+    double omega = v * sample.curvature.value();
+    double heading = sample.pose.Rotation().Radians().value();
+    if (k > 0) {
+      heading = X(2, k - 1) +
+                AngleModulus(units::radian_t{heading - X(2, k - 1)}).value();
+    }
+    X.col(k) << sample.pose.X().value(), sample.pose.Y().value(), heading,
+        v - omega * trackwidth / 2, v + omega * trackwidth / 2;
+  }
+  Eigen::Matrix<double, 2, Eigen::Dynamic> U{2, N + 1};
+  for (int k = 0; k < N; ++k) {
+    // u = B⁻¹(dv/dt − Av)
+    Vectord<2> accel =
+        (X.block<2, 1>(3, k + 1) - X.block<2, 1>(3, k)) / guessDt;
+    U.col(k) = B.householderQr().solve(accel - A * X.block<2, 1>(3, k));
+  }
+  U.col(N) = U.col(N - 1);
+  U = U.cwiseMax(-options.maxVoltage.value())
+          .cwiseMin(options.maxVoltage.value());
+  problem.X().set_value(X);
+  problem.U().set_value(U);
+
+  problem.constrain_initial_state(X.col(0));
+  problem.constrain_final_state(X.col(N));
+  problem.set_lower_input_bound(-options.maxVoltage.value());
+  problem.set_upper_input_bound(options.maxVoltage.value());
+
+  if (options.maxCurrent) {
+    // I = (V − ω/Kᵥ)/R, where ω = vG/r is the motor speed
+    double backEmfPerVelocity =
+        drive.gearing / drive.wheelRadius.value() / drive.motor.Kv.value();
+    double R = drive.motor.R.value();
+    double maxCurrent = options.maxCurrent->value();
+    problem.for_each_step(
+        [&](const slp::VariableMatrix& x, const slp::VariableMatrix& u) {
+          for (int side = 0; side < 2; ++side) {
+            auto current = (u[side] - backEmfPerVelocity * x[3 + side]) / R;
+            problem.subject_to(current >= -maxCurrent);
+            problem.subject_to(current <= maxCurrent);
+          }
+        });
+  }
+
+  ConstrainProblem(problem, N, interiorWaypoints,
+                   WaypointIndices(samples, interiorWaypoints), options);
+
+  if (!Solve(problem, options)) {
+    return std::nullopt;
+  }
+
+  double dt = problem.dt()(0, 0).value();
+  X = problem.X().value();
+  std::vector<Trajectory::State> states;
+  states.reserve(N + 1);
+  for (int k = 0; k <= N; ++k) {
+    double v = (X(3, k) + X(4, k)) / 2;
+    double omega = (X(4, k) - X(3, k)) / trackwidth;
+    int next = (k < N) ? k + 1 : k;
+    int prev = next - 1;
+    double accel = ((X(3, next) + X(4, next)) - (X(3, prev) + X(4, prev))) /
+                   2 / dt;
+    states.push_back(
+        {units::second_t{k * dt}, units::meters_per_second_t{v},
+         units::meters_per_second_squared_t{accel},
+         Pose2d{units::meter_t{X(0, k)}, units::meter_t{X(1, k)},
+                units::radian_t{X(2, k)}},
+         units::curvature_t{std::abs(v) > 1e-9 ? omega / v : 0.0}});
+  }
+  return Trajectory{states};
+}
+
+std::optional<Trajectory> TrajectoryOptimizer::OptimizeSwerve(
+    const Trajectory& initialGuess,
+    std::span<const Translation2d> interiorWaypoints, const SwerveDrive& drive,
+    const Options& options) {
+  CheckOptions(interiorWaypoints, options);
+  const int N = options.numSamples;
+
+  // States are x, y, and their velocities. Inputs are the accelerations.
+  auto dynamics = [](const slp::VariableMatrix& x,
+                     const slp::VariableMatrix& u) {
+    slp::VariableMatrix xdot{4};
+    xdot[0] = x[2];
+    xdot[1] = x[3];
+    xdot[2] = u[0];
+    xdot[3] = u[1];
+    return xdot;
+  };
+
+  auto samples = SampleGuess(initialGuess, N);
+  double guessDt = initialGuess.TotalTime().value() / N;
+  slp::OCP problem{4,
+                   2,
+                   std::chrono::duration<double>{guessDt},
+                   N,
+                   dynamics,
+                   slp::DynamicsType::EXPLICIT_ODE,
+                   slp::TimestepMethod::VARIABLE_SINGLE,
+                   slp::TranscriptionMethod::DIRECT_TRANSCRIPTION};
+
+  Eigen::Matrix<double, 4, Eigen::Dynamic> X{4, N + 1};
+  Eigen::Matrix<double, 2, Eigen::Dynamic> U{2, N + 1};
+  for (int k = 0; k <= N; ++k) {
+    const auto& sample = samples[k];
+    double v = sample.velocity.value();
+    double a = sample.acceleration.value();
+    double curvature = sample.curvature.value();
+    double cos = sample.pose.Rotation().Cos();
+    double sin = sample.pose.Rotation().Sin();
+    X.col(k) << sample.pose.X().value(), sample.pose.Y().value(), v * cos,
+        v * sin;
+    // Tangential plus centripetal acceleration
+    U.col(k) << a * cos - v * v * curvature * sin,
+        a * sin + v * v * curvature * cos;
+  }
+  problem.X().set_value(X);
+  problem.U().set_value(U);
+
+  problem.constrain_initial_state(X.col(0));
+  problem.constrain_final_state(X.col(N));
+
+  // Each module's wheel provides an equal share of the force, F = ma/n. The
+  // drive motor then needs a current of I = Fr/(GKₜ) and a voltage of
+  // V = IR + ω/Kᵥ, where ω = vG/r is the motor speed. Since the force and
+  // velocity can point in any direction, the limits apply to the magnitude.
+  double r = drive.wheelRadius.value();
+  double currentPerAccel = drive.mass.value() / drive.numModules * r /
+                           drive.gearing / drive.motor.Kt.value();
+  double voltagePerAccel = currentPerAccel * drive.motor.R.value();
+  double voltagePerVelocity = drive.gearing / r / drive.motor.Kv.value();
+  double maxVoltage = options.maxVoltage.value();
+  problem.for_each_step(
+      [&](const slp::VariableMatrix& x, const slp::VariableMatrix& u) {
+        problem.subject_to(
+            slp::pow(voltagePerAccel * u[0] + voltagePerVelocity * x[2], 2) +
+                slp::pow(voltagePerAccel * u[1] + voltagePerVelocity * x[3],
+                         2) <=
+            maxVoltage * maxVoltage);
+        if (options.maxCurrent) {
+          double maxAccel = options.maxCurrent->value() / currentPerAccel;
+          problem.subject_to(slp::pow(u[0], 2) + slp::pow(u[1], 2) <=
+                             maxAccel * maxAccel);
+        }
+      });
+
+  ConstrainProblem(problem, N, interiorWaypoints,
+                   WaypointIndices(samples, interiorWaypoints), options);
+
+  if (!Solve(problem, options)) {
+    return std::nullopt;
+  }
+
+  double dt = problem.dt()(0, 0).value();
+  X = problem.X().value();
+  U = problem.U().value();
+
+  // The direction of travel is undefined while stopped, so use the direction
+  // of the previous moving state, or the first one at the start
+  auto isMoving = [&](int k) { return std::hypot(X(2, k), X(3, k)) > 1e-6; };
+  std::vector<double> directions(N + 1);
+  int firstMoving = 0;
+  while (firstMoving < N && !isMoving(firstMoving)) {
+    ++firstMoving;
+  }
+  for (int k = 0; k <= N; ++k) {
+    int source = (std::max)(k, firstMoving);
+    if (k > firstMoving && !isMoving(k)) {
+      directions[k] = directions[k - 1];
+    } else if (isMoving(source)) {
+      directions[k] = std::atan2(X(3, source), X(2, source));
+    } else {
+      directions[k] = samples[k].pose.Rotation().Radians().value();
+    }
+  }
+
+  std::vector<Trajectory::State> states;
+  states.reserve(N + 1);
+  for (int k = 0; k <= N; ++k) {
+    double vx = X(2, k);
+    double vy = X(3, k);
+    double ax = U(0, k);
+    double ay = U(1, k);
+    double v = std::hypot(vx, vy);
+    double accel = std::hypot(ax, ay);
+    double curvature = 0.0;
+    if (v > 1e-6) {
+      accel = (vx * ax + vy * ay) / v;
+      curvature = (vx * ay - vy * ax) / (v * v * v);
+    }
+    states.push_back({units::second_t{k * dt}, units::meters_per_second_t{v},
+                      units::meters_per_second_squared_t{accel},
+                      Pose2d{units::meter_t{X(0, k)}, units::meter_t{X(1, k)},
+                             units::radian_t{directions[k]}},
+                      units::curvature_t{curvature}});
+  }
+  return Trajectory{states};
+}
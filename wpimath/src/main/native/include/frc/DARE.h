@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <string_view>
 
 #include <Eigen/Cholesky>
@@ -147,6 +148,82 @@ Eigen::Matrix<double, States, States> DARE(
   return H_k1;
 }
 
+/**
+ * Computes the unique stabilizing solution X to the discrete-time algebraic
+ * Riccati equation:
+ *
+ *   AᵀXA − X − AᵀXB(BᵀXB + R)⁻¹BᵀXA + Q = 0
+ *
+ * starting from an initial guess X₀, such as the solution for a nearby
+ * system. This uses Newton's method (Hewer's algorithm), which converges
+ * quadratically, so it only takes a couple of iterations if X₀ is close to
+ * the solution. If the feedback gain from X₀ doesn't stabilize (A, B) or the
+ * iteration fails to converge, this falls back to the solver above.
+ *
+ * Like the function above, this skips precondition checks.
+ *
+ * @tparam States Number of states.
+ * @tparam Inputs Number of inputs.
+ * @param A The system matrix.
+ * @param B The input matrix.
+ * @param Q The state cost matrix.
+ * @param R_llt The LLT decomposition of the input cost matrix.
+ * @param X_0 The initial guess for the solution.
+ * @return Solution to the DARE.
+ */
+template <int States, int Inputs>
+Eigen::Matrix<double, States, States> DARE(
+    const Eigen::Matrix<double, States, States>& A,
+    const Eigen::Matrix<double, States, Inputs>& B,
+    const Eigen::Matrix<double, States, States>& Q,
+    const Eigen::LLT<Eigen::Matrix<double, Inputs, Inputs>>& R_llt,
+    const Eigen::Matrix<double, States, States>& X_0) {
+  using StateMatrix = Eigen::Matrix<double, States, States>;
+
+  const Eigen::Matrix<double, Inputs, Inputs> R = R_llt.reconstructedMatrix();
+
+  StateMatrix X = X_0;
+  for (int newtonIter = 0; newtonIter < 10; ++newtonIter) {
+    // K = (BᵀXB + R)⁻¹BᵀXA
+    Eigen::Matrix<double, Inputs, States> K =
+        (B.transpose() * X * B + R).llt().solve(B.transpose() * X * A);
+
+    // Solve the Stein equation Xₖ₊₁ = A_clᵀXₖ₊₁A_cl + Q + KᵀRK where
+    // A_cl = A − BK with Smith's doubling iteration:
+    //
+    //   Y₀ = Q + KᵀRK, M₀ = A_cl
+    //   Yⱼ₊₁ = Yⱼ + MⱼᵀYⱼMⱼ, Mⱼ₊₁ = Mⱼ²
+    //
+    // This only converges if A_cl is stable, so failing to converge means K
+    // isn't stabilizing.
+    StateMatrix M = A - B * K;
+    StateMatrix Y = Q + K.transpose() * R * K;
+    bool converged = false;
+    for (int smithIter = 0; smithIter < 32 && !converged; ++smithIter) {
+      StateMatrix delta = M.transpose() * Y * M;
+      Y += delta;
+      M *= M;
+      double Y_norm = Y.norm();
+      if (!std::isfinite(Y_norm)) {
+        break;
+      }
+      converged = delta.norm() <= 1e-14 * Y_norm;
+    }
+    if (!converged) {
+      break;
+    }
+
+    // while |Xₖ₊₁ − Xₖ| > ε |Xₖ₊₁|
+    bool done = (Y - X).norm() <= 1e-10 * Y.norm();
+    X = Y;
+    if (done) {
+      return X;
+    }
+  }
+
+  return DARE<States, Inputs>(A, B, Q, R_llt);
+}
+
 }  // namespace detail
 
 /**
@@ -6,10 +6,10 @@
 
 #include <wpi/SymbolExports.h>
 #include <wpi/array.h>
-#include <wpi/interpolating_map.h>
 
 #include "frc/EigenCore.h"
 #include "frc/controller/DifferentialDriveWheelVoltages.h"
+#include "frc/controller/LTVGainTable.h"
 #include "frc/geometry/Pose2d.h"
 #include "frc/system/LinearSystem.h"
 #include "frc/trajectory/Trajectory.h"
@@ -61,6 +61,28 @@ class WPILIB_DLLEXPORT LTVDifferentialDriveController {
                                  const wpi::array<double, 2>& Relems,
                                  units::second_t dt);
 
+  /**
+   * Constructs a linear time-varying differential drive controller with
+   * options for building the gain lookup table, such as computing it on
+   * multiple threads or caching it in a file.
+   *
+   * @param plant      The differential drive velocity plant.
+   * @param trackwidth The distance between the differential drive's left and
+   *                   right wheels.
+   * @param Qelems     The maximum desired error tolerance for each state.
+   * @param Relems     The maximum desired control effort for each input.
+   * @param dt         Discretization timestep.
+   * @param options    Gain lookup table options.
+   * @throws std::domain_error if max velocity of plant with 12 V input <= 0 m/s
+   *     or >= 15 m/s.
+   */
+  LTVDifferentialDriveController(const frc::LinearSystem<2, 2, 2>& plant,
+                                 units::meter_t trackwidth,
+                                 const wpi::array<double, 5>& Qelems,
+                                 const wpi::array<double, 2>& Relems,
+                                 units::second_t dt,
+                                 const LTVGainTableOptions& options);
+
   /**
    * Move constructor.
    */
@@ -126,10 +148,15 @@ class WPILIB_DLLEXPORT LTVDifferentialDriveController {
       const Trajectory::State& desiredState);
 
  private:
+  static detail::LTVGainTable<5, 2> MakeGainTable(
+      const frc::LinearSystem<2, 2, 2>& plant, units::meter_t trackwidth,
+      const wpi::array<double, 5>& Qelems, const wpi::array<double, 2>& Relems,
+      units::second_t dt, const LTVGainTableOptions& options);
+
   units::meter_t m_trackwidth;
 
   // LUT from drivetrain linear velocity to LQR gain
-  wpi::interpolating_map<units::meters_per_second_t, Matrixd<2, 5>> m_table;
+  detail::LTVGainTable<5, 2> m_table;
 
   Vectord<5> m_error;
   Vectord<5> m_tolerance;
@@ -0,0 +1,255 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Cholesky>
+#include <wpi/SymbolExports.h>
+#include <wpi/interpolating_map.h>
+
+#include "frc/DARE.h"
+#include "frc/EigenCore.h"
+#include "units/velocity.h"
+
+namespace frc {
+
+/**
+ * Options for building the gain lookup table of a linear time-varying (LTV)
+ * controller.
+ */
+struct LTVGainTableOptions {
+  /**
+   * Number of threads used to compute the gains. With 1, the gains are
+   * computed on the calling thread.
+   */
+  int numThreads = 1;
+
+  /**
+   * Path of a gain table file to cache the gains in. If empty, the gains are
+   * always computed when the controller is constructed.
+   *
+   * The table is read from the file when the controller is constructed. If
+   * the file doesn't exist, can't be read, or was made with different
+   * controller parameters, the gains are computed instead and the file is
+   * (re)written. Either way, using the controller never touches the file.
+   *
+   * Generating the file in simulation and deploying it with the robot code
+   * (e.g., in the deploy directory) avoids computing the gains on the robot.
+   */
+  std::string cachePath;
+};
+
+namespace detail {
+
+/**
+ * Writes a gain table file.
+ *
+ * @param path The file path.
+ * @param params The controller parameters the gains were computed from.
+ * @param rows The number of rows of each gain matrix.
+ * @param cols The number of columns of each gain matrix.
+ * @param velocities The velocity of each table entry.
+ * @param gains The gain matrix of each table entry, in row-major order.
+ * @return True if the file was written.
+ */
+WPILIB_DLLEXPORT
+bool SaveLTVGainTable(std::string_view path, std::span<const double> params,
+                      int rows, int cols, std::span<const double> velocities,
+                      std::span<const double> gains);
+
+/**
+ * Reads a gain table file.
+ *
+ * @param path The file path.
+ * @param params The controller parameters the gains must have been computed
+ *     from.
+ * @param rows The number of rows of each gain matrix.
+ * @param cols The number of columns of each gain matrix.
+ * @param velocities Output for the velocity of each table entry.
+ * @param gains Output for the gain matrix of each table entry, in row-major
+ *     order.
+ * @return True if the file was read, matches params, rows, and cols, and
+ *     holds finite gains at increasing velocities.
+ */
+WPILIB_DLLEXPORT
+bool LoadLTVGainTable(std::string_view path, std::span<const double> params,
+                      int rows, int cols, std::vector<double>* velocities,
+                      std::vector<double>* gains);
+
+/**
+ * Velocity-indexed LQR gain lookup table for linear time-varying controllers.
+ *
+ * The gains are computed at 0.01 m/s increments from -maxVelocity to
+ * maxVelocity. Each DARE is warm-started from the solution at the neighboring
+ * velocity, and the velocity range can be split between multiple threads.
+ *
+ * @tparam States Number of states.
+ * @tparam Inputs Number of inputs.
+ */
+template <int States, int Inputs>
+class LTVGainTable {
+ public:
+  using GainMatrix = Matrixd<Inputs, States>;
+
+  /**
+   * Function that computes the discretized model linearized around the given
+   * velocity. It may be called concurrently from multiple threads.
+   */
+  using ModelFunction = std::function<void(
+      units::meters_per_second_t velocity, Matrixd<States, States>* discA,
+      Matrixd<States, Inputs>* discB)>;
+
+  /**
+   * Constructs a gain table, loading the gains from the cache file in options
+   * or computing them if that fails.
+   *
+   * @param model The discretized model as a function of velocity.
+   * @param Q The state cost matrix.
+   * @param R The input cost matrix.
+   * @param maxVelocity The maximum velocity in the table.
+   * @param params The controller parameters, used to validate the cache file.
+   * @param options Table build options.
+   */
+  LTVGainTable(ModelFunction model, const Matrixd<States, States>& Q,
+               const Matrixd<Inputs, Inputs>& R,
+               units::meters_per_second_t maxVelocity,
+               std::vector<double> params, LTVGainTableOptions options)
+      : m_model{std::move(model)},
+        m_Q{Q},
+        m_R{R},
+        m_maxVelocity{maxVelocity},
+        m_params{std::move(params)},
+        m_options{std::move(options)} {
+    if (m_options.cachePath.empty() || !Load()) {
+      Build();
+    }
+  }
+
+  /**
+   * Returns the gain for the given velocity, interpolating between table
+   * entries.
+   *
+   * @param velocity The velocity.
+   */
+  GainMatrix operator[](units::meters_per_second_t velocity) const {
+    return m_table[velocity];
+  }
+
+ private:
+  // Computes the table, then writes the cache file if there is one
+  void Build() {
+    std::vector<units::meters_per_second_t> velocities;
+    for (auto velocity = -m_maxVelocity; velocity < m_maxVelocity;
+         velocity += 0.01_mps) {
+      velocities.emplace_back(velocity);
+    }
+
+    auto R_llt = m_R.llt();
+    std::vector<GainMatrix> gains(velocities.size());
+
+    // Solves a contiguous range of velocities, warm-starting each DARE from
+    // the previous one
+    auto solveRange = [&](size_t begin, size_t end) {
+      Matrixd<States, States> S;
+      for (size_t i = begin; i < end; ++i) {
+        Matrixd<States, States> discA;
+        Matrixd<States, Inputs> discB;
+        m_model(velocities[i], &discA, &discB);
+
+        if (i == begin) {
+          S = detail::DARE<States, Inputs>(discA, discB, m_Q, R_llt);
+        } else {
+          S = detail::DARE<States, Inputs>(discA, discB, m_Q, R_llt, S);
+        }
+
+        // K = (BᵀSB + R)⁻¹BᵀSA
+        gains[i] = (discB.transpose() * S * discB + m_R)
+                       .llt()
+                       .solve(discB.transpose() * S * discA);
+      }
+    };
+
+    // Don't bother with threads for fewer than 100 velocities each
+    size_t numThreads =
+        std::clamp<size_t>((std::max)(m_options.numThreads, 1), 1,
+                           (velocities.size() + 99) / 100);
+    size_t chunkSize = (velocities.size() + numThreads - 1) / numThreads;
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+      threads.emplace_back(solveRange, i * chunkSize,
+                           (std::min)((i + 1) * chunkSize, velocities.size()));
+    }
+    solveRange(0, (std::min)(chunkSize, velocities.size()));
+    for (auto&& thread : threads) {
+      thread.join();
+    }
+
+    m_table.clear();
+    for (size_t i = 0; i < velocities.size(); ++i) {
+      m_table.insert(velocities[i], gains[i]);
+    }
+
+    if (!m_options.cachePath.empty()) {
+      std::vector<double> rawVelocities;
+      std::vector<double> rawGains;
+      rawVelocities.reserve(velocities.size());
+      rawGains.reserve(velocities.size() * Inputs * States);
+      for (size_t i = 0; i < velocities.size(); ++i) {
+        rawVelocities.emplace_back(velocities[i].value());
+        for (int row = 0; row < Inputs; ++row) {
+          for (int col = 0; col < States; ++col) {
+            rawGains.emplace_back(gains[i](row, col));
+          }
+        }
+      }
+      SaveLTVGainTable(m_options.cachePath, m_params, Inputs, States,
+                       rawVelocities, rawGains);
+    }
+  }
+
+  // Reads the table from the cache file. Returns false if the file is
+  // missing, invalid, or was made with different parameters.
+  bool Load() {
+    std::vector<double> velocities;
+    std::vector<double> gains;
+    if (!LoadLTVGainTable(m_options.cachePath, m_params, Inputs, States,
+                          &velocities, &gains) ||
+        velocities.empty()) {
+      return false;
+    }
+
+    m_table.clear();
+    for (size_t i = 0; i < velocities.size(); ++i) {
+      GainMatrix K;
+      for (int row = 0; row < Inputs; ++row) {
+        for (int col = 0; col < States; ++col) {
+          K(row, col) = gains[(i * Inputs + row) * States + col];
+        }
+      }
+      m_table.insert(units::meters_per_second_t{velocities[i]}, K);
+    }
+    return true;
+  }
+
+  ModelFunction m_model;
+  Matrixd<States, States> m_Q;
+  Matrixd<Inputs, Inputs> m_R;
+  units::meters_per_second_t m_maxVelocity;
+  std::vector<double> m_params;
+  LTVGainTableOptions m_options;
+
+  wpi::interpolating_map<units::meters_per_second_t, GainMatrix> m_table;
+};
+
+}  // namespace detail
+}  // namespace frc
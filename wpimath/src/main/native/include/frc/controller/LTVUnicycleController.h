@@ -6,9 +6,9 @@
 
 #include <wpi/SymbolExports.h>
 #include <wpi/array.h>
-#include <wpi/interpolating_map.h>
 
 #include "frc/EigenCore.h"
+#include "frc/controller/LTVGainTable.h"
 #include "frc/geometry/Pose2d.h"
 #include "frc/kinematics/ChassisSpeeds.h"
 #include "frc/trajectory/Trajectory.h"
@@ -65,6 +65,26 @@ class WPILIB_DLLEXPORT LTVUnicycleController {
                         const wpi::array<double, 2>& Relems, units::second_t dt,
                         units::meters_per_second_t maxVelocity = 9_mps);
 
+  /**
+   * Constructs a linear time-varying unicycle controller with options for
+   * building the gain lookup table, such as computing it on multiple threads
+   * or caching it in a file.
+   *
+   * @param Qelems The maximum desired error tolerance for each state (x, y,
+   *               heading).
+   * @param Relems The maximum desired control effort for each input (linear
+   *               velocity, angular velocity).
+   * @param dt     Discretization timestep.
+   * @param maxVelocity The maximum velocity for the controller gain lookup
+   *                    table.
+   * @param options Gain lookup table options.
+   * @throws std::domain_error if maxVelocity <= 0 m/s or >= 15 m/s.
+   */
+  LTVUnicycleController(const wpi::array<double, 3>& Qelems,
+                        const wpi::array<double, 2>& Relems, units::second_t dt,
+                        units::meters_per_second_t maxVelocity,
+                        const LTVGainTableOptions& options);
+
   /**
    * Move constructor.
    */
@@ -124,8 +144,13 @@ class WPILIB_DLLEXPORT LTVUnicycleController {
   void SetEnabled(bool enabled);
 
  private:
+  static detail::LTVGainTable<3, 2> MakeGainTable(
+      const wpi::array<double, 3>& Qelems, const wpi::array<double, 2>& Relems,
+      units::second_t dt, units::meters_per_second_t maxVelocity,
+      const LTVGainTableOptions& options);
+
   // LUT from drivetrain linear velocity to LQR gain
-  wpi::interpolating_map<units::meters_per_second_t, Matrixd<2, 3>> m_table;
+  detail::LTVGainTable<3, 2> m_table;
 
   Pose2d m_poseError;
   Pose2d m_poseTolerance;
@@ -270,6 +270,39 @@ class ExtendedKalmanFilter {
    */
   void SetXhat(int i, double value) { m_xHat(i) = value; }
 
+  /**
+   * Sets a function that returns the Jacobian of f(x, u) with respect to x.
+   * Predict() uses it instead of differentiating f(x, u) numerically, which
+   * takes 2 * States extra evaluations of f(x, u).
+   *
+   * AutodiffJacobian can compute it automatically from f(x, u).
+   *
+   * @param dfdx A function of x and u that returns the Jacobian of f(x, u)
+   *             with respect to x, or nullptr to differentiate numerically.
+   */
+  void SetStateJacobian(
+      std::function<StateMatrix(const StateVector&, const InputVector&)>
+          dfdx) {
+    m_dfdx = std::move(dfdx);
+  }
+
+  /**
+   * Sets a function that returns the Jacobian of the h(x, u) passed to the
+   * constructor with respect to x. The Correct() overloads that use that h(x,
+   * u) use it instead of differentiating h(x, u) numerically.
+   *
+   * AutodiffJacobian can compute it automatically from h(x, u).
+   *
+   * @param dhdx A function of x and u that returns the Jacobian of h(x, u)
+   *             with respect to x, or nullptr to differentiate numerically.
+   */
+  void SetMeasurementJacobian(
+      std::function<Matrixd<Outputs, States>(const StateVector&,
+                                             const InputVector&)>
+          dhdx) {
+    m_dhdx = std::move(dhdx);
+  }
+
   /**
    * Resets the observer.
    */
@@ -287,7 +320,8 @@ class ExtendedKalmanFilter {
   void Predict(const InputVector& u, units::second_t dt) {
     // Find continuous A
     StateMatrix contA =
-        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+        m_dfdx ? m_dfdx(m_xHat, u)
+               : NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
 
     // Find discrete A and Q
     StateMatrix discA;
@@ -309,7 +343,7 @@ class ExtendedKalmanFilter {
    * @param y Measurement vector.
    */
   void Correct(const InputVector& u, const OutputVector& y) {
-    Correct<Outputs>(u, y, m_h, m_contR, m_residualFuncY, m_addFuncX);
+    Correct(u, y, m_contR);
   }
 
   /**
@@ -323,7 +357,12 @@ class ExtendedKalmanFilter {
    */
   void Correct(const InputVector& u, const OutputVector& y,
                const Matrixd<Outputs, Outputs>& R) {
-    Correct<Outputs>(u, y, m_h, R, m_residualFuncY, m_addFuncX);
+    if (m_dhdx) {
+      CorrectWithJacobian<Outputs>(u, y, m_h, m_dhdx(m_xHat, u), R,
+                                   m_residualFuncY, m_addFuncX);
+    } else {
+      Correct<Outputs>(u, y, m_h, R, m_residualFuncY, m_addFuncX);
+    }
   }
 
   /**
@@ -379,8 +418,40 @@ class ExtendedKalmanFilter {
           residualFuncY,
       std::function<StateVector(const StateVector&, const StateVector&)>
           addFuncX) {
-    const Matrixd<Rows, States> C =
-        NumericalJacobianX<Rows, States, Inputs>(h, m_xHat, u);
+    CorrectWithJacobian<Rows>(
+        u, y, h, NumericalJacobianX<Rows, States, Inputs>(h, m_xHat, u), R,
+        residualFuncY, addFuncX);
+  }
+
+ private:
+  std::function<StateVector(const StateVector&, const InputVector&)> m_f;
+  std::function<OutputVector(const StateVector&, const InputVector&)> m_h;
+  std::function<StateMatrix(const StateVector&, const InputVector&)> m_dfdx;
+  std::function<Matrixd<Outputs, States>(const StateVector&,
+                                         const InputVector&)>
+      m_dhdx;
+  std::function<OutputVector(const OutputVector&, const OutputVector&)>
+      m_residualFuncY;
+  std::function<StateVector(const StateVector&, const StateVector&)> m_addFuncX;
+  StateVector m_xHat = StateVector::Zero();
+  StateMatrix m_P;
+  StateMatrix m_contQ;
+  Matrixd<Outputs, Outputs> m_contR;
+  units::second_t m_dt;
+
+  StateMatrix m_initP;
+
+  // Corrects the state estimate with the given Jacobian C of h(x, u)
+  template <int Rows>
+  void CorrectWithJacobian(
+      const InputVector& u, const Vectord<Rows>& y,
+      const std::function<Vectord<Rows>(const StateVector&, const InputVector&)>&
+          h,
+      const Matrixd<Rows, States>& C, const Matrixd<Rows, Rows>& R,
+      const std::function<Vectord<Rows>(const Vectord<Rows>&,
+                                        const Vectord<Rows>&)>& residualFuncY,
+      const std::function<StateVector(const StateVector&, const StateVector&)>&
+          addFuncX) {
     const Matrixd<Rows, Rows> discR = DiscretizeR<Rows>(R, m_dt);
 
     Matrixd<Rows, Rows> S = C * m_P * C.transpose() + discR;
@@ -413,19 +484,6 @@ class ExtendedKalmanFilter {
           K * discR * K.transpose();
   }
 
- private:
-  std::function<StateVector(const StateVector&, const InputVector&)> m_f;
-  std::function<OutputVector(const StateVector&, const InputVector&)> m_h;
-  std::function<OutputVector(const OutputVector&, const OutputVector&)>
-      m_residualFuncY;
-  std::function<StateVector(const StateVector&, const StateVector&)> m_addFuncX;
-  StateVector m_xHat = StateVector::Zero();
-  StateMatrix m_P;
-  StateMatrix m_contQ;
-  Matrixd<Outputs, Outputs> m_contR;
-  units::second_t m_dt;
-
-  StateMatrix m_initP;
 };
 
 }  // namespace frc
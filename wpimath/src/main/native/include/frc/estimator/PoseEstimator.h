@@ -4,8 +4,10 @@
 
 #pragma once
 
-#include <map>
+#include <algorithm>
 #include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Core>
@@ -70,6 +72,8 @@ class WPILIB_DLLEXPORT PoseEstimator {
     }
 
     SetVisionMeasurementStdDevs(visionMeasurementStdDevs);
+
+    m_visionUpdates.reserve(kVisionUpdateCapacity);
   }
 
   /**
@@ -84,21 +88,7 @@ class WPILIB_DLLEXPORT PoseEstimator {
    */
   void SetVisionMeasurementStdDevs(
       const wpi::array<double, 3>& visionMeasurementStdDevs) {
-    wpi::array<double, 3> r{wpi::empty_array};
-    for (size_t i = 0; i < 3; ++i) {
-      r[i] = visionMeasurementStdDevs[i] * visionMeasurementStdDevs[i];
-    }
-
-    // Solve for closed form Kalman gain for continuous Kalman filter with A = 0
-    // and C = I. See wpimath/algorithms.md.
-    for (size_t row = 0; row < 3; ++row) {
-      if (m_q[row] == 0.0) {
-        m_visionK(row, row) = 0.0;
-      } else {
-        m_visionK(row, row) =
-            m_q[row] / (m_q[row] + std::sqrt(m_q[row] * r[row]));
-      }
-    }
+    m_visionK = VisionGain(visionMeasurementStdDevs);
   }
 
   /**
@@ -188,7 +178,7 @@ class WPILIB_DLLEXPORT PoseEstimator {
 
     // Step 2: If there are no applicable vision updates, use the odometry-only
     // information.
-    if (m_visionUpdates.empty() || timestamp < m_visionUpdates.begin()->first) {
+    if (m_visionUpdates.empty() || timestamp < m_visionUpdates.front().first) {
       return m_odometryPoseBuffer.Sample(timestamp);
     }
 
@@ -197,9 +187,9 @@ class WPILIB_DLLEXPORT PoseEstimator {
     // First, find the iterator past the sample timestamp, then go back one.
     // Note that upper_bound() won't return begin() because we check begin()
     // earlier.
-    auto floorIter = m_visionUpdates.upper_bound(timestamp);
+    auto floorIter = VisionUpdateUpperBound(timestamp);
     --floorIter;
-    auto visionUpdate = floorIter->second;
+    const auto& visionUpdate = floorIter->second;
 
     // Step 4: Get the pose measured by odometry at the time of the sample.
     auto odometryEstimate = m_odometryPoseBuffer.Sample(timestamp);
@@ -246,51 +236,15 @@ class WPILIB_DLLEXPORT PoseEstimator {
     // Step 1: Clean up any old entries
     CleanUpVisionUpdates();
 
-    // Step 2: Get the pose measured by odometry at the moment the vision
-    // measurement was made.
-    auto odometrySample = m_odometryPoseBuffer.Sample(timestamp);
-
-    if (!odometrySample) {
-      return;
-    }
-
-    // Step 3: Get the vision-compensated pose estimate at the moment the vision
-    // measurement was made.
-    auto visionSample = SampleAt(timestamp);
-
-    if (!visionSample) {
+    // Step 2: Calculate and record the vision update, removing any later ones
+    if (!RecordVisionUpdate(visionRobotPose, timestamp, m_visionK)) {
       return;
     }
 
-    // Step 4: Measure the transform between the old pose estimate and the
-    // vision transform.
-    auto transform = visionRobotPose - visionSample.value();
-
-    // Step 5: We should not trust the transform entirely, so instead we scale
-    // this transform by a Kalman gain matrix representing how much we trust
-    // vision measurements compared to our current pose.
-    Eigen::Vector3d k_times_transform =
-        m_visionK * Eigen::Vector3d{transform.X().value(),
-                                    transform.Y().value(),
-                                    transform.Rotation().Radians().value()};
-
-    // Step 6: Convert back to Transform2d.
-    Transform2d scaledTransform{
-        units::meter_t{k_times_transform(0)},
-        units::meter_t{k_times_transform(1)},
-        Rotation2d{units::radian_t{k_times_transform(2)}}};
-
-    // Step 7: Calculate and record the vision update.
-    VisionUpdate visionUpdate{*visionSample + scaledTransform, *odometrySample};
-    m_visionUpdates[timestamp] = visionUpdate;
-
-    // Step 8: Remove later vision measurements. (Matches previous behavior)
-    auto firstAfter = m_visionUpdates.upper_bound(timestamp);
-    m_visionUpdates.erase(firstAfter, m_visionUpdates.end());
-
-    // Step 9: Update latest pose estimate. Since we cleared all updates after
+    // Step 3: Update latest pose estimate. Since we cleared all updates after
     // this vision update, it's guaranteed to be the latest vision update.
-    m_poseEstimate = visionUpdate.Compensate(m_odometry.GetPose());
+    m_poseEstimate =
+        m_visionUpdates.back().second.Compensate(m_odometry.GetPose());
   }
 
   /**
@@ -328,6 +282,89 @@ class WPILIB_DLLEXPORT PoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * A timestamped vision measurement for AddVisionMeasurements().
+   */
+  struct VisionMeasurement {
+    /// The pose of the robot as measured by the vision camera.
+    Pose2d visionRobotPose;
+
+    /// The timestamp of the vision measurement, in the same epoch as
+    /// AddVisionMeasurement()'s timestamp.
+    units::second_t timestamp;
+
+    /// Standard deviations of this measurement (x position in meters, y
+    /// position in meters, and heading in radians). If empty, the standard
+    /// deviations set by SetVisionMeasurementStdDevs() are used.
+    std::optional<wpi::array<double, 3>> visionMeasurementStdDevs;
+  };
+
+  /**
+   * Adds a batch of vision measurements to the Kalman Filter, such as all of
+   * the measurements from several cameras in one robot loop.
+   *
+   * The measurements are applied in timestamp order (measurements with equal
+   * timestamps are applied in the order given). This gives the same pose
+   * estimate as calling AddVisionMeasurement() for each measurement in that
+   * order, but old vision updates are cleaned up and the current pose estimate
+   * recomputed only once for the whole batch.
+   *
+   * Unlike AddVisionMeasurement(), standard deviations given with a
+   * measurement only apply to that measurement.
+   *
+   * @param measurements The vision measurements, in any order.
+   */
+  void AddVisionMeasurements(std::span<const VisionMeasurement> measurements) {
+    // Step 0: If there are no odometry updates to sample, skip.
+    if (measurements.empty() ||
+        m_odometryPoseBuffer.GetInternalBuffer().empty()) {
+      return;
+    }
+
+    // Step 1: Sort the measurements by timestamp, reusing the index array
+    // between calls.
+    m_visionBatchOrder.resize(measurements.size());
+    for (size_t i = 0; i < measurements.size(); ++i) {
+      m_visionBatchOrder[i] = i;
+    }
+    std::stable_sort(m_visionBatchOrder.begin(), m_visionBatchOrder.end(),
+                     [&](size_t a, size_t b) {
+                       return measurements[a].timestamp <
+                              measurements[b].timestamp;
+                     });
+
+    // Step 2: Clean up any old entries
+    CleanUpVisionUpdates();
+
+    // Step 3: Record the vision updates in order. Each one only removes vision
+    // updates later than itself, so this leaves the latest measurement's
+    // update last.
+    units::second_t oldestTimestamp =
+        m_odometryPoseBuffer.GetInternalBuffer().front().first -
+        kBufferDuration;
+    bool recorded = false;
+    for (size_t i : m_visionBatchOrder) {
+      const auto& measurement = measurements[i];
+      if (measurement.timestamp < oldestTimestamp) {
+        continue;
+      }
+      if (measurement.visionMeasurementStdDevs) {
+        recorded |= RecordVisionUpdate(
+            measurement.visionRobotPose, measurement.timestamp,
+            VisionGain(*measurement.visionMeasurementStdDevs));
+      } else {
+        recorded |= RecordVisionUpdate(measurement.visionRobotPose,
+                                       measurement.timestamp, m_visionK);
+      }
+    }
+
+    // Step 4: Update latest pose estimate.
+    if (recorded) {
+      m_poseEstimate =
+          m_visionUpdates.back().second.Compensate(m_odometry.GetPose());
+    }
+  }
+
   /**
    * Updates the pose estimator with wheel encoder and gyro information. This
    * should be called every loop.
@@ -363,7 +400,7 @@ class WPILIB_DLLEXPORT PoseEstimator {
     if (m_visionUpdates.empty()) {
       m_poseEstimate = odometryEstimate;
     } else {
-      auto visionUpdate = m_visionUpdates.rbegin()->second;
+      const auto& visionUpdate = m_visionUpdates.back().second;
       m_poseEstimate = visionUpdate.Compensate(odometryEstimate);
     }
 
@@ -371,6 +408,110 @@ class WPILIB_DLLEXPORT PoseEstimator {
   }
 
  private:
+  /**
+   * Computes the vision measurement Kalman gain for the given standard
+   * deviations.
+   */
+  Eigen::Matrix3d VisionGain(
+      const wpi::array<double, 3>& visionMeasurementStdDevs) const {
+    wpi::array<double, 3> r{wpi::empty_array};
+    for (size_t i = 0; i < 3; ++i) {
+      r[i] = visionMeasurementStdDevs[i] * visionMeasurementStdDevs[i];
+    }
+
+    // Solve for closed form Kalman gain for continuous Kalman filter with A = 0
+    // and C = I. See wpimath/algorithms.md.
+    Eigen::Matrix3d visionK = Eigen::Matrix3d::Zero();
+    for (size_t row = 0; row < 3; ++row) {
+      if (m_q[row] == 0.0) {
+        visionK(row, row) = 0.0;
+      } else {
+        visionK(row, row) =
+            m_q[row] / (m_q[row] + std::sqrt(m_q[row] * r[row]));
+      }
+    }
+    return visionK;
+  }
+
+  /**
+   * Computes and records the vision update for a vision measurement, removing
+   * any later vision updates. Doesn't update the current pose estimate.
+   *
+   * @param visionRobotPose The pose of the robot as measured by the vision
+   *     camera.
+   * @param timestamp The timestamp of the vision measurement.
+   * @param visionK The vision measurement Kalman gain.
+   * @return True if the vision update was recorded.
+   */
+  bool RecordVisionUpdate(const Pose2d& visionRobotPose,
+                          units::second_t timestamp,
+                          const Eigen::Matrix3d& visionK) {
+    // Step 1: Get the pose measured by odometry at the moment the vision
+    // measurement was made.
+    auto odometrySample = m_odometryPoseBuffer.Sample(timestamp);
+
+    if (!odometrySample) {
+      return false;
+    }
+
+    // Step 2: Get the vision-compensated pose estimate at the moment the vision
+    // measurement was made.
+    auto visionSample = SampleAt(timestamp);
+
+    if (!visionSample) {
+      return false;
+    }
+
+    // Step 3: Measure the transform between the old pose estimate and the
+    // vision transform.
+    auto transform = visionRobotPose - visionSample.value();
+
+    // Step 4: We should not trust the transform entirely, so instead we scale
+    // this transform by a Kalman gain matrix representing how much we trust
+    // vision measurements compared to our current pose.
+    Eigen::Vector3d k_times_transform =
+        visionK * Eigen::Vector3d{transform.X().value(), transform.Y().value(),
+                                  transform.Rotation().Radians().value()};
+
+    // Step 5: Convert back to Transform2d.
+    Transform2d scaledTransform{
+        units::meter_t{k_times_transform(0)},
+        units::meter_t{k_times_transform(1)},
+        Rotation2d{units::radian_t{k_times_transform(2)}}};
+
+    // Step 6: Remove later vision measurements. (Matches previous behavior)
+    m_visionUpdates.erase(VisionUpdateUpperBound(timestamp),
+                          m_visionUpdates.end());
+
+    // Step 7: Calculate and record the vision update. It's now the latest one.
+    VisionUpdate visionUpdate{*visionSample + scaledTransform, *odometrySample};
+    if (!m_visionUpdates.empty() &&
+        m_visionUpdates.back().first == timestamp) {
+      m_visionUpdates.back().second = visionUpdate;
+    } else {
+      m_visionUpdates.emplace_back(timestamp, visionUpdate);
+    }
+    return true;
+  }
+
+  /**
+   * Returns an iterator to the first vision update after the given timestamp.
+   */
+  auto VisionUpdateUpperBound(units::second_t timestamp) {
+    return std::upper_bound(
+        m_visionUpdates.begin(), m_visionUpdates.end(), timestamp,
+        [](units::second_t t, const auto& entry) { return t < entry.first; });
+  }
+
+  /**
+   * Returns an iterator to the first vision update after the given timestamp.
+   */
+  auto VisionUpdateUpperBound(units::second_t timestamp) const {
+    return std::upper_bound(
+        m_visionUpdates.begin(), m_visionUpdates.end(), timestamp,
+        [](units::second_t t, const auto& entry) { return t < entry.first; });
+  }
+
   /**
    * Removes stale vision updates that won't affect sampling.
    */
@@ -386,7 +527,7 @@ class WPILIB_DLLEXPORT PoseEstimator {
 
     // Step 2: If there are no vision updates before that timestamp, skip.
     if (m_visionUpdates.empty() ||
-        oldestOdometryTimestamp < m_visionUpdates.begin()->first) {
+        oldestOdometryTimestamp < m_visionUpdates.front().first) {
       return;
     }
 
@@ -396,7 +537,7 @@ class WPILIB_DLLEXPORT PoseEstimator {
     // back one. Note that upper_bound() won't return begin() because we check
     // begin() earlier.
     auto newestNeededVisionUpdate =
-        m_visionUpdates.upper_bound(oldestOdometryTimestamp);
+        VisionUpdateUpperBound(oldestOdometryTimestamp);
     --newestNeededVisionUpdate;
 
     // Step 4: Remove all entries strictly before the newest timestamp we need.
@@ -426,16 +567,22 @@ class WPILIB_DLLEXPORT PoseEstimator {
 
   static constexpr units::second_t kBufferDuration = 1.5_s;
 
+  // Initial capacity of m_visionUpdates. It only grows if more vision updates
+  // than this are needed to cover the odometry buffer.
+  static constexpr size_t kVisionUpdateCapacity = 128;
+
   Odometry<WheelSpeeds, WheelPositions>& m_odometry;
   wpi::array<double, 3> m_q{wpi::empty_array};
   Eigen::Matrix3d m_visionK = Eigen::Matrix3d::Zero();
 
   // Maps timestamps to odometry-only pose estimates
   TimeInterpolatableBuffer<Pose2d> m_odometryPoseBuffer{kBufferDuration};
-  // Maps timestamps to vision updates
+  // Vision updates and their timestamps, sorted by timestamp
   // Always contains one entry before the oldest entry in m_odometryPoseBuffer,
   // unless there have been no vision measurements after the last reset
-  std::map<units::second_t, VisionUpdate> m_visionUpdates;
+  std::vector<std::pair<units::second_t, VisionUpdate>> m_visionUpdates;
+  // Scratch space for sorting AddVisionMeasurements() batches
+  std::vector<size_t> m_visionBatchOrder;
 
   Pose2d m_poseEstimate;
 };
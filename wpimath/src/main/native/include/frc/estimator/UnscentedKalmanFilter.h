@@ -228,6 +228,40 @@ class UnscentedKalmanFilter {
    */
   void SetXhat(int i, double value) { m_xHat(i) = value; }
 
+  /**
+   * Sets a function that returns the Jacobian of f(x, u) with respect to x.
+   * When the process noise is linearized, Predict() uses it instead of
+   * differentiating f(x, u) numerically, which takes 2 * States extra
+   * evaluations of f(x, u).
+   *
+   * AutodiffJacobian can compute it automatically from f(x, u).
+   *
+   * @param dfdx A function of x and u that returns the Jacobian of f(x, u)
+   *             with respect to x, or nullptr to differentiate numerically.
+   */
+  void SetStateJacobian(
+      std::function<StateMatrix(const StateVector&, const InputVector&)>
+          dfdx) {
+    m_dfdx = std::move(dfdx);
+  }
+
+  /**
+   * Sets whether Predict() linearizes the model around the state estimate to
+   * discretize the process noise covariance, which is the default.
+   *
+   * Linearizing costs 2 * States extra evaluations of f(x, u) (unless a
+   * Jacobian is set with SetStateJacobian()), a matrix
+   * exponential, and a Cholesky factorization per prediction. When disabled,
+   * the process noise covariance is discretized as Q dt instead, which is
+   * accurate for short timesteps and whose square root is just a diagonal
+   * matrix.
+   *
+   * @param enabled Whether to linearize the model.
+   */
+  void SetLinearizedProcessNoise(bool enabled) {
+    m_linearizeProcessNoise = enabled;
+  }
+
   /**
    * Resets the observer.
    */
@@ -247,12 +281,18 @@ class UnscentedKalmanFilter {
     m_dt = dt;
 
     // Discretize Q before projecting mean and covariance forward
-    StateMatrix contA =
-        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
-    StateMatrix discA;
     StateMatrix discQ;
-    DiscretizeAQ<States>(contA, m_contQ, m_dt, &discA, &discQ);
-    Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(discQ);
+    if (m_linearizeProcessNoise) {
+      StateMatrix contA =
+          m_dfdx ? m_dfdx(m_xHat, u)
+                 : NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+      StateMatrix discA;
+      DiscretizeAQ<States>(contA, m_contQ, m_dt, &discA, &discQ);
+      Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(discQ);
+    } else {
+      // Q is diagonal, so √(Q dt) is too
+      discQ = (m_contQ.diagonal() * m_dt.value()).cwiseSqrt().asDiagonal();
+    }
 
     // Generate sigma points around the state mean
     //
@@ -435,11 +475,14 @@ class UnscentedKalmanFilter {
     //   K = (S_{y} \ P_{xy})ᵀ / S_{y}
     //   K = (S_{y}ᵀ \ (S_{y} \ P_{xy}ᵀ))ᵀ
     //
+    // S_{y} is lower triangular, so this is two triangular solves.
+    //
     // equation (27)
     Matrixd<States, Rows> K =
         Sy.transpose()
-            .fullPivHouseholderQr()
-            .solve(Sy.fullPivHouseholderQr().solve(Pxy.transpose()))
+            .template triangularView<Eigen::Upper>()
+            .solve(Sy.template triangularView<Eigen::Lower>().solve(
+                Pxy.transpose()))
             .transpose();
 
     // Compute the posterior state mean
@@ -467,6 +510,7 @@ class UnscentedKalmanFilter {
  private:
   std::function<StateVector(const StateVector&, const InputVector&)> m_f;
   std::function<OutputVector(const StateVector&, const InputVector&)> m_h;
+  std::function<StateMatrix(const StateVector&, const InputVector&)> m_dfdx;
   std::function<StateVector(const Matrixd<States, 2 * States + 1>&,
                             const Vectord<2 * States + 1>&)>
       m_meanFuncX;
@@ -484,6 +528,7 @@ class UnscentedKalmanFilter {
   Matrixd<Outputs, Outputs> m_contR;
   Matrixd<States, 2 * States + 1> m_sigmasF;
   units::second_t m_dt;
+  bool m_linearizeProcessNoise = true;
 
   MerweScaledSigmaPoints<States> m_pts;
 };
@@ -5,8 +5,12 @@
 #pragma once
 
 #include <algorithm>
+#include <compare>
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <optional>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -58,39 +62,43 @@ class TimeInterpolatableBuffer {
   /**
    * Add a sample to the buffer.
    *
+   * Samples are usually added in time order, which takes amortized constant
+   * time. Adding a sample older than the newest one requires shifting the
+   * newer samples.
+   *
    * @param time   The timestamp of the sample.
    * @param sample The sample object.
    */
   void AddSample(units::second_t time, T sample) {
-    // Add the new state into the vector
-    if (m_pastSnapshots.size() == 0 || time > m_pastSnapshots.back().first) {
-      m_pastSnapshots.emplace_back(time, sample);
+    if (m_length == 0 || time > Back().first) {
+      PushBack(time, std::move(sample));
     } else {
-      auto first_after = std::upper_bound(
-          m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-          [](auto t, const auto& pair) { return t < pair.first; });
-
-      if (first_after == m_pastSnapshots.begin()) {
-        // All entries come after the sample
-        m_pastSnapshots.insert(first_after, std::pair{time, sample});
-      } else if (auto last_not_greater_than = first_after - 1;
-                 last_not_greater_than == m_pastSnapshots.begin() ||
-                 last_not_greater_than->first < time) {
-        // Some entries come before the sample, but none are recorded with the
-        // same time
-        m_pastSnapshots.insert(first_after, std::pair{time, sample});
-      } else {
+      // Index of the first entry after the sample
+      size_t firstAfter = UpperBound(time);
+
+      if (firstAfter > 0 && At(firstAfter - 1).first == time) {
         // An entry exists with the same recorded time
-        last_not_greater_than->second = sample;
+        At(firstAfter - 1).second = std::move(sample);
+      } else {
+        // Make room for the sample by shifting the newer entries back
+        PushBack(Back().first, Back().second);
+        for (size_t i = m_length - 2; i > firstAfter; --i) {
+          At(i) = std::move(At(i - 1));
+        }
+        At(firstAfter) = std::pair{time, std::move(sample)};
       }
     }
-    while (time - m_pastSnapshots[0].first > m_historySize) {
-      m_pastSnapshots.erase(m_pastSnapshots.begin());
+    while (time - At(0).first > m_historySize) {
+      m_front = (m_front + 1) & (m_data.size() - 1);
+      --m_length;
     }
   }
 
   /** Clear all old samples. */
-  void Clear() { m_pastSnapshots.clear(); }
+  void Clear() {
+    m_front = 0;
+    m_length = 0;
+  }
 
   /**
    * Sample the buffer at the given time. If the buffer is empty, an empty
@@ -99,59 +107,245 @@ class TimeInterpolatableBuffer {
    * @param time The time at which to sample the buffer.
    */
   std::optional<T> Sample(units::second_t time) const {
-    if (m_pastSnapshots.empty()) {
+    if (m_length == 0) {
       return {};
     }
 
-    // We will perform a binary search to find the index of the element in the
-    // vector that has a timestamp that is equal to or greater than the vision
-    // measurement timestamp.
-
-    if (time <= m_pastSnapshots.front().first) {
-      return m_pastSnapshots.front().second;
+    if (time <= At(0).first) {
+      return At(0).second;
     }
-    if (time > m_pastSnapshots.back().first) {
-      return m_pastSnapshots.back().second;
+    if (time > Back().first) {
+      return Back().second;
     }
-    if (m_pastSnapshots.size() < 2) {
-      return m_pastSnapshots[0].second;
+    if (m_length < 2) {
+      return At(0).second;
     }
 
-    // Get the iterator which has a key no less than the requested key.
-    auto upper_bound = std::lower_bound(
-        m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-        [](const auto& pair, auto t) { return t > pair.first; });
+    // Binary search for the index of the first entry with a timestamp equal to
+    // or greater than the requested time. The checks above guarantee it's in
+    // [1, size).
+    size_t upper = LowerBound(time);
+    const auto& upperBound = At(upper);
+    const auto& lowerBound = At(upper - 1);
+
+    double t =
+        ((time - lowerBound.first) / (upperBound.first - lowerBound.first));
+
+    return m_interpolatingFunc(lowerBound.second, upperBound.second, t);
+  }
+
+  /**
+   * View of the samples in the buffer, oldest first. It supports indexing and
+   * random-access iteration like a std::vector, but the samples can't be added
+   * or removed through it.
+   *
+   * @tparam Buffer The buffer type (const or non-const).
+   */
+  template <typename Buffer>
+  class View {
+   public:
+    using value_type = std::pair<units::second_t, T>;
+    using reference =
+        std::conditional_t<std::is_const_v<Buffer>, const value_type&,
+                           value_type&>;
+
+    /** Random-access iterator over the samples. */
+    class iterator {
+     public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = View::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = std::remove_reference_t<View::reference>*;
+      using reference = View::reference;
+
+      constexpr iterator() = default;
+      constexpr iterator(Buffer* buffer, size_t index)
+          : m_buffer{buffer}, m_index{index} {}
 
-    if (upper_bound == m_pastSnapshots.begin()) {
-      return upper_bound->second;
+      constexpr reference operator*() const { return m_buffer->At(m_index); }
+      constexpr pointer operator->() const { return &m_buffer->At(m_index); }
+      constexpr reference operator[](difference_type n) const {
+        return m_buffer->At(m_index + n);
+      }
+
+      constexpr iterator& operator++() {
+        ++m_index;
+        return *this;
+      }
+      constexpr iterator operator++(int) {
+        iterator retval = *this;
+        ++m_index;
+        return retval;
+      }
+      constexpr iterator& operator--() {
+        --m_index;
+        return *this;
+      }
+      constexpr iterator operator--(int) {
+        iterator retval = *this;
+        --m_index;
+        return retval;
+      }
+      constexpr iterator& operator+=(difference_type n) {
+        m_index += n;
+        return *this;
+      }
+      constexpr iterator& operator-=(difference_type n) {
+        m_index -= n;
+        return *this;
+      }
+      constexpr iterator operator+(difference_type n) const {
+        return iterator{m_buffer, m_index + n};
+      }
+      friend constexpr iterator operator+(difference_type n,
+                                          const iterator& it) {
+        return it + n;
+      }
+      constexpr iterator operator-(difference_type n) const {
+        return iterator{m_buffer, m_index - n};
+      }
+      constexpr difference_type operator-(const iterator& other) const {
+        return static_cast<difference_type>(m_index) -
+               static_cast<difference_type>(other.m_index);
+      }
+
+      constexpr bool operator==(const iterator& other) const {
+        return m_index == other.m_index;
+      }
+      constexpr auto operator<=>(const iterator& other) const {
+        return m_index <=> other.m_index;
+      }
+
+     private:
+      Buffer* m_buffer = nullptr;
+      size_t m_index = 0;
+    };
+
+    constexpr explicit View(Buffer* buffer) : m_buffer{buffer} {}
+
+    /** Returns true if there are no samples. */
+    constexpr bool empty() const { return m_buffer->m_length == 0; }
+
+    /** Returns the number of samples. */
+    constexpr size_t size() const { return m_buffer->m_length; }
+
+    /**
+     * Returns the oldest sample. The buffer must not be empty.
+     */
+    constexpr reference front() const { return m_buffer->At(0); }
+
+    /**
+     * Returns the newest sample. The buffer must not be empty.
+     */
+    constexpr reference back() const { return m_buffer->Back(); }
+
+    /**
+     * Returns the sample at the given index, starting from the oldest.
+     */
+    constexpr reference operator[](size_t index) const {
+      return m_buffer->At(index);
     }
 
-    auto lower_bound = upper_bound - 1;
+    /** Returns begin iterator. */
+    constexpr iterator begin() const { return iterator{m_buffer, 0}; }
 
-    double t = ((time - lower_bound->first) /
-                (upper_bound->first - lower_bound->first));
+    /** Returns end iterator. */
+    constexpr iterator end() const {
+      return iterator{m_buffer, m_buffer->m_length};
+    }
 
-    return m_interpolatingFunc(lower_bound->second, upper_bound->second, t);
-  }
+   private:
+    Buffer* m_buffer;
+  };
 
   /**
    * Grant access to the internal sample buffer. Used in Pose Estimation to
    * replay odometry inputs stored within this buffer.
    */
-  std::vector<std::pair<units::second_t, T>>& GetInternalBuffer() {
-    return m_pastSnapshots;
+  View<TimeInterpolatableBuffer> GetInternalBuffer() {
+    return View<TimeInterpolatableBuffer>{this};
   }
 
   /**
    * Grant access to the internal sample buffer.
    */
-  const std::vector<std::pair<units::second_t, T>>& GetInternalBuffer() const {
-    return m_pastSnapshots;
+  View<const TimeInterpolatableBuffer> GetInternalBuffer() const {
+    return View<const TimeInterpolatableBuffer>{this};
   }
 
  private:
+  // Returns the entry at the given index, starting from the oldest
+  std::pair<units::second_t, T>& At(size_t index) {
+    return m_data[(m_front + index) & (m_data.size() - 1)];
+  }
+
+  const std::pair<units::second_t, T>& At(size_t index) const {
+    return m_data[(m_front + index) & (m_data.size() - 1)];
+  }
+
+  std::pair<units::second_t, T>& Back() { return At(m_length - 1); }
+
+  const std::pair<units::second_t, T>& Back() const {
+    return At(m_length - 1);
+  }
+
+  // Appends an entry, doubling the capacity if the buffer is full
+  void PushBack(units::second_t time, T sample) {
+    if (m_length == m_data.size()) {
+      // Unwrap the entries into the start of the new storage. Its size is
+      // kept a power of two so indices can wrap with a mask. The unused slots
+      // hold copies of the new sample so T needn't be default constructible.
+      size_t size = m_data.empty() ? 16 : m_data.size() * 2;
+      std::vector<std::pair<units::second_t, T>> data;
+      data.reserve(size);
+      for (size_t i = 0; i < m_length; ++i) {
+        data.emplace_back(std::move(At(i)));
+      }
+      data.resize(size, std::pair{time, sample});
+      m_data = std::move(data);
+      m_front = 0;
+    }
+    At(m_length) = std::pair{time, std::move(sample)};
+    ++m_length;
+  }
+
+  // Returns the index of the first entry with a timestamp greater than time
+  size_t UpperBound(units::second_t time) const {
+    size_t low = 0;
+    size_t count = m_length;
+    while (count > 0) {
+      size_t step = count / 2;
+      if (!(time < At(low + step).first)) {
+        low += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return low;
+  }
+
+  // Returns the index of the first entry with a timestamp not less than time
+  size_t LowerBound(units::second_t time) const {
+    size_t low = 0;
+    size_t count = m_length;
+    while (count > 0) {
+      size_t step = count / 2;
+      if (At(low + step).first < time) {
+        low += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return low;
+  }
+
   units::second_t m_historySize;
-  std::vector<std::pair<units::second_t, T>> m_pastSnapshots;
+  // Ring buffer of samples in time order. Its size is zero or a power of two.
+  std::vector<std::pair<units::second_t, T>> m_data;
+  size_t m_front = 0;
+  size_t m_length = 0;
   std::function<T(const T&, const T&, double)> m_interpolatingFunc;
 };
 
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <span>
+#include <vector>
 
 #include <Eigen/QR>
 #include <wpi/SymbolExports.h>
@@ -169,15 +171,14 @@ class SwerveDriveKinematics
       return moduleStates;
     }
 
-    // We have a new center of rotation. We need to compute the matrix again.
+    // We have a new center of rotation. Only the column that maps the
+    // rotational velocity depends on it, so only that column is recomputed.
     if (centerOfRotation != m_previousCoR) {
       for (size_t i = 0; i < NumModules; i++) {
-        // clang-format off
-      m_inverseKinematics.template block<2, 3>(i * 2, 0) =
-        Matrixd<2, 3>{
-          {1, 0, (-m_modules[i].Y() + centerOfRotation.Y()).value()},
-          {0, 1, (+m_modules[i].X() - centerOfRotation.X()).value()}};
-        // clang-format on
+        m_inverseKinematics(i * 2, 2) =
+            (-m_modules[i].Y() + centerOfRotation.Y()).value();
+        m_inverseKinematics(i * 2 + 1, 2) =
+            (+m_modules[i].X() - centerOfRotation.X()).value();
       }
       m_previousCoR = centerOfRotation;
     }
@@ -204,6 +205,66 @@ class SwerveDriveKinematics
     return moduleStates;
   }
 
+  /**
+   * Performs inverse kinematics on many chassis velocities at once. This is
+   * equivalent to calling ToSwerveModuleStates(const ChassisSpeeds&, const
+   * Translation2d&) on each chassis velocity in order, but the module
+   * velocities of every chassis velocity are computed together in
+   * structure-of-arrays form so Eigen can vectorize them. This is meant for
+   * offline tools and simulations that evaluate the kinematics for entire
+   * trajectories.
+   *
+   * As with the single chassis velocity version, modules that aren't moving
+   * keep the previously calculated module angle, and the module angles of the
+   * last chassis velocity are remembered for subsequent calls.
+   *
+   * @param chassisSpeeds The desired chassis speeds.
+   * @param centerOfRotation The center of rotation used for all chassis speeds.
+   * @return The module states for each chassis velocity.
+   */
+  std::vector<wpi::array<SwerveModuleState, NumModules>> ToSwerveModuleStates(
+      std::span<const ChassisSpeeds> chassisSpeeds,
+      const Translation2d& centerOfRotation = Translation2d{}) const {
+    const auto size = static_cast<Eigen::Index>(chassisSpeeds.size());
+
+    Eigen::ArrayXd vx(size);
+    Eigen::ArrayXd vy(size);
+    Eigen::ArrayXd omega(size);
+    for (Eigen::Index j = 0; j < size; ++j) {
+      vx(j) = chassisSpeeds[j].vx.value();
+      vy(j) = chassisSpeeds[j].vy.value();
+      omega(j) = chassisSpeeds[j].omega.value();
+    }
+
+    std::vector<wpi::array<SwerveModuleState, NumModules>> moduleStates(
+        chassisSpeeds.size(),
+        wpi::array<SwerveModuleState, NumModules>(wpi::empty_array));
+
+    Eigen::ArrayXd x(size);
+    Eigen::ArrayXd y(size);
+    Eigen::ArrayXd speed(size);
+    for (size_t i = 0; i < NumModules; ++i) {
+      double rx = (m_modules[i].X() - centerOfRotation.X()).value();
+      double ry = (m_modules[i].Y() - centerOfRotation.Y()).value();
+      x = vx - omega * ry;
+      y = vy + omega * rx;
+      speed = (x.square() + y.square()).sqrt();
+
+      // A module's angle only depends on its own previous angle, so each
+      // module's angles are carried forward independently
+      Rotation2d heading = m_moduleHeadings[i];
+      for (Eigen::Index j = 0; j < size; ++j) {
+        if (speed(j) > 1e-6) {
+          heading = Rotation2d{x(j), y(j)};
+        }
+        moduleStates[j][i] = {units::meters_per_second_t{speed(j)}, heading};
+      }
+      m_moduleHeadings[i] = heading;
+    }
+
+    return moduleStates;
+  }
+
   wpi::array<SwerveModuleState, NumModules> ToWheelSpeeds(
       const ChassisSpeeds& chassisSpeeds) const override {
     return ToSwerveModuleStates(chassisSpeeds);
@@ -260,6 +321,47 @@ class SwerveDriveKinematics
             units::radians_per_second_t{chassisSpeedsVector(2)}};
   }
 
+  /**
+   * Performs forward kinematics on many sets of module states at once. This is
+   * equivalent to calling ToChassisSpeeds(const wpi::array<SwerveModuleState,
+   * NumModules>&) on each set of module states, but the least-squares problems
+   * of every set are solved together as a single multi-column solve.
+   *
+   * @param moduleStates The sets of module states. The order of the module
+   * states in each set should be same as passed into the constructor of this
+   * class.
+   * @return The chassis speed for each set of module states.
+   */
+  std::vector<ChassisSpeeds> ToChassisSpeeds(
+      std::span<const wpi::array<SwerveModuleState, NumModules>> moduleStates)
+      const {
+    const auto size = static_cast<Eigen::Index>(moduleStates.size());
+
+    Eigen::Matrix<double, NumModules * 2, Eigen::Dynamic> moduleStateMatrix(
+        NumModules * 2, size);
+    for (Eigen::Index j = 0; j < size; ++j) {
+      for (size_t i = 0; i < NumModules; ++i) {
+        const auto& module = moduleStates[j][i];
+        moduleStateMatrix(i * 2, j) = module.speed.value() * module.angle.Cos();
+        moduleStateMatrix(i * 2 + 1, j) =
+            module.speed.value() * module.angle.Sin();
+      }
+    }
+
+    Eigen::Matrix<double, 3, Eigen::Dynamic> chassisSpeedsMatrix =
+        m_forwardKinematics.solve(moduleStateMatrix);
+
+    std::vector<ChassisSpeeds> chassisSpeeds;
+    chassisSpeeds.reserve(moduleStates.size());
+    for (Eigen::Index j = 0; j < size; ++j) {
+      chassisSpeeds.push_back(
+          {units::meters_per_second_t{chassisSpeedsMatrix(0, j)},
+           units::meters_per_second_t{chassisSpeedsMatrix(1, j)},
+           units::radians_per_second_t{chassisSpeedsMatrix(2, j)}});
+    }
+    return chassisSpeeds;
+  }
+
   /**
    * Performs forward kinematics to return the resulting Twist2d from the
    * given module position deltas. This method is often used for odometry --
@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <random>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include <wpi/SymbolExports.h>
 #include <wpi/array.h>
 
 #include "frc/EigenCore.h"
@@ -25,7 +28,7 @@ namespace frc {
  * @see <a
  * href="https://en.wikipedia.org/wiki/Travelling_salesman_problem">https://en.wikipedia.org/wiki/Travelling_salesman_problem</a>
  */
-class TravelingSalesman {
+class WPILIB_DLLEXPORT TravelingSalesman {
  public:
   /**
    * Constructs a traveling salesman problem solver with a cost function defined
@@ -134,6 +137,63 @@ class TravelingSalesman {
     return solution;
   }
 
+  /**
+   * Finds the path through every pose that minimizes the cost. The first pose
+   * in the returned array is the first pose that was passed in.
+   *
+   * Unlike the other overloads, this evaluates the cost function once for each
+   * pair of poses up front. Each iteration then proposes either reversing part
+   * of the path (2-opt) or moving up to three consecutive poses elsewhere in
+   * the path (Or-opt), and only the edges that change are used to compute the
+   * change in cost. This makes each iteration independent of the number of
+   * poses for symmetric cost functions, so it scales to much longer paths.
+   *
+   * The solver is restarted from random paths the given number of times, and
+   * the best path found is returned. The restarts are independent, so they can
+   * be split between multiple threads.
+   *
+   * @param poses An array of Pose2ds the path must pass through.
+   * @param iterations The number of times the solver attempts to find a better
+   *     random neighbor in each restart.
+   * @param restarts The number of times the solver is run.
+   * @param numThreads The number of threads to split the restarts between.
+   *     With 1, the solver runs on the calling thread.
+   * @return The optimized path as an array of Pose2ds.
+   */
+  std::vector<Pose2d> Solve(std::span<const Pose2d> poses, int iterations,
+                            int restarts, int numThreads = 1) const {
+    return Solve(poses, iterations, restarts, numThreads,
+                 std::random_device{}());
+  }
+
+  /**
+   * Finds the path through every pose that minimizes the cost, like the
+   * overload above, with the given random seed. The same seed, poses and
+   * parameters always give the same path, regardless of the number of
+   * threads.
+   *
+   * @param poses An array of Pose2ds the path must pass through.
+   * @param iterations The number of times the solver attempts to find a better
+   *     random neighbor in each restart.
+   * @param restarts The number of times the solver is run.
+   * @param numThreads The number of threads to split the restarts between.
+   *     With 1, the solver runs on the calling thread.
+   * @param seed The seed of the random number generator.
+   * @return The optimized path as an array of Pose2ds.
+   */
+  std::vector<Pose2d> Solve(std::span<const Pose2d> poses, int iterations,
+                            int restarts, int numThreads,
+                            unsigned int seed) const {
+    auto indices = SolveIndices(poses, iterations, restarts, numThreads, seed);
+
+    std::vector<Pose2d> solution;
+    solution.reserve(indices.size());
+    for (size_t index : indices) {
+      solution.emplace_back(poses[index]);
+    }
+    return solution;
+  }
+
  private:
   // Default cost is distance between poses
   std::function<double(const Pose2d&, const Pose2d&)> m_cost =
@@ -141,6 +201,15 @@ class TravelingSalesman {
     return units::math::hypot(a.X() - b.X(), a.Y() - b.Y()).value();
   };
 
+  /**
+   * Solves the problem with a precomputed cost matrix.
+   *
+   * @return The indices of the poses in path order, starting with 0.
+   */
+  std::vector<size_t> SolveIndices(std::span<const Pose2d> poses,
+                                   int iterations, int restarts, int numThreads,
+                                   unsigned int seed) const;
+
   /**
    * A random neighbor is generated to try to replace the current one.
    *
@@ -28,7 +28,6 @@
 
 #pragma once
 
-#include <stack>
 #include <string>
 #include <utility>
 #include <vector>
@@ -72,57 +71,91 @@ class WPILIB_DLLEXPORT SplineParameterizer {
   static std::vector<PoseWithCurvature> Parameterize(const Spline<Dim>& spline,
                                                      double t0 = 0.0,
                                                      double t1 = 1.0) {
+    std::vector<PoseWithCurvature> splinePoints;
+    Workspace workspace;
+    Parameterize(spline, &splinePoints, &workspace, true, t0, t1);
+    return splinePoints;
+  }
+
+  /**
+   * Scratch storage for Parameterize(). Reusing a workspace between calls
+   * avoids reallocating it for each spline. A workspace must not be used by
+   * multiple threads at the same time.
+   */
+  class Workspace {
+   private:
+    friend class SplineParameterizer;
+
+    std::vector<std::pair<double, double>> stack;
+  };
+
+  /**
+   * Parametrizes the spline, appending the points to an existing vector
+   * instead of returning a new one.
+   *
+   * @param spline The spline to parameterize.
+   * @param points The vector to append the points to.
+   * @param workspace Scratch storage for the parameterization.
+   * @param includeStart Whether to append the point at t0.
+   * @param t0 Starting internal spline parameter.
+   * @param t1 Ending internal spline parameter.
+   */
+  template <int Dim>
+  static void Parameterize(const Spline<Dim>& spline,
+                           std::vector<PoseWithCurvature>* points,
+                           Workspace* workspace, bool includeStart = true,
+                           double t0 = 0.0, double t1 = 1.0) {
     constexpr const char* kMalformedSplineExceptionMsg =
         "Could not parameterize a malformed spline. This means that you "
         "probably had two or more adjacent waypoints that were very close "
         "together with headings in opposing directions.";
-    std::vector<PoseWithCurvature> splinePoints;
 
     // The parameterization does not add the initial point. Let's add that.
-    if (auto point = spline.GetPoint(t0)) {
-      splinePoints.push_back(point.value());
-    } else {
+    auto point = spline.GetPoint(t0);
+    if (!point) {
       throw MalformedSplineException(kMalformedSplineExceptionMsg);
     }
+    if (includeStart) {
+      points->push_back(point.value());
+    }
+
+    // Segments are processed in order along the spline, so the start of each
+    // segment is always the last point found
+    Pose2d start = point.value().first;
 
     // We use an "explicit stack" to simulate recursion, instead of a recursive
     // function call This give us greater control, instead of a stack overflow
-    std::stack<StackContents> stack;
-    stack.emplace(StackContents{t0, t1});
+    auto& stack = workspace->stack;
+    stack.clear();
+    stack.emplace_back(t0, t1);
 
     int iterations = 0;
 
     while (!stack.empty()) {
-      auto current = stack.top();
-      stack.pop();
-
-      auto start = spline.GetPoint(current.t0);
-      if (!start) {
-        throw MalformedSplineException(kMalformedSplineExceptionMsg);
-      }
+      auto [currentT0, currentT1] = stack.back();
+      stack.pop_back();
 
-      auto end = spline.GetPoint(current.t1);
+      auto end = spline.GetPoint(currentT1);
       if (!end) {
         throw MalformedSplineException(kMalformedSplineExceptionMsg);
       }
 
-      const auto twist = start.value().first.Log(end.value().first);
+      const auto twist = start.Log(end.value().first);
 
       if (units::math::abs(twist.dy) > kMaxDy ||
           units::math::abs(twist.dx) > kMaxDx ||
           units::math::abs(twist.dtheta) > kMaxDtheta) {
-        stack.emplace(StackContents{(current.t0 + current.t1) / 2, current.t1});
-        stack.emplace(StackContents{current.t0, (current.t0 + current.t1) / 2});
+        stack.emplace_back((currentT0 + currentT1) / 2, currentT1);
+        stack.emplace_back(currentT0, (currentT0 + currentT1) / 2);
       } else {
-        splinePoints.push_back(end.value());
+        points->push_back(end.value());
+        start = end.value().first;
       }
 
       if (iterations++ >= kMaxIterations) {
         throw MalformedSplineException(kMalformedSplineExceptionMsg);
       }
     }
-
-    return splinePoints;
   }
 
  private:
@@ -131,11 +164,6 @@ class WPILIB_DLLEXPORT SplineParameterizer {
   static inline constexpr units::meter_t kMaxDy = 0.05_in;
   static inline constexpr units::radian_t kMaxDtheta = 0.0872_rad;
 
-  struct StackContents {
-    double t0;
-    double t1;
-  };
-
   /**
    * A malformed spline does not actually explode the LIFO stack size. Instead,
    * the stack size stays at a relatively small number (e.g. 30) and never
@@ -0,0 +1,80 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <sleipnir/autodiff/jacobian.hpp>
+#include <sleipnir/autodiff/variable_matrix.hpp>
+
+#include "frc/EigenCore.h"
+
+namespace frc {
+
+/**
+ * Jacobian with respect to x of a function f(x, u), computed by automatic
+ * differentiation.
+ *
+ * f(x, u) is traced once on construction into a Sleipnir expression graph.
+ * Each evaluation then only updates the graph's values and computes the
+ * derivatives from it, so it needs no extra evaluations of f(x, u) and has no
+ * finite difference error. This can be passed to the Kalman filters as an
+ * analytic Jacobian.
+ *
+ * Since f(x, u) is traced once, it must not branch on the values of x or u.
+ * Writing f(x, u) as a generic lambda lets the same function be used with both
+ * Eigen vectors and Sleipnir variables.
+ *
+ * Copies share the same expression graph, so they must not be evaluated
+ * concurrently.
+ *
+ * @tparam Rows Number of rows in result of f(x, u).
+ * @tparam States Number of rows in x.
+ * @tparam Inputs Number of rows in u.
+ */
+template <int Rows, int States, int Inputs>
+class AutodiffJacobian {
+ public:
+  /**
+   * Constructs an autodiff Jacobian.
+   *
+   * @param f Vector-valued function from which to compute the Jacobian.
+   */
+  explicit AutodiffJacobian(
+      std::function<slp::VariableMatrix(const slp::VariableMatrix& x,
+                                        const slp::VariableMatrix& u)>
+          f)
+      : m_graph{std::make_shared<Graph>(f)} {}
+
+  /**
+   * Returns the Jacobian with respect to x of f(x, u).
+   *
+   * @param x State vector.
+   * @param u Input vector.
+   */
+  Matrixd<Rows, States> operator()(const Vectord<States>& x,
+                                   const Vectord<Inputs>& u) const {
+    m_graph->x.set_value(x);
+    m_graph->u.set_value(u);
+    return m_graph->jacobian.value().toDense();
+  }
+
+ private:
+  struct Graph {
+    explicit Graph(const std::function<slp::VariableMatrix(
+                       const slp::VariableMatrix&, const slp::VariableMatrix&)>&
+                       f)
+        : x{States}, u{Inputs}, jacobian{f(x, u), x} {}
+
+    slp::VariableMatrix x;
+    slp::VariableMatrix u;
+    slp::Jacobian jacobian;
+  };
+
+  std::shared_ptr<Graph> m_graph;
+};
+
+}  // namespace frc
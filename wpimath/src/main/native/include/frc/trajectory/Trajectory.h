@@ -5,6 +5,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -154,24 +156,128 @@ class WPILIB_DLLEXPORT Trajectory {
     // Use binary search to get the element with a timestamp no less than the
     // requested timestamp. This starts at 1 because we use the previous state
     // later on for interpolation.
-    auto sample =
-        std::lower_bound(m_states.cbegin() + 1, m_states.cend(), t,
-                         [](const auto& a, const auto& b) { return a.t < b; });
+    return SampleSegment(LowerBound(t, 1, m_states.size()), t);
+  }
 
-    auto prevSample = sample - 1;
+  /**
+   * Samples a trajectory at a sequence of points in time, reusing the position
+   * of each sample to find the next one. Sampling the same trajectory at
+   * increasing times, as a path follower does, takes amortized constant time
+   * per sample instead of a binary search over all of the states.
+   *
+   * The sampler refers to the trajectory, so the trajectory must outlive it
+   * and must not be modified while it's in use.
+   */
+  class WPILIB_DLLEXPORT Sampler {
+   public:
+    /**
+     * Constructs a sampler for a trajectory.
+     *
+     * @param trajectory The trajectory to sample.
+     */
+    explicit Sampler(const Trajectory& trajectory)
+        : m_trajectory{&trajectory} {}
 
-    // The sample's timestamp is now greater than or equal to the requested
-    // timestamp. If it is greater, we need to interpolate between the
-    // previous state and the current state to get the exact state that we
-    // want.
+    /**
+     * Sample the trajectory at a point in time. Returns the same state as
+     * Trajectory::Sample().
+     *
+     * If the time is at or a little after the previous sample's time, the
+     * states are searched forward from the previous sample. Otherwise, this
+     * falls back to a binary search.
+     *
+     * @param t The point in time since the beginning of the trajectory to
+     *     sample.
+     * @return The state at that point in time.
+     * @throws std::runtime_error if the trajectory has no states.
+     */
+    State Sample(units::second_t t) {
+      const auto& states = m_trajectory->m_states;
+      if (states.empty()) {
+        throw std::runtime_error(
+            "Trajectory cannot be sampled if it has no states.");
+      }
 
-    // If the difference in states is negligible, then we are spot on!
-    if (units::math::abs(sample->t - prevSample->t) < 1E-9_s) {
-      return *sample;
+      if (t <= states.front().t) {
+        return states.front();
+      }
+      if (t >= m_trajectory->m_totalTime) {
+        return states.back();
+      }
+
+      // Find the first state at index 1 or later with a timestamp no less than
+      // t, starting from the previous sample's state
+      size_t index = (std::min)(m_index, states.size() - 1);
+      if (index > 1 && states[index - 1].t >= t) {
+        // Went backward
+        index = m_trajectory->LowerBound(t, 1, index);
+      } else {
+        // Step forward a few states, then give up and binary search the rest
+        size_t end = (std::min)(index + kMaxSteps, states.size());
+        while (index < end && states[index].t < t) {
+          ++index;
+        }
+        if (index == end) {
+          index = m_trajectory->LowerBound(t, index, states.size());
+        }
+      }
+      m_index = index;
+
+      return m_trajectory->SampleSegment(index, t);
     }
-    // Interpolate between the two states for the state that we want.
-    return prevSample->Interpolate(
-        *sample, (t - prevSample->t) / (sample->t - prevSample->t));
+
+    /**
+     * Samples the trajectory at each of the given points in time, which are
+     * usually (but don't have to be) in increasing order.
+     *
+     * @param times The points in time since the beginning of the trajectory to
+     *     sample.
+     * @param output The state at each point in time. Must be the same size as
+     *     times.
+     * @throws std::invalid_argument if times and output aren't the same size.
+     * @throws std::runtime_error if the trajectory has no states.
+     */
+    void SampleMany(std::span<const units::second_t> times,
+                    std::span<State> output) {
+      if (times.size() != output.size()) {
+        throw std::invalid_argument(
+            "Trajectory sample times and output must be the same size.");
+      }
+      for (size_t i = 0; i < times.size(); ++i) {
+        output[i] = Sample(times[i]);
+      }
+    }
+
+    /**
+     * Forgets the previous sample, so the next sample does a binary search.
+     */
+    void Reset() { m_index = 1; }
+
+   private:
+    // The number of states to step forward before binary searching
+    static constexpr size_t kMaxSteps = 8;
+
+    const Trajectory* m_trajectory;
+
+    // The index of the end state of the previous sample's segment
+    size_t m_index = 1;
+  };
+
+  /**
+   * Samples the trajectory at each of the given points in time. This is faster
+   * than sampling each point in time separately if the times are in increasing
+   * order.
+   *
+   * @param times The points in time since the beginning of the trajectory to
+   *     sample.
+   * @param output The state at each point in time. Must be the same size as
+   *     times.
+   * @throws std::invalid_argument if times and output aren't the same size.
+   * @throws std::runtime_error if the trajectory has no states.
+   */
+  void SampleMany(std::span<const units::second_t> times,
+                  std::span<State> output) const {
+    Sampler{*this}.SampleMany(times, output);
   }
 
   /**
@@ -260,6 +366,43 @@ class WPILIB_DLLEXPORT Trajectory {
   bool operator==(const Trajectory&) const = default;
 
  private:
+  /**
+   * Returns the index of the first state in [begin, end) with a timestamp no
+   * less than t, or end if there isn't one.
+   */
+  size_t LowerBound(units::second_t t, size_t begin, size_t end) const {
+    return std::lower_bound(
+               m_states.cbegin() + begin, m_states.cbegin() + end, t,
+               [](const auto& a, const auto& b) { return a.t < b; }) -
+           m_states.cbegin();
+  }
+
+  /**
+   * Samples the trajectory between the state at the given index and the one
+   * before it.
+   *
+   * @param index The index of the first state with a timestamp no less than t.
+   *     Must be at least 1.
+   * @param t The point in time to sample.
+   */
+  State SampleSegment(size_t index, units::second_t t) const {
+    const auto& sample = m_states[index];
+    const auto& prevSample = m_states[index - 1];
+
+    // The sample's timestamp is now greater than or equal to the requested
+    // timestamp. If it is greater, we need to interpolate between the
+    // previous state and the current state to get the exact state that we
+    // want.
+
+    // If the difference in states is negligible, then we are spot on!
+    if (units::math::abs(sample.t - prevSample.t) < 1E-9_s) {
+      return sample;
+    }
+    // Interpolate between the two states for the state that we want.
+    return prevSample.Interpolate(
+        sample, (t - prevSample.t) / (sample.t - prevSample.t));
+  }
+
   std::vector<State> m_states;
   units::second_t m_totalTime = 0_s;
 };
@@ -84,6 +84,95 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
   static Trajectory GenerateTrajectory(const std::vector<Pose2d>& waypoints,
                                        const TrajectoryConfig& config);
 
+  /**
+   * Reusable state for generating trajectories.
+   *
+   * Generating trajectories with a workspace reuses the spline point buffers
+   * of previous calls instead of allocating new ones, and can parameterize the
+   * splines of a trajectory on multiple threads, each with its own scratch
+   * storage. The generated trajectories are identical to those generated
+   * without a workspace.
+   *
+   * A workspace must not be used by multiple threads at the same time.
+   */
+  class WPILIB_DLLEXPORT Workspace {
+   public:
+    /**
+     * Constructs a workspace.
+     *
+     * @param numThreads Number of threads used to parameterize the splines of
+     *     a trajectory. With 1, the splines are parameterized on the calling
+     *     thread.
+     */
+    explicit Workspace(int numThreads = 1);
+
+   private:
+    friend class TrajectoryGenerator;
+
+    int m_numThreads;
+    std::vector<SplineParameterizer::Workspace> m_splineWorkspaces;
+    std::vector<std::vector<PoseWithCurvature>> m_splinePoints;
+    std::vector<PoseWithCurvature> m_points;
+  };
+
+  /**
+   * Generates a trajectory from the given control vectors and config, using
+   * the buffers and threads of a workspace.
+   *
+   * @param initial           The initial control vector.
+   * @param interiorWaypoints The interior waypoints.
+   * @param end               The ending control vector.
+   * @param config            The configuration for the trajectory.
+   * @param workspace         The workspace.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(
+      Spline<3>::ControlVector initial,
+      const std::vector<Translation2d>& interiorWaypoints,
+      Spline<3>::ControlVector end, const TrajectoryConfig& config,
+      Workspace& workspace);
+
+  /**
+   * Generates a trajectory from the given waypoints and config, using the
+   * buffers and threads of a workspace.
+   *
+   * @param start             The starting pose.
+   * @param interiorWaypoints The interior waypoints.
+   * @param end               The ending pose.
+   * @param config            The configuration for the trajectory.
+   * @param workspace         The workspace.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(
+      const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
+      const Pose2d& end, const TrajectoryConfig& config, Workspace& workspace);
+
+  /**
+   * Generates a trajectory from the given quintic control vectors and config,
+   * using the buffers and threads of a workspace.
+   *
+   * @param controlVectors List of quintic control vectors.
+   * @param config         The configuration for the trajectory.
+   * @param workspace      The workspace.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(
+      std::vector<Spline<5>::ControlVector> controlVectors,
+      const TrajectoryConfig& config, Workspace& workspace);
+
+  /**
+   * Generates a trajectory from the given waypoints and config, using the
+   * buffers and threads of a workspace.
+   *
+   * @param waypoints List of waypoints.
+   * @param config    The configuration for the trajectory.
+   * @param workspace The workspace.
+   * @return The generated trajectory.
+   */
+  static Trajectory GenerateTrajectory(const std::vector<Pose2d>& waypoints,
+                                       const TrajectoryConfig& config,
+                                       Workspace& workspace);
+
   /**
    * Generate spline points from a vector of splines by parameterizing the
    * splines.
@@ -124,6 +213,15 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
  private:
   static void ReportError(const char* error);
 
+  // Parameterizes the splines into workspace.m_points
+  template <typename Spline>
+  static void SplinePointsFromSplines(const std::vector<Spline>& splines,
+                                      Workspace& workspace);
+
+  // Time parameterizes workspace.m_points
+  static Trajectory TimeParameterize(const TrajectoryConfig& config,
+                                     Workspace& workspace);
+
   static const Trajectory kDoNothingTrajectory;
   static std::function<void(const char*)> s_errorFunc;
 };
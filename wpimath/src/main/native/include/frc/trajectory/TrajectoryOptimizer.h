@@ -0,0 +1,166 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <wpi/SymbolExports.h>
+
+#include "frc/geometry/Translation2d.h"
+#include "frc/system/plant/DCMotor.h"
+#include "frc/trajectory/Trajectory.h"
+#include "units/current.h"
+#include "units/length.h"
+#include "units/mass.h"
+#include "units/moment_of_inertia.h"
+#include "units/time.h"
+#include "units/voltage.h"
+
+namespace frc {
+
+/**
+ * Generates time-optimal trajectories for differential and swerve drives.
+ *
+ * A trajectory from TrajectoryGenerator is used as the initial guess. Its path
+ * and timing are then optimized with the bundled Sleipnir solver so the robot
+ * reaches the end of the trajectory as fast as its motors allow, subject to
+ * voltage and current limits, circular obstacles, and interior waypoints.
+ *
+ * The initial guess determines the start and end poses and velocities, and
+ * which side of each obstacle the optimized path goes around.
+ */
+class WPILIB_DLLEXPORT TrajectoryOptimizer {
+ public:
+  /**
+   * Circular region of the field that the robot must stay out of.
+   */
+  struct Obstacle {
+    /// The center of the obstacle.
+    Translation2d center;
+
+    /// The radius of the obstacle.
+    units::meter_t radius;
+  };
+
+  /**
+   * Physical model of a differential drive.
+   */
+  struct DifferentialDrive {
+    /// The motors driving one side of the drivetrain.
+    DCMotor motor;
+
+    /// The gear ratio from the motors to the wheels (greater than 1 is a
+    /// reduction).
+    double gearing;
+
+    /// The wheel radius.
+    units::meter_t wheelRadius;
+
+    /// The distance between the left and right wheels.
+    units::meter_t trackwidth;
+
+    /// The mass of the robot.
+    units::kilogram_t mass;
+
+    /// The moment of inertia of the robot about its center.
+    units::kilogram_square_meter_t moi;
+  };
+
+  /**
+   * Physical model of a swerve drive.
+   */
+  struct SwerveDrive {
+    /// The drive motor of one module.
+    DCMotor motor;
+
+    /// The gear ratio from the drive motor to the wheel (greater than 1 is a
+    /// reduction).
+    double gearing;
+
+    /// The wheel radius.
+    units::meter_t wheelRadius;
+
+    /// The number of modules.
+    int numModules = 4;
+
+    /// The mass of the robot.
+    units::kilogram_t mass;
+  };
+
+  /**
+   * Constraints and solver settings for the optimization.
+   */
+  struct Options {
+    /// The maximum voltage applied to the motors.
+    units::volt_t maxVoltage = 12_V;
+
+    /// The maximum current drawn by the motors of one drivetrain side or
+    /// swerve module. If empty, current isn't limited.
+    std::optional<units::ampere_t> maxCurrent;
+
+    /// Obstacles that the robot must stay out of.
+    std::vector<Obstacle> obstacles;
+
+    /// The distance from the robot's center to its farthest point, used to
+    /// keep the robot out of obstacles.
+    units::meter_t robotRadius = 0_m;
+
+    /// The number of trajectory segments. Must be at least 2 and greater than
+    /// the number of interior waypoints.
+    int numSamples = 100;
+
+    /// The maximum time spent in the solver.
+    units::second_t timeout = 5_s;
+  };
+
+  /**
+   * Optimizes a differential drive trajectory.
+   *
+   * The states of the returned trajectory are evenly spaced in time. Their
+   * poses are the robot pose, as for a trajectory from TrajectoryGenerator.
+   *
+   * @param initialGuess The trajectory to start from.
+   * @param interiorWaypoints Translations the robot must pass through, in
+   *     order.
+   * @param drive The drivetrain model.
+   * @param options The constraints and solver settings.
+   * @return The optimized trajectory, or an empty optional if the solver failed
+   *     to find one.
+   * @throws std::invalid_argument if options.numSamples is less than 2 or not
+   *     greater than the number of interior waypoints.
+   */
+  static std::optional<Trajectory> OptimizeDifferential(
+      const Trajectory& initialGuess,
+      std::span<const Translation2d> interiorWaypoints,
+      const DifferentialDrive& drive, const Options& options);
+
+  /**
+   * Optimizes a swerve drive trajectory.
+   *
+   * The robot heading isn't part of the optimization, so the drivetrain is
+   * modeled as if it doesn't rotate. As for a trajectory from
+   * TrajectoryGenerator, the rotation of each pose of the returned trajectory
+   * is the direction of travel, and the robot heading is left to the holonomic
+   * controller. The states are evenly spaced in time.
+   *
+   * @param initialGuess The trajectory to start from.
+   * @param interiorWaypoints Translations the robot must pass through, in
+   *     order.
+   * @param drive The drivetrain model.
+   * @param options The constraints and solver settings.
+   * @return The optimized trajectory, or an empty optional if the solver failed
+   *     to find one.
+   * @throws std::invalid_argument if options.numSamples is less than 2 or not
+   *     greater than the number of interior waypoints.
+   */
+  static std::optional<Trajectory> OptimizeSwerve(
+      const Trajectory& initialGuess,
+      std::span<const Translation2d> interiorWaypoints,
+      const SwerveDrive& drive, const Options& options);
+};
+
+}  // namespace frc
@@ -474,3 +474,36 @@ TEST(DARETest, QDecomposition) {
   auto ret2 = frc::DARE<2, 2>(A, B, Q_2, R);
   EXPECT_FALSE(ret2);
 }
+
+TEST(DARETest, WarmStart) {
+  frc::Matrixd<2, 2> A{{1, 1}, {0, 1}};
+  frc::Matrixd<2, 1> B{{0}, {1}};
+  frc::Matrixd<2, 2> Q{{1, 0}, {0, 0}};
+  frc::Matrixd<1, 1> R{{0.3}};
+  auto R_llt = R.llt();
+
+  // Seed from the solution of a nearby system
+  frc::Matrixd<2, 2> A_0{{1, 0.9}, {0, 1}};
+  frc::Matrixd<2, 2> X_0 = frc::detail::DARE<2, 1>(A_0, B, Q, R_llt);
+
+  auto X = frc::detail::DARE<2, 1>(A, B, Q, R_llt, X_0);
+  ExpectMatrixEqual(X, X.transpose(), 1e-10);
+  ExpectPositiveSemidefinite(X);
+  ExpectDARESolution(A, B, Q, R, X);
+  ExpectMatrixEqual(X, frc::detail::DARE<2, 1>(A, B, Q, R_llt), 1e-8);
+}
+
+TEST(DARETest, WarmStartNotStabilizing) {
+  frc::Matrixd<2, 2> A{{1, 1}, {0, 1}};
+  frc::Matrixd<2, 1> B{{0}, {1}};
+  frc::Matrixd<2, 2> Q{{1, 0}, {0, 0}};
+  frc::Matrixd<1, 1> R{{0.3}};
+  auto R_llt = R.llt();
+
+  // X₀ = 0 gives K = 0, which doesn't stabilize A, so this must fall back to
+  // solving from scratch
+  auto X = frc::detail::DARE<2, 1>(A, B, Q, R_llt,
+                                   frc::Matrixd<2, 2>::Zero().eval());
+  ExpectPositiveSemidefinite(X);
+  ExpectDARESolution(A, B, Q, R, X);
+}
@@ -0,0 +1,130 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/controller/LTVGainTable.h"
+#include "frc/controller/LTVUnicycleController.h"
+#include "frc/system/Discretization.h"
+
+namespace {
+
+frc::detail::LTVGainTable<2, 1> MakeTable(
+    const frc::LTVGainTableOptions& options, double param = 1.0) {
+  // Double integrator with a velocity-dependent damping term
+  auto model = [](units::meters_per_second_t velocity,
+                  frc::Matrixd<2, 2>* discA, frc::Matrixd<2, 1>* discB) {
+    frc::Matrixd<2, 2> A{{0.0, 1.0}, {0.0, -0.1 * velocity.value()}};
+    frc::Matrixd<2, 1> B{{0.0}, {1.0}};
+    frc::DiscretizeAB(A, B, 20_ms, discA, discB);
+  };
+  return {model,
+          frc::Matrixd<2, 2>{{1.0, 0.0}, {0.0, 1.0}},
+          frc::Matrixd<1, 1>{{1.0}},
+          3_mps,
+          {param},
+          options};
+}
+
+frc::LTVGainTableOptions CacheOptions(std::string path) {
+  frc::LTVGainTableOptions options;
+  options.cachePath = std::move(path);
+  return options;
+}
+
+std::string TempPath(std::string_view name) {
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove(path);
+  return path.string();
+}
+
+}  // namespace
+
+TEST(LTVGainTableTest, ParallelMatchesSerial) {
+  auto serial = MakeTable({});
+  frc::LTVGainTableOptions options;
+  options.numThreads = 4;
+  auto parallel = MakeTable(options);
+
+  for (auto velocity = -3_mps; velocity < 3_mps; velocity += 0.137_mps) {
+    EXPECT_TRUE(serial[velocity].isApprox(parallel[velocity], 1e-8));
+  }
+}
+
+TEST(LTVGainTableTest, CacheRoundTrip) {
+  auto path = TempPath("LTVGainTableTest_CacheRoundTrip.bin");
+
+  auto computed = MakeTable(CacheOptions(path));
+  ASSERT_TRUE(std::filesystem::exists(path));
+
+  auto loaded = MakeTable(CacheOptions(path));
+  for (auto velocity = -3_mps; velocity < 3_mps; velocity += 0.137_mps) {
+    EXPECT_EQ(computed[velocity], loaded[velocity]);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(LTVGainTableTest, CacheParameterMismatch) {
+  auto path = TempPath("LTVGainTableTest_CacheParameterMismatch.bin");
+
+  MakeTable(CacheOptions(path), 1.0);
+
+  // Different parameters must not use the cached gains
+  auto table = MakeTable(CacheOptions(path), 2.0);
+  auto reference = MakeTable({}, 2.0);
+  EXPECT_EQ(table[1_mps], reference[1_mps]);
+
+  // The file is rewritten with the new parameters
+  std::vector<double> velocities;
+  std::vector<double> gains;
+  double param = 2.0;
+  EXPECT_TRUE(frc::detail::LoadLTVGainTable(path, {&param, 1}, 1, 2,
+                                            &velocities, &gains));
+
+  std::filesystem::remove(path);
+}
+
+TEST(LTVGainTableTest, CorruptCacheRebuiltOnConstruction) {
+  auto path = TempPath("LTVGainTableTest_CorruptCacheRebuiltOnConstruction.bin");
+  std::ofstream{path, std::ios::binary} << "LTVG garbage";
+
+  auto table = MakeTable(CacheOptions(path));
+
+  // The file is rewritten by the constructor, before the table is used
+  std::vector<double> velocities;
+  std::vector<double> gains;
+  double param = 1.0;
+  EXPECT_TRUE(frc::detail::LoadLTVGainTable(path, {&param, 1}, 1, 2,
+                                            &velocities, &gains));
+  EXPECT_EQ(MakeTable({})[1_mps], table[1_mps]);
+
+  std::filesystem::remove(path);
+}
+
+TEST(LTVGainTableTest, UnicycleControllerCache) {
+  auto path = TempPath("LTVGainTableTest_UnicycleControllerCache.bin");
+
+  frc::LTVUnicycleController computed{
+      {0.0625, 0.125, 2.0}, {1.0, 2.0}, 20_ms, 9_mps, CacheOptions(path)};
+  frc::LTVUnicycleController loaded{
+      {0.0625, 0.125, 2.0}, {1.0, 2.0}, 20_ms, 9_mps, CacheOptions(path)};
+  frc::LTVUnicycleController reference{
+      {0.0625, 0.125, 2.0}, {1.0, 2.0}, 20_ms, 9_mps};
+
+  frc::Pose2d pose{1_m, 2_m, 0.1_rad};
+  frc::Pose2d poseRef{1.1_m, 1.9_m, 0.2_rad};
+  auto expected = reference.Calculate(pose, poseRef, 2.345_mps, 0.5_rad_per_s);
+  auto actual = loaded.Calculate(pose, poseRef, 2.345_mps, 0.5_rad_per_s);
+  EXPECT_DOUBLE_EQ(expected.vx.value(), actual.vx.value());
+  EXPECT_DOUBLE_EQ(expected.omega.value(), actual.omega.value());
+
+  std::filesystem::remove(path);
+}
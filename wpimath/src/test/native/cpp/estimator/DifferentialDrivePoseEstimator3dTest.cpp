@@ -2,6 +2,7 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
 #include <limits>
 #include <random>
 #include <tuple>
@@ -285,6 +286,72 @@ TEST(DifferentialDrivePoseEstimator3dTest, SimultaneousVisionMeasurements) {
   }
 }
 
+TEST(DifferentialDrivePoseEstimator3dTest, BatchVisionMeasurements) {
+  // A batch of vision measurements should give the same result as adding them
+  // one at a time in timestamp order
+  frc::DifferentialDriveKinematics kinematics{1_m};
+  frc::DifferentialDrivePoseEstimator3d sequential{
+      kinematics,           frc::Rotation3d{},   0_m, 0_m, frc::Pose3d{},
+      {0.1, 0.1, 0.1, 0.1}, {0.5, 0.5, 0.5, 0.5}};
+  frc::DifferentialDrivePoseEstimator3d batched{
+      kinematics,           frc::Rotation3d{},   0_m, 0_m, frc::Pose3d{},
+      {0.1, 0.1, 0.1, 0.1}, {0.5, 0.5, 0.5, 0.5}};
+
+  using VisionMeasurement =
+      frc::DifferentialDrivePoseEstimator3d::VisionMeasurement;
+  for (int loop = 0; loop < 20; ++loop) {
+    units::second_t time = loop * 20_ms;
+    frc::Rotation3d gyroAngle{0_rad, 0_rad, units::radian_t{0.01 * loop}};
+    units::meter_t distance = loop * 0.02_m;
+    sequential.UpdateWithTime(time, gyroAngle, distance, 1.1 * distance);
+    batched.UpdateWithTime(time, gyroAngle, distance, 1.1 * distance);
+
+    // Measurements from several cameras, with different latencies and out of
+    // order
+    std::vector<VisionMeasurement> measurements{
+        {frc::Pose3d{distance + 0.1_m, 0.05_m, 0.01_m, gyroAngle},
+         time - 30_ms,
+         {}},
+        {frc::Pose3d{distance - 0.1_m, -0.05_m, 0_m, gyroAngle}, time - 50_ms,
+         wpi::array{1.0, 1.0, 1.0, 1.0}},
+        {frc::Pose3d{distance, 0.1_m, 0_m, frc::Rotation3d{}}, time - 10_ms,
+         {}},
+        {frc::Pose3d{distance, -0.1_m, 0_m, gyroAngle}, time - 30_ms, {}},
+        // Too old to be used
+        {frc::Pose3d{5_m, 5_m, 0_m, frc::Rotation3d{}}, time - 5_s, {}}};
+
+    std::vector<VisionMeasurement> sorted = measurements;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto& a, const auto& b) {
+                       return a.timestamp < b.timestamp;
+                     });
+    for (const auto& measurement : sorted) {
+      if (measurement.visionMeasurementStdDevs) {
+        sequential.AddVisionMeasurement(measurement.visionRobotPose,
+                                        measurement.timestamp,
+                                        *measurement.visionMeasurementStdDevs);
+        sequential.SetVisionMeasurementStdDevs({0.5, 0.5, 0.5, 0.5});
+      } else {
+        sequential.AddVisionMeasurement(measurement.visionRobotPose,
+                                        measurement.timestamp);
+      }
+    }
+    batched.AddVisionMeasurements(measurements);
+
+    auto expected = sequential.GetEstimatedPosition();
+    auto actual = batched.GetEstimatedPosition();
+    EXPECT_NEAR(expected.X().value(), actual.X().value(), 1e-9);
+    EXPECT_NEAR(expected.Y().value(), actual.Y().value(), 1e-9);
+    EXPECT_NEAR(expected.Z().value(), actual.Z().value(), 1e-9);
+    EXPECT_NEAR(expected.Rotation().X().value(),
+                actual.Rotation().X().value(), 1e-9);
+    EXPECT_NEAR(expected.Rotation().Y().value(),
+                actual.Rotation().Y().value(), 1e-9);
+    EXPECT_NEAR(expected.Rotation().Z().value(),
+                actual.Rotation().Z().value(), 1e-9);
+  }
+}
+
 TEST(DifferentialDrivePoseEstimator3dTest, TestDiscardStaleVisionMeasurements) {
   frc::DifferentialDriveKinematics kinematics{1_m};
 
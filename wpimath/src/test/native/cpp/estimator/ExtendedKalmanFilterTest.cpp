@@ -11,6 +11,7 @@
 #include "frc/EigenCore.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/system/NumericalIntegration.h"
 #include "frc/system/NumericalJacobian.h"
 #include "frc/system/plant/DCMotor.h"
 #include "frc/trajectory/TrajectoryGenerator.h"
@@ -49,6 +50,33 @@ frc::Vectord<5> Dynamics(const frc::Vectord<5>& x, const frc::Vectord<2>& u) {
           k1.value() * ((C1 * vr).value() + (C2 * Vr).value())};
 }
 
+frc::Matrixd<5, 5> DynamicsJacobian(
+    const frc::Vectord<5>& x, [[maybe_unused]] const frc::Vectord<2>& u) {
+  auto motors = frc::DCMotor::CIM(2);
+
+  constexpr double Ghigh = 7.08;       // High gear ratio
+  constexpr auto rb = 0.8382_m / 2.0;  // Robot radius
+  constexpr auto r = 0.0746125_m;      // Wheel radius
+  constexpr auto m = 63.503_kg;        // Robot mass
+  constexpr auto J = 5.6_kg_sq_m;      // Robot moment of inertia
+
+  double C1 = (-std::pow(Ghigh, 2) * motors.Kt /
+               (motors.Kv * motors.R * units::math::pow<2>(r)))
+                  .value();
+  double k1 = (1 / m + units::math::pow<2>(rb) / J).value();
+  double k2 = (1 / m - units::math::pow<2>(rb) / J).value();
+
+  double v = 0.5 * (x(3) + x(4));
+  double c = std::cos(x(2));
+  double s = std::sin(x(2));
+  double w = 1.0 / (2.0 * rb.value());
+  return frc::Matrixd<5, 5>{{0.0, 0.0, -v * s, 0.5 * c, 0.5 * c},
+                            {0.0, 0.0, v * c, 0.5 * s, 0.5 * s},
+                            {0.0, 0.0, 0.0, -w, w},
+                            {0.0, 0.0, 0.0, k1 * C1, k2 * C1},
+                            {0.0, 0.0, 0.0, k2 * C1, k1 * C1}};
+}
+
 frc::Vectord<3> LocalMeasurementModel(
     const frc::Vectord<5>& x, [[maybe_unused]] const frc::Vectord<2>& u) {
   return frc::Vectord<3>{x(2), x(3), x(4)};
@@ -146,3 +174,46 @@ TEST(ExtendedKalmanFilterTest, Convergence) {
   ASSERT_NEAR(0.0, observer.Xhat(3), 1.0);
   ASSERT_NEAR(0.0, observer.Xhat(4), 1.0);
 }
+
+TEST(ExtendedKalmanFilterTest, AnalyticJacobians) {
+  constexpr units::second_t dt = 5_ms;
+
+  frc::ExtendedKalmanFilter<5, 2, 3> numerical{Dynamics,
+                                               LocalMeasurementModel,
+                                               {0.5, 0.5, 10.0, 1.0, 1.0},
+                                               {0.0001, 0.5, 0.5},
+                                               dt};
+  frc::ExtendedKalmanFilter<5, 2, 3> analytic{Dynamics,
+                                              LocalMeasurementModel,
+                                              {0.5, 0.5, 10.0, 1.0, 1.0},
+                                              {0.0001, 0.5, 0.5},
+                                              dt};
+  analytic.SetStateJacobian(DynamicsJacobian);
+  analytic.SetMeasurementJacobian(
+      [](const frc::Vectord<5>&, const frc::Vectord<2>&) {
+        return frc::Matrixd<3, 5>{{0.0, 0.0, 1.0, 0.0, 0.0},
+                                  {0.0, 0.0, 0.0, 1.0, 0.0},
+                                  {0.0, 0.0, 0.0, 0.0, 1.0}};
+      });
+
+  frc::Vectord<5> x{1.0, 2.0, 0.5, 0.0, 0.0};
+  numerical.SetXhat(x);
+  analytic.SetXhat(x);
+
+  for (int i = 0; i < 200; ++i) {
+    frc::Vectord<2> u{6.0 + 0.01 * i, 8.0 - 0.01 * i};
+
+    numerical.Predict(u, dt);
+    analytic.Predict(u, dt);
+    x = frc::RK4(Dynamics, x, u, dt);
+
+    auto y = LocalMeasurementModel(x, u) + frc::Vectord<3>{0.001, -0.1, 0.1};
+    numerical.Correct(u, y);
+    analytic.Correct(u, y);
+  }
+
+  // The numerical Jacobians are only accurate to about the square root of
+  // machine epsilon, so the estimates can't be expected to match any closer
+  EXPECT_TRUE(analytic.Xhat().isApprox(numerical.Xhat(), 1e-4));
+  EXPECT_TRUE(analytic.P().isApprox(numerical.P(), 1e-4));
+}
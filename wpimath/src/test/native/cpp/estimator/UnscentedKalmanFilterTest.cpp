@@ -306,4 +306,40 @@ TEST(UnscentedKalmanFilterTest, MotorConvergence) {
   EXPECT_NEAR(true_kA, observer.Xhat(3), true_kA * 0.5);
 }
 
+TEST(UnscentedKalmanFilterTest, UnlinearizedProcessNoise) {
+  constexpr units::second_t dt = 4_ms;
+  constexpr int steps = 1000;
+  constexpr double true_kV = 3;
+  constexpr double true_kA = 0.2;
+
+  frc::UnscentedKalmanFilter<4, 1, 3> linearized{
+      MotorDynamics, MotorMeasurementModel, wpi::array{0.1, 1.0, 1e-10, 1e-10},
+      wpi::array{0.02, 0.1, 0.1}, dt};
+  frc::UnscentedKalmanFilter<4, 1, 3> unlinearized{
+      MotorDynamics, MotorMeasurementModel, wpi::array{0.1, 1.0, 1e-10, 1e-10},
+      wpi::array{0.02, 0.1, 0.1}, dt};
+  unlinearized.SetLinearizedProcessNoise(false);
+
+  frc::Vectord<4> P0{0.001, 0.001, 10, 10};
+  for (auto observer : {&linearized, &unlinearized}) {
+    observer->SetXhat(frc::Vectord<4>{0.0, 0.0, 2.0, 2.0});
+    observer->SetP(P0.asDiagonal());
+  }
+
+  frc::Vectord<4> x{0.0, 0.0, true_kV, true_kA};
+  for (int i = 0; i < steps; ++i) {
+    auto u = MotorControlInput(i * dt.value());
+    x = frc::RK4(MotorDynamics, x, u, dt);
+    auto y = MotorMeasurementModel(x, u);
+    for (auto observer : {&linearized, &unlinearized}) {
+      observer->Predict(u, dt);
+      observer->Correct(u, y);
+    }
+  }
+
+  EXPECT_NEAR(true_kV, unlinearized.Xhat(2), true_kV * 0.5);
+  EXPECT_NEAR(true_kA, unlinearized.Xhat(3), true_kA * 0.5);
+  EXPECT_TRUE(unlinearized.Xhat().isApprox(linearized.Xhat(), 1e-2));
+}
+
 }  // namespace
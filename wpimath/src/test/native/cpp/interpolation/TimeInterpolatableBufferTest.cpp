@@ -2,6 +2,7 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
 #include <cmath>
 
 #include <gtest/gtest.h>
@@ -59,3 +60,72 @@ TEST(TimeInterpolatableBufferTest, Pose2d) {
   EXPECT_TRUE(std::abs(sample.Y().value() - (1.0 / std::sqrt(2.0))) < 0.01);
   EXPECT_TRUE(std::abs(sample.Rotation().Degrees().value() - 45.0) < 0.01);
 }
+
+TEST(TimeInterpolatableBufferTest, Pruning) {
+  frc::TimeInterpolatableBuffer<double> buffer{1_s};
+
+  // Add enough samples for the oldest ones to be pruned several times over
+  for (int i = 0; i <= 1000; ++i) {
+    buffer.AddSample(i * 10_ms, i);
+  }
+
+  auto samples = buffer.GetInternalBuffer();
+  ASSERT_EQ(101u, samples.size());
+  EXPECT_DOUBLE_EQ(9.0, samples.front().first.value());
+  EXPECT_DOUBLE_EQ(10.0, samples.back().first.value());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    EXPECT_DOUBLE_EQ(900.0 + i, samples[i].second);
+  }
+
+  EXPECT_DOUBLE_EQ(900.0, buffer.Sample(0_s).value());
+  EXPECT_DOUBLE_EQ(950.5, buffer.Sample(9.505_s).value());
+  EXPECT_DOUBLE_EQ(1000.0, buffer.Sample(11_s).value());
+}
+
+TEST(TimeInterpolatableBufferTest, OutOfOrderAfterWrap) {
+  frc::TimeInterpolatableBuffer<double> buffer{1_s};
+
+  // Wrap around the internal storage, then insert older samples
+  for (int i = 0; i < 150; ++i) {
+    buffer.AddSample(i * 10_ms, i);
+  }
+  buffer.AddSample(0.995_s, 99.5);
+  buffer.AddSample(1.465_s, 146.5);
+  buffer.AddSample(0.8_s, -1.0);
+
+  auto samples = buffer.GetInternalBuffer();
+  EXPECT_TRUE(std::is_sorted(
+      samples.begin(), samples.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; }));
+  EXPECT_DOUBLE_EQ(-1.0, buffer.Sample(0.8_s).value());
+  EXPECT_DOUBLE_EQ(99.5, buffer.Sample(0.995_s).value());
+  EXPECT_DOUBLE_EQ(146.5, buffer.Sample(1.465_s).value());
+  EXPECT_DOUBLE_EQ(100.0, buffer.Sample(1_s).value());
+
+  buffer.Clear();
+  EXPECT_TRUE(buffer.GetInternalBuffer().empty());
+  EXPECT_FALSE(buffer.Sample(1_s));
+}
+
+TEST(TimeInterpolatableBufferTest, NonDefaultConstructible) {
+  struct Value {
+    explicit Value(double value) : x{value} {}
+    double x;
+  };
+  frc::TimeInterpolatableBuffer<Value> buffer{
+      10_s, [](const Value& start, const Value& end, double t) {
+        return Value{start.x + (end.x - start.x) * t};
+      }};
+
+  // Grow the internal storage several times
+  for (int i = 0; i < 100; ++i) {
+    buffer.AddSample(i * 10_ms, Value{static_cast<double>(i)});
+  }
+  buffer.AddSample(0.505_s, Value{-1.0});
+
+  EXPECT_EQ(101u, buffer.GetInternalBuffer().size());
+  EXPECT_DOUBLE_EQ(0.0, buffer.Sample(0_s).value().x);
+  EXPECT_DOUBLE_EQ(-1.0, buffer.Sample(0.505_s).value().x);
+  EXPECT_DOUBLE_EQ(99.0, buffer.Sample(1_s).value().x);
+  EXPECT_DOUBLE_EQ(2.5, buffer.Sample(25_ms).value().x);
+}
@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <numbers>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -309,3 +310,56 @@ TEST_F(SwerveDriveKinematicsTest, DesaturateNegativeSpeed) {
   EXPECT_NEAR(arr[2].speed.value(), -1.0, kEpsilon);
   EXPECT_NEAR(arr[3].speed.value(), -1.0, kEpsilon);
 }
+
+TEST_F(SwerveDriveKinematicsTest, BatchInverseKinematicsMatchesSingle) {
+  std::vector<ChassisSpeeds> speeds{{5_mps, 0_mps, 0_rad_per_s},
+                                    {0_mps, 0_mps, 0_rad_per_s},
+                                    {1_mps, 3_mps, 1.5_rad_per_s},
+                                    {0_mps, 0_mps, 2_rad_per_s},
+                                    {-2_mps, 1_mps, -0.5_rad_per_s}};
+  Translation2d centerOfRotation{12_m, 12_m};
+
+  SwerveDriveKinematics<4> single{m_fl, m_fr, m_bl, m_br};
+  auto batch = m_kinematics.ToSwerveModuleStates(speeds, centerOfRotation);
+
+  ASSERT_EQ(speeds.size(), batch.size());
+  for (size_t j = 0; j < speeds.size(); ++j) {
+    auto expected = single.ToSwerveModuleStates(speeds[j], centerOfRotation);
+    for (size_t i = 0; i < 4; ++i) {
+      EXPECT_NEAR(expected[i].speed.value(), batch[j][i].speed.value(), 1e-9);
+      EXPECT_NEAR(expected[i].angle.Radians().value(),
+                  batch[j][i].angle.Radians().value(), 1e-9);
+    }
+  }
+
+  // The module angles of the last chassis speeds are kept, as with the single
+  // chassis speeds version
+  auto expected = single.ToSwerveModuleStates(ChassisSpeeds{});
+  auto actual = m_kinematics.ToSwerveModuleStates(ChassisSpeeds{});
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_NEAR(expected[i].angle.Radians().value(),
+                actual[i].angle.Radians().value(), 1e-9);
+  }
+}
+
+TEST_F(SwerveDriveKinematicsTest, BatchForwardKinematicsMatchesSingle) {
+  std::vector<wpi::array<SwerveModuleState, 4>> states{
+      {SwerveModuleState{5_mps, 0_deg}, SwerveModuleState{5_mps, 0_deg},
+       SwerveModuleState{5_mps, 0_deg}, SwerveModuleState{5_mps, 0_deg}},
+      {SwerveModuleState{106.629_mps, 135_deg},
+       SwerveModuleState{106.629_mps, 45_deg},
+       SwerveModuleState{106.629_mps, -135_deg},
+       SwerveModuleState{106.629_mps, -45_deg}},
+      {SwerveModuleState{1_mps, 10_deg}, SwerveModuleState{2_mps, 20_deg},
+       SwerveModuleState{3_mps, 30_deg}, SwerveModuleState{4_mps, 40_deg}}};
+
+  auto batch = m_kinematics.ToChassisSpeeds(states);
+
+  ASSERT_EQ(states.size(), batch.size());
+  for (size_t j = 0; j < states.size(); ++j) {
+    auto expected = m_kinematics.ToChassisSpeeds(states[j]);
+    EXPECT_NEAR(expected.vx.value(), batch[j].vx.value(), 1e-9);
+    EXPECT_NEAR(expected.vy.value(), batch[j].vy.value(), 1e-9);
+    EXPECT_NEAR(expected.omega.value(), batch[j].omega.value(), 1e-9);
+  }
+}
@@ -2,7 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <span>
 #include <vector>
 
@@ -142,3 +144,89 @@ TEST(TravelingSalesmanTest, TenLengthDynamicPathWithDistanceCost) {
 
   EXPECT_TRUE(IsMatchingCycle(expected, solution));
 }
+
+TEST(TravelingSalesmanTest, TenLengthCostMatrixPathWithDistanceCost) {
+  // ....6.3..1.2.......
+  // ..4................
+  // .............9.....
+  // .0.................
+  // .....7..5...8......
+  // ...................
+  wpi::array<frc::Pose2d, 10> poses{
+      frc::Pose2d{2_m, 4_m, 0_rad},  frc::Pose2d{10_m, 1_m, 0_rad},
+      frc::Pose2d{12_m, 1_m, 0_rad}, frc::Pose2d{7_m, 1_m, 0_rad},
+      frc::Pose2d{3_m, 2_m, 0_rad},  frc::Pose2d{9_m, 5_m, 0_rad},
+      frc::Pose2d{5_m, 1_m, 0_rad},  frc::Pose2d{6_m, 5_m, 0_rad},
+      frc::Pose2d{13_m, 5_m, 0_rad}, frc::Pose2d{14_m, 3_m, 0_rad}};
+
+  frc::TravelingSalesman traveler;
+  std::vector<frc::Pose2d> solution =
+      traveler.Solve(std::span<const frc::Pose2d>{poses}, 500, 4, 2, 1);
+
+  ASSERT_EQ(10u, solution.size());
+  EXPECT_EQ(poses[0], solution[0]);
+  wpi::array<frc::Pose2d, 10> expected{poses[0], poses[4], poses[6], poses[3],
+                                       poses[1], poses[2], poses[9], poses[8],
+                                       poses[5], poses[7]};
+
+  EXPECT_TRUE(IsMatchingCycle(expected, solution));
+}
+
+TEST(TravelingSalesmanTest, CostMatrixPathWithAsymmetricCost) {
+  wpi::array<frc::Pose2d, 8> poses{
+      frc::Pose2d{2_m, 4_m, 0_rad},  frc::Pose2d{10_m, 1_m, 0_rad},
+      frc::Pose2d{12_m, 1_m, 0_rad}, frc::Pose2d{7_m, 1_m, 0_rad},
+      frc::Pose2d{3_m, 2_m, 0_rad},  frc::Pose2d{9_m, 5_m, 0_rad},
+      frc::Pose2d{5_m, 1_m, 0_rad},  frc::Pose2d{6_m, 5_m, 0_rad}};
+
+  // Moving left costs more than moving right, so the direction matters
+  auto cost = [](frc::Pose2d a, frc::Pose2d b) {
+    double distance = a.Translation().Distance(b.Translation()).value();
+    return b.X() < a.X() ? 1.5 * distance : distance;
+  };
+  auto pathCost = [&](std::span<const frc::Pose2d> path) {
+    double sum = 0.0;
+    for (size_t i = 0; i < path.size(); ++i) {
+      sum += cost(path[i], path[(i + 1) % path.size()]);
+    }
+    return sum;
+  };
+
+  // Find the optimal cost by brute force over the orders of poses 1 to 7
+  wpi::array<int, 8> order{0, 1, 2, 3, 4, 5, 6, 7};
+  double optimalCost = std::numeric_limits<double>::infinity();
+  do {
+    std::vector<frc::Pose2d> path;
+    for (int index : order) {
+      path.emplace_back(poses[index]);
+    }
+    optimalCost = std::min(optimalCost, pathCost(path));
+  } while (std::next_permutation(order.begin() + 1, order.end()));
+
+  frc::TravelingSalesman traveler{cost};
+  std::vector<frc::Pose2d> solution =
+      traveler.Solve(std::span<const frc::Pose2d>{poses}, 2000, 8, 2, 1);
+
+  ASSERT_EQ(8u, solution.size());
+  EXPECT_EQ(poses[0], solution[0]);
+  for (const auto& pose : poses) {
+    EXPECT_EQ(1, std::count(solution.begin(), solution.end(), pose));
+  }
+  EXPECT_NEAR(optimalCost, pathCost(solution), 1e-9);
+}
+
+TEST(TravelingSalesmanTest, CostMatrixPathIsDeterministic) {
+  std::vector<frc::Pose2d> poses;
+  for (int i = 0; i < 30; ++i) {
+    poses.emplace_back(units::meter_t{(i * 7) % 11 * 1.0},
+                       units::meter_t{i % 5 * 1.0}, 0_rad);
+  }
+
+  frc::TravelingSalesman traveler;
+  auto solution = traveler.Solve(poses, 200, 6, 1, 42);
+
+  // The same seed gives the same path, however the restarts are split
+  EXPECT_EQ(solution, traveler.Solve(poses, 200, 6, 1, 42));
+  EXPECT_EQ(solution, traveler.Solve(poses, 200, 6, 3, 42));
+  EXPECT_EQ(solution, traveler.Solve(poses, 200, 6, 6, 42));
+}
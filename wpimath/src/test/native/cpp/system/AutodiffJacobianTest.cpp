@@ -0,0 +1,66 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "frc/system/AutodiffJacobian.h"
+
+namespace {
+
+frc::Matrixd<4, 4> A{{1, 2, 4, 1}, {5, 2, 3, 4}, {5, 1, 3, 2}, {1, 1, 3, 7}};
+frc::Matrixd<4, 2> B{{1, 1}, {2, 1}, {3, 2}, {3, 7}};
+
+// Unicycle model with x = [x, y, heading, velocity]ᵀ and
+// u = [acceleration, angular velocity]ᵀ
+template <typename Vector>
+Vector Unicycle(const Vector& x, const Vector& u) {
+  using std::cos;
+  using std::sin;
+  using slp::cos;
+  using slp::sin;
+
+  Vector xdot{4};
+  xdot[0] = x[3] * cos(x[2]);
+  xdot[1] = x[3] * sin(x[2]);
+  xdot[2] = u[1];
+  xdot[3] = u[0] - 0.1 * x[3] * x[3];
+  return xdot;
+}
+
+}  // namespace
+
+// Test that we can recover A from Ax + Bu exactly
+TEST(AutodiffJacobianTest, Ax) {
+  frc::AutodiffJacobian<4, 4, 2> jacobian{
+      [](const slp::VariableMatrix& x, const slp::VariableMatrix& u) {
+        return slp::VariableMatrix{A * x + B * u};
+      }};
+
+  EXPECT_EQ(A, jacobian(frc::Vectord<4>::Zero(), frc::Vectord<2>::Zero()));
+  EXPECT_EQ(A, jacobian(frc::Vectord<4>{1, 2, 3, 4}, frc::Vectord<2>{5, 6}));
+}
+
+// Test that the Jacobian of a nonlinear function matches the closed-form one
+// at every point it's reevaluated at
+TEST(AutodiffJacobianTest, Nonlinear) {
+  frc::AutodiffJacobian<4, 4, 2> jacobian{
+      [](const slp::VariableMatrix& x, const slp::VariableMatrix& u) {
+        return Unicycle(x, u);
+      }};
+
+  for (double heading : {0.0, 0.5, 2.0, -3.0}) {
+    frc::Vectord<4> x{1.0, 2.0, heading, 1.5};
+    frc::Vectord<2> u{0.5, -1.0};
+
+    double v = x(3);
+    frc::Matrixd<4, 4> expected{
+        {0.0, 0.0, -v * std::sin(heading), std::cos(heading)},
+        {0.0, 0.0, v * std::cos(heading), std::sin(heading)},
+        {0.0, 0.0, 0.0, 0.0},
+        {0.0, 0.0, 0.0, -0.2 * v}};
+    EXPECT_TRUE(jacobian(x, u).isApprox(expected, 1e-12));
+  }
+}
@@ -55,3 +55,49 @@ TEST(TrajectoryGenerationTest, CurvatureOptimization) {
     EXPECT_NE(0, t.States()[i].curvature.value());
   }
 }
+
+TEST(TrajectoryGenerationTest, WorkspaceMatchesDefault) {
+  // Serpentine across the field
+  std::vector<Pose2d> waypoints;
+  for (int i = 0; i < 24; ++i) {
+    waypoints.emplace_back(units::meter_t{i * 0.6}, (i % 2 == 0) ? 0_m : 1_m,
+                           (i % 2 == 0) ? 45_deg : -45_deg);
+  }
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  config.AddConstraint(CentripetalAccelerationConstraint{8_fps_sq});
+
+  auto expected = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+
+  TrajectoryGenerator::Workspace workspace{4};
+  for (int i = 0; i < 2; ++i) {
+    auto trajectory =
+        TrajectoryGenerator::GenerateTrajectory(waypoints, config, workspace);
+    EXPECT_EQ(expected, trajectory);
+  }
+
+  // Reusing the workspace for a shorter trajectory
+  std::vector<Pose2d> shortWaypoints{waypoints.begin(), waypoints.begin() + 3};
+  EXPECT_EQ(TrajectoryGenerator::GenerateTrajectory(shortWaypoints, config),
+            TrajectoryGenerator::GenerateTrajectory(shortWaypoints, config,
+                                                    workspace));
+
+  config.SetReversed(true);
+  EXPECT_EQ(TrajectoryGenerator::GenerateTrajectory(waypoints, config),
+            TrajectoryGenerator::GenerateTrajectory(waypoints, config,
+                                                    workspace));
+}
+
+TEST(TrajectoryGenerationTest, WorkspaceReturnsEmptyOnMalformed) {
+  std::vector<Pose2d> waypoints;
+  for (int i = 0; i < 16; ++i) {
+    waypoints.emplace_back(units::meter_t{i * 1.0}, 0_m, 0_deg);
+  }
+  waypoints.emplace_back(waypoints.back().X() + 1_m, 0_m, 180_deg);
+
+  TrajectoryGenerator::Workspace workspace{4};
+  const auto t = TrajectoryGenerator::GenerateTrajectory(
+      waypoints, TrajectoryConfig(12_fps, 12_fps_sq), workspace);
+
+  ASSERT_EQ(t.States().size(), 1u);
+  ASSERT_EQ(t.TotalTime(), 0_s);
+}
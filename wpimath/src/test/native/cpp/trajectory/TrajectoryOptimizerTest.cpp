@@ -0,0 +1,129 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/TrajectoryOptimizer.h"
+
+using namespace frc;
+
+namespace {
+
+constexpr TrajectoryOptimizer::DifferentialDrive kDifferentialDrive{
+    DCMotor::NEO(2), 8.0, 3_in, 0.6_m, 50_kg, 5_kg_sq_m};
+
+constexpr TrajectoryOptimizer::SwerveDrive kSwerveDrive{
+    DCMotor::NEO(1), 6.75, 2_in, 4, 50_kg};
+
+}  // namespace
+
+TEST(TrajectoryOptimizerTest, DifferentialStraightLine) {
+  auto guess = TrajectoryGenerator::GenerateTrajectory(
+      Pose2d{}, {}, Pose2d{4_m, 0_m, 0_deg}, TrajectoryConfig{1_mps, 1_mps_sq});
+
+  TrajectoryOptimizer::Options options;
+  options.numSamples = 30;
+  options.maxCurrent = 60_A;
+  auto trajectory = TrajectoryOptimizer::OptimizeDifferential(
+      guess, {}, kDifferentialDrive, options);
+  ASSERT_TRUE(trajectory);
+
+  EXPECT_LT(trajectory->TotalTime(), guess.TotalTime());
+  const auto& states = trajectory->States();
+  ASSERT_EQ(states.size(), 31u);
+  EXPECT_EQ(states.front().pose, Pose2d{});
+  EXPECT_NEAR(states.back().pose.X().value(), 4.0, 1e-6);
+  EXPECT_NEAR(states.back().pose.Y().value(), 0.0, 1e-6);
+  EXPECT_NEAR(states.back().velocity.value(), 0.0, 1e-6);
+}
+
+TEST(TrajectoryOptimizerTest, DifferentialObstacleAndWaypoint) {
+  const std::vector<Translation2d> waypoints{{2_m, 1_m}};
+  auto guess = TrajectoryGenerator::GenerateTrajectory(
+      Pose2d{}, waypoints, Pose2d{4_m, 0_m, 0_deg},
+      TrajectoryConfig{1_mps, 1_mps_sq});
+
+  TrajectoryOptimizer::Options options;
+  options.numSamples = 40;
+  options.obstacles.push_back({{2_m, 0_m}, 0.5_m});
+  options.robotRadius = 0.2_m;
+  auto trajectory = TrajectoryOptimizer::OptimizeDifferential(
+      guess, waypoints, kDifferentialDrive, options);
+  ASSERT_TRUE(trajectory);
+
+  EXPECT_LT(trajectory->TotalTime(), guess.TotalTime());
+  bool reachedWaypoint = false;
+  for (const auto& state : trajectory->States()) {
+    EXPECT_GE(state.pose.Translation().Distance({2_m, 0_m}).value(),
+              0.7 - 1e-6);
+    if (state.pose.Translation().Distance(waypoints[0]) < 1e-6_m) {
+      reachedWaypoint = true;
+    }
+  }
+  EXPECT_TRUE(reachedWaypoint);
+  EXPECT_NEAR(trajectory->States().back().pose.X().value(), 4.0, 1e-6);
+}
+
+TEST(TrajectoryOptimizerTest, SwerveCurrentLimit) {
+  auto guess = TrajectoryGenerator::GenerateTrajectory(
+      Pose2d{}, {}, Pose2d{3_m, 2_m, 0_deg}, TrajectoryConfig{1_mps, 1_mps_sq});
+
+  TrajectoryOptimizer::Options options;
+  options.numSamples = 30;
+  options.maxCurrent = 40_A;
+  auto trajectory =
+      TrajectoryOptimizer::OptimizeSwerve(guess, {}, kSwerveDrive, options);
+  ASSERT_TRUE(trajectory);
+
+  EXPECT_LT(trajectory->TotalTime(), guess.TotalTime());
+
+  // a = IGKₜn/(rm)
+  double maxAccel = 40.0 * kSwerveDrive.gearing *
+                    kSwerveDrive.motor.Kt.value() * kSwerveDrive.numModules /
+                    kSwerveDrive.wheelRadius.value() /
+                    kSwerveDrive.mass.value();
+  for (const auto& state : trajectory->States()) {
+    EXPECT_LE(std::abs(state.acceleration.value()), maxAccel + 1e-6);
+  }
+  EXPECT_NEAR(trajectory->States().back().pose.X().value(), 3.0, 1e-6);
+  EXPECT_NEAR(trajectory->States().back().pose.Y().value(), 2.0, 1e-6);
+}
+
+TEST(TrajectoryOptimizerTest, TooFewSamples) {
+  auto guess = TrajectoryGenerator::GenerateTrajectory(
+      Pose2d{}, {}, Pose2d{4_m, 0_m, 0_deg}, TrajectoryConfig{1_mps, 1_mps_sq});
+
+  TrajectoryOptimizer::Options options;
+  for (int numSamples : {-1, 0, 1}) {
+    options.numSamples = numSamples;
+    EXPECT_THROW(TrajectoryOptimizer::OptimizeDifferential(
+                     guess, {}, kDifferentialDrive, options),
+                 std::invalid_argument);
+    EXPECT_THROW(
+        TrajectoryOptimizer::OptimizeSwerve(guess, {}, kSwerveDrive, options),
+        std::invalid_argument);
+  }
+}
+
+TEST(TrajectoryOptimizerTest, MoreWaypointsThanSamples) {
+  const std::vector<Translation2d> waypoints{
+      {1_m, 0.5_m}, {2_m, 1_m}, {3_m, 0.5_m}};
+  auto guess = TrajectoryGenerator::GenerateTrajectory(
+      Pose2d{}, waypoints, Pose2d{4_m, 0_m, 0_deg},
+      TrajectoryConfig{1_mps, 1_mps_sq});
+
+  // Each waypoint needs its own sample between the endpoints
+  TrajectoryOptimizer::Options options;
+  options.numSamples = 3;
+  EXPECT_THROW(TrajectoryOptimizer::OptimizeDifferential(
+                   guess, waypoints, kDifferentialDrive, options),
+               std::invalid_argument);
+  EXPECT_THROW(TrajectoryOptimizer::OptimizeSwerve(guess, waypoints,
+                                                   kSwerveDrive, options),
+               std::invalid_argument);
+}
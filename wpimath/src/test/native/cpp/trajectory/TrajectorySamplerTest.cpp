@@ -0,0 +1,73 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/Trajectory.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+
+namespace {
+
+frc::Trajectory MakeTrajectory() {
+  frc::TrajectoryConfig config{3_mps, 3_mps_sq};
+  return frc::TrajectoryGenerator::GenerateTrajectory(
+      frc::Pose2d{}, {frc::Translation2d{1_m, 1_m}},
+      frc::Pose2d{3_m, 0_m, 0_deg}, config);
+}
+
+}  // namespace
+
+TEST(TrajectorySamplerTest, MatchesSample) {
+  auto trajectory = MakeTrajectory();
+  frc::Trajectory::Sampler sampler{trajectory};
+
+  // Forward in small steps, then in steps larger than the distance between
+  // states, past the end, backward, and jumping around
+  std::vector<units::second_t> times;
+  for (auto t = -0.1_s; t < trajectory.TotalTime() + 0.1_s; t += 1_ms) {
+    times.emplace_back(t);
+  }
+  for (auto t = 0_s; t < trajectory.TotalTime(); t += 0.1_s) {
+    times.emplace_back(t);
+  }
+  for (auto t = trajectory.TotalTime(); t > 0_s; t -= 20_ms) {
+    times.emplace_back(t);
+  }
+  for (auto t : trajectory.States()) {
+    times.emplace_back(t.t);
+  }
+  times.insert(times.end(), {1_s, 0.2_s, 1.5_s, 0.5_s, 0.5_s, 0_s, 1.1_s});
+
+  for (auto t : times) {
+    EXPECT_EQ(trajectory.Sample(t), sampler.Sample(t));
+  }
+}
+
+TEST(TrajectorySamplerTest, SampleMany) {
+  auto trajectory = MakeTrajectory();
+
+  std::vector<units::second_t> times;
+  for (auto t = 0_s; t < trajectory.TotalTime(); t += 20_ms) {
+    times.emplace_back(t);
+  }
+  std::vector<frc::Trajectory::State> output(times.size());
+  trajectory.SampleMany(times, output);
+
+  for (size_t i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(trajectory.Sample(times[i]), output[i]);
+  }
+
+  std::vector<frc::Trajectory::State> wrongSize(times.size() - 1);
+  EXPECT_THROW(trajectory.SampleMany(times, wrongSize), std::invalid_argument);
+}
+
+TEST(TrajectorySamplerTest, Empty) {
+  frc::Trajectory trajectory;
+  frc::Trajectory::Sampler sampler{trajectory};
+  EXPECT_THROW(sampler.Sample(0_s), std::runtime_error);
+}